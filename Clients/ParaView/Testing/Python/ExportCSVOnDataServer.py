@@ -0,0 +1,52 @@
+#/usr/bin/env python
+from paraview.simple import *
+from paraview.vtk.util.misc import vtkGetTempDir
+from os.path import join
+
+# This test tests that exporting CSV from a spreadsheet directly from the data
+# server (WriteOnDataServer) writes the same header and rows as exporting it
+# from the client, and respects column visibility.
+
+def read_csv(csvfilename):
+    import csv
+    with open(csvfilename, "r") as csvfile:
+        rows = [row for row in csv.reader(csvfile, delimiter=",")]
+    assert len(rows) > 0, "empty file: %s" % csvfilename
+    return rows[0], rows[1:]
+
+Sphere()
+elevation = Elevation()
+UpdatePipeline()
+numberOfPoints = elevation.GetDataInformation().GetNumberOfPoints()
+
+clientfilename = join(vtkGetTempDir(), "data_client.csv")
+serverfilename = join(vtkGetTempDir(), "data_server.csv")
+v = CreateView("SpreadSheetView")
+r = Show()
+
+ExportView(clientfilename)
+ExportView(serverfilename, WriteOnDataServer=1)
+
+clientheader, clientrows = read_csv(clientfilename)
+header, rows = read_csv(serverfilename)
+print(header)
+assert ("Normals_0" in header and \
+        "Elevation" in header and \
+        "Point ID" in header and \
+        "__vtkIsSelected__" not in header)
+assert header == clientheader, "header differs from the client export"
+assert len(rows) == numberOfPoints, "expected one row per point"
+assert all(len(row) == len(header) for row in rows), "rows do not match the header"
+# rows are written in the order they are distributed among processes.
+assert sorted(rows) == sorted(clientrows), "rows differ from the client export"
+
+v.HiddenColumnLabels = ["Normals"]
+Render()
+
+ExportView(serverfilename, WriteOnDataServer=1)
+header, rows = read_csv(serverfilename)
+assert ("Normals_0" not in header and \
+        "Elevation" in header and \
+        "Point ID" in header)
+assert len(rows) == numberOfPoints, "expected one row per point"
+assert all(len(row) == len(header) for row in rows), "rows do not match the header"
@@ -39,6 +39,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "cdi.h"
 #include <string>
+#include <vector>
 
 namespace cdi_tools
 {
@@ -119,9 +120,11 @@ void cdi_get_full(CDIVar* cdiVar, T* buffer, int nlevels)
 template <class T>
 void cdi_get_part_struct(CDIVar* cdiVar, int start, size_t size, T* buffer, int nlevels)
 {
+  // CDI cannot read part of a structured grid: read the requested levels of
+  // the whole grid on the heap, large grids would not fit on the stack.
   const size_t gridsize = cdiVar->GridSize;
-  T fullbuff[gridsize * nlevels];
-  cdi_get_full(cdiVar, fullbuff, nlevels);
+  std::vector<T> fullbuff(gridsize * nlevels);
+  cdi_get_full(cdiVar, fullbuff.data(), nlevels);
   for (size_t lev = 0; lev < nlevels; lev++)
   {
     for (size_t i = 0; i < size; i++)
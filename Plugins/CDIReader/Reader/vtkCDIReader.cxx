@@ -48,6 +48,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMultiProcessController.h"
 #include "vtkPointData.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
@@ -58,8 +59,14 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "cdi_tools.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <list>
 #include <set>
 #include <sstream>
+#include <unordered_map>
 
 namespace
 {
@@ -160,6 +167,23 @@ struct Grid
   size_t Size;
   int PointsPerCell;
 };
+
+//----------------------------------------------------------------------------
+// Header of the grid cache file. It is followed by the global vertex id of
+// every cell corner (int), then by the longitude and the latitude of every
+// vertex (double), in native byte order.
+struct GridCacheHeader
+{
+  char Magic[8];
+  int64_t GridFileTime;
+  uint64_t GridFileSize;
+  int64_t NumberOfCells;
+  int32_t PointsPerCell;
+  int32_t Radians;
+  int64_t NumberOfPoints;
+};
+
+constexpr char GRID_CACHE_MAGIC[8] = { 'C', 'D', 'I', 'G', 'R', 'I', 'D', '1' };
 }
 
 //----------------------------------------------------------------------------
@@ -195,6 +219,77 @@ public:
   std::map<std::string, Dimset> DimensionSets;
   std::vector<Grid> Grids;
   CDIObject DataFile, GridFile, VGridFile;
+
+  // The grid geometry of the local piece, as constructed for one projection
+  // and before wrapping.
+  struct CachedGeometry
+  {
+    int NumberLocalCells;
+    int NumberLocalPoints;
+    int NumberOfPoints;
+    int ModNumPoints;
+    int ModNumCells;
+    int VertexIdRange[2];
+    std::vector<double> PointX;
+    std::vector<double> PointY;
+    std::vector<double> PointZ;
+    std::vector<int> OrigConnections;
+    std::vector<int> VertexIds;
+  };
+
+  // An entry of the cache: either a slab of a variable or a grid geometry.
+  struct CacheEntry
+  {
+    std::string Key;
+    std::vector<char> Slab;
+    std::shared_ptr<CachedGeometry> Geometry;
+    size_t Size = 0;
+  };
+
+  // Cache of the data read from the files, most recently used first.
+  std::list<CacheEntry> Cache;
+  std::unordered_map<std::string, std::list<CacheEntry>::iterator> CacheIndex;
+  size_t CacheBytes = 0;
+
+  CacheEntry* FindInCache(const std::string& key)
+  {
+    auto it = this->CacheIndex.find(key);
+    if (it == this->CacheIndex.end())
+    {
+      return nullptr;
+    }
+    this->Cache.splice(this->Cache.begin(), this->Cache, it->second);
+    return &this->Cache.front();
+  }
+
+  void AddToCache(CacheEntry&& entry, size_t budget)
+  {
+    auto it = this->CacheIndex.find(entry.Key);
+    if (it != this->CacheIndex.end())
+    {
+      this->CacheBytes -= it->second->Size;
+      this->Cache.erase(it->second);
+      this->CacheIndex.erase(it);
+    }
+    if (entry.Size > budget)
+    {
+      return;
+    }
+    this->TrimCache(budget - entry.Size);
+    this->CacheBytes += entry.Size;
+    this->Cache.push_front(std::move(entry));
+    this->CacheIndex[this->Cache.front().Key] = this->Cache.begin();
+  }
+
+  void TrimCache(size_t budget)
+  {
+    while (this->CacheBytes > budget && !this->Cache.empty())
+    {
+      this->CacheBytes -= this->Cache.back().Size;
+      this->CacheIndex.erase(this->Cache.back().Key);
+      this->Cache.pop_back();
+    }
+  }
 };
 
 namespace
@@ -248,6 +343,73 @@ int ComparePointWithIndex(const void* a, const void* b)
   }
   return 0;
 }
+
+//----------------------------------------------------------------------------
+// Modification time and size of a file, part of the keys of the in-memory
+// cache so that entries read from a file that has since changed are not used.
+//----------------------------------------------------------------------------
+std::string GetFileStamp(const std::string& fileName)
+{
+  std::ostringstream stamp;
+  stamp << vtksys::SystemTools::ModifiedTime(fileName) << "|"
+        << vtksys::SystemTools::FileLength(fileName);
+  return stamp.str();
+}
+
+//----------------------------------------------------------------------------
+// Renumber the local vertices in increasing order of their global ids, given
+// the local id (connections) and the global id (vertexIds) of every local cell
+// corner. This is how ReadGridCache numbers the vertices, and it is the order
+// of the vertices of the whole grid. Leaves everything unchanged and returns
+// false if local and global ids do not match one to one.
+//----------------------------------------------------------------------------
+bool SortLocalVerticesByGlobalId(std::vector<int>& connections, const std::vector<int>& vertexIds,
+  int numberOfPoints, std::vector<double>& x, std::vector<double>& y, std::vector<double>& z)
+{
+  std::vector<int> globalIds(numberOfPoints, -1);
+  for (size_t j = 0; j < connections.size(); j++)
+  {
+    int& globalId = globalIds[connections[j]];
+    if (globalId != -1 && globalId != vertexIds[j])
+    {
+      return false;
+    }
+    globalId = vertexIds[j];
+  }
+
+  std::vector<int> order(numberOfPoints);
+  for (int i = 0; i < numberOfPoints; i++)
+  {
+    order[i] = i;
+  }
+  std::sort(
+    order.begin(), order.end(), [&](int a, int b) { return globalIds[a] < globalIds[b]; });
+  for (int i = 0; i < numberOfPoints; i++)
+  {
+    if (globalIds[order[i]] == -1 || (i > 0 && globalIds[order[i]] == globalIds[order[i - 1]]))
+    {
+      return false;
+    }
+  }
+
+  std::vector<int> newIds(numberOfPoints);
+  std::vector<double> sortedX(numberOfPoints), sortedY(numberOfPoints), sortedZ(numberOfPoints);
+  for (int i = 0; i < numberOfPoints; i++)
+  {
+    newIds[order[i]] = i;
+    sortedX[i] = x[order[i]];
+    sortedY[i] = y[order[i]];
+    sortedZ[i] = z[order[i]];
+  }
+  std::copy(sortedX.begin(), sortedX.end(), x.begin());
+  std::copy(sortedY.begin(), sortedY.end(), y.begin());
+  std::copy(sortedZ.begin(), sortedZ.end(), z.begin());
+  for (int& connection : connections)
+  {
+    connection = newIds[connection];
+  }
+  return true;
+}
 } // end of anonymous namepace
 
 vtkStandardNewMacro(vtkCDIReader);
@@ -279,6 +441,10 @@ vtkCDIReader::vtkCDIReader()
     this->SetController(dummyController);
   }
 
+  const char* cacheDir = vtksys::SystemTools::GetEnv("PV_CDI_GRID_CACHE_DIR");
+  this->UseGridCache = cacheDir != nullptr;
+  this->GridCacheDirectory = cacheDir ? cacheDir : "";
+
   vtkDebugMacro("MAX_VARS:" << MAX_VARS);
   vtkDebugMacro("Created vtkCDIReader");
 }
@@ -1406,6 +1572,18 @@ int vtkCDIReader::ConstructGridGeometry()
   this->NumberLocalCells = this->GetPartitioning(this->Piece, this->NumPieces, this->NumberOfCells,
     this->PointsPerCell, this->BeginPoint, this->EndPoint, this->BeginCell, this->EndCell);
 
+  this->DepthVar.resize(this->MaximumNVertLevels);
+  vtkDebugMacro("Getting vertical axis" << this->ZAxisID << " expecting up to "
+                                        << this->MaximumNVertLevels << " levels.");
+  zaxisInqLevels(this->ZAxisID, this->DepthVar.data());
+  vtkDebugMacro("Got vertical axis" << this->ZAxisID);
+
+  if (this->ReadGeometryFromCache())
+  {
+    vtkDebugMacro("Grid geometry read from the cache");
+    return 1;
+  }
+
   int size = this->NumberLocalCells * this->PointsPerCell;
   int size2 = this->NumberAllCells * this->PointsPerCell;
   std::vector<double> cLonVertices;
@@ -1417,66 +1595,55 @@ int vtkCDIReader::ConstructGridGeometry()
   }
   cLonVertices.resize(size);
   cLatVertices.resize(size);
-  this->DepthVar.resize(this->MaximumNVertLevels);
+  this->OrigConnections.resize(size);
+  this->VertexIds.resize(size);
+  int new_cells[2];
 
-  vtkDebugMacro("Start reading Vertices");
-  try
+  // With a valid grid cache, every rank reads the vertices of its own cells
+  // only, already deduplicated.
+  bool cached = this->UseGridCache && this->ReadGridCache(cLonVertices, cLatVertices);
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+  if (this->Decomposition && this->UseGridCache)
   {
-    gridInqXboundsPart(Internals->Grids.at(this->GridID).GridID,
-      (this->BeginCell * this->PointsPerCell), size, cLonVertices.data());
-    gridInqYboundsPart(Internals->Grids.at(this->GridID).GridID,
-      (this->BeginCell * this->PointsPerCell), size, cLatVertices.data());
+    // all ranks must use the cache, or none since the vertices are otherwise
+    // numbered by the first rank.
+    int localCached = cached ? 1 : 0;
+    int allCached = 0;
+    this->Controller->AllReduce(&localCached, &allCached, 1, vtkCommunicator::MIN_OP);
+    cached = allCached == 1;
   }
-  catch (const std::out_of_range& oor)
+#endif
+
+  if (cached)
   {
-    vtkErrorMacro(
-      "Out of Range error trying to get the grid id for reading vertices: " << oor.what());
-    return 0;
+    vtkDebugMacro("Read " << this->NumberLocalPoints << " vertices from the grid cache");
+    new_cells[0] = size;
+    new_cells[1] = this->NumberLocalPoints;
   }
-  vtkDebugMacro("Done reading Vertices");
-  vtkDebugMacro("Getting vertical axis" << this->ZAxisID << " expecting up to "
-                                        << this->MaximumNVertLevels << " levels.");
-  zaxisInqLevels(this->ZAxisID, this->DepthVar.data());
-  vtkDebugMacro("Got vertical axis" << this->ZAxisID);
-  char units[CDI_MAX_NAME];
-  this->OrigConnections.resize(size);
-  int new_cells[2];
-  try
+  else
   {
-    if (this->ProjectionMode != projection::CATALYST)
+    vtkDebugMacro("Start reading Vertices");
+    if (!this->ReadGridVertices(this->BeginCell * this->PointsPerCell, size, cLonVertices.data(),
+          cLatVertices.data()))
     {
-      gridInqXunits(this->Internals->Grids.at(this->GridID).GridID, units);
-      if (strncmp(units, "degree", 6) == 0)
-      {
-        for (int i = 0; i < size; i++)
-        {
-          cLonVertices[i] = vtkMath::RadiansFromDegrees(cLonVertices[i]);
-        }
-      }
-      gridInqYunits(this->Internals->Grids.at(this->GridID).GridID, units);
-      if (strncmp(units, "degree", 6) == 0)
-      {
-        for (int i = 0; i < size; i++)
-        {
-          cLatVertices[i] = vtkMath::RadiansFromDegrees(cLatVertices[i]);
-        }
-      }
+      return 0;
     }
-  }
-  catch (const std::out_of_range& oor)
-  {
-    vtkErrorMacro("Out of Range error trying to get the grid id for getting the coordinate units "
-                  "for projecting: "
-      << oor.what());
-    return 0;
-  }
+    vtkDebugMacro("Done reading Vertices");
+
+    // check for duplicates in the Point list and update the triangle list
+    vtkDebugMacro("Removing duplicates for clon/clat, size = " << size);
 
-  // check for duplicates in the Point list and update the triangle list
-  vtkDebugMacro("Removing duplicates for clon/clat, size = " << size);
+    this->RemoveDuplicates(
+      cLonVertices.data(), cLatVertices.data(), size, &this->OrigConnections[0], new_cells);
+    vtkDebugMacro("Removed duplicates for clon/clat");
+
+    if (this->UseGridCache && size == size2)
+    {
+      this->WriteGridCache(
+        this->OrigConnections.data(), size, cLonVertices.data(), cLatVertices.data(), new_cells[1]);
+    }
+  }
 
-  this->RemoveDuplicates(
-    cLonVertices.data(), cLatVertices.data(), size, &this->OrigConnections[0], new_cells);
-  vtkDebugMacro("Removed duplicates for clon/clat");
   this->NumberLocalCells = new_cells[0] / this->PointsPerCell;
   this->NumberLocalPoints = new_cells[1];
   if (this->NumberOfPoints and this->NumberOfPoints != new_cells[1])
@@ -1513,52 +1680,26 @@ int vtkCDIReader::ConstructGridGeometry()
   this->ReconstructNew = false;
 
   // if we run with data decomposition, we need to know the mapping of points
-  this->VertexIds.resize(size);
-  std::vector<int> vertex_ids2;
-  if (size2 > vertex_ids2.max_size())
-  {
-    vtkErrorMacro("Too many points to construct geometry.");
-    return 0;
-  }
-  vertex_ids2.resize(size2);
 #if VTK_MODULE_ENABLE_VTK_ParallelMPI
   if (this->Decomposition)
   {
-    if (this->Piece == 0)
+    // with the grid cache, VertexIds were read from it.
+    if (!cached && this->Piece == 0)
     {
       int new_cells2[2];
-      std::vector<double> clon_vert2(size2);
-      std::vector<double> clat_vert2(size2);
-      try
+      std::vector<int> vertex_ids2;
+      std::vector<double> clon_vert2;
+      std::vector<double> clat_vert2;
+      if (size2 > vertex_ids2.max_size())
       {
-        gridInqXboundsPart(
-          this->Internals->Grids.at(this->GridID).GridID, 0, size2, clon_vert2.data());
-        gridInqYboundsPart(
-          this->Internals->Grids.at(this->GridID).GridID, 0, size2, clat_vert2.data());
-
-        gridInqXunits(this->Internals->Grids.at(this->GridID).GridID, units);
-        if (strncmp(units, "degree", 6) == 0)
-        {
-          for (int i = 0; i < size2; i++)
-          {
-            clon_vert2[i] = vtkMath::RadiansFromDegrees(clon_vert2[i]);
-          }
-        }
-
-        gridInqYunits(this->Internals->Grids.at(this->GridID).GridID, units);
-        if (strncmp(units, "degree", 6) == 0)
-        {
-          for (int i = 0; i < size2; i++)
-          {
-            clat_vert2[i] = vtkMath::RadiansFromDegrees(clat_vert2[i]);
-          }
-        }
+        vtkErrorMacro("Too many points to construct geometry.");
+        return 0;
       }
-      catch (const std::out_of_range& oor)
+      vertex_ids2.resize(size2);
+      clon_vert2.resize(size2);
+      clat_vert2.resize(size2);
+      if (!this->ReadGridVertices(0, size2, clon_vert2.data(), clat_vert2.data()))
       {
-        vtkErrorMacro(
-          "Out of Range error trying to get the grid id for converting lat/lon in parallel: "
-          << oor.what());
         return 0;
       }
 
@@ -1566,19 +1707,41 @@ int vtkCDIReader::ConstructGridGeometry()
 
       this->RemoveDuplicates(
         clon_vert2.data(), clat_vert2.data(), size2, vertex_ids2.data(), new_cells2);
+      if (this->UseGridCache)
+      {
+        this->WriteGridCache(
+          vertex_ids2.data(), size2, clon_vert2.data(), clat_vert2.data(), new_cells2[1]);
+      }
+
+      // send each rank the ids of its own vertices only.
       for (int i = 1; i < this->NumPieces; i++)
       {
-        this->Controller->Send(vertex_ids2.data(), size2, i, 101);
+        int beginPoint, endPoint, beginCell, endCell;
+        this->GetPartitioning(i, this->NumPieces, this->NumberOfCells, this->PointsPerCell,
+          beginPoint, endPoint, beginCell, endCell);
+        this->Controller->Send(
+          vertex_ids2.data() + beginPoint, endPoint - beginPoint + 1, i, 101);
       }
+      std::copy(vertex_ids2.begin() + this->BeginPoint, vertex_ids2.begin() + this->EndPoint + 1,
+        this->VertexIds.begin());
     }
-    else
+    else if (!cached)
+    {
+      this->Controller->Receive(this->VertexIds.data(), size, 0, 101);
+    }
+
+    if (!cached)
     {
-      this->Controller->Receive(vertex_ids2.data(), size2, 0, 101);
+      // number the vertices as when reading them from the grid cache.
+      ::SortLocalVerticesByGlobalId(this->OrigConnections, this->VertexIds,
+        this->NumberLocalPoints, this->PointX, this->PointY, this->PointZ);
+    }
 
-      for (int i = this->BeginPoint; i < (this->EndPoint + 1); i++)
-      {
-        this->VertexIds[i - this->BeginPoint] = vertex_ids2[i];
-      }
+    if (!this->VertexIds.empty())
+    {
+      auto range = std::minmax_element(this->VertexIds.begin(), this->VertexIds.end());
+      this->VertexIdRange[0] = *range.first;
+      this->VertexIdRange[1] = *range.second;
     }
 
     this->SetupPointConnectivity();
@@ -1587,11 +1750,314 @@ int vtkCDIReader::ConstructGridGeometry()
 
   this->CurrentExtraPoint = this->NumberLocalPoints;
   this->CurrentExtraCell = this->NumberLocalCells;
+  this->AddGeometryToCache();
 
   vtkDebugMacro("Grid Reconstruction complete...");
   return 1;
 }
 
+//----------------------------------------------------------------------------
+// Key of the grid geometry of the local piece, for the current projection, in
+// the cache.
+//----------------------------------------------------------------------------
+std::string vtkCDIReader::GetGeometryCacheKey()
+{
+  const std::string gridFile = this->Internals->GridFile.getURI();
+  std::ostringstream key;
+  key << "grid|" << gridFile << "|" << ::GetFileStamp(gridFile) << "|" << this->GridID << "|"
+      << this->NumberOfCells << "|" << this->PointsPerCell << "|" << this->Piece << "|"
+      << this->NumPieces << "|" << this->Decomposition << "|" << this->ProjectionMode;
+  return key.str();
+}
+
+//----------------------------------------------------------------------------
+// Restore the grid geometry constructed by ConstructGridGeometry from the
+// cache. Returns false if it is not in the cache.
+//----------------------------------------------------------------------------
+bool vtkCDIReader::ReadGeometryFromCache()
+{
+  Internal::CacheEntry* entry =
+    this->CacheSize > 0 ? this->Internals->FindInCache(this->GetGeometryCacheKey()) : nullptr;
+  bool cached = entry != nullptr;
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+  if (this->Decomposition)
+  {
+    // all ranks must use the cache, or none since the first rank otherwise
+    // sends the vertex ids to the others.
+    int localCached = cached ? 1 : 0;
+    int allCached = 0;
+    this->Controller->AllReduce(&localCached, &allCached, 1, vtkCommunicator::MIN_OP);
+    cached = allCached == 1;
+  }
+#endif
+  if (!cached)
+  {
+    return false;
+  }
+
+  const Internal::CachedGeometry& geometry = *entry->Geometry;
+  this->NumberLocalCells = geometry.NumberLocalCells;
+  this->NumberLocalPoints = geometry.NumberLocalPoints;
+  this->NumberOfPoints = geometry.NumberOfPoints;
+  this->ModNumPoints = geometry.ModNumPoints;
+  this->ModNumCells = geometry.ModNumCells;
+  this->VertexIdRange[0] = geometry.VertexIdRange[0];
+  this->VertexIdRange[1] = geometry.VertexIdRange[1];
+  this->OrigConnections = geometry.OrigConnections;
+  this->VertexIds = geometry.VertexIds;
+
+  // room for the points added by wrapping.
+  this->PointX.assign(geometry.PointX.begin(), geometry.PointX.end());
+  this->PointY.assign(geometry.PointY.begin(), geometry.PointY.end());
+  this->PointZ.assign(geometry.PointZ.begin(), geometry.PointZ.end());
+  this->PointX.resize(this->ModNumPoints);
+  this->PointY.resize(this->ModNumPoints);
+  this->PointZ.resize(this->ModNumPoints);
+  this->PointMap.resize((size_t)floor(this->NumberOfPoints * (this->Bloat * this->Bloat)));
+  this->CellMap.resize((size_t)floor(this->NumberOfCells * this->Bloat));
+
+  this->GridReconstructed = true;
+  this->ReconstructNew = false;
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+  if (this->Decomposition)
+  {
+    this->SetupPointConnectivity();
+  }
+#endif
+
+  this->CurrentExtraPoint = this->NumberLocalPoints;
+  this->CurrentExtraCell = this->NumberLocalCells;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// Add the grid geometry just constructed by ConstructGridGeometry to the cache.
+//----------------------------------------------------------------------------
+void vtkCDIReader::AddGeometryToCache()
+{
+  if (this->CacheSize <= 0)
+  {
+    return;
+  }
+
+  auto geometry = std::make_shared<Internal::CachedGeometry>();
+  geometry->NumberLocalCells = this->NumberLocalCells;
+  geometry->NumberLocalPoints = this->NumberLocalPoints;
+  geometry->NumberOfPoints = this->NumberOfPoints;
+  geometry->ModNumPoints = this->ModNumPoints;
+  geometry->ModNumCells = this->ModNumCells;
+  geometry->VertexIdRange[0] = this->VertexIdRange[0];
+  geometry->VertexIdRange[1] = this->VertexIdRange[1];
+  geometry->PointX.assign(this->PointX.begin(), this->PointX.begin() + this->NumberLocalPoints);
+  geometry->PointY.assign(this->PointY.begin(), this->PointY.begin() + this->NumberLocalPoints);
+  geometry->PointZ.assign(this->PointZ.begin(), this->PointZ.begin() + this->NumberLocalPoints);
+  geometry->OrigConnections = this->OrigConnections;
+  geometry->VertexIds = this->VertexIds;
+
+  Internal::CacheEntry entry;
+  entry.Key = this->GetGeometryCacheKey();
+  entry.Size = 3 * geometry->PointX.size() * sizeof(double) +
+    (geometry->OrigConnections.size() + geometry->VertexIds.size()) * sizeof(int);
+  entry.Geometry = geometry;
+  this->Internals->AddToCache(std::move(entry), static_cast<size_t>(this->CacheSize) << 20);
+}
+
+//----------------------------------------------------------------------------
+// Read the vertices of the cells from the grid file, in radians unless using
+// the catalyst projection.
+//----------------------------------------------------------------------------
+int vtkCDIReader::ReadGridVertices(int start, int size, double* lon, double* lat)
+{
+  try
+  {
+    const int gridID = this->Internals->Grids.at(this->GridID).GridID;
+    gridInqXboundsPart(gridID, start, size, lon);
+    gridInqYboundsPart(gridID, start, size, lat);
+
+    if (this->ProjectionMode != projection::CATALYST)
+    {
+      char units[CDI_MAX_NAME];
+      gridInqXunits(gridID, units);
+      if (strncmp(units, "degree", 6) == 0)
+      {
+        for (int i = 0; i < size; i++)
+        {
+          lon[i] = vtkMath::RadiansFromDegrees(lon[i]);
+        }
+      }
+      gridInqYunits(gridID, units);
+      if (strncmp(units, "degree", 6) == 0)
+      {
+        for (int i = 0; i < size; i++)
+        {
+          lat[i] = vtkMath::RadiansFromDegrees(lat[i]);
+        }
+      }
+    }
+  }
+  catch (const std::out_of_range& oor)
+  {
+    vtkErrorMacro(
+      "Out of Range error trying to get the grid id for reading vertices: " << oor.what());
+    return 0;
+  }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+std::string vtkCDIReader::GetGridCacheFileName()
+{
+  const std::string gridFile =
+    vtksys::SystemTools::CollapseFullPath(this->Internals->GridFile.getURI());
+  const std::string directory = !this->GridCacheDirectory.empty()
+    ? this->GridCacheDirectory
+    : vtksys::SystemTools::GetFilenamePath(gridFile);
+
+  // The hash keeps caches for grid files from different directories apart
+  // when they share a cache directory. A grid file can hold several grids.
+  std::ostringstream name;
+  name << directory << "/." << vtksys::SystemTools::GetFilenameName(gridFile) << "." << std::hex
+       << std::hash<std::string>{}(gridFile) << "." << std::dec << this->GridID << ".cdigrid";
+  return name.str();
+}
+
+//----------------------------------------------------------------------------
+// Read the vertices of the local cells from the grid cache. Fills
+// OrigConnections, VertexIds and the coordinates of the NumberLocalPoints
+// local vertices. Returns false if there is no cache or if it is out of date.
+//----------------------------------------------------------------------------
+bool vtkCDIReader::ReadGridCache(std::vector<double>& lon, std::vector<double>& lat)
+{
+  const std::string gridFile = this->Internals->GridFile.getURI();
+  const std::string cacheFileName = this->GetGridCacheFileName();
+  vtksys::ifstream cacheFile(cacheFileName.c_str(), std::ios::in | std::ios::binary);
+  if (!cacheFile)
+  {
+    return false;
+  }
+
+  GridCacheHeader header;
+  if (!cacheFile.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+    memcmp(header.Magic, GRID_CACHE_MAGIC, sizeof(GRID_CACHE_MAGIC)) != 0 ||
+    header.GridFileTime != static_cast<int64_t>(vtksys::SystemTools::ModifiedTime(gridFile)) ||
+    header.GridFileSize != static_cast<uint64_t>(vtksys::SystemTools::FileLength(gridFile)) ||
+    header.NumberOfCells != this->NumberAllCells || header.PointsPerCell != this->PointsPerCell ||
+    header.Radians != (this->ProjectionMode != projection::CATALYST ? 1 : 0))
+  {
+    vtkDebugMacro("Grid cache " << cacheFileName << " is out of date.");
+    return false;
+  }
+
+  // hyperslab of the vertex ids for the local cells
+  const int size = this->NumberLocalCells * this->PointsPerCell;
+  std::vector<int> globalIds(size);
+  const std::streamoff idsOffset = sizeof(header);
+  cacheFile.seekg(idsOffset + static_cast<std::streamoff>(this->BeginPoint) * sizeof(int));
+  if (size == 0 || !cacheFile.read(reinterpret_cast<char*>(globalIds.data()), size * sizeof(int)))
+  {
+    return false;
+  }
+
+  // hyperslab of the coordinates of these vertices
+  const auto range = std::minmax_element(globalIds.begin(), globalIds.end());
+  const int minId = *range.first;
+  const int maxId = *range.second;
+  if (minId < 0 || maxId >= header.NumberOfPoints)
+  {
+    return false;
+  }
+  const size_t numberOfIds = static_cast<size_t>(maxId - minId + 1);
+  std::vector<double> rangeLon(numberOfIds);
+  std::vector<double> rangeLat(numberOfIds);
+  const std::streamoff lonOffset = idsOffset +
+    static_cast<std::streamoff>(header.NumberOfCells) * header.PointsPerCell * sizeof(int);
+  const std::streamoff latOffset =
+    lonOffset + static_cast<std::streamoff>(header.NumberOfPoints) * sizeof(double);
+  cacheFile.seekg(lonOffset + static_cast<std::streamoff>(minId) * sizeof(double));
+  cacheFile.read(reinterpret_cast<char*>(rangeLon.data()), numberOfIds * sizeof(double));
+  cacheFile.seekg(latOffset + static_cast<std::streamoff>(minId) * sizeof(double));
+  cacheFile.read(reinterpret_cast<char*>(rangeLat.data()), numberOfIds * sizeof(double));
+  if (!cacheFile)
+  {
+    return false;
+  }
+
+  // number the local vertices in increasing order of their global ids, as
+  // the vertices of the whole grid are numbered without the cache. Local and
+  // global ids are then the same when reading the whole grid.
+  std::vector<int> localIds(numberOfIds, -1);
+  for (int j = 0; j < size; j++)
+  {
+    localIds[globalIds[j] - minId] = 0;
+  }
+  int numberOfPoints = 0;
+  for (size_t k = 0; k < numberOfIds; k++)
+  {
+    if (localIds[k] == 0)
+    {
+      localIds[k] = numberOfPoints;
+      lon[numberOfPoints] = rangeLon[k];
+      lat[numberOfPoints] = rangeLat[k];
+      numberOfPoints++;
+    }
+  }
+  for (int j = 0; j < size; j++)
+  {
+    this->OrigConnections[j] = localIds[globalIds[j] - minId];
+    this->VertexIds[j] = globalIds[j];
+  }
+  this->NumberLocalPoints = numberOfPoints;
+  this->VertexIdRange[0] = minId;
+  this->VertexIdRange[1] = maxId;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// Write the grid cache from the deduplicated vertices of the whole grid.
+//----------------------------------------------------------------------------
+bool vtkCDIReader::WriteGridCache(const int* vertexIds, int numberOfVertices, const double* lon,
+  const double* lat, int numberOfPoints)
+{
+  const std::string gridFile = this->Internals->GridFile.getURI();
+  GridCacheHeader header;
+  memcpy(header.Magic, GRID_CACHE_MAGIC, sizeof(GRID_CACHE_MAGIC));
+  header.GridFileTime = static_cast<int64_t>(vtksys::SystemTools::ModifiedTime(gridFile));
+  header.GridFileSize = static_cast<uint64_t>(vtksys::SystemTools::FileLength(gridFile));
+  header.NumberOfCells = numberOfVertices / this->PointsPerCell;
+  header.PointsPerCell = this->PointsPerCell;
+  header.Radians = this->ProjectionMode != projection::CATALYST ? 1 : 0;
+  header.NumberOfPoints = numberOfPoints;
+
+  // Write to a temporary file first so that other processes never see a
+  // partially written cache.
+  const std::string cacheFileName = this->GetGridCacheFileName();
+  const std::string tmpFileName = cacheFileName + ".tmp";
+  {
+    vtksys::ofstream cacheFile(tmpFileName.c_str(), std::ios::out | std::ios::binary);
+    if (!cacheFile)
+    {
+      vtkDebugMacro("Cannot write grid cache " << cacheFileName);
+      return false;
+    }
+    cacheFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    cacheFile.write(reinterpret_cast<const char*>(vertexIds), numberOfVertices * sizeof(int));
+    cacheFile.write(reinterpret_cast<const char*>(lon), numberOfPoints * sizeof(double));
+    cacheFile.write(reinterpret_cast<const char*>(lat), numberOfPoints * sizeof(double));
+    if (!cacheFile)
+    {
+      cacheFile.close();
+      vtksys::SystemTools::RemoveFile(tmpFileName);
+      return false;
+    }
+  }
+  if (!vtksys::SystemTools::RenameFile(tmpFileName, cacheFileName))
+  {
+    vtksys::SystemTools::RemoveFile(tmpFileName);
+    return false;
+  }
+  return true;
+}
+
 //----------------------------------------------------------------------------
 // Allocate into sphere view of geometry
 // This is work in progress, but as almost all variables are cell based, it
@@ -1795,6 +2261,41 @@ int vtkCDIReader::AddClonClatHalo()
   return 0;
 }
 
+//----------------------------------------------------------------------------
+//  Read a slab of a variable, from the cache if it was read before.
+//----------------------------------------------------------------------------
+template <typename ValueType>
+void vtkCDIReader::ReadVarSlab(cdi_tools::CDIVar* cdiVar, int timestep, int level, int start,
+  int length, int numberOfLevels, ValueType* buffer)
+{
+  const size_t bytes = sizeof(ValueType) * static_cast<size_t>(length) * numberOfLevels;
+  std::ostringstream key;
+  key << "slab|" << this->FileName << "|" << ::GetFileStamp(this->FileName) << "|"
+      << cdiVar->VarID << "|" << timestep << "|" << level << "|" << numberOfLevels << "|" << start
+      << "|" << length << "|" << sizeof(ValueType);
+
+  Internal::CacheEntry* entry =
+    this->CacheSize > 0 ? this->Internals->FindInCache(key.str()) : nullptr;
+  if (entry)
+  {
+    std::memcpy(buffer, entry->Slab.data(), bytes);
+    return;
+  }
+
+  cdi_set_cur(cdiVar, timestep, level);
+  cdi_tools::cdi_get_part<ValueType>(cdiVar, start, length, buffer, numberOfLevels, this->Grib);
+
+  if (this->CacheSize > 0)
+  {
+    Internal::CacheEntry newEntry;
+    newEntry.Key = key.str();
+    newEntry.Slab.assign(
+      reinterpret_cast<const char*>(buffer), reinterpret_cast<const char*>(buffer) + bytes);
+    newEntry.Size = bytes;
+    this->Internals->AddToCache(std::move(newEntry), static_cast<size_t>(this->CacheSize) << 20);
+  }
+}
+
 //----------------------------------------------------------------------------
 //  Read in Missing value mask. We probably should not read this, but just fetch it, but hell,
 //  whatever.
@@ -1861,9 +2362,8 @@ int vtkCDIReader::CheckForMaskData()
       float* dataTmpMask = new float[this->MaximumCells * sizeof(float)];
       CHECK_NEW(dataTmpMask);
 
-      cdi_set_cur(cdiVar, 0, 0);
-      cdi_tools::cdi_get_part<float>(cdiVar, this->BeginCell, this->NumberLocalCells, dataTmpMask,
-        this->MaximumNVertLevels, this->Grib);
+      this->ReadVarSlab<float>(cdiVar, 0, 0, this->BeginCell, this->NumberLocalCells,
+        this->MaximumNVertLevels, dataTmpMask);
       vtkDebugMacro("Done with read of 3d Mask data");
 
       // readjust the data
@@ -1885,9 +2385,8 @@ int vtkCDIReader::CheckForMaskData()
       this->CellMask.resize(this->NumberLocalCells * this->Bloat);
       float* dataTmpMask = new float[this->NumberLocalCells];
 
-      cdi_set_cur(cdiVar, 0, this->VerticalLevelSelected);
-      cdi_tools::cdi_get_part<float>(
-        cdiVar, this->BeginCell, this->NumberLocalCells, dataTmpMask, 1, this->Grib);
+      this->ReadVarSlab<float>(cdiVar, 0, this->VerticalLevelSelected, this->BeginCell,
+        this->NumberLocalCells, 1, dataTmpMask);
 
       // readjust the data
       for (int j = 0; j < this->NumberLocalCells; j++)
@@ -2714,9 +3213,8 @@ int vtkCDIReader::LoadCellVarDataTemplate(
   {
     if (!this->ShowMultilayerView)
     {
-      cdi_set_cur(cdiVar, timestep, this->VerticalLevelSelected);
-      cdi_tools::cdi_get_part<ValueType>(
-        cdiVar, this->BeginCell, this->NumberLocalCells, dataBlock, 1, this->Grib);
+      this->ReadVarSlab<ValueType>(cdiVar, timestep, this->VerticalLevelSelected,
+        this->BeginCell, this->NumberLocalCells, 1, dataBlock);
 
       // put out data for extra cells
       for (int j = this->NumberLocalCells; j < this->CurrentExtraCell; j++)
@@ -2728,9 +3226,8 @@ int vtkCDIReader::LoadCellVarDataTemplate(
     else
     {
       ValueType* dataTmp = new ValueType[this->MaximumCells];
-      cdi_set_cur(cdiVar, timestep, 0);
-      cdi_tools::cdi_get_part<ValueType>(cdiVar, this->BeginCell, this->NumberLocalCells, dataTmp,
-        this->MaximumNVertLevels, this->Grib);
+      this->ReadVarSlab<ValueType>(cdiVar, timestep, 0, this->BeginCell, this->NumberLocalCells,
+        this->MaximumNVertLevels, dataTmp);
 
       // readjust the data
       for (int j = 0; j < this->NumberLocalCells; j++)
@@ -2761,9 +3258,8 @@ int vtkCDIReader::LoadCellVarDataTemplate(
   {
     if (!this->ShowMultilayerView)
     {
-      cdi_set_cur(cdiVar, timestep, 0);
-      cdi_tools::cdi_get_part<ValueType>(
-        cdiVar, this->BeginCell, this->NumberLocalCells, dataBlock, 1, this->Grib);
+      this->ReadVarSlab<ValueType>(
+        cdiVar, timestep, 0, this->BeginCell, this->NumberLocalCells, 1, dataBlock);
 
       // put out data for extra cells
       for (int j = this->NumberLocalCells; j < this->CurrentExtraCell; j++)
@@ -2775,9 +3271,8 @@ int vtkCDIReader::LoadCellVarDataTemplate(
     else
     {
       ValueType* dataTmp = new ValueType[this->NumberLocalCells];
-      cdi_set_cur(cdiVar, timestep, 0);
-      cdi_tools::cdi_get_part<ValueType>(
-        cdiVar, this->BeginCell, this->NumberLocalCells, dataTmp, 1, this->Grib);
+      this->ReadVarSlab<ValueType>(
+        cdiVar, timestep, 0, this->BeginCell, this->NumberLocalCells, 1, dataTmp);
 
       for (int j = 0; j < +this->NumberLocalCells; j++)
       {
@@ -2875,9 +3370,8 @@ int vtkCDIReader::LoadPointVarDataTemplate(
     {
       if (!this->ShowMultilayerView)
       {
-        cdi_set_cur(cdiVar, timestep, this->VerticalLevelSelected);
-        cdi_tools::cdi_get_part<ValueType>(
-          cdiVar, this->BeginPoint, this->NumberLocalPoints, dataBlock, 1, this->Grib);
+        this->ReadVarSlab<ValueType>(cdiVar, timestep, this->VerticalLevelSelected,
+          this->BeginPoint, this->NumberLocalPoints, 1, dataBlock);
         dataBlock[0] = dataBlock[1];
 
         // put out data for extra points
@@ -2889,9 +3383,8 @@ int vtkCDIReader::LoadPointVarDataTemplate(
       }
       else
       {
-        cdi_set_cur(cdiVar, timestep, 0);
-        cdi_tools::cdi_get_part<ValueType>(cdiVar, this->BeginPoint, this->NumberLocalPoints,
-          dataTmp, this->MaximumNVertLevels, this->Grib);
+        this->ReadVarSlab<ValueType>(cdiVar, timestep, 0, this->BeginPoint,
+          this->NumberLocalPoints, this->MaximumNVertLevels, dataTmp);
         dataTmp[0] = dataTmp[1];
 
         // put out data for extra points
@@ -2911,16 +3404,14 @@ int vtkCDIReader::LoadPointVarDataTemplate(
     {
       if (!this->ShowMultilayerView)
       {
-        cdi_set_cur(cdiVar, timestep, 0);
-        cdi_tools::cdi_get_part<ValueType>(
-          cdiVar, this->BeginPoint, this->NumberLocalPoints, dataBlock, 1, this->Grib);
+        this->ReadVarSlab<ValueType>(
+          cdiVar, timestep, 0, this->BeginPoint, this->NumberLocalPoints, 1, dataBlock);
         dataBlock[0] = dataBlock[1];
       }
       else
       {
-        cdi_set_cur(cdiVar, timestep, 0);
-        cdi_tools::cdi_get_part<ValueType>(
-          cdiVar, this->BeginPoint, this->NumberLocalPoints, dataTmp, 1, this->Grib);
+        this->ReadVarSlab<ValueType>(
+          cdiVar, timestep, 0, this->BeginPoint, this->NumberLocalPoints, 1, dataTmp);
         dataTmp[0] = dataTmp[1];
       }
     }
@@ -2956,9 +3447,16 @@ int vtkCDIReader::LoadPointVarDataTemplate(
   }
   else
   {
-    int length = (this->NumberAllPoints / this->NumPieces);
-    int start = (length * this->Piece);
-    ValueType* dataTmp2 = new ValueType[length];
+    // only read the range of vertices used by the local cells.
+    int start = this->VertexIdRange[0];
+    int length = this->VertexIdRange[1] - start + 1;
+    if (length <= 0)
+    {
+      delete[] dataTmp;
+      return 0;
+    }
+    const int numberOfLevels = this->ShowMultilayerView ? this->MaximumNVertLevels : 1;
+    ValueType* dataTmp2 = new ValueType[static_cast<size_t>(length) * numberOfLevels];
 
     // 3D arrays ...
     vtkDebugMacro("Dimensions: " << varType);
@@ -2966,32 +3464,20 @@ int vtkCDIReader::LoadPointVarDataTemplate(
     {
       if (!this->ShowMultilayerView)
       {
-        cdi_set_cur(cdiVar, timestep, this->VerticalLevelSelected);
-        cdi_tools::cdi_get_part<ValueType>(cdiVar, start, length, dataTmp2, 1, this->Grib);
-        dataTmp2[0] = dataTmp2[1];
+        this->ReadVarSlab<ValueType>(
+          cdiVar, timestep, this->VerticalLevelSelected, start, length, 1, dataTmp2);
 
         // readjust the data
         size_t size = this->NumberLocalCells * this->PointsPerCell;
         for (size_t j = 0; j < size; j++)
         {
-          int pos = this->VertexIds[j];
-          int pos_conn = this->OrigConnections[j];
-          if ((pos > start) && (pos < (start + length + 1)))
-          {
-            dataBlock[pos_conn] = dataTmp2[pos - start];
-          }
-          else
-          {
-            dataBlock[pos_conn] = 0.0;
-          }
+          dataBlock[this->OrigConnections[j]] = dataTmp2[this->VertexIds[j] - start];
         }
       }
       else
       {
-        cdi_set_cur(cdiVar, timestep, 0);
-        cdi_tools::cdi_get_part<ValueType>(
-          cdiVar, start, length, dataTmp, this->MaximumNVertLevels, this->Grib);
-        dataTmp[0] = dataTmp[1];
+        this->ReadVarSlab<ValueType>(
+          cdiVar, timestep, 0, start, length, this->MaximumNVertLevels, dataTmp2);
       }
     }
     // 2D arrays ...
@@ -2999,31 +3485,18 @@ int vtkCDIReader::LoadPointVarDataTemplate(
     {
       if (!this->ShowMultilayerView)
       {
-        cdi_set_cur(cdiVar, timestep, 0);
-        cdi_tools::cdi_get_part<ValueType>(cdiVar, start, length, dataTmp2, 1, this->Grib);
-        dataTmp2[0] = dataTmp2[1];
+        this->ReadVarSlab<ValueType>(cdiVar, timestep, 0, start, length, 1, dataTmp2);
 
         // readjust the data
         size_t size = this->NumberLocalCells * this->PointsPerCell;
         for (size_t j = 0; j < size; j++)
         {
-          int pos = this->VertexIds[j];
-          int pos_conn = this->OrigConnections[j];
-          if ((pos > start) && (pos < (start + length + 1)))
-          {
-            dataBlock[pos_conn] = dataTmp2[pos - start];
-          }
-          else
-          {
-            dataBlock[pos_conn] = 0.0;
-          }
+          dataBlock[this->OrigConnections[j]] = dataTmp2[this->VertexIds[j] - start];
         }
       }
       else
       {
-        cdi_set_cur(cdiVar, timestep, 0);
-        cdi_tools::cdi_get_part<ValueType>(cdiVar, start, length, dataTmp, 1, this->Grib);
-        dataTmp[0] = dataTmp[1];
+        this->ReadVarSlab<ValueType>(cdiVar, timestep, 0, start, length, 1, dataTmp2);
       }
     }
     delete[] dataTmp2;
@@ -3661,6 +4134,38 @@ void vtkCDIReader::SetSkipGrid(bool val)
   this->SkipGrid = val;
 }
 
+//------------------------------------------------------------------------------
+void vtkCDIReader::SetCacheSize(int val)
+{
+  val = std::max(val, 0);
+  if (this->CacheSize != val)
+  {
+    this->CacheSize = val;
+    this->Internals->TrimCache(static_cast<size_t>(val) << 20);
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkCDIReader::SetUseGridCache(bool val)
+{
+  if (this->UseGridCache != val)
+  {
+    this->UseGridCache = val;
+    this->Modified();
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkCDIReader::SetGridCacheDirectory(const char* val)
+{
+  const std::string dir = val ? val : "";
+  if (this->GridCacheDirectory != dir)
+  {
+    this->GridCacheDirectory = dir;
+    this->Modified();
+  }
+}
+
 //----------------------------------------------------------------------------
 //  Set view to be multilayered view.
 //----------------------------------------------------------------------------
@@ -3724,6 +4229,9 @@ void vtkCDIReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "UseMask: " << (this->UseMask ? "ON" : "OFF") << endl;
   os << indent << "CustomMaskValue: " << this->CustomMaskValue << endl;
   os << indent << "SkipGrid: " << (this->SkipGrid ? "ON" : "OFF") << endl;
+  os << indent << "UseGridCache: " << (this->UseGridCache ? "ON" : "OFF") << endl;
+  os << indent << "GridCacheDirectory: " << this->GridCacheDirectory << endl;
+  os << indent << "CacheSize: " << this->CacheSize << endl;
   os << indent << "InvertMask: " << (this->InvertMask ? "ON" : "OFF") << endl;
   os << indent << "VerticalLevel: " << this->VerticalLevelSelected << "\n";
   os << indent << "VerticalLevelRange: " << this->VerticalLevelRange[0] << ","
@@ -56,6 +56,11 @@ class vtkDoubleArray;
 class vtkFieldData;
 class vtkMultiProcessController;
 
+namespace cdi_tools
+{
+struct CDIVar;
+}
+
 /**
  *
  * @class vtkCDIReader
@@ -192,6 +197,38 @@ public:
   void SetShowMultilayerView(bool val);
   vtkGetMacro(ShowMultilayerView, bool);
 
+  ///@{
+  /**
+   * If true, the connectivity of the horizontal grid is saved to a cache file
+   * the first time the grid is read, and reused as long as the grid file does
+   * not change. With a valid cache, each rank only reads the part of the cache
+   * for its own cells, instead of the first rank reading and sorting the whole
+   * grid. The cache file is written to `GridCacheDirectory`, if set, otherwise
+   * next to the grid file. Both default to the value of the
+   * `PV_CDI_GRID_CACHE_DIR` environment variable, i.e. caching is enabled when
+   * that variable is set and disabled otherwise.
+   */
+  void SetUseGridCache(bool val);
+  vtkGetMacro(UseGridCache, bool);
+  void SetGridCacheDirectory(const char* val);
+  const char* GetGridCacheDirectory() { return this->GridCacheDirectory.c_str(); }
+  ///@}
+
+  ///@{
+  /**
+   * Maximum size, in MiB, of the cache of data read from the files. The slabs
+   * of variables read for a (variable, time step, level) and the projected
+   * geometry of the grid for each projection are kept in the cache, and the
+   * least recently used ones are discarded when it is full, so that going
+   * back to a time step, a variable or a projection does not read the files
+   * again. The cache is shared by all the files of a series. Entries are keyed
+   * on the modification time and size of the files, so that data from a file
+   * that has been rewritten is read again. 0 disables it. Default is 256.
+   */
+  void SetCacheSize(int val);
+  vtkGetMacro(CacheSize, int);
+  ///@}
+
   vtkGetObjectMacro(Controller, vtkMultiProcessController);
   virtual void SetController(vtkMultiProcessController*);
 
@@ -223,6 +260,14 @@ protected:
   int ReplaceFillWithNan(const int varID, vtkDataArray* dataArray);
   int RegenerateGeometry();
   int ConstructGridGeometry();
+  std::string GetGeometryCacheKey();
+  bool ReadGeometryFromCache();
+  void AddGeometryToCache();
+  int ReadGridVertices(int start, int size, double* lon, double* lat);
+  std::string GetGridCacheFileName();
+  bool ReadGridCache(std::vector<double>& lon, std::vector<double>& lat);
+  bool WriteGridCache(const int* vertexIds, int numberOfVertices, const double* lon,
+    const double* lat, int numberOfPoints);
   void GuessGridFile();
   int LoadClonClatVars();
   int AddClonClatHalo();
@@ -300,6 +345,9 @@ protected:
   bool UseCustomMaskValue = false;
 
   bool SkipGrid = false;
+  bool UseGridCache = false;
+  std::string GridCacheDirectory = "";
+  int CacheSize = 256;
 
   vtkNew<vtkCallbackCommand> SelectionObserver;
   bool InfoRequested = false;
@@ -360,6 +408,7 @@ protected:
   int MaximumCells = 0;
   int MaximumPoints = 0;
   std::vector<int> VertexIds;
+  int VertexIdRange[2] = { 0, -1 }; // range of VertexIds, to read point data of local cells
 
   int NumberOfCellVars = 0;
   int NumberOfPointVars = 0;
@@ -387,6 +436,14 @@ private:
   int LoadCellVarDataTemplate(int variable, double dTime, vtkDataArray* dataArray);
   template <typename ValueType>
   int LoadPointVarDataTemplate(int variable, double dTime, vtkDataArray* dataArray);
+
+  /**
+   * Read `length` values of a variable from `start`, on `numberOfLevels`
+   * levels from `level`, through the cache.
+   */
+  template <typename ValueType>
+  void ReadVarSlab(cdi_tools::CDIVar* cdiVar, int timestep, int level, int start, int length,
+    int numberOfLevels, ValueType* buffer);
 };
 
 #endif
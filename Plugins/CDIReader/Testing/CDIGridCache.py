@@ -0,0 +1,78 @@
+from paraview.simple import *
+from paraview import servermanager as sm
+from paraview import smtesting
+import os
+import shutil
+
+# Checks that reading a grid from the grid cache (PV_CDI_GRID_CACHE_DIR) gives
+# the same points, cells and arrays as reading it from the file, which also
+# writes the cache.
+
+LoadDistributedPlugin("CDIReader", ns=globals())
+smtesting.ProcessCommandLineArguments()
+
+fileName = smtesting.DataDir + "/Plugins/CDIReader/Testing/Data/NetCDF/ts.nc"
+cacheDirectory = os.path.join(smtesting.TempDir, "CDIGridCache")
+shutil.rmtree(cacheDirectory, ignore_errors=True)
+os.makedirs(cacheDirectory)
+os.environ["PV_CDI_GRID_CACHE_DIR"] = cacheDirectory
+
+
+def read():
+    reader = CDIReader(FileNames=[fileName])
+    # no in-memory cache, to read the grid from the cache file.
+    reader.CacheSize = 0
+    reader.PointArrayStatus = reader.PointArrayStatus.Available
+    reader.CellArrayStatus = reader.CellArrayStatus.Available
+    output = sm.Fetch(reader)
+    Delete(reader)
+    return output
+
+
+def cacheFiles():
+    return [name for name in os.listdir(cacheDirectory) if name.endswith(".cdigrid")]
+
+
+def compareArrays(a, b, what):
+    if a is None or b is None:
+        raise smtesting.TestError("missing %s" % what)
+    if a.GetNumberOfTuples() != b.GetNumberOfTuples() or \
+            a.GetNumberOfComponents() != b.GetNumberOfComponents():
+        raise smtesting.TestError("%s sizes differ" % what)
+    for index in range(a.GetNumberOfValues()):
+        if a.GetValue(index) != b.GetValue(index):
+            raise smtesting.TestError("%s differ at value %d" % (what, index))
+
+
+def compareAttributes(a, b, what):
+    if a.GetNumberOfArrays() != b.GetNumberOfArrays():
+        raise smtesting.TestError("number of %s arrays differ" % what)
+    for index in range(a.GetNumberOfArrays()):
+        name = a.GetArrayName(index)
+        compareArrays(a.GetArray(name), b.GetArray(name), "%s array %s" % (what, name))
+
+
+if cacheFiles():
+    raise smtesting.TestError("the grid cache is not empty")
+miss = read()
+if not cacheFiles():
+    raise smtesting.TestError("reading the grid did not write the grid cache")
+hit = read()
+
+if miss.GetNumberOfPoints() == 0 or miss.GetNumberOfCells() == 0:
+    raise smtesting.TestError("empty output")
+if miss.GetNumberOfPoints() != hit.GetNumberOfPoints():
+    raise smtesting.TestError("number of points differ: %d (file), %d (cache)" %
+                              (miss.GetNumberOfPoints(), hit.GetNumberOfPoints()))
+if miss.GetNumberOfCells() != hit.GetNumberOfCells():
+    raise smtesting.TestError("number of cells differ: %d (file), %d (cache)" %
+                              (miss.GetNumberOfCells(), hit.GetNumberOfCells()))
+compareArrays(miss.GetPoints().GetData(), hit.GetPoints().GetData(), "points")
+compareArrays(miss.GetCells().GetConnectivityArray(), hit.GetCells().GetConnectivityArray(),
+              "cell connectivity")
+compareAttributes(miss.GetPointData(), hit.GetPointData(), "point")
+compareAttributes(miss.GetCellData(), hit.GetCellData(), "cell")
+if miss.GetPointData().GetNumberOfArrays() == 0 and miss.GetCellData().GetNumberOfArrays() == 0:
+    raise smtesting.TestError("no arrays were read")
+
+shutil.rmtree(cacheDirectory, ignore_errors=True)
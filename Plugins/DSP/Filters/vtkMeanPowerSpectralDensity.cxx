@@ -16,6 +16,7 @@
 #include "vtkMeanPowerSpectralDensity.h"
 
 #include "vtkAccousticUtilities.h"
+#include "vtkArrayDispatch.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkDataArrayRange.h"
 #include "vtkDoubleArray.h"
@@ -23,11 +24,82 @@
 #include "vtkInformationVector.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPThreadLocal.h"
 #include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTable.h"
 
+#include <cmath>
+#include <vector>
+
+namespace
+{
+//-----------------------------------------------------------------------------
+// Add the magnitude of the values of an FFT array to `sum`, ignoring the first
+// value (DC frequency).
+struct AddMagnitudeWorker
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* array, double* sum) const
+  {
+    const vtkIdType nbTuples = array->GetNumberOfTuples();
+    if (array->GetNumberOfComponents() == 2)
+    {
+      const auto fftTupleRange = vtk::DataArrayTupleRange<2>(array, 1, nbTuples);
+      for (const auto tuple : fftTupleRange)
+      {
+        const double re = static_cast<double>(tuple[0]);
+        const double im = static_cast<double>(tuple[1]);
+        *sum++ += std::sqrt(re * re + im * im);
+      }
+    }
+    else
+    {
+      const auto fftValueRange = vtk::DataArrayValueRange<1>(array, 1, nbTuples);
+      for (const auto fft : fftValueRange)
+      {
+        *sum++ += std::abs(static_cast<double>(fft));
+      }
+    }
+  }
+};
+
+//-----------------------------------------------------------------------------
+// Sum the magnitude of the FFT arrays of all blocks, each thread summing a range
+// of blocks into its own buffer.
+struct MagnitudeSumFunctor
+{
+  const std::vector<vtkDataArray*>& FFTArrays;
+  const vtkIdType NumberOfValues;
+  vtkSMPThreadLocal<std::vector<double>> Sums;
+
+  MagnitudeSumFunctor(const std::vector<vtkDataArray*>& fftArrays, vtkIdType numberOfValues)
+    : FFTArrays(fftArrays)
+    , NumberOfValues(numberOfValues)
+  {
+  }
+
+  void Initialize() { this->Sums.Local().assign(this->NumberOfValues, 0.0); }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double* sum = this->Sums.Local().data();
+    AddMagnitudeWorker worker;
+    for (vtkIdType blockId = begin; blockId < end; ++blockId)
+    {
+      vtkDataArray* fftArray = this->FFTArrays[blockId];
+      if (!vtkArrayDispatch::Dispatch::Execute(fftArray, worker, sum))
+      {
+        worker(fftArray, sum);
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+}
+
 //-----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkMeanPowerSpectralDensity);
 
@@ -77,20 +149,15 @@ int vtkMeanPowerSpectralDensity::RequestData(vtkInformation* vtkNotUsed(request)
   auto resValueRange = vtk::DataArrayValueRange(res);
   vtkSMPTools::Fill(resValueRange.begin(), resValueRange.end(), 0.0);
 
-  int N = 0;
-  bool isComplex = false;
-
-  if (fftArray->GetNumberOfComponents() == 2)
-  {
-    isComplex = true;
-  }
-  else if (fftArray->GetNumberOfComponents() != 1)
+  const int nbComponents = fftArray->GetNumberOfComponents();
+  if (nbComponents != 1 && nbComponents != 2)
   {
     vtkErrorMacro("The selected FFT array should only have 1 or 2 components.");
     return 0;
   }
 
-  // Compute sum of all FFTs over all microphones
+  // Gather the FFTs of all microphones
+  std::vector<vtkDataArray*> fftArrays;
   for (; !iter->IsDoneWithTraversal(); iter->GoToNextItem())
   {
     node = vtkTable::SafeDownCast(iter->GetCurrentDataObject());
@@ -103,29 +170,25 @@ int vtkMeanPowerSpectralDensity::RequestData(vtkInformation* vtkNotUsed(request)
       return 0;
     }
 
-    assert((fftArray->GetNumberOfTuples() - 1) == resValueRange.size() &&
-      "fftArray size is not coherent");
-
-    if (isComplex)
+    if ((fftArray->GetNumberOfTuples() - 1) != resValueRange.size() ||
+      fftArray->GetNumberOfComponents() != nbComponents)
     {
-      auto fftTupleRange = vtk::DataArrayTupleRange<2>(fftArray).GetSubRange(1);
-      using TupleType = decltype(fftTupleRange)::ConstTupleReferenceType;
-      vtkSMPTools::Transform(fftTupleRange.cbegin(), fftTupleRange.cend(), resValueRange.cbegin(),
-        resValueRange.begin(), [](TupleType tuple, double value) {
-          const double magnitude = std::hypot(*tuple.begin(), *(tuple.begin() + 1));
-          return value + magnitude;
-        });
-    }
-    else
-    {
-      auto fftValueRange = vtk::DataArrayValueRange(fftArray).GetSubRange(1);
-      using FFTType = decltype(fftValueRange)::ValueType;
-      vtkSMPTools::Transform(fftValueRange.cbegin(), fftValueRange.cend(), resValueRange.cbegin(),
-        resValueRange.begin(),
-        [](FFTType fft, double value) { return value + static_cast<double>(std::abs(fft)); });
+      vtkErrorMacro("FFT array " << this->FFTArrayName << " in block "
+                                 << iter->GetCurrentFlatIndex()
+                                 << " does not have the same size as in the first block.");
+      return 0;
     }
+    fftArrays.push_back(fftArray);
+  }
+  const int N = static_cast<int>(fftArrays.size());
 
-    ++N;
+  // Compute sum of all FFTs over all microphones, in parallel over microphones
+  MagnitudeSumFunctor functor(fftArrays, res->GetNumberOfValues());
+  vtkSMPTools::For(0, static_cast<vtkIdType>(fftArrays.size()), functor);
+  for (const std::vector<double>& sum : functor.Sums)
+  {
+    vtkSMPTools::Transform(resValueRange.cbegin(), resValueRange.cend(), sum.cbegin(),
+      resValueRange.begin(), [](double value, double partialSum) { return value + partialSum; });
   }
 
   // Compute mean PSD
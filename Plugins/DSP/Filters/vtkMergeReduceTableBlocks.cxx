@@ -32,12 +32,41 @@
 
 #include <algorithm>
 #include <string>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// Running reductions of the selected columns, updated block after block.
+struct vtkMergeReduceTableBlocks::vtkInternals
+{
+  struct Column
+  {
+    std::string Name;
+    vtkSmartPointer<vtkDataArray> Copy;
+    vtkSmartPointer<vtkDataArray> Sum;
+    vtkSmartPointer<vtkDataArray> Min;
+    vtkSmartPointer<vtkDataArray> Max;
+  };
+
+  std::vector<Column> Columns;
+  vtkIdType NumberOfRows = 0;
+  vtkIdType NumberOfReducedBlocks = 0;
+  bool Initialized = false;
+
+  void Reset()
+  {
+    this->Columns.clear();
+    this->NumberOfRows = 0;
+    this->NumberOfReducedBlocks = 0;
+    this->Initialized = false;
+  }
+};
 
 //-----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkMergeReduceTableBlocks);
 
 // ----------------------------------------------------------------------------
 vtkMergeReduceTableBlocks::vtkMergeReduceTableBlocks()
+  : Internals(new vtkInternals())
 {
   // Add operation types
   for (auto type : { "Mean", "Sum", "Min", "Max" })
@@ -54,49 +83,153 @@ vtkMergeReduceTableBlocks::vtkMergeReduceTableBlocks()
     vtkCommand::ModifiedEvent, this, &vtkMergeReduceTableBlocks::Modified);
 }
 
+// ----------------------------------------------------------------------------
+vtkMergeReduceTableBlocks::~vtkMergeReduceTableBlocks() = default;
+
 //------------------------------------------------------------------------------
 int vtkMergeReduceTableBlocks::FillInputPortInformation(int vtkNotUsed(port), vtkInformation* info)
 {
-  info->Set(vtkDataObject::DATA_TYPE_NAME(), "vtkMultiBlockDataSet");
+  info->Remove(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE());
+  info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkMultiBlockDataSet");
+  info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkTable");
   return 1;
 }
 
 //------------------------------------------------------------------------------
-int vtkMergeReduceTableBlocks::RequestData(vtkInformation* vtkNotUsed(request),
+int vtkMergeReduceTableBlocks::RequestInformation(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
 {
-  vtkMultiBlockDataSet* input = vtkMultiBlockDataSet::GetData(inputVector[0]);
-  if (!input)
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  this->NumberOfTimeSteps = this->StreamTimeSteps
+    ? inInfo->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS())
+    : 0;
+
+  if (this->StreamTimeSteps)
   {
-    vtkErrorMacro("No valid multiblock input!");
-    return 0;
+    // The output is reduced over all time steps.
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    outInfo->Remove(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+    outInfo->Remove(vtkStreamingDemandDrivenPipeline::TIME_RANGE());
+  }
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkMergeReduceTableBlocks::RequestUpdateExtent(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* vtkNotUsed(outputVector))
+{
+  // When streaming, RequestData asks the executive to iterate over the time
+  // steps of the input, in order, one per execution.
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  double* inTimes = inInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+  if (this->StreamTimeSteps && inTimes && this->CurrentTimeIndex < this->NumberOfTimeSteps)
+  {
+    inInfo->Set(
+      vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP(), inTimes[this->CurrentTimeIndex]);
   }
-  if (input->GetNumberOfBlocks() == 0)
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkMergeReduceTableBlocks::RequestData(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkDataObject* input = vtkDataObject::GetData(inputVector[0]);
+  vtkTable* output = vtkTable::GetData(outputVector);
+
+  if (!this->StreamTimeSteps)
   {
+    this->Internals->Reset();
+    if (!this->ReduceBlocks(input))
+    {
+      this->Internals->Reset();
+      return 0;
+    }
+    this->FinalizeReduction(output);
+    this->Internals->Reset();
     return 1;
   }
 
-  vtkTable* firstTable = vtkTable::SafeDownCast(input->GetBlock(0));
-  if (!firstTable)
+  if (this->CurrentTimeIndex == 0)
+  {
+    // First time step, start new reductions.
+    this->Internals->Reset();
+  }
+
+  if (!this->ReduceBlocks(input))
   {
-    vtkErrorMacro("Expected a vtkTable at block index 0, aborting");
+    request->Remove(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING());
+    this->CurrentTimeIndex = 0;
+    this->Internals->Reset();
     return 0;
   }
 
-  vtkTable* output = vtkTable::GetData(outputVector);
-  vtkIdType nbRows = firstTable->GetNumberOfRows();
+  this->CurrentTimeIndex++;
+  if (this->CurrentTimeIndex < this->NumberOfTimeSteps)
+  {
+    // There are more time steps to reduce.
+    request->Set(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING(), 1);
+    return 1;
+  }
+
+  // We are done, build the output.
+  request->Remove(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING());
+  this->CurrentTimeIndex = 0;
+  this->FinalizeReduction(output);
+  this->Internals->Reset();
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+bool vtkMergeReduceTableBlocks::ReduceBlocks(vtkDataObject* input)
+{
+  if (vtkTable* table = vtkTable::SafeDownCast(input))
+  {
+    return this->ReduceTable(table);
+  }
+
+  vtkMultiBlockDataSet* multiBlock = vtkMultiBlockDataSet::SafeDownCast(input);
+  if (!multiBlock)
+  {
+    vtkErrorMacro("Expected a vtkMultiBlockDataSet or a vtkTable as input, aborting");
+    return false;
+  }
+
+  auto iter = vtk::TakeSmartPointer(multiBlock->NewIterator());
+  iter->SkipEmptyNodesOn();
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    vtkTable* table = vtkTable::SafeDownCast(iter->GetCurrentDataObject());
+    if (!table)
+    {
+      vtkErrorMacro(
+        "Expected a vtkTable at block index " << iter->GetCurrentFlatIndex() << ", aborting");
+      return false;
+    }
+    if (!this->ReduceTable(table))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkMergeReduceTableBlocks::InitializeReduction(vtkTable* firstTable)
+{
   const bool wantMean = this->OperationSelection->ArrayIsEnabled("Mean");
   const bool wantMin = this->OperationSelection->ArrayIsEnabled("Min");
   const bool wantMax = this->OperationSelection->ArrayIsEnabled("Max");
   const bool wantSum = this->OperationSelection->ArrayIsEnabled("Sum");
+  const vtkIdType nbRows = firstTable->GetNumberOfRows();
 
-  // Loop over columns, blocks, rows, and operations
+  this->Internals->NumberOfRows = nbRows;
   for (vtkIdType arrIdx = 0; arrIdx < firstTable->GetNumberOfColumns(); arrIdx++)
   {
     std::string colName = firstTable->GetColumnName(arrIdx);
-
-    if (!this->ColumnToReduceSelection->ArrayIsEnabled(colName.c_str()) &&
-      !this->ColumnToCopySelection->ArrayIsEnabled(colName.c_str()))
+    const bool reduce = this->ColumnToReduceSelection->ArrayIsEnabled(colName.c_str());
+    const bool copy = this->ColumnToCopySelection->ArrayIsEnabled(colName.c_str());
+    if (!reduce && !copy)
     {
       continue;
     }
@@ -105,135 +238,174 @@ int vtkMergeReduceTableBlocks::RequestData(vtkInformation* vtkNotUsed(request),
     if (!array)
     {
       vtkErrorMacro("Could not find array named " << colName << ".");
-      return 0;
+      return false;
     }
 
-    // Shallow copy array to output if needed
-    if (this->ColumnToCopySelection->ArrayIsEnabled(colName.c_str()))
+    vtkInternals::Column column;
+    column.Name = colName;
+
+    // Copy array to output if needed. When streaming, the input of the next
+    // time step may reuse the memory of this one.
+    if (copy)
     {
-      vtkSmartPointer<vtkDataArray> outArray;
-      outArray.TakeReference(array->NewInstance());
-      outArray->ShallowCopy(array);
-      output->AddColumn(outArray);
+      column.Copy.TakeReference(array->NewInstance());
+      if (this->StreamTimeSteps)
+      {
+        column.Copy->DeepCopy(array);
+      }
+      else
+      {
+        column.Copy->ShallowCopy(array);
+      }
     }
 
-    if (this->ColumnToReduceSelection->ArrayIsEnabled(colName.c_str()))
+    if (reduce)
     {
       // Prepare arrays based on input array type
-      auto sum = vtk::TakeSmartPointer(array->NewInstance());
-      auto min = vtk::TakeSmartPointer(array->NewInstance());
-      auto max = vtk::TakeSmartPointer(array->NewInstance());
-      vtkIdType nbComp = array->GetNumberOfComponents();
-
+      const int nbComp = array->GetNumberOfComponents();
       if (wantSum || wantMean)
       {
-        sum->SetNumberOfComponents(nbComp);
-        sum->SetNumberOfTuples(nbRows);
-        sum->SetName((colName + "_Sum").c_str());
-        auto sumRange = vtk::DataArrayValueRange(sum);
+        column.Sum.TakeReference(array->NewInstance());
+        column.Sum->SetNumberOfComponents(nbComp);
+        column.Sum->SetNumberOfTuples(nbRows);
+        column.Sum->SetName((colName + "_Sum").c_str());
+        auto sumRange = vtk::DataArrayValueRange(column.Sum);
         vtkSMPTools::Fill(sumRange.begin(), sumRange.end(), 0.0);
       }
 
       if (wantMin)
       {
-        min->SetNumberOfComponents(nbComp);
-        min->SetNumberOfTuples(nbRows);
-        min->SetName((colName + "_Min").c_str());
-        auto minRange = vtk::DataArrayValueRange(min);
+        column.Min.TakeReference(array->NewInstance());
+        column.Min->SetNumberOfComponents(nbComp);
+        column.Min->SetNumberOfTuples(nbRows);
+        column.Min->SetName((colName + "_Min").c_str());
+        auto minRange = vtk::DataArrayValueRange(column.Min);
         vtkSMPTools::Fill(minRange.begin(), minRange.end(), VTK_DOUBLE_MAX);
       }
 
       if (wantMax)
       {
-        max->SetNumberOfComponents(nbComp);
-        max->SetNumberOfTuples(nbRows);
-        max->SetName((colName + "_Max").c_str());
-        auto maxRange = vtk::DataArrayValueRange(max);
+        column.Max.TakeReference(array->NewInstance());
+        column.Max->SetNumberOfComponents(nbComp);
+        column.Max->SetNumberOfTuples(nbRows);
+        column.Max->SetName((colName + "_Max").c_str());
+        auto maxRange = vtk::DataArrayValueRange(column.Max);
         vtkSMPTools::Fill(maxRange.begin(), maxRange.end(), VTK_DOUBLE_MIN);
       }
+    }
 
-      auto iter = vtk::TakeSmartPointer(input->NewIterator());
-      iter->SkipEmptyNodesOn();
+    this->Internals->Columns.push_back(std::move(column));
+  }
 
-      for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
-      {
-        vtkTable* table = vtkTable::SafeDownCast(iter->GetCurrentDataObject());
-        if (!table)
-        {
-          vtkErrorMacro(
-            "Expected a vtkTable at block index " << iter->GetCurrentFlatIndex() << ", aborting");
-          return 0;
-        }
-
-        array = vtkDataArray::SafeDownCast(table->GetColumnByName(colName.c_str()));
-        if (!array)
-        {
-          vtkErrorMacro("Could not find array named " << colName << ".");
-          return 0;
-        }
-
-        auto arrayRange = vtk::DataArrayValueRange(array);
-        auto sumRange = vtk::DataArrayValueRange(sum);
-        auto minRange = vtk::DataArrayValueRange(min);
-        auto maxRange = vtk::DataArrayValueRange(max);
-
-        // Type of output arrays elements should be the same as array due to the use of NewInstance
-        using ArrayType = decltype(arrayRange)::value_type;
-
-        if (wantSum || wantMean)
-        {
-          vtkSMPTools::Transform(arrayRange.cbegin(), arrayRange.cend(), sumRange.cbegin(),
-            sumRange.begin(), [](ArrayType x, ArrayType y) { return x + y; });
-        }
-
-        if (wantMin)
-        {
-          vtkSMPTools::Transform(arrayRange.cbegin(), arrayRange.cend(), minRange.cbegin(),
-            minRange.begin(), [](ArrayType x, ArrayType y) { return std::min(x, y); });
-        }
-
-        if (wantMax)
-        {
-          vtkSMPTools::Transform(arrayRange.cbegin(), arrayRange.cend(), maxRange.cbegin(),
-            maxRange.begin(), [](ArrayType x, ArrayType y) { return std::max(x, y); });
-        }
-      }
+  this->Internals->Initialized = true;
+  return true;
+}
 
-      // Assign columns for the current array being reduced
-      if (wantSum)
-      {
-        output->AddColumn(sum);
-      }
+//------------------------------------------------------------------------------
+bool vtkMergeReduceTableBlocks::ReduceTable(vtkTable* table)
+{
+  if (!this->Internals->Initialized && !this->InitializeReduction(table))
+  {
+    return false;
+  }
 
-      if (wantMin)
-      {
-        output->AddColumn(min);
-      }
+  for (const vtkInternals::Column& column : this->Internals->Columns)
+  {
+    if (!column.Sum && !column.Min && !column.Max)
+    {
+      continue;
+    }
 
-      if (wantMax)
-      {
-        output->AddColumn(max);
-      }
+    vtkDataArray* array = vtkDataArray::SafeDownCast(table->GetColumnByName(column.Name.c_str()));
+    if (!array)
+    {
+      vtkErrorMacro("Could not find array named " << column.Name << ".");
+      return false;
+    }
+    vtkDataArray* reference = column.Sum ? column.Sum : (column.Min ? column.Min : column.Max);
+    if (array->GetNumberOfValues() != reference->GetNumberOfValues())
+    {
+      vtkErrorMacro("Array named " << column.Name << " does not have the same size in all blocks.");
+      return false;
+    }
 
-      if (wantMean)
-      {
-        vtkNew<vtkDoubleArray> mean;
-        mean->SetNumberOfComponents(nbComp);
-        mean->SetNumberOfTuples(nbRows);
-        mean->SetName((colName + "_Mean").c_str());
-        auto meanRange = vtk::DataArrayValueRange(mean);
-        auto sumRange = vtk::DataArrayValueRange(sum);
-
-        using ArrayType = decltype(sumRange)::value_type;
-        vtkSMPTools::Transform(sumRange.cbegin(), sumRange.cend(), meanRange.begin(),
-          [input](ArrayType x) { return x / static_cast<double>(input->GetNumberOfBlocks()); });
-
-        output->AddColumn(mean);
-      }
+    auto arrayRange = vtk::DataArrayValueRange(array);
+
+    // Type of output arrays elements should be the same as array due to the use of NewInstance
+    using ArrayType = decltype(arrayRange)::value_type;
+
+    if (column.Sum)
+    {
+      auto sumRange = vtk::DataArrayValueRange(column.Sum);
+      vtkSMPTools::Transform(arrayRange.cbegin(), arrayRange.cend(), sumRange.cbegin(),
+        sumRange.begin(), [](ArrayType x, ArrayType y) { return x + y; });
+    }
+
+    if (column.Min)
+    {
+      auto minRange = vtk::DataArrayValueRange(column.Min);
+      vtkSMPTools::Transform(arrayRange.cbegin(), arrayRange.cend(), minRange.cbegin(),
+        minRange.begin(), [](ArrayType x, ArrayType y) { return std::min(x, y); });
+    }
+
+    if (column.Max)
+    {
+      auto maxRange = vtk::DataArrayValueRange(column.Max);
+      vtkSMPTools::Transform(arrayRange.cbegin(), arrayRange.cend(), maxRange.cbegin(),
+        maxRange.begin(), [](ArrayType x, ArrayType y) { return std::max(x, y); });
     }
   }
 
-  return 1;
+  this->Internals->NumberOfReducedBlocks++;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkMergeReduceTableBlocks::FinalizeReduction(vtkTable* output)
+{
+  const bool wantMean = this->OperationSelection->ArrayIsEnabled("Mean");
+  const bool wantSum = this->OperationSelection->ArrayIsEnabled("Sum");
+  const double nbBlocks = static_cast<double>(this->Internals->NumberOfReducedBlocks);
+
+  for (const vtkInternals::Column& column : this->Internals->Columns)
+  {
+    if (column.Copy)
+    {
+      output->AddColumn(column.Copy);
+    }
+
+    // Assign columns for the current array being reduced
+    if (column.Sum && wantSum)
+    {
+      output->AddColumn(column.Sum);
+    }
+
+    if (column.Min)
+    {
+      output->AddColumn(column.Min);
+    }
+
+    if (column.Max)
+    {
+      output->AddColumn(column.Max);
+    }
+
+    if (column.Sum && wantMean)
+    {
+      vtkNew<vtkDoubleArray> mean;
+      mean->SetNumberOfComponents(column.Sum->GetNumberOfComponents());
+      mean->SetNumberOfTuples(this->Internals->NumberOfRows);
+      mean->SetName((column.Name + "_Mean").c_str());
+      auto meanRange = vtk::DataArrayValueRange(mean);
+      auto sumRange = vtk::DataArrayValueRange(column.Sum);
+
+      using ArrayType = decltype(sumRange)::value_type;
+      vtkSMPTools::Transform(sumRange.cbegin(), sumRange.cend(), meanRange.begin(),
+        [nbBlocks](ArrayType x) { return x / nbBlocks; });
+
+      output->AddColumn(mean);
+    }
+  }
 }
 
 //--------------------------------------- --------------------------------------
@@ -246,4 +418,5 @@ void vtkMergeReduceTableBlocks::PrintSelf(std::ostream& os, vtkIndent indent)
   this->ColumnToCopySelection->PrintSelf(os, indent.GetNextIndent());
   os << indent << "OperationSelection:\n";
   this->OperationSelection->PrintSelf(os, indent.GetNextIndent());
+  os << indent << "StreamTimeSteps: " << this->StreamTimeSteps << std::endl;
 }
@@ -19,6 +19,12 @@
  * This filter performs reduction operations such as the mean or the sum over
  * columns across all blocks of a multiblock of vtkTables.
  * Input arrays can also be copied to the output.
+ *
+ * When StreamTimeSteps is enabled, the reductions are also performed across
+ * all the time steps of the input: the filter requests the time steps one
+ * after the other and updates running reductions with each of them, so that
+ * only a single time step of the input is in memory at once. The input can
+ * then also be a single vtkTable.
  */
 
 #ifndef vtkMergeReduceTableBlocks_h
@@ -28,7 +34,10 @@
 #include "vtkNew.h" // for vtkNew
 #include "vtkTableAlgorithm.h"
 
+#include <memory> // for std::unique_ptr
+
 class vtkDataArraySelection;
+class vtkTable;
 
 class VTKDSPFILTERSPLUGIN_EXPORT vtkMergeReduceTableBlocks : public vtkTableAlgorithm
 {
@@ -54,13 +63,53 @@ public:
    */
   vtkGetNewMacro(OperationSelection, vtkDataArraySelection);
 
+  ///@{
+  /**
+   * If true, reduce over all the time steps of the input instead of the
+   * current one only, by executing once per time step. The output does not
+   * depend on time. Copied columns are taken from the first time step.
+   * Default is false.
+   */
+  vtkSetMacro(StreamTimeSteps, bool);
+  vtkGetMacro(StreamTimeSteps, bool);
+  vtkBooleanMacro(StreamTimeSteps, bool);
+  ///@}
+
 protected:
   vtkMergeReduceTableBlocks();
-  ~vtkMergeReduceTableBlocks() override = default;
+  ~vtkMergeReduceTableBlocks() override;
 
   int FillInputPortInformation(int, vtkInformation*) override;
+  int RequestInformation(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+  int RequestUpdateExtent(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
+  /**
+   * Update the running reductions with every table of input, which is either
+   * a vtkTable or a vtkMultiBlockDataSet of vtkTables.
+   */
+  bool ReduceBlocks(vtkDataObject* input);
+
+  /**
+   * Update the running reductions with a single table, initializing them
+   * from it if it is the first one.
+   */
+  bool ReduceTable(vtkTable* table);
+
+  /**
+   * Set up the copied columns and the reduction arrays from the first table.
+   */
+  bool InitializeReduction(vtkTable* firstTable);
+
+  /**
+   * Add the copied and reduced columns to the output.
+   */
+  void FinalizeReduction(vtkTable* output);
+
+  bool StreamTimeSteps = false;
+  int NumberOfTimeSteps = 0;
+  int CurrentTimeIndex = 0;
+
 private:
   vtkMergeReduceTableBlocks(const vtkMergeReduceTableBlocks&) = delete;
   void operator=(const vtkMergeReduceTableBlocks&) = delete;
@@ -68,6 +117,9 @@ private:
   vtkNew<vtkDataArraySelection> ColumnToReduceSelection;
   vtkNew<vtkDataArraySelection> ColumnToCopySelection;
   vtkNew<vtkDataArraySelection> OperationSelection;
+
+  struct vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
 };
 
 #endif // vtkMergeReduceTableBlocks_h
@@ -15,6 +15,7 @@
 
 #include "vtkProjectSpectrumMagnitude.h"
 
+#include "vtkArrayDispatch.h"
 #include "vtkCommand.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkDataArray.h"
@@ -26,14 +27,42 @@
 #include "vtkMultiBlockDataSet.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTable.h"
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <vector>
 #include <vtkDataArrayRange.h>
 
+namespace
+{
+//-----------------------------------------------------------------------------
+// Compute the mean of the tuples of an array in [begin, end), scaled by
+// `factor`, into `mean`.
+struct MeanInRangeWorker
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* array, vtkIdType begin, vtkIdType end, double factor,
+    std::vector<double>& mean) const
+  {
+    std::fill(mean.begin(), mean.end(), 0.0);
+    const auto inRange = vtk::DataArrayTupleRange(array, begin, end);
+    for (const auto inTuple : inRange)
+    {
+      auto outComponent = mean.begin();
+      for (const auto inComponent : inTuple)
+      {
+        *outComponent++ += inComponent * factor;
+      }
+    }
+  }
+};
+}
+
 //-----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkProjectSpectrumMagnitude);
 
@@ -196,19 +225,20 @@ int vtkProjectSpectrumMagnitude::RequestData(vtkInformation* vtkNotUsed(request)
       vtkWarningMacro("Could not find array named " << colName << ".");
       continue;
     }
+    const int nbComponents = modelArray->GetNumberOfComponents();
     auto outArray = vtk::TakeSmartPointer(modelArray->NewInstance());
-    outArray->SetNumberOfComponents(modelArray->GetNumberOfComponents());
+    outArray->SetNumberOfComponents(nbComponents);
     outArray->SetNumberOfTuples(nbBlocks);
     outArray->SetName((colName).c_str());
     outArray->Fill(0.0);
-    auto outRange = vtk::DataArrayTupleRange(outArray);
-    auto outIterator = outRange.begin();
     const double componentFactor = 1.0 / firstTable->GetNumberOfRows();
 
-    // Fill output array
+    // Gather the arrays of all blocks
+    std::vector<vtkDataArray*> inArrays;
+    inArrays.reserve(nbBlocks);
     auto iter = vtk::TakeSmartPointer(tables->NewIterator());
     iter->SkipEmptyNodesOn();
-    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem(), outIterator++)
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
     {
       vtkTable* table = vtkTable::SafeDownCast(iter->GetCurrentDataObject());
       if (table == nullptr)
@@ -222,17 +252,39 @@ int vtkProjectSpectrumMagnitude::RequestData(vtkInformation* vtkNotUsed(request)
         vtkErrorMacro("Could not find array named " << colName << ".");
         return 0;
       }
+      if (inArray->GetNumberOfComponents() != nbComponents ||
+        inArray->GetNumberOfTuples() < freqRange[1])
+      {
+        vtkErrorMacro("Array named " << colName << " does not have the same layout in all blocks.");
+        return 0;
+      }
+      inArrays.push_back(inArray);
+    }
 
-      // Mean all values inside frequency range
-      const auto inRange = vtk::DataArrayTupleRange(inArray, freqRange[0], freqRange[1]);
-      for (const auto inTuple : inRange)
+    // Mean all values inside frequency range, in parallel over blocks
+    const vtkIdType nbInArrays = std::min(static_cast<vtkIdType>(inArrays.size()), nbBlocks);
+    std::vector<double> means(nbInArrays * nbComponents);
+    vtkSMPThreadLocal<std::vector<double>> tlMean;
+    vtkSMPTools::For(0, nbInArrays, [&](vtkIdType begin, vtkIdType end) {
+      std::vector<double>& mean = tlMean.Local();
+      mean.resize(nbComponents);
+      MeanInRangeWorker worker;
+      for (vtkIdType blockId = begin; blockId < end; ++blockId)
       {
-        auto outComponent = outIterator->begin();
-        for (const auto inComponent : inTuple)
+        vtkDataArray* inArray = inArrays[blockId];
+        if (!vtkArrayDispatch::Dispatch::Execute(
+              inArray, worker, freqRange[0], freqRange[1], componentFactor, mean))
         {
-          *outComponent += inComponent * componentFactor;
-          outComponent++;
+          worker(inArray, freqRange[0], freqRange[1], componentFactor, mean);
         }
+        std::copy(mean.begin(), mean.end(), means.begin() + blockId * nbComponents);
+      }
+    });
+    for (vtkIdType blockId = 0; blockId < nbInArrays; ++blockId)
+    {
+      for (int comp = 0; comp < nbComponents; ++comp)
+      {
+        outArray->SetComponent(blockId, comp, means[blockId * nbComponents + comp]);
       }
     }
 
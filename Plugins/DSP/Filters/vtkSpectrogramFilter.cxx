@@ -78,25 +78,7 @@ int vtkSpectrogramFilter::RequestData(vtkInformation* vtkNotUsed(request),
     inputArray = vtkDataArray::SafeDownCast(input->GetColumn(0));
   }
 
-  std::vector<vtkFFT::ScalarNumber> window(this->TimeResolution);
-  switch (this->WindowType)
-  {
-    case vtkTableFFT::HANNING:
-      vtkFFT::GenerateKernel1D(window.data(), window.size(), vtkFFT::HanningGenerator);
-      break;
-    case vtkTableFFT::BARTLETT:
-      vtkFFT::GenerateKernel1D(window.data(), window.size(), vtkFFT::BartlettGenerator);
-      break;
-    case vtkTableFFT::SINE:
-      vtkFFT::GenerateKernel1D(window.data(), window.size(), vtkFFT::SineGenerator);
-      break;
-    case vtkTableFFT::BLACKMAN:
-      vtkFFT::GenerateKernel1D(window.data(), window.size(), vtkFFT::BlackmanGenerator);
-      break;
-    case vtkTableFFT::RECTANGULAR:
-    default:
-      vtkFFT::GenerateKernel1D(window.data(), window.size(), vtkFFT::RectangularGenerator);
-  }
+  const std::vector<vtkFFT::ScalarNumber>& window = this->GetWindow();
   vtkSmartPointer<vtkFFT::vtkScalarNumberArray> signal =
     vtkFFT::vtkScalarNumberArray::SafeDownCast(inputArray);
   if (!signal)
@@ -138,6 +120,41 @@ int vtkSpectrogramFilter::RequestData(vtkInformation* vtkNotUsed(request),
   return 1;
 }
 
+//-----------------------------------------------------------------------------
+const std::vector<vtkFFT::ScalarNumber>& vtkSpectrogramFilter::GetWindow()
+{
+  if (this->WindowKernelType == this->WindowType &&
+    this->Window.size() == static_cast<size_t>(this->TimeResolution))
+  {
+    return this->Window;
+  }
+
+  this->Window.resize(this->TimeResolution);
+  switch (this->WindowType)
+  {
+    case vtkTableFFT::HANNING:
+      vtkFFT::GenerateKernel1D(this->Window.data(), this->Window.size(), vtkFFT::HanningGenerator);
+      break;
+    case vtkTableFFT::BARTLETT:
+      vtkFFT::GenerateKernel1D(
+        this->Window.data(), this->Window.size(), vtkFFT::BartlettGenerator);
+      break;
+    case vtkTableFFT::SINE:
+      vtkFFT::GenerateKernel1D(this->Window.data(), this->Window.size(), vtkFFT::SineGenerator);
+      break;
+    case vtkTableFFT::BLACKMAN:
+      vtkFFT::GenerateKernel1D(
+        this->Window.data(), this->Window.size(), vtkFFT::BlackmanGenerator);
+      break;
+    case vtkTableFFT::RECTANGULAR:
+    default:
+      vtkFFT::GenerateKernel1D(
+        this->Window.data(), this->Window.size(), vtkFFT::RectangularGenerator);
+  }
+  this->WindowKernelType = this->WindowType;
+  return this->Window;
+}
+
 //-----------------------------------------------------------------------------
 double vtkSpectrogramFilter::ComputeSampleRate(vtkTable* input)
 {
@@ -30,9 +30,12 @@
 #define vtkSpectrogramFilter_h
 
 #include "vtkDSPFiltersPluginModule.h" // For export
+#include "vtkFFT.h"                     // For vtkFFT::ScalarNumber
 #include "vtkImageAlgorithm.h"
 #include "vtkTableFFT.h" // For enum
 
+#include <vector> // For std::vector
+
 class VTKDSPFILTERSPLUGIN_EXPORT vtkSpectrogramFilter : public vtkImageAlgorithm
 {
 public:
@@ -88,6 +91,12 @@ protected:
 
   double ComputeSampleRate(vtkTable* input);
 
+  /**
+   * Returns the window kernel for the current window type and time resolution.
+   * The kernel is only generated again when one of them changes.
+   */
+  const std::vector<vtkFFT::ScalarNumber>& GetWindow();
+
 private:
   vtkSpectrogramFilter(const vtkSpectrogramFilter&) = delete;
   void operator=(const vtkSpectrogramFilter&) = delete;
@@ -96,6 +105,9 @@ private:
   int TimeResolution = 100;
   int OverlapPercentage = 50;
   double DefaultSampleRate = 1e4;
+
+  std::vector<vtkFFT::ScalarNumber> Window;
+  int WindowKernelType = -1;
 };
 
 #endif // vtkSpectrogramFilter_h
@@ -0,0 +1,118 @@
+from paraview.simple import *
+from paraview import servermanager as sm
+
+# Checks that Merge Reduce Table Blocks with Stream Time Steps reduces the
+# table blocks of all the time steps of a temporal multiblock source, and that
+# the result matches a reduction, at once, of the same tables.
+
+LoadDistributedPlugin("DigitalSignalProcessing", ns=globals())
+
+timeSteps = [0.0, 0.5, 1.0, 1.5, 2.0]
+numberOfBlocks = 3
+numberOfRows = 10
+
+# builds the table blocks of a time step in `output`, starting at block `first`.
+buildTables = """
+from vtkmodules.vtkCommonCore import vtkDoubleArray
+from vtkmodules.vtkCommonDataModel import vtkTable
+
+def buildTables(output, time, first):
+    for block in range(%d):
+        table = vtkTable()
+        timeColumn = vtkDoubleArray()
+        timeColumn.SetName("Time")
+        pressure = vtkDoubleArray()
+        pressure.SetName("pressure")
+        for row in range(%d):
+            timeColumn.InsertNextValue(row)
+            pressure.InsertNextValue((block + 1) * row + 10 * time * time - block)
+        table.AddColumn(timeColumn)
+        table.AddColumn(pressure)
+        output.SetBlock(first + block, table)
+""" % (numberOfBlocks, numberOfRows)
+
+
+def pressure(time, block, row):
+    return (block + 1) * row + 10 * time * time - block
+
+
+# temporal source, giving the blocks of a single time step per update.
+temporal = ProgrammableSource()
+temporal.OutputDataSetType = "vtkMultiBlockDataSet"
+temporal.ScriptRequestInformation = """executive = self.GetExecutive()
+outInfo = executive.GetOutputInformation(0)
+outInfo.Remove(executive.TIME_STEPS())
+for time in %r:
+    outInfo.Append(executive.TIME_STEPS(), time)
+outInfo.Remove(executive.TIME_RANGE())
+outInfo.Append(executive.TIME_RANGE(), %r)
+outInfo.Append(executive.TIME_RANGE(), %r)""" % (timeSteps, timeSteps[0], timeSteps[-1])
+temporal.Script = buildTables + """
+executive = self.GetExecutive()
+outInfo = executive.GetOutputInformation(0)
+time = outInfo.Get(executive.UPDATE_TIME_STEP()) \
+    if outInfo.Has(executive.UPDATE_TIME_STEP()) else %r
+buildTables(self.GetOutputDataObject(0), time, 0)""" % timeSteps[0]
+
+# the same tables, for all time steps at once.
+merged = ProgrammableSource()
+merged.OutputDataSetType = "vtkMultiBlockDataSet"
+merged.Script = buildTables + """
+for index, time in enumerate(%r):
+    buildTables(self.GetOutputDataObject(0), time, index * %d)""" % (timeSteps, numberOfBlocks)
+
+operations = ["Mean", "Sum", "Min", "Max"]
+
+
+def reduceTables(source, stream):
+    reduction = MergeReduceTableBlocks(Input=source)
+    reduction.ColumnArraysToReduce = ["pressure"]
+    reduction.ColumnArraysToCopy = ["Time"]
+    reduction.OperationTypes = operations
+    reduction.StreamTimeSteps = stream
+    output = sm.Fetch(reduction)
+    Delete(reduction)
+    return output
+
+
+assert temporal.TimestepValues is not None and len(temporal.TimestepValues) == len(timeSteps), \
+    "the temporal source does not report its time steps"
+
+streamed = reduceTables(temporal, 1)
+atOnce = reduceTables(merged, 0)
+single = reduceTables(temporal, 0)
+
+expected = {"pressure_Sum": [], "pressure_Min": [], "pressure_Max": [], "pressure_Mean": []}
+for row in range(numberOfRows):
+    values = [pressure(time, block, row) for time in timeSteps for block in range(numberOfBlocks)]
+    expected["pressure_Sum"].append(sum(values))
+    expected["pressure_Min"].append(min(values))
+    expected["pressure_Max"].append(max(values))
+    expected["pressure_Mean"].append(sum(values) / len(values))
+
+
+def check(output, mode):
+    assert output.GetNumberOfRows() == numberOfRows, "wrong number of rows (%s)" % mode
+    time = output.GetColumnByName("Time")
+    assert time is not None, "missing copied Time column (%s)" % mode
+    for row in range(numberOfRows):
+        assert time.GetValue(row) == row, "wrong copied Time at row %d (%s)" % (row, mode)
+    for name, values in expected.items():
+        column = output.GetColumnByName(name)
+        assert column is not None, "missing column %s (%s)" % (name, mode)
+        for row in range(numberOfRows):
+            assert abs(column.GetValue(row) - values[row]) < 1e-6, \
+                "wrong %s at row %d (%s)" % (name, row, mode)
+
+
+check(atOnce, "reduced at once")
+check(streamed, "streamed")
+
+# without streaming, only the current time step is reduced.
+sumColumn = single.GetColumnByName("pressure_Sum")
+assert sumColumn is not None and single.GetNumberOfRows() == numberOfRows
+firstTimeSum = sum(pressure(timeSteps[0], block, 0) for block in range(numberOfBlocks))
+assert abs(sumColumn.GetValue(0) - firstTimeSum) < 1e-6, "unexpected single time step reduction"
+
+# streaming again gives the same result.
+check(reduceTables(temporal, 1), "streamed twice")
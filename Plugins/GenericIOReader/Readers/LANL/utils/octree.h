@@ -45,9 +45,12 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef _GIO_PV_OCTREE_H_
 #define _GIO_PV_OCTREE_H_
 
+#include <fstream>
+#include <iostream>
 #include <list>
 #include <math.h>
 #include <stdint.h>
+#include <string>
 #include <vector>
 
 namespace GIOPvPlugin
@@ -68,8 +71,28 @@ struct octreeMeta
   std::vector<int> leaf;
   std::vector<extent> coord;
   std::vector<size_t> numPoints;
-  int MPIrank;
-  int fileOffset;
+  std::vector<int> MPIrank;      // GenericIO block holding the leaf's rows
+  std::vector<size_t> fileOffset; // first row of the leaf in that block
+};
+
+//
+// A contiguous range of rows of a GenericIO block and the region of space
+// its particles lie in. Used to only read the parts of a file that intersect
+// a region of interest.
+struct spatialBlock
+{
+  int rank;       // GenericIO block (data rank)
+  size_t offset;  // first row in the block
+  size_t numRows; // number of rows
+  float extents[6];
+
+  bool intersects(const double bounds[6]) const
+  {
+    for (int i = 0; i < 3; i++)
+      if (extents[2 * i] > bounds[2 * i + 1] || extents[2 * i + 1] < bounds[2 * i])
+        return false;
+    return true;
+  }
 };
 
 struct PartitionExtents
@@ -332,53 +355,44 @@ inline int Octree::getLeafIndex(float pos[3])
 inline int readOctFile(std::string filename, octreeMeta& octreeInfo)
 {
   std::ifstream metaFile(filename.c_str());
+  if (!metaFile.is_open())
+    return 0; // Could not open file!!!
 
-  if (metaFile.is_open())
-  {
-    octreeInfo.filename = filename;
-
-    while (metaFile)
-    {
-      metaFile >> octreeInfo.extents[0] >> octreeInfo.extents[1];
-      metaFile >> octreeInfo.extents[2] >> octreeInfo.extents[3];
-      metaFile >> octreeInfo.extents[4] >> octreeInfo.extents[5];
+  octreeInfo.filename = filename;
 
-      metaFile >> octreeInfo.numLevels;
-      metaFile >> octreeInfo.numMPIranks;
-      metaFile >> octreeInfo.numOctreeLeaves;
+  metaFile >> octreeInfo.extents[0] >> octreeInfo.extents[1];
+  metaFile >> octreeInfo.extents[2] >> octreeInfo.extents[3];
+  metaFile >> octreeInfo.extents[4] >> octreeInfo.extents[5];
 
-      // std::cout << octreeInfo.numLevels << std::endl;
-      // std::cout << octreeInfo.numMPIranks << std::endl;
-      // std::cout << octreeInfo.numOctreeLeaves << std::endl;
+  metaFile >> octreeInfo.numLevels;
+  metaFile >> octreeInfo.numMPIranks;
+  metaFile >> octreeInfo.numOctreeLeaves;
+  if (!metaFile || octreeInfo.numOctreeLeaves < 0)
+    return 0;
 
-      // Allocate space for entries
-      octreeInfo.leaf.resize(octreeInfo.numOctreeLeaves);
-      octreeInfo.coord.resize(octreeInfo.numOctreeLeaves);
-      octreeInfo.numPoints.resize(octreeInfo.numOctreeLeaves);
+  // Allocate space for entries
+  octreeInfo.leaf.resize(octreeInfo.numOctreeLeaves);
+  octreeInfo.coord.resize(octreeInfo.numOctreeLeaves);
+  octreeInfo.numPoints.resize(octreeInfo.numOctreeLeaves);
+  octreeInfo.MPIrank.resize(octreeInfo.numOctreeLeaves);
+  octreeInfo.fileOffset.resize(octreeInfo.numOctreeLeaves);
 
-      for (int i = 0; i < octreeInfo.numOctreeLeaves; i++)
-      {
-        metaFile >> octreeInfo.leaf[i];
-        metaFile >> octreeInfo.coord[i].extents[0];
-        metaFile >> octreeInfo.coord[i].extents[1];
-        metaFile >> octreeInfo.coord[i].extents[2];
-        metaFile >> octreeInfo.coord[i].extents[3];
-        metaFile >> octreeInfo.coord[i].extents[4];
-        metaFile >> octreeInfo.coord[i].extents[5];
-        metaFile >> octreeInfo.numPoints[i];
-        metaFile >> octreeInfo.MPIrank;
-        metaFile >> octreeInfo.fileOffset;
-      }
-    }
-    metaFile.close();
-  }
-  else
+  for (int i = 0; i < octreeInfo.numOctreeLeaves; i++)
   {
-    // Could not open file!!!
-    return 0;
+    metaFile >> octreeInfo.leaf[i];
+    metaFile >> octreeInfo.coord[i].extents[0];
+    metaFile >> octreeInfo.coord[i].extents[1];
+    metaFile >> octreeInfo.coord[i].extents[2];
+    metaFile >> octreeInfo.coord[i].extents[3];
+    metaFile >> octreeInfo.coord[i].extents[4];
+    metaFile >> octreeInfo.coord[i].extents[5];
+    metaFile >> octreeInfo.numPoints[i];
+    metaFile >> octreeInfo.MPIrank[i];
+    metaFile >> octreeInfo.fileOffset[i];
   }
 
-  return 1;
+  // a truncated file is unusable as the rows of leaves would be wrong.
+  return metaFile ? 1 : 0;
 }
 
 } // GIOPvPlugin namespace
@@ -48,9 +48,11 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "vtkDataObject.h"
 #include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkTypeInt16Array.h"
@@ -68,6 +70,8 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <algorithm>
 #include <cmath>
+#include <functional>
+#include <limits>
 #include <numeric>
 #include <random>
 #include <thread>
@@ -134,6 +138,84 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "LANL/utils/timer.h"
 */
 
+namespace
+{
+// Operations on the columns read by GenericIO, for each of the types it supports
+template <typename T>
+struct ValueAsDouble
+{
+  typedef double (*Function)(const void*, size_t);
+  static double apply(const void* data, size_t index)
+  {
+    return static_cast<double>(static_cast<const T*>(data)[index]);
+  }
+};
+
+// dst[i] = src[rows[i]], dst being a column of the output
+template <typename T>
+struct GatherRows
+{
+  typedef void (*Function)(const void*, const size_t*, size_t, void*);
+  static void apply(const void* src, const size_t* rows, size_t numRows, void* dst)
+  {
+    const T* in = static_cast<const T*>(src);
+    T* out = static_cast<T*>(dst);
+    for (size_t i = 0; i < numRows; i++)
+      out[i] = in[rows[i]];
+  }
+};
+
+// dst[3 * i + component] = src[rows[i]], dst being the output points
+template <typename T>
+struct GatherComponent
+{
+  typedef void (*Function)(const void*, const size_t*, size_t, double*, int);
+  static void apply(const void* src, const size_t* rows, size_t numRows, double* dst, int component)
+  {
+    const T* in = static_cast<const T*>(src);
+    double* out = dst + component;
+    for (size_t i = 0; i < numRows; i++)
+      out[3 * i] = static_cast<double>(in[rows[i]]);
+  }
+};
+
+template <template <typename> class Op>
+typename Op<float>::Function getTypedOp(const std::string& dataType)
+{
+  if (dataType == "double")
+    return Op<double>::apply;
+  else if (dataType == "int8_t")
+    return Op<int8_t>::apply;
+  else if (dataType == "int16_t")
+    return Op<int16_t>::apply;
+  else if (dataType == "int32_t")
+    return Op<int32_t>::apply;
+  else if (dataType == "int64_t")
+    return Op<int64_t>::apply;
+  else if (dataType == "uint8_t")
+    return Op<uint8_t>::apply;
+  else if (dataType == "uint16_t")
+    return Op<uint16_t>::apply;
+  else if (dataType == "uint32_t")
+    return Op<uint32_t>::apply;
+  else if (dataType == "uint64_t")
+    return Op<uint64_t>::apply;
+  return Op<float>::apply; // unknown types are shown as float
+}
+
+// One vertex per point, without going through InsertNextCell
+void makeVertexCells(vtkCellArray* cells, vtkIdType numPoints)
+{
+  vtkNew<vtkIdTypeArray> offsets;
+  vtkNew<vtkIdTypeArray> connectivity;
+  offsets->SetNumberOfValues(numPoints + 1);
+  connectivity->SetNumberOfValues(numPoints);
+  std::iota(offsets->GetPointer(0), offsets->GetPointer(0) + numPoints + 1, 0);
+  std::iota(connectivity->GetPointer(0), connectivity->GetPointer(0) + numPoints, 0);
+  cells->SetData(offsets, connectivity);
+}
+}
+
 vtkStandardNewMacro(vtkGenIOReader);
 
 vtkGenIOReader::vtkGenIOReader()
@@ -153,6 +235,12 @@ vtkGenIOReader::vtkGenIOReader()
   // sampling
   sampleType = 0; // full data
 
+  // spatial sampling: load everything
+  spatialBounds[0] = spatialBounds[2] = spatialBounds[4] = 0;
+  spatialBounds[1] = spatialBounds[3] = spatialBounds[5] = -1;
+  spatialFraction = 0;
+  spatialCacheValid = false;
+
   // % loading
   dataPercentage = 0.1;
   percentageType = 1; // 0:normal, 1:power cube
@@ -200,6 +288,7 @@ void vtkGenIOReader::SetFileName(char* fname)
 {
   dataFilename = std::string(fname);
   msgLog << "SetFileName | Opening filename: " << dataFilename << " ...\n";
+  spatialCacheValid = false;
 
   this->Modified();
 }
@@ -232,6 +321,18 @@ void vtkGenIOReader::SetPercentageType(int _type)
   }
 }
 
+void vtkGenIOReader::SetSpatialBounds(
+  double xMin, double xMax, double yMin, double yMax, double zMin, double zMax)
+{
+  double bounds[6] = { xMin, xMax, yMin, yMax, zMin, zMax };
+  if (!std::equal(bounds, bounds + 6, spatialBounds))
+  {
+    std::copy(bounds, bounds + 6, spatialBounds);
+    spatialCacheValid = false;
+    this->Modified();
+  }
+}
+
 void vtkGenIOReader::SetResetSelection(int /* _x */)
 {
   selections.clear();
@@ -294,6 +395,7 @@ void vtkGenIOReader::SetCellArrayStatus(const char* name, int status)
   else
     CellDataArraySelection->DisableArray(name);
 
+  spatialCacheValid = false;
   this->Modified();
 }
 
@@ -411,15 +513,65 @@ bool vtkGenIOReader::doMPIDataSplitting(int numDataRanksTmp, int numMPIranks, in
   return splitReading;
 }
 
-void vtkGenIOReader::theadedParsing(int threadId, int numThreads, size_t numRowsToSample,
-  size_t numLoadingRows, vtkSmartPointer<vtkCellArray> cells, vtkSmartPointer<vtkPoints> pnts,
-  int numSelections)
+void vtkGenIOReader::addVariables(size_t numElements)
 {
-  GIOPvPlugin::Timer parseClock;
+  // Specify location where to store each var read in
+  for (size_t j = 0; j < readInData.size(); j++)
+  {
+    if (paraviewData[j].load)
+    {
+      readInData[j].setNumElements(numElements);
+      readInData[j].allocateMem(1);
+
+      if (readInData[j].dataType == "float")
+        gioReader->addVariable((readInData[j].name), (float*)readInData[j].data, true);
+      else if (readInData[j].dataType == "double")
+        gioReader->addVariable((readInData[j].name), (double*)readInData[j].data, true);
+      else if (readInData[j].dataType == "int8_t")
+        gioReader->addVariable((readInData[j].name), (int8_t*)readInData[j].data, true);
+      else if (readInData[j].dataType == "int16_t")
+        gioReader->addVariable((readInData[j].name), (int16_t*)readInData[j].data, true);
+      else if (readInData[j].dataType == "int32_t")
+        gioReader->addVariable((readInData[j].name), (int32_t*)readInData[j].data, true);
+      else if (readInData[j].dataType == "int64_t")
+        gioReader->addVariable((readInData[j].name), (int64_t*)readInData[j].data, true);
+      else if (readInData[j].dataType == "uint8_t")
+        gioReader->addVariable((readInData[j].name), (uint8_t*)readInData[j].data, true);
+      else if (readInData[j].dataType == "uint16_t")
+        gioReader->addVariable((readInData[j].name), (uint16_t*)readInData[j].data, true);
+      else if (readInData[j].dataType == "uint32_t")
+        gioReader->addVariable((readInData[j].name), (uint32_t*)readInData[j].data, true);
+      else if (readInData[j].dataType == "uint64_t")
+        gioReader->addVariable((readInData[j].name), (uint64_t*)readInData[j].data, true);
+      else
+        msgLog << readInData[j].dataType << " = data type undefined!!!";
+    }
+  }
+}
 
-  // parseClock.start();
-  vtkIdType _idx;
+size_t vtkGenIOReader::getNumRowsToSample(size_t numLoadingRows)
+{
+  size_t numRowsToSample;
+  if (percentageType == 0) // normal
+    numRowsToSample = round(numLoadingRows * dataPercentage);
+  else
+    numRowsToSample = round(numLoadingRows * (dataPercentage * dataPercentage * dataPercentage));
+
+  return std::min(numRowsToSample, numLoadingRows);
+}
+
+void vtkGenIOReader::allocateOutput(vtkPoints* pnts, size_t numPoints)
+{
+  // existing values are kept, e.g. the points of previously read ranks
+  pnts->SetNumberOfPoints(numPoints);
+  for (size_t i = 0; i < tupleArray.size(); i++)
+    if (tupleArray[i] != nullptr)
+      tupleArray[i]->SetNumberOfTuples(numPoints);
+}
 
+void vtkGenIOReader::theadedSampling(int threadId, int numThreads, size_t numRowsToSample,
+  size_t numLoadingRows, int numSelections, std::vector<size_t>& rows)
+{
   size_t rowsPerThread = floor(numLoadingRows / (float)numThreads);
   size_t startRow = rowsPerThread * threadId;
   size_t numRowsToSamplePerThread = floor(numRowsToSample / (float)numThreads);
@@ -431,20 +583,14 @@ void vtkGenIOReader::theadedParsing(int threadId, int numThreads, size_t numRows
       numRowsToSamplePerThread = numLoadingRows - startRow;
   }
 
-  double pnt[3];
+  rows.clear();
+  rows.reserve(numRowsToSamplePerThread);
   for (size_t j = startRow; j < (startRow + numRowsToSamplePerThread); ++j)
   {
     // Choose random element to load
     size_t _j = _num[j];
     while (_j >= numLoadingRows)
-    {
-      mtx.lock();
-      size_t _nextHash = nextHash;
-      nextHash++;
-      mtx.unlock();
-
-      _j = _num[_nextHash];
-    }
+      _j = _num[nextHash++];
 
     //
     // Selection
@@ -455,9 +601,9 @@ void vtkGenIOReader::theadedParsing(int threadId, int numThreads, size_t numRows
       {
         for (size_t k = 0; k < paraviewData.size(); k++)
         {
-          ParaviewSelection __sel = selections[i];
+          const ParaviewSelection& __sel = selections[i];
 
-          std::string _name = readInData[k].name;
+          const std::string& _name = readInData[k].name;
           if (_name == __sel.selectedScalar)
           {
             bool localMatchedCriteria = false;
@@ -487,68 +633,344 @@ void vtkGenIOReader::theadedParsing(int threadId, int numThreads, size_t numRows
         continue;
     }
 
-    mtx.lock();
-    _idx = idx;
-    idx++;
-    mtx.unlock();
+    rows.push_back(_j);
+  }
+}
 
-    int tupleCount = 0;
-    for (size_t k = 0; k < paraviewData.size(); k++)
+void vtkGenIOReader::theadedParsing(
+  const std::vector<size_t>& rows, vtkIdType offset, vtkPoints* pnts)
+{
+  // Each thread owns the range [offset, offset + rows.size()) of the output arrays, which
+  // are already allocated: nothing is shared, so no locking is needed.
+  const size_t* _rows = rows.data();
+  size_t numRows = rows.size();
+  double* pntData = static_cast<double*>(pnts->GetData()->GetVoidPointer(3 * offset));
+
+  int tupleCount = 0;
+  for (size_t k = 0; k < paraviewData.size(); k++)
+  {
+    const std::string& _dataType = readInData[k].dataType;
+
+    // Load the x,y,z variables
+    if (paraviewData[k].xVar)
+      getTypedOp<GatherComponent>(_dataType)(readInData[k].data, _rows, numRows, pntData, 0);
+
+    if (paraviewData[k].yVar)
+      getTypedOp<GatherComponent>(_dataType)(readInData[k].data, _rows, numRows, pntData, 1);
+
+    if (paraviewData[k].zVar)
+      getTypedOp<GatherComponent>(_dataType)(readInData[k].data, _rows, numRows, pntData, 2);
+
+    // Load the scalars that the user wants to see
+    if (paraviewData[k].show)
     {
-      // Load the x,y,z variables
-      if (paraviewData[k].xVar)
-        pnt[0] = ((float*)readInData[k].data)[_j];
+      getTypedOp<GatherRows>(_dataType)(
+        readInData[k].data, _rows, numRows, tupleArray[tupleCount]->GetVoidPointer(offset));
+      tupleCount++;
+    }
+  }
+}
 
-      if (paraviewData[k].yVar)
-        pnt[1] = ((float*)readInData[k].data)[_j];
+void vtkGenIOReader::parseRows(const std::vector<std::vector<size_t>>& rows, vtkPoints* pnts)
+{
+  // Prefix sum of the number of rows of each thread: where each thread writes
+  std::vector<vtkIdType> offsets(rows.size());
+  vtkIdType numRows = 0;
+  for (size_t t = 0; t < rows.size(); t++)
+  {
+    offsets[t] = idx + numRows;
+    numRows += static_cast<vtkIdType>(rows[t].size());
+  }
 
-      if (paraviewData[k].zVar)
-        pnt[2] = ((float*)readInData[k].data)[_j];
+  // Only grow: the output may have been allocated for the whole update already
+  if (idx + numRows > pnts->GetNumberOfPoints())
+    allocateOutput(pnts, idx + numRows);
 
-      // Load the scalars that the user wants to see
-      if (paraviewData[k].show)
-      {
-        std::string _dataType = readInData[k].dataType;
-
-        mtx.lock();
-        if (_dataType == "float")
-          (tupleArray[tupleCount])->InsertTuple1(_idx, ((float*)readInData[k].data)[_j]);
-        else if (_dataType == "double")
-          (tupleArray[tupleCount])->InsertTuple1(_idx, ((double*)readInData[k].data)[_j]);
-        else if (_dataType == "int8_t")
-          (tupleArray[tupleCount])->InsertTuple1(_idx, ((int8_t*)readInData[k].data)[_j]);
-        else if (_dataType == "int16_t")
-          (tupleArray[tupleCount])->InsertTuple1(_idx, ((int16_t*)readInData[k].data)[_j]);
-        else if (_dataType == "int32_t")
-          (tupleArray[tupleCount])->InsertTuple1(_idx, ((int32_t*)readInData[k].data)[_j]);
-        else if (_dataType == "int64_t")
-          (tupleArray[tupleCount])->InsertTuple1(_idx, ((int64_t*)readInData[k].data)[_j]);
-        else if (_dataType == "uint8_t")
-          (tupleArray[tupleCount])->InsertTuple1(_idx, ((uint8_t*)readInData[k].data)[_j]);
-        else if (_dataType == "uint16_t")
-          (tupleArray[tupleCount])->InsertTuple1(_idx, ((uint16_t*)readInData[k].data)[_j]);
-        else if (_dataType == "uint32_t")
-          (tupleArray[tupleCount])->InsertTuple1(_idx, ((uint32_t*)readInData[k].data)[_j]);
-        else if (_dataType == "uint64_t")
-          (tupleArray[tupleCount])->InsertTuple1(_idx, ((uint64_t*)readInData[k].data)[_j]);
-        else
-          msgLog << _dataType << " ...data type undefined !!!";
-        mtx.unlock();
+  std::vector<std::thread> threadPool;
+  threadPool.reserve(rows.size());
+  for (size_t t = 0; t < rows.size(); t++)
+    threadPool.push_back(std::thread(
+      &vtkGenIOReader::theadedParsing, this, std::cref(rows[t]), offsets[t], pnts));
+
+  for (auto& th : threadPool)
+    th.join();
+
+  idx += numRows;
+  totalPoints += static_cast<int>(numRows);
+}
+
+void vtkGenIOReader::parseRows(
+  size_t numRowsToSample, size_t numLoadingRows, vtkPoints* pnts, int numSelections)
+{
+  nextHash = numLoadingRows;
+
+  std::vector<std::vector<size_t>> rows(concurentThreadsSupported);
+  std::vector<std::thread> threadPool;
+  threadPool.reserve(concurentThreadsSupported);
+  for (int t = 0; t < concurentThreadsSupported; t++)
+    threadPool.push_back(std::thread(&vtkGenIOReader::theadedSampling, this, t,
+      concurentThreadsSupported, numRowsToSample, numLoadingRows, numSelections,
+      std::ref(rows[t])));
+
+  for (auto& th : threadPool)
+    th.join();
+
+  parseRows(rows, pnts);
+}
+
+void vtkGenIOReader::buildSpatialIndex()
+{
+  spatialIndex.clear();
+  spatialRowsRead.clear();
+  spatialFraction = 0;
+  spatialCacheValid = false;
+
+  // Use the leaves of a precomputed octree if there is one matching this file: these
+  // are much finer than the blocks the file was written as.
+  GIOPvPlugin::octreeMeta octreeInfo;
+  if (GIOPvPlugin::readOctFile(dataFilename + ".oct", octreeInfo) &&
+    octreeInfo.numMPIranks == numDataRanks)
+  {
+    bool valid = true;
+    for (int i = 0; i < octreeInfo.numOctreeLeaves && valid; i++)
+    {
+      GIOPvPlugin::spatialBlock block;
+      block.rank = octreeInfo.MPIrank[i];
+      block.offset = octreeInfo.fileOffset[i];
+      block.numRows = octreeInfo.numPoints[i];
+      std::copy(octreeInfo.coord[i].extents, octreeInfo.coord[i].extents + 6, block.extents);
+
+      valid = block.rank >= 0 && block.rank < numDataRanks &&
+        block.offset + block.numRows <= gioReader->readNumElems(block.rank);
+      spatialIndex.push_back(block);
+    }
+
+    if (valid)
+    {
+      msgLog << "Spatial index: " << spatialIndex.size() << " octree leaves\n";
+      spatialRowsRead.assign(spatialIndex.size(), 0);
+      return;
+    }
+
+    msgLog << "Octree file " << octreeInfo.filename << " does not match the data, ignored\n";
+    spatialIndex.clear();
+  }
 
-        tupleCount++;
+  // Otherwise, use the blocks of the file: the header has the position of the block of
+  // each rank in the decomposition of the physical domain.
+  int dims[3];
+  double origin[3], scale[3];
+  gioReader->readDims(dims);
+  gioReader->readPhysOrigin(origin);
+  gioReader->readPhysScale(scale);
+  bool hasExtents = dims[0] > 0 && dims[1] > 0 && dims[2] > 0 &&
+    (scale[0] != 0 || scale[1] != 0 || scale[2] != 0);
+
+  for (int i = 0; i < numDataRanks; i++)
+  {
+    GIOPvPlugin::spatialBlock block;
+    block.rank = i;
+    block.offset = 0;
+    block.numRows = gioReader->readNumElems(i);
+
+    int coords[3];
+    gioReader->readCoords(coords, i);
+    for (int j = 0; j < 3; j++)
+    {
+      if (hasExtents)
+      {
+        block.extents[2 * j] = origin[j] + scale[j] * coords[j] / dims[j];
+        block.extents[2 * j + 1] = origin[j] + scale[j] * (coords[j] + 1) / dims[j];
+      }
+      else
+      {
+        block.extents[2 * j] = -std::numeric_limits<float>::infinity();
+        block.extents[2 * j + 1] = std::numeric_limits<float>::infinity();
       }
     }
+    spatialIndex.push_back(block);
+  }
+  spatialRowsRead.assign(spatialIndex.size(), 0);
+  msgLog << "Spatial index: " << spatialIndex.size() << " blocks"
+         << (hasExtents ? "" : " (no physical extents in header)") << "\n";
+}
+
+void vtkGenIOReader::spatialSampling(vtkPoints* pnts, size_t& totalPointsProcessed)
+{
+  double fraction = dataPercentage;
+  if (percentageType == 1)
+    fraction = dataPercentage * dataPercentage * dataPercentage;
+  fraction = std::min(std::max(fraction, 0.0), 1.0);
+
+  bool useBounds = spatialBounds[0] <= spatialBounds[1] && spatialBounds[2] <= spatialBounds[3] &&
+    spatialBounds[4] <= spatialBounds[5];
+
+  // Blocks intersecting the region, split among MPI ranks by row count
+  std::vector<size_t> selected;
+  size_t totalRows = 0;
+  for (size_t b = 0; b < spatialIndex.size(); b++)
+    if (!useBounds || spatialIndex[b].intersects(spatialBounds))
+    {
+      selected.push_back(b);
+      totalRows += spatialIndex[b].numRows;
+    }
 
-    mtx.lock();
-    pnts->InsertPoint(_idx, pnt);
-    cells->InsertNextCell(1, &_idx);
-    totalPoints++;
-    mtx.unlock();
+  std::vector<size_t> myBlocks;
+  size_t rowsBefore = 0;
+  for (size_t b : selected)
+  {
+    size_t middleRow = rowsBefore + spatialIndex[b].numRows / 2;
+    rowsBefore += spatialIndex[b].numRows;
+    if (totalRows > 0 && static_cast<int>(middleRow * numRanks / totalRows) == myRank)
+      myBlocks.push_back(b);
   }
+  msgLog << "Spatial blocks: " << selected.size() << " of " << spatialIndex.size()
+         << " intersect the bounds, " << myBlocks.size() << " on this rank\n";
+
+  // Progressive refinement: when the fraction grows, only read the rows not read yet.
+  // Rows of a block are selected in the order of their hash, so the rows selected for a
+  // fraction include those selected for any smaller fraction.
+  bool reuse = spatialCacheValid && spatialCache && fraction >= spatialFraction &&
+    spatialRowsRead.size() == spatialIndex.size();
+  if (reuse)
+  {
+    vtkPointData* cachedPD = spatialCache->GetPointData();
+    int tupleCount = 0;
+    for (size_t k = 0; k < paraviewData.size() && reuse; k++)
+      if (paraviewData[k].show)
+        reuse = cachedPD->GetArray(paraviewData[k].name.c_str()) != nullptr;
+    if (reuse)
+    {
+      for (size_t k = 0; k < paraviewData.size(); k++)
+        if (paraviewData[k].show)
+          tupleArray[tupleCount++]->DeepCopy(cachedPD->GetArray(paraviewData[k].name.c_str()));
+      if (spatialCache->GetPoints())
+        pnts->DeepCopy(spatialCache->GetPoints());
+      idx = pnts->GetNumberOfPoints();
+      totalPoints = static_cast<int>(idx);
+      msgLog << "Reusing " << idx << " points from the previous update\n";
+    }
+  }
+  if (!reuse)
+    spatialRowsRead.assign(spatialIndex.size(), 0);
+
+  // Allocate for all the rows to read, points outside of the bounds are trimmed at the end
+  size_t maxPoints = idx;
+  for (size_t b : myBlocks)
+  {
+    const GIOPvPlugin::spatialBlock& block = spatialIndex[b];
+    size_t rowsWanted =
+      std::min(block.numRows, static_cast<size_t>(round(block.numRows * fraction)));
+    maxPoints += rowsWanted - std::min(rowsWanted, spatialRowsRead[b]);
+  }
+  allocateOutput(pnts, maxPoints);
+
+  std::vector<ValueAsDouble<float>::Function> getters(readInData.size());
+  for (size_t k = 0; k < readInData.size(); k++)
+    getters[k] = getTypedOp<ValueAsDouble>(readInData[k].dataType);
+
+  for (size_t b : myBlocks)
+  {
+    const GIOPvPlugin::spatialBlock& block = spatialIndex[b];
+    size_t rowsWanted =
+      std::min(block.numRows, static_cast<size_t>(round(block.numRows * fraction)));
+    size_t first = spatialRowsRead[b];
+    if (rowsWanted <= first)
+      continue;
+    size_t count = rowsWanted - first;
+    totalPointsProcessed += count;
+
+    // Same random selection as the other sampling types: the rows with the smallest
+    // hashes are selected, those in [first, rowsWanted) being the ones not read yet.
+    std::vector<size_t> order(block.numRows);
+    std::iota(order.begin(), order.end(), 0);
+    auto byHash = [this](size_t r0, size_t r1) { return _num[r0] < _num[r1]; };
+    std::nth_element(order.begin(), order.begin() + rowsWanted, order.end(), byHash);
+    std::nth_element(order.begin(), order.begin() + first, order.begin() + rowsWanted, byHash);
+    std::vector<size_t> selectedRows(order.begin() + first, order.begin() + rowsWanted);
+    std::vector<size_t>().swap(order);
+    std::sort(selectedRows.begin(), selectedRows.end());
+
+    // GenericIO reads contiguous sections: the selected rows are read with at most
+    // maxSections reads, skipping the largest runs of rows that are not selected.
+    const size_t maxSections = 32;
+    size_t minGap = 0;
+    if (selectedRows.size() > maxSections)
+    {
+      std::vector<size_t> gaps(selectedRows.size() - 1);
+      for (size_t j = 1; j < selectedRows.size(); j++)
+        gaps[j - 1] = selectedRows[j] - selectedRows[j - 1];
+      std::nth_element(gaps.begin(), gaps.begin() + (maxSections - 1), gaps.end(),
+        std::greater<size_t>());
+      minGap = gaps[maxSections - 1] + 1;
+    }
+
+    size_t sectionBegin = 0;
+    for (size_t j = 1; j <= selectedRows.size(); j++)
+    {
+      if (j < selectedRows.size() &&
+        (minGap == 0 || selectedRows[j] - selectedRows[j - 1] < minGap))
+        continue;
+
+      const size_t* sectionRows = selectedRows.data() + sectionBegin;
+      const size_t numSectionRows = j - sectionBegin;
+      const size_t sectionStart = sectionRows[0];
+      const size_t sectionLength = sectionRows[numSectionRows - 1] - sectionStart + 1;
+      sectionBegin = j;
+
+      addVariables(sectionLength);
+      gioReader->readDataSection(block.offset + sectionStart, sectionLength, block.rank, false);
+
+      // Keep the selected rows inside the bounds, each thread filtering a contiguous chunk
+      std::vector<std::vector<size_t>> rows(concurentThreadsSupported);
+      std::vector<std::thread> threadPool;
+      threadPool.reserve(concurentThreadsSupported);
+      for (int t = 0; t < concurentThreadsSupported; t++)
+        threadPool.push_back(std::thread([&, t]() {
+          size_t start = numSectionRows * t / concurentThreadsSupported;
+          size_t end = numSectionRows * (t + 1) / concurentThreadsSupported;
+          rows[t].reserve(end - start);
+
+          double pnt[3] = { 0, 0, 0 };
+          for (size_t i = start; i < end; i++)
+          {
+            const size_t j = sectionRows[i] - sectionStart;
+            if (useBounds)
+            {
+              for (size_t k = 0; k < paraviewData.size(); k++)
+              {
+                if (paraviewData[k].xVar)
+                  pnt[0] = getters[k](readInData[k].data, j);
+                if (paraviewData[k].yVar)
+                  pnt[1] = getters[k](readInData[k].data, j);
+                if (paraviewData[k].zVar)
+                  pnt[2] = getters[k](readInData[k].data, j);
+              }
+
+              if (pnt[0] < spatialBounds[0] || pnt[0] > spatialBounds[1] ||
+                pnt[1] < spatialBounds[2] || pnt[1] > spatialBounds[3] ||
+                pnt[2] < spatialBounds[4] || pnt[2] > spatialBounds[5])
+                continue;
+            }
+            rows[t].push_back(j);
+          }
+        }));
 
-  // parseClock.stop();
-  // msgLog <<" time taken ~ parsing for thread id "  << threadId << " took " <<
-  // parseClock.getDuration() << " s.\n";
+      for (auto& th : threadPool)
+        th.join();
+
+      parseRows(rows, pnts);
+
+      for (size_t k = 0; k < readInData.size(); k++)
+        readInData[k].deAllocateMem();
+      gioReader->clearVariables();
+    }
+
+    spatialRowsRead[b] = rowsWanted;
+    msgLog << "Spatial block " << b << " (rank " << block.rank << "): read " << count
+           << " more rows, " << rowsWanted << " of " << block.numRows << "\n";
+  }
+  spatialFraction = fraction;
 }
 
 //
@@ -761,6 +1183,8 @@ int vtkGenIOReader::RequestInformation(vtkInformation* /*rqst*/,
 
     metaDataBuilt = true;
     msgLog << "numVars: " + std::to_string(numVars) << "\n";
+
+    buildSpatialIndex();
   }
   else
     msgLog << "\nHeader file already opened!\n";
@@ -853,6 +1277,7 @@ int vtkGenIOReader::RequestData(
   //
   // Adjust based on the percentage of data we want to show
   size_t maxRowsInRank = 0;
+  size_t maxRowsToSample = 0;
   int splitReadingCount = 0;
   for (int i = ranksRangeToLoad[0]; i <= ranksRangeToLoad[1]; ++i)
   {
@@ -866,22 +1291,23 @@ int vtkGenIOReader::RequestData(
     }
     maxRowsInRank = std::max(maxRowsInRank, numLoadingRows);
 
-// Find the number of rows after sampling
-#if 0 // numRowsToSample is unused before scope ends.
-    size_t numRowsToSample = numLoadingRows;
-    if (percentageType == 0) // normal
-      numRowsToSample = numLoadingRows * dataPercentage;
-    else
-      numRowsToSample = numLoadingRows * (dataPercentage * dataPercentage * dataPercentage);
-#endif
+    // Find the number of rows after sampling
+    maxRowsToSample += getNumRowsToSample(numLoadingRows);
   }
+  splitReadingCount = 0;
 
   //
   // Generate a random number, sort of hashing really where each key is unique
-  if (!randomNumGenerated)
+  size_t numHashes = maxRowsInRank;
+  if (sampleType == 2)
+    for (const auto& block : spatialIndex)
+      numHashes = std::max(numHashes, block.numRows);
+  if (!randomNumGenerated || _num.size() < numHashes)
   {
     hashClock.start();
-    _num.resize(maxRowsInRank);
+    // the rows selected in spatial blocks depend on the hashes
+    spatialCacheValid = false;
+    _num.resize(numHashes);
     std::iota(_num.begin(), _num.end(), 0);
     shuffle(_num.begin(), _num.end(), std::default_random_engine(randomSeed));
     hashClock.stop();
@@ -896,11 +1322,9 @@ int vtkGenIOReader::RequestData(
   // Initialize points and cells
   idx = 0;
   vtkSmartPointer<vtkPoints> pnts = vtkSmartPointer<vtkPoints>::New();
-  // pnts = vtkSmartPointer<vtkPoints>::New();
   pnts->SetDataTypeToDouble();
-  // cells = vtkSmartPointer<vtkCellArray>::New();
   vtkSmartPointer<vtkCellArray> cells = vtkSmartPointer<vtkCellArray>::New();
-  tupleArray.resize(numVars);
+  tupleArray.assign(numVars, nullptr);
 
   //
   // Create the vtk structures to show the data
@@ -944,6 +1368,10 @@ int vtkGenIOReader::RequestData(
   }
   numActiveTuples = tupleCount;
 
+  // Parsing writes to preallocated ranges of the output, trimmed once all is parsed
+  if (sampleType != 2)
+    allocateOutput(pnts, maxRowsToSample);
+
   intializeClock.stop();
   msgLog << "\nReading now: " << numActiveTuples << " ... \n";
   debugLog.writeLogToDisk(msgLog);
@@ -968,37 +1396,7 @@ int vtkGenIOReader::RequestData(
         _clock.start();
 
         // Specify location where to store each var read in
-        for (size_t j = 0; j < readInData.size(); j++)
-        {
-          if (paraviewData[j].load)
-          {
-            readInData[j].setNumElements(Np);
-            readInData[j].allocateMem(1);
-
-            if (readInData[j].dataType == "float")
-              gioReader->addVariable((readInData[j].name), (float*)readInData[j].data, true);
-            else if (readInData[j].dataType == "double")
-              gioReader->addVariable((readInData[j].name), (double*)readInData[j].data, true);
-            else if (readInData[j].dataType == "int8_t")
-              gioReader->addVariable((readInData[j].name), (int8_t*)readInData[j].data, true);
-            else if (readInData[j].dataType == "int16_t")
-              gioReader->addVariable((readInData[j].name), (int16_t*)readInData[j].data, true);
-            else if (readInData[j].dataType == "int32_t")
-              gioReader->addVariable((readInData[j].name), (int32_t*)readInData[j].data, true);
-            else if (readInData[j].dataType == "int64_t")
-              gioReader->addVariable((readInData[j].name), (int64_t*)readInData[j].data, true);
-            else if (readInData[j].dataType == "uint8_t")
-              gioReader->addVariable((readInData[j].name), (uint8_t*)readInData[j].data, true);
-            else if (readInData[j].dataType == "uint16_t")
-              gioReader->addVariable((readInData[j].name), (uint16_t*)readInData[j].data, true);
-            else if (readInData[j].dataType == "uint32_t")
-              gioReader->addVariable((readInData[j].name), (uint32_t*)readInData[j].data, true);
-            else if (readInData[j].dataType == "uint64_t")
-              gioReader->addVariable((readInData[j].name), (uint64_t*)readInData[j].data, true);
-            else
-              msgLog << readInData[j].dataType << " = data type undefined!!!";
-          }
-        }
+        addVariables(Np);
         _clock.stop();
         msgLog << "\n\nInput read rank: " << i << ", paraviewData.size(): " << paraviewData.size()
                << ", time to create structures: " << _clock.getDuration() << " s.\n";
@@ -1021,15 +1419,7 @@ int vtkGenIOReader::RequestData(
         }
 
         // Find the number of rows after sampling
-        size_t numRowsToSample = numLoadingRows;
-        if (percentageType == 0) // normal
-          numRowsToSample = round(numLoadingRows * dataPercentage);
-        else
-          numRowsToSample =
-            round(numLoadingRows * (dataPercentage * dataPercentage * dataPercentage));
-
-        if (numRowsToSample > numLoadingRows)
-          numRowsToSample = numLoadingRows;
+        size_t numRowsToSample = getNumRowsToSample(numLoadingRows);
 
         msgLog << "Rank (i): " + std::to_string(i) << ", Np/numLoadingRows: " << numLoadingRows
                << ", # rows in rank: " << gioReader->readNumElems(i)
@@ -1042,18 +1432,7 @@ int vtkGenIOReader::RequestData(
 
         // Parse scalars
         parseClock.start();
-        nextHash = numLoadingRows;
-
-        std::vector<std::thread> threadPool;
-        threadPool.reserve(concurentThreadsSupported);
-        for (int t = 0; t < concurentThreadsSupported; t++)
-        {
-          threadPool.push_back(std::thread(&vtkGenIOReader::theadedParsing, this, t,
-            concurentThreadsSupported, numRowsToSample, numLoadingRows, cells, pnts, -1));
-        }
-
-        for (auto& th : threadPool)
-          th.join();
+        parseRows(numRowsToSample, numLoadingRows, pnts, -1);
         parseClock.stop();
         msgLog << " time taken ~ parsing: " << parseClock.getDuration() << " s.\n";
 
@@ -1067,6 +1446,13 @@ int vtkGenIOReader::RequestData(
       debugLog.writeLogToDisk(msgLog);
       break;
 
+    case 2:
+      msgLog << "\nSpatial sampling; sample type = " << std::to_string(this->sampleType) << "\n";
+      spatialSampling(pnts, totalPointsProcessed);
+      msgLog << "Case 2 done!\n";
+      debugLog.writeLogToDisk(msgLog);
+      break;
+
     case 3:
     {
       msgLog << "Selecting based on ... \n";
@@ -1106,37 +1492,7 @@ int vtkGenIOReader::RequestData(
         gioReader->readCoords(Coords, i);
 
         _clock.start();
-        for (size_t j = 0; j < readInData.size(); j++)
-        {
-          if (paraviewData[j].load)
-          {
-            readInData[j].setNumElements(Np);
-            readInData[j].allocateMem(1);
-
-            if (readInData[j].dataType == "float")
-              gioReader->addVariable((readInData[j].name), (float*)readInData[j].data, true);
-            else if (readInData[j].dataType == "double")
-              gioReader->addVariable((readInData[j].name), (double*)readInData[j].data, true);
-            else if (readInData[j].dataType == "int8_t")
-              gioReader->addVariable((readInData[j].name), (int8_t*)readInData[j].data, true);
-            else if (readInData[j].dataType == "int16_t")
-              gioReader->addVariable((readInData[j].name), (int16_t*)readInData[j].data, true);
-            else if (readInData[j].dataType == "int32_t")
-              gioReader->addVariable((readInData[j].name), (int32_t*)readInData[j].data, true);
-            else if (readInData[j].dataType == "int64_t")
-              gioReader->addVariable((readInData[j].name), (int64_t*)readInData[j].data, true);
-            else if (readInData[j].dataType == "uint8_t")
-              gioReader->addVariable((readInData[j].name), (uint8_t*)readInData[j].data, true);
-            else if (readInData[j].dataType == "uint16_t")
-              gioReader->addVariable((readInData[j].name), (uint16_t*)readInData[j].data, true);
-            else if (readInData[j].dataType == "uint32_t")
-              gioReader->addVariable((readInData[j].name), (uint32_t*)readInData[j].data, true);
-            else if (readInData[j].dataType == "uint64_t")
-              gioReader->addVariable((readInData[j].name), (uint64_t*)readInData[j].data, true);
-            else
-              msgLog << readInData[j].dataType << " = data type undefined!!!";
-          }
-        }
+        addVariables(Np);
         _clock.stop();
         msgLog << "Input read rank: " << i << ", paraviewData.size(): " << paraviewData.size()
                << ", time to create structures: " << _clock.getDuration() << " s.\n";
@@ -1160,15 +1516,7 @@ int vtkGenIOReader::RequestData(
         msgLog << "numLoadingRows: " << numLoadingRows << "\n";
 
         // Find the number of rows after sampling
-        size_t numRowsToSample = numLoadingRows;
-        if (percentageType == 0) // normal
-          numRowsToSample = round(numLoadingRows * dataPercentage);
-        else
-          numRowsToSample =
-            round(numLoadingRows * (dataPercentage * dataPercentage * dataPercentage));
-
-        if (numRowsToSample > numLoadingRows)
-          numRowsToSample = numLoadingRows;
+        size_t numRowsToSample = getNumRowsToSample(numLoadingRows);
         msgLog << "\ni: " + std::to_string(i) << ", Np: " << numLoadingRows
                << ", # rows in rank: " << gioReader->readNumElems(i)
                << ", dataPercentage: " << dataPercentage
@@ -1179,20 +1527,7 @@ int vtkGenIOReader::RequestData(
 
         // Load scalars
         parseClock.start();
-        nextHash = numLoadingRows;
-
-        std::vector<std::thread> threadPool;
-        threadPool.reserve(concurentThreadsSupported);
-        for (int t = 0; t < concurentThreadsSupported; t++)
-        {
-          threadPool.push_back(
-            std::thread(&vtkGenIOReader::theadedParsing, this, t, concurentThreadsSupported,
-              numRowsToSample, numLoadingRows, cells, pnts, numSelections));
-        }
-
-        for (auto& th : threadPool)
-          th.join();
-
+        parseRows(numRowsToSample, numLoadingRows, pnts, numSelections);
         parseClock.stop();
         msgLog << " time taken: " << parseClock.getDuration() << " s.\n";
 
@@ -1215,6 +1550,10 @@ int vtkGenIOReader::RequestData(
 
   cleanupClock.start();
 
+  // Drop what was allocated for rows that were not selected
+  allocateOutput(pnts, idx);
+  makeVertexCells(cells, idx);
+
   output->SetPoints(pnts);
   output->SetCells(VTK_VERTEX, cells);
 
@@ -1223,6 +1562,15 @@ int vtkGenIOReader::RequestData(
 
   output->Squeeze();
 
+  // keep the output around so that a higher percentage only reads the extra rows
+  if (sampleType == 2)
+  {
+    if (!spatialCache)
+      spatialCache = vtkSmartPointer<vtkUnstructuredGrid>::New();
+    spatialCache->ShallowCopy(output);
+    spatialCacheValid = true;
+  }
+
   for (int i = 0; i < numActiveTuples; i++)
     (tupleArray[i])->Delete();
 
@@ -54,14 +54,16 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "utils/gioData.h" // genio header
 #include "utils/log.h"     // genio header
+#include "utils/octree.h"  // genio header
 
-#include <mutex>   // for std::mutex
+#include <atomic>  // for std::atomic
 #include <sstream> // for std::stringstream
 #include <string>  // for std::string
 #include <vector>  // for std::vector
 
 class vtkDataArray;
 class vtkMultiProcessController;
+class vtkUnstructuredGrid;
 
 namespace lanl
 {
@@ -126,6 +128,8 @@ public:
   void SetSampleType(int s);
   void SetDataPercentToShow(double t);
   void SetPercentageType(int _type);
+  void SetSpatialBounds(
+    double xMin, double xMax, double yMin, double yMax, double zMin, double zMax);
 
   void SetResetSelection(int _x);
   void SelectScalar(const char* selectedScalar);
@@ -157,8 +161,21 @@ protected:
     vtkInformationVector* outputVector) override;
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
-  void theadedParsing(int threadId, int numThreads, size_t numRowsToSample, size_t Np,
-    vtkSmartPointer<vtkCellArray> cells, vtkSmartPointer<vtkPoints> pnts, int numSelections = -1);
+  void addVariables(size_t numElements);
+  size_t getNumRowsToSample(size_t numLoadingRows);
+  void allocateOutput(vtkPoints* pnts, size_t numPoints);
+  void buildSpatialIndex();
+  void spatialSampling(vtkPoints* pnts, size_t& totalPointsProcessed);
+
+  // Parsing happens in two passes: threads first choose the rows to show, then each
+  // copies its rows to its own range of the output, given by the prefix sum of the
+  // number of rows chosen by the threads before it.
+  void parseRows(
+    size_t numRowsToSample, size_t numLoadingRows, vtkPoints* pnts, int numSelections = -1);
+  void parseRows(const std::vector<std::vector<size_t>>& rows, vtkPoints* pnts);
+  void theadedSampling(int threadId, int numThreads, size_t numRowsToSample, size_t Np,
+    int numSelections, std::vector<size_t>& rows);
+  void theadedParsing(const std::vector<size_t>& rows, vtkIdType offset, vtkPoints* pnts);
 
   void displayMsg(std::string msg);
 
@@ -168,11 +185,18 @@ private:
   int numRanks, myRank;
 
   // Threads
-  std::mutex mtx;
   int concurentThreadsSupported;
 
   // Sampling type
-  int sampleType; // 0:full data, 2:octree(unused) 3:selection
+  int sampleType; // 0:full data, 2:spatial 3:selection
+
+  // Spatial sampling
+  double spatialBounds[6]; // region to load, everything if empty
+  std::vector<GIOPvPlugin::spatialBlock> spatialIndex;
+  std::vector<size_t> spatialRowsRead; // rows already read from each spatial block
+  double spatialFraction;              // fraction of the rows read from each block
+  bool spatialCacheValid;
+  vtkSmartPointer<vtkUnstructuredGrid> spatialCache; // output of the last spatial update
 
   // Loading
   int percentageType; // 0:normal, 1:power cubelog
@@ -205,7 +229,7 @@ private:
   // Random numbers
   std::vector<size_t> _num;
   bool randomNumGenerated;
-  size_t nextHash;
+  std::atomic<size_t> nextHash;
 
   // data
   std::string dataFilename;
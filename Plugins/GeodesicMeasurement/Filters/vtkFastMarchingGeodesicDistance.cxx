@@ -23,6 +23,7 @@
 #include "vtkFastMarchingGeodesicDistance.h"
 
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCommand.h"
 #include "vtkExecutive.h"
 #include "vtkFloatArray.h"
@@ -31,13 +32,19 @@
 #include "vtkInformationVector.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 
 #include "gw_core/GW_Face.h"
 #include "gw_core/GW_Vertex.h"
 #include "gw_geodesic/GW_GeodesicMesh.h"
 #include "gw_geodesic/GW_GeodesicPath.h"
+#include <algorithm>
 #include <cassert>
 #include <set>
+#include <vector>
 
 #ifdef _WIN32
 // new is being defined to a new method that takes in 4 parameters.
@@ -61,6 +68,104 @@ public:
 
   ~vtkGeodesicMeshInternals() { delete this->Mesh; }
 
+  // Fill an empty GW_GeodesicMesh from the points and triangles of a
+  // vtkPolyData. Returns false if the polydata holds cells other than
+  // triangles. Does not modify the polydata, so several meshes may be built
+  // concurrently from the same one.
+  static bool BuildMesh(vtkPolyData* in, GW::GW_GeodesicMesh* mesh)
+  {
+    // Setup the mesh points
+    double pt[3];
+    vtkPoints* pts = in->GetPoints();
+    const int nPts = in->GetNumberOfPoints();
+
+    // Allocate vertices
+    mesh->SetNbrVertex(nPts);
+
+    // loop over the points and copy them over
+    for (int i = 0; i < nPts; i++)
+    {
+      pts->GetPoint(i, pt);
+      GW::GW_GeodesicVertex& point = (GW::GW_GeodesicVertex&)mesh->CreateNewVertex();
+      point.SetPosition(GW::GW_Vector3D(pt[0], pt[1], pt[2]));
+      mesh->SetVertex(i, &point);
+    }
+
+    vtkCellArray* cells = in->GetPolys();
+    if (!cells)
+    {
+      return true;
+    }
+
+    // Allocate number of cells
+    mesh->SetNbrFace(in->GetNumberOfPolys());
+
+    vtkIdType npts = 0;
+    const vtkIdType* ptIds = nullptr;
+    int i = 0;
+    auto iter = vtk::TakeSmartPointer(cells->NewIterator());
+    for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal(); iter->GoToNextCell(), ++i)
+    {
+      // Possible types
+      //    VTK_VERTEX, VTK_POLY_VERTEX, VTK_LINE,
+      //    VTK_POLY_LINE,VTK_TRIANGLE, VTK_QUAD,
+      //    VTK_POLYGON, or VTK_TRIANGLE_STRIP.
+
+      // only handle triangles
+      iter->GetCurrentCell(npts, ptIds);
+
+      // bail out if we encounter anything other than triangles
+      if (npts != 3)
+      {
+        return false;
+      }
+
+      // construct the face and add add it to our internal GeodesicMesh
+      GW::GW_GeodesicFace& cell = (GW::GW_GeodesicFace&)mesh->CreateNewFace();
+      GW::GW_Vertex* a = mesh->GetVertex(ptIds[0]);
+      GW::GW_Vertex* b = mesh->GetVertex(ptIds[1]);
+      GW::GW_Vertex* c = mesh->GetVertex(ptIds[2]);
+      cell.SetVertex(*a, *b, *c);
+      mesh->SetFace(i, &cell);
+    }
+
+    // Setup the neighborhood for each face prior to fast marching. Builds the
+    // inverse map vert -> face
+    mesh->BuildConnectivity();
+    return true;
+  }
+
+  // Returns false if the polydata holds cells other than triangles, as
+  // BuildMesh does, without building a mesh.
+  static bool IsTriangleMesh(vtkPolyData* in)
+  {
+    vtkCellArray* cells = in->GetPolys();
+    if (!cells)
+    {
+      return true;
+    }
+    vtkIdType npts = 0;
+    const vtkIdType* ptIds = nullptr;
+    auto iter = vtk::TakeSmartPointer(cells->NewIterator());
+    for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal(); iter->GoToNextCell())
+    {
+      iter->GetCurrentCell(npts, ptIds);
+      if (npts != 3)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Register the callbacks chosen by SetupCallbacks on a mesh
+  void RegisterCallbacks(GW::GW_GeodesicMesh* mesh) const
+  {
+    mesh->RegisterForceStopCallbackFunction(this->StopCallback);
+    mesh->RegisterVertexInsersionCallbackFunction(this->InsertionCallback);
+    mesh->RegisterWeightCallbackFunction(this->WeightCallback);
+  }
+
   // This callback is called every time a front vertex is visited to check
   // if we should terminate marching.
   static GW::GW_Bool FastMarchingStopCallback(GW::GW_GeodesicVertex& v, void* callbackData)
@@ -75,15 +180,8 @@ public:
     }
 
     // Stop if the vertex id is one of the destination vertices
-    if (filter->DestinationVertexStopCriterion->GetNumberOfIds())
-    {
-      if (filter->DestinationVertexStopCriterion->IsId(v.GetID()) != -1)
-      {
-        return true;
-      }
-    }
-
-    return false;
+    const std::vector<unsigned char>& destinations = filter->Internals->DestinationMask;
+    return v.GetID() < destinations.size() && destinations[v.GetID()];
   }
 
   // This callback is invoked prior to adding new vertices to the front
@@ -93,17 +191,9 @@ public:
     vtkFastMarchingGeodesicDistance* filter =
       static_cast<vtkFastMarchingGeodesicDistance*>(callbackData);
 
-    // Prevent bleeding into exclusion regions
-    if (filter->ExclusionPointIds->GetNumberOfIds())
-    {
-      if (filter->ExclusionPointIds->IsId(v.GetID()) != -1)
-      {
-        // do not add it.
-        return false;
-      }
-    }
-
-    return true;
+    // Prevent bleeding into exclusion regions. If excluded, do not add it.
+    const std::vector<unsigned char>& exclusions = filter->Internals->ExclusionMask;
+    return v.GetID() >= exclusions.size() || !exclusions[v.GetID()];
   }
 
   // This callback is invoked to get the propagation weight at a given vertex.
@@ -114,7 +204,7 @@ public:
     vtkFastMarchingGeodesicDistance* filter =
       static_cast<vtkFastMarchingGeodesicDistance*>(callbackData);
 
-    return (GW::GW_Float)filter->PropagationWeights->GetTuple1(v.GetID());
+    return (GW::GW_Float)filter->Internals->Weights[v.GetID()];
   }
 
   // This callback is invoked to get the propagation weight at a given vertex.
@@ -124,9 +214,157 @@ public:
     return 1.0;
   }
 
+  // A copy of the mesh owned by a thread, to march from several seeds
+  // concurrently. Copies of an instance start empty.
+  struct ThreadMesh
+  {
+    ThreadMesh() = default;
+    ThreadMesh(const ThreadMesh&) {}
+    ThreadMesh& operator=(const ThreadMesh&) = delete;
+    ~ThreadMesh() { delete this->Mesh; }
+
+    GW::GW_GeodesicMesh* Mesh = nullptr;
+    vtkMTimeType BuildTime = 0;
+  };
+
+  // Mesh used when marching from all the seeds at once. It is not built
+  // when ComputeDistancePerSeed is on.
   GW::GW_GeodesicMesh* Mesh;
+  GW::GW_U32 NumberOfVertices = 0;
+
+  // Geometry the meshes were last built from
+  vtkPoints* Points = nullptr;
+  vtkMTimeType PointsMTime = 0;
+  vtkCellArray* Polys = nullptr;
+  vtkMTimeType PolysMTime = 0;
+
+  // Meshes used by ComputeDistancesPerSeed, kept between executions
+  vtkSMPThreadLocal<ThreadMesh> ThreadMeshes;
+
+  // Per vertex flags for the exclusion and destination criteria, so that the
+  // callbacks do not have to search the id lists
+  std::vector<unsigned char> ExclusionMask;
+  std::vector<unsigned char> DestinationMask;
+
+  // Copy of the propagation weights, read concurrently by the meshes of
+  // ComputeDistancesPerSeed
+  std::vector<double> Weights;
+
+  GW::GW_GeodesicMesh::T_FastMarchingCallbackFunction StopCallback = nullptr;
+  GW::GW_GeodesicMesh::T_VertexInsersionCallbackFunction InsertionCallback = nullptr;
+  GW::GW_GeodesicMesh::T_WeightCallbackFunction WeightCallback = nullptr;
 };
 
+namespace
+{
+//-----------------------------------------------------------------------------
+// Marches from each seed separately, on a mesh per thread, and stores the
+// distance from the i-th seed in the i-th component of the distance field.
+class vtkSeedDistancesFunctor
+{
+public:
+  vtkSeedDistancesFunctor(vtkGeodesicMeshInternals* internals, vtkPolyData* input,
+    vtkMTimeType buildTime, vtkIdList* seeds, vtkFloatArray* distances, float notVisitedValue,
+    void* callbackData)
+    : Internals(internals)
+    , Input(input)
+    , BuildTime(buildTime)
+    , Seeds(seeds)
+    , Distances(distances)
+    , NotVisitedValue(notVisitedValue)
+    , CallbackData(callbackData)
+    , NumberOfPoints(input->GetNumberOfPoints())
+  {
+  }
+
+  void Initialize()
+  {
+    this->Visited.Local().assign(this->NumberOfPoints, 0);
+    this->MaximumDistance.Local() = 0;
+
+    vtkGeodesicMeshInternals::ThreadMesh& local = this->Internals->ThreadMeshes.Local();
+    if (!local.Mesh || local.BuildTime != this->BuildTime)
+    {
+      // The surface changed since this thread last built its mesh
+      delete local.Mesh;
+      local.Mesh = new GW::GW_GeodesicMesh();
+      local.Mesh->SetCallbackData(this->CallbackData);
+      vtkGeodesicMeshInternals::BuildMesh(this->Input, local.Mesh);
+      local.BuildTime = this->BuildTime;
+    }
+    this->Internals->RegisterCallbacks(local.Mesh);
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    GW::GW_GeodesicMesh* mesh = this->Internals->ThreadMeshes.Local().Mesh;
+    std::vector<unsigned char>& visited = this->Visited.Local();
+    float& maximumDistance = this->MaximumDistance.Local();
+    const int nComp = this->Distances ? this->Distances->GetNumberOfComponents() : 0;
+    float* distances = this->Distances ? this->Distances->GetPointer(0) : nullptr;
+
+    for (vtkIdType seedIdx = begin; seedIdx < end; ++seedIdx)
+    {
+      mesh->ResetGeodesicMesh();
+      mesh->AddStartVertex(
+        *((GW::GW_GeodesicVertex*)mesh->GetVertex((GW::GW_U32)(this->Seeds->GetId(seedIdx)))));
+      mesh->SetUpFastMarching();
+      while (!mesh->PerformFastMarchingOneStep())
+      {
+      }
+
+      for (vtkIdType i = 0; i < this->NumberOfPoints; i++)
+      {
+        GW::GW_GeodesicVertex* vertex = (GW::GW_GeodesicVertex*)(mesh->GetVertex((GW::GW_U32)i));
+        float distance = this->NotVisitedValue;
+        if (vertex->GetState() > 1)
+        {
+          distance = vertex->GetDistance();
+          visited[i] = 1;
+          maximumDistance = std::max(maximumDistance, distance);
+        }
+        if (distances)
+        {
+          distances[i * nComp + seedIdx] = distance;
+        }
+      }
+    }
+  }
+
+  void Reduce()
+  {
+    std::vector<unsigned char> visited(this->NumberOfPoints, 0);
+    for (const std::vector<unsigned char>& localVisited : this->Visited)
+    {
+      std::transform(visited.begin(), visited.end(), localVisited.begin(), visited.begin(),
+        [](unsigned char a, unsigned char b) { return a | b; });
+    }
+    this->NumberOfVisitedPoints = std::count(visited.begin(), visited.end(), 1);
+
+    this->MaximumDistanceResult = 0;
+    for (float localMaximum : this->MaximumDistance)
+    {
+      this->MaximumDistanceResult = std::max(this->MaximumDistanceResult, localMaximum);
+    }
+  }
+
+  vtkIdType NumberOfVisitedPoints = 0;
+  float MaximumDistanceResult = 0;
+
+private:
+  vtkGeodesicMeshInternals* Internals;
+  vtkPolyData* Input;
+  vtkMTimeType BuildTime;
+  vtkIdList* Seeds;
+  vtkFloatArray* Distances;
+  float NotVisitedValue;
+  void* CallbackData;
+  vtkIdType NumberOfPoints;
+  vtkSMPThreadLocal<std::vector<unsigned char>> Visited;
+  vtkSMPThreadLocal<float> MaximumDistance;
+};
+}
+
 //-----------------------------------------------------------------------------
 vtkFastMarchingGeodesicDistance::vtkFastMarchingGeodesicDistance()
 {
@@ -140,6 +378,7 @@ vtkFastMarchingGeodesicDistance::vtkFastMarchingGeodesicDistance()
   this->PropagationWeights = nullptr;
   this->IterationIndex = 0;
   this->FastMarchingIterationEventResolution = 100;
+  this->ComputeDistancePerSeed = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -174,10 +413,10 @@ int vtkFastMarchingGeodesicDistance::RequestData(vtkInformation* vtkNotUsed(requ
   output->ShallowCopy(input);
 
   // Initialize the GW_GeodesicMesh structure
-  this->SetupGeodesicMesh(input);
-
-  // Setup termination criteria, if any
-  this->SetupCallbacks();
+  if (!this->SetupGeodesicMesh(input))
+  {
+    return 0;
+  }
 
   // Extract seed point id list as points with non-zero values of a given field
   this->SetSeedsFromNonZeroField(this->GetInputArrayToProcess(0, input));
@@ -186,6 +425,15 @@ int vtkFastMarchingGeodesicDistance::RequestData(vtkInformation* vtkNotUsed(requ
   // uniform propagation weights
   this->SetPropagationWeights(this->GetInputArrayToProcess(1, input));
 
+  // Setup termination criteria and propagation weights, if any
+  this->SetupCallbacks();
+
+  if (this->ComputeDistancePerSeed)
+  {
+    // March from every seed separately, concurrently
+    return this->ComputeDistancesPerSeed(input, output);
+  }
+
   // Internally setup seeds for fast marching
   this->AddSeedsInternal();
 
@@ -199,93 +447,70 @@ int vtkFastMarchingGeodesicDistance::RequestData(vtkInformation* vtkNotUsed(requ
 }
 
 //-----------------------------------------------------------------------------
-void vtkFastMarchingGeodesicDistance::SetupGeodesicMesh(vtkPolyData* in)
+bool vtkFastMarchingGeodesicDistance::SetupGeodesicMesh(vtkPolyData* in)
 {
-  // If the input or the filter parameters have changed since the last
-  // execution, or we are running for the first time..
-  if (this->GeodesicMeshBuildTime.GetMTime() < in->GetMTime() || !this->Internals->Mesh)
+  // Only the points and the triangles are converted, so the mesh does not
+  // need to be rebuilt when anything else changes, such as the point data
+  // holding the seeds or the weights.
+  vtkGeodesicMeshInternals* internals = this->Internals;
+  vtkPoints* points = in->GetPoints();
+  vtkCellArray* polys = in->GetPolys();
+  const vtkMTimeType pointsMTime = points ? points->GetMTime() : 0;
+  const vtkMTimeType polysMTime = polys ? polys->GetMTime() : 0;
+
+  const bool changed = internals->Points != points || internals->PointsMTime != pointsMTime ||
+    internals->Polys != polys || internals->PolysMTime != polysMTime;
+
+  // If the surface has changed since the last execution, or we are running
+  // for the first time.. When marching from each seed, the meshes are built
+  // per thread by ComputeDistancesPerSeed, so only check the triangles.
+  if (changed || (!this->ComputeDistancePerSeed && !internals->Mesh))
   {
-    // Need to rebuild the GW_GeodesicMesh
-
-    if (!this->Internals->Mesh)
+    // Need to rebuild the GW_GeodesicMesh: delete the internal instance and
+    // re-populate
+    delete internals->Mesh;
+    internals->Mesh = nullptr;
+    internals->Points = nullptr;
+
+    bool valid;
+    if (this->ComputeDistancePerSeed)
     {
-      // Delete the internal instance and re-populate
-      delete this->Internals->Mesh;
-      this->Internals->Mesh = new GW::GW_GeodesicMesh();
-      this->Internals->Mesh->SetCallbackData(this);
+      valid = vtkGeodesicMeshInternals::IsTriangleMesh(in);
     }
-
-    // Setup the GW_GeodesicMesh mesh
-    GW::GW_GeodesicMesh* mesh = this->Internals->Mesh;
-
-    // Setup the mesh points
-    double pt[3];
-    vtkPoints* pts = in->GetPoints();
-    const int nPts = in->GetNumberOfPoints();
-
-    // Allocate vertices
-    mesh->SetNbrVertex(nPts);
-
-    // loop over the points and copy them over
-    for (int i = 0; i < nPts; i++)
+    else
     {
-      pts->GetPoint(i, pt);
-      GW::GW_GeodesicVertex& point = (GW::GW_GeodesicVertex&)mesh->CreateNewVertex();
-      point.SetPosition(GW::GW_Vector3D(pt[0], pt[1], pt[2]));
-      mesh->SetVertex(i, &point);
+      internals->Mesh = new GW::GW_GeodesicMesh();
+      internals->Mesh->SetCallbackData(this);
+      valid = vtkGeodesicMeshInternals::BuildMesh(in, internals->Mesh);
     }
-
-    vtkIdType npts = 0;
-    const vtkIdType* ptIds = nullptr;
-    const int nCells = in->GetNumberOfPolys();
-    vtkCellArray* cells = in->GetPolys();
-    if (!cells)
+    if (!valid)
     {
-      return;
+      vtkErrorMacro(<< "This filter works only with triangle meshes. Triangulate first.");
+      delete internals->Mesh;
+      internals->Mesh = nullptr;
+      return false;
     }
-    cells->InitTraversal();
 
-    // Allocate number of cells
-    mesh->SetNbrFace(nCells);
+    internals->NumberOfVertices = static_cast<GW::GW_U32>(in->GetNumberOfPoints());
+    internals->Points = points;
+    internals->PointsMTime = pointsMTime;
+    internals->Polys = polys;
+    internals->PolysMTime = polysMTime;
 
-    for (int i = 0; i < nCells; i++)
+    // Update timestamp, so that the meshes of ComputeDistancesPerSeed are
+    // rebuilt only when the surface changed
+    if (changed)
     {
-      // Possible types
-      //    VTK_VERTEX, VTK_POLY_VERTEX, VTK_LINE,
-      //    VTK_POLY_LINE,VTK_TRIANGLE, VTK_QUAD,
-      //    VTK_POLYGON, or VTK_TRIANGLE_STRIP.
-
-      // only handle triangles
-      cells->GetNextCell(npts, ptIds);
-
-      // bail out if we encounter anything other than triangles
-      if (npts != 3)
-      {
-        vtkErrorMacro(<< "This filter works only with triangle meshes. Triangulate first.");
-        delete this->Internals->Mesh;
-        this->Internals->Mesh = nullptr;
-        return;
-      }
-
-      // construct the face and add add it to our internal GeodesicMesh
-      GW::GW_GeodesicFace& cell = (GW::GW_GeodesicFace&)mesh->CreateNewFace();
-      GW::GW_Vertex* a = mesh->GetVertex(ptIds[0]);
-      GW::GW_Vertex* b = mesh->GetVertex(ptIds[1]);
-      GW::GW_Vertex* c = mesh->GetVertex(ptIds[2]);
-      cell.SetVertex(*a, *b, *c);
-      mesh->SetFace(i, &cell);
+      this->GeodesicMeshBuildTime.Modified();
     }
-
-    // Setup the neighborhood for each face prior to fast marching. Builds the
-    // inverse map vert -> face
-    mesh->BuildConnectivity();
-
-    // Update timestamp
-    this->GeodesicMeshBuildTime.Modified();
   }
 
   // Restart in preparation for fast marching
-  this->Internals->Mesh->ResetGeodesicMesh();
+  if (internals->Mesh)
+  {
+    internals->Mesh->ResetGeodesicMesh();
+  }
+  return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -349,6 +574,43 @@ int vtkFastMarchingGeodesicDistance::Compute()
   return 1;
 }
 
+//-----------------------------------------------------------------------------
+int vtkFastMarchingGeodesicDistance::ComputeDistancesPerSeed(vtkPolyData* input, vtkPolyData* pd)
+{
+  if (!this->Seeds || !this->Seeds->GetNumberOfIds())
+  {
+    vtkErrorMacro(<< "Please supply at least one seed.");
+    return 0;
+  }
+
+  const vtkIdType nSeeds = this->Seeds->GetNumberOfIds();
+  const vtkIdType nPts = input->GetNumberOfPoints();
+  for (vtkIdType i = 0; i < nSeeds; i++)
+  {
+    if (this->Seeds->GetId(i) < 0 || this->Seeds->GetId(i) >= nPts)
+    {
+      vtkErrorMacro(<< "Invalid seed point id " << this->Seeds->GetId(i) << ".");
+      return 0;
+    }
+  }
+
+  // get the field array to populate into, with a component per seed
+  vtkFloatArray* arr = this->GetGeodesicDistanceField(pd);
+  if (arr)
+  {
+    arr->SetNumberOfComponents(static_cast<int>(nSeeds));
+    arr->SetNumberOfTuples(nPts);
+  }
+
+  vtkSeedDistancesFunctor functor(this->Internals, input, this->GeodesicMeshBuildTime.GetMTime(),
+    this->Seeds, arr, this->NotVisitedValue, this);
+  vtkSMPTools::For(0, nSeeds, 1, functor);
+
+  this->MaximumDistance = functor.MaximumDistanceResult;
+  this->NumberOfVisitedPoints = functor.NumberOfVisitedPoints;
+  return 1;
+}
+
 //-----------------------------------------------------------------------------
 void vtkFastMarchingGeodesicDistance::CopyDistanceField(vtkPolyData* pd)
 {
@@ -412,52 +674,82 @@ void vtkFastMarchingGeodesicDistance::CopyDistanceField(vtkPolyData* pd)
 void vtkFastMarchingGeodesicDistance::SetupCallbacks()
 {
   // Setup various callbacks invoked during fast marching.
+  vtkGeodesicMeshInternals* internals = this->Internals;
+  const GW::GW_U32 nVerts = internals->NumberOfVertices;
+
+  // Flag the vertices of an id list, ignoring ids that are not on the mesh
+  auto fillMask = [nVerts](vtkIdList* ids, std::vector<unsigned char>& mask) {
+    mask.assign(nVerts, 0);
+    for (vtkIdType i = 0; i < ids->GetNumberOfIds(); i++)
+    {
+      const vtkIdType id = ids->GetId(i);
+      if (id >= 0 && static_cast<GW::GW_U32>(id) < nVerts)
+      {
+        mask[id] = 1;
+      }
+    }
+  };
 
   // Termination criteria. The ForceStopCallbackFunction is used to test if we
   // should end the fast marching or not.
   // We use this callback to check if a set of user defined destination
   // vertices have been reached, or if we've marched beyond a user specified
   // distance.
+  internals->DestinationMask.clear();
   if (this->DistanceStopCriterion > 0 ||
     (this->DestinationVertexStopCriterion &&
       this->DestinationVertexStopCriterion->GetNumberOfIds()))
   {
-    this->Internals->Mesh->RegisterForceStopCallbackFunction(
-      vtkGeodesicMeshInternals::FastMarchingStopCallback);
+    if (this->DestinationVertexStopCriterion)
+    {
+      fillMask(this->DestinationVertexStopCriterion, internals->DestinationMask);
+    }
+    internals->StopCallback = vtkGeodesicMeshInternals::FastMarchingStopCallback;
   }
   else
   {
-    this->Internals->Mesh->RegisterForceStopCallbackFunction(nullptr);
+    internals->StopCallback = nullptr;
   }
 
   // Setup callback prior to adding a new vertex into the front...
   // The VertexInsersionCallbackFunction is invoked prior to adding a new
   // vertex to the front. Here we check if the added vertices belong to the
   // "ExclusionPointIds".
+  internals->ExclusionMask.clear();
   if (this->ExclusionPointIds && this->ExclusionPointIds->GetNumberOfIds())
   {
-    this->Internals->Mesh->RegisterVertexInsersionCallbackFunction(
-      vtkGeodesicMeshInternals::FastMarchingVertexInsertionCallback);
+    fillMask(this->ExclusionPointIds, internals->ExclusionMask);
+    internals->InsertionCallback = vtkGeodesicMeshInternals::FastMarchingVertexInsertionCallback;
   }
   else
   {
-    this->Internals->Mesh->RegisterVertexInsersionCallbackFunction(nullptr);
+    internals->InsertionCallback = nullptr;
   }
 
   // Setup callback to get the propagation weights
   // The WeightCallbackFunction is used to define the metric on the mesh.
+  // The weights are copied so that the callback does not go through the
+  // vtkDataArray API, which is not safe to call from several threads.
+  internals->Weights.clear();
   if (this->PropagationWeights &&
-    static_cast<GW::GW_U32>(this->PropagationWeights->GetNumberOfTuples()) ==
-      this->Internals->Mesh->GetNbrVertex())
+    static_cast<GW::GW_U32>(this->PropagationWeights->GetNumberOfTuples()) == nVerts)
   {
-    this->Internals->Mesh->RegisterWeightCallbackFunction(
-      vtkGeodesicMeshInternals::FastMarchingPropagationWeightCallback);
+    internals->Weights.resize(nVerts);
+    for (GW::GW_U32 i = 0; i < nVerts; i++)
+    {
+      internals->Weights[i] = this->PropagationWeights->GetComponent(i, 0);
+    }
+    internals->WeightCallback = vtkGeodesicMeshInternals::FastMarchingPropagationWeightCallback;
   }
   else
   {
     // assumes uniform weight of 1.
-    this->Internals->Mesh->RegisterWeightCallbackFunction(
-      vtkGeodesicMeshInternals::FastMarchingPropagationNoWeightCallback);
+    internals->WeightCallback = vtkGeodesicMeshInternals::FastMarchingPropagationNoWeightCallback;
+  }
+
+  if (internals->Mesh)
+  {
+    internals->RegisterCallbacks(internals->Mesh);
   }
 }
 
@@ -496,5 +788,6 @@ void vtkFastMarchingGeodesicDistance::PrintSelf(ostream& os, vtkIndent indent)
      << "FastMarchingIterationEventResolution: " << this->FastMarchingIterationEventResolution
      << endl;
   os << indent << "IterationIndex: " << this->IterationIndex << endl;
+  os << indent << "ComputeDistancePerSeed: " << this->ComputeDistancePerSeed << endl;
   // GeodesicMeshBuildTime
 }
@@ -60,6 +60,19 @@
 // propagate quickly in regions of low curvature and slow down in regions of
 // high curvature. Note that the propagation weights must be strictly positive.
 //
+// .SECTION Distance per seed
+// By default, the distance field is the distance to the nearest seed,
+// computed by a single fast marching from all the seeds. When
+// ComputeDistancePerSeed is on, the fast marching is run from each seed
+// separately and concurrently, and the distance field has one component per
+// seed. Each thread marches on its own copy of the mesh, and the mesh used
+// by the single fast marching is not built.
+//
+// .SECTION Caching
+// The internal mesh is only rebuilt when the points or the triangles of the
+// input change, so changing the seeds, the criteria or the weights does not
+// require converting the input again.
+//
 // .SECTION Miscellaneous
 // The filter reports IterationEvents. It does not report progress events,
 // since its not possible to pre-determine when the front might terminate.
@@ -139,6 +152,16 @@ public:
   virtual void SetPropagationWeights(vtkDataArray*);
   vtkGetObjectMacro(PropagationWeights, vtkDataArray);
 
+  // Description:
+  // If on, compute the distance from each seed separately, as one component
+  // of the distance field per seed, instead of the distance to the nearest
+  // seed. Seeds are processed concurrently. The termination criteria,
+  // exclusion region and propagation weights apply to each seed. No
+  // IterationEvents are invoked in this mode. Off by default.
+  vtkSetMacro(ComputeDistancePerSeed, vtkTypeBool);
+  vtkGetMacro(ComputeDistancePerSeed, vtkTypeBool);
+  vtkBooleanMacro(ComputeDistancePerSeed, vtkTypeBool);
+
   // Description:
   // Events invoked by the filter
 
@@ -153,8 +176,10 @@ protected:
 
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
-  // Create GW_GeodesicMesh given an instance of a vtkPolyData
-  void SetupGeodesicMesh(vtkPolyData* in);
+  // Create GW_GeodesicMesh given an instance of a vtkPolyData, if its points
+  // or triangles changed. Only checks the triangles when
+  // ComputeDistancePerSeed is on. Returns false if it is not a triangle mesh.
+  bool SetupGeodesicMesh(vtkPolyData* in);
 
   // Setup the optional termination criteria, if set
   void SetupCallbacks();
@@ -171,6 +196,10 @@ protected:
   // Copy the resulting distance field from GeoMesh into the float array
   void CopyDistanceField(vtkPolyData* pd);
 
+  // Do the fast marching from each seed separately and store the distances
+  // in the components of the distance field of pd
+  int ComputeDistancesPerSeed(vtkPolyData* input, vtkPolyData* pd);
+
   // The internal GW_GeodsicMesh structure
   vtkGeodesicMeshInternals* Internals;
 
@@ -198,6 +227,9 @@ protected:
   // Propagation, ie speed function weights
   vtkDataArray* PropagationWeights;
 
+  // March from each seed separately
+  vtkTypeBool ComputeDistancePerSeed;
+
   friend class vtkFastMarchingGeodesicPath;
   friend class vtkGeodesicMeshInternals;
   void* GetGeodesicMesh();
@@ -36,6 +36,7 @@
 #include "vtkObject.h"
 
 #include <functional> // for std::function
+#include <vector>     // for std::vector
 
 class vtkDataArray;
 class vtkDoubleArray;
@@ -69,6 +70,17 @@ public:
    */
   virtual double GetValue() const = 0;
 
+  ///@{
+  /**
+   * Serialization of the accumulated data, used to merge accumulators living on different
+   * processes. Serialize appends the state of the accumulator to buffer. AddSerialized adds
+   * a state written by Serialize on an accumulator with the same parameters, as
+   * Add(vtkAbstractAccumulator*) would, and moves data past the values it read.
+   */
+  virtual void Serialize(std::vector<double>& buffer) const = 0;
+  virtual void AddSerialized(const double*& data) = 0;
+  ///@}
+
   virtual void DeepCopy(vtkObject*) {}
   virtual void ShallowCopy(vtkObject*) {}
   virtual void Initialize() {}
@@ -21,6 +21,7 @@
 #include "vtkObjectFactory.h"
 
 #include <cassert>
+#include <vector>
 
 vtkAbstractObjectFactoryNewMacro(vtkAbstractArrayMeasurement);
 
@@ -88,6 +89,30 @@ void vtkAbstractArrayMeasurement::Add(vtkAbstractArrayMeasurement* arrayMeasurem
   this->Modified();
 }
 
+//----------------------------------------------------------------------------
+void vtkAbstractArrayMeasurement::Serialize(std::vector<double>& buffer) const
+{
+  buffer.push_back(static_cast<double>(this->NumberOfAccumulatedData));
+  buffer.push_back(this->TotalWeight);
+  for (std::size_t i = 0; i < this->Accumulators.size(); ++i)
+  {
+    this->Accumulators[i]->Serialize(buffer);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkAbstractArrayMeasurement::AddSerialized(const double*& data)
+{
+  assert(this->Accumulators.size() && "Accumulators are not allocated");
+  this->NumberOfAccumulatedData += static_cast<vtkIdType>(*data++);
+  this->TotalWeight += *data++;
+  for (std::size_t i = 0; i < this->Accumulators.size(); ++i)
+  {
+    this->Accumulators[i]->AddSerialized(data);
+  }
+  this->Modified();
+}
+
 //----------------------------------------------------------------------------
 bool vtkAbstractArrayMeasurement::Measure(double& value)
 {
@@ -118,6 +118,19 @@ public:
    */
   virtual void Add(vtkAbstractArrayMeasurement* arrayMeasurement);
 
+  /**
+   * Appends the accumulated data to buffer, so it can be sent to another process.
+   */
+  virtual void Serialize(std::vector<double>& buffer) const;
+
+  /**
+   * Method used to add accumulated data written by Serialize on an instance of the same dynamic
+   * type, with the same parameters, as Add(vtkAbstractArrayMeasurement*) would.
+   *
+   * @param data points to the serialized data. It is moved past the values read.
+   */
+  virtual void AddSerialized(const double*& data);
+
   /**
    * Notifies if the accumulated data is suitable for measuring.
    * The second implementation aims to be able to dynamically tell whether accumulated data is fit
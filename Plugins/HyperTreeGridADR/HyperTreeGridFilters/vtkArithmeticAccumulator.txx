@@ -23,6 +23,7 @@
 
 #include <cassert>
 #include <functional>
+#include <vector>
 
 template <typename FunctorT>
 vtkStandardNewMacro(vtkArithmeticAccumulator<FunctorT>);
@@ -94,6 +95,21 @@ bool vtkArithmeticAccumulator<FunctorT>::HasSameParameters(
   return acc && this->Functor == acc->GetFunctor();
 }
 
+//----------------------------------------------------------------------------
+template <typename FunctorT>
+void vtkArithmeticAccumulator<FunctorT>::Serialize(std::vector<double>& buffer) const
+{
+  buffer.push_back(this->Value);
+}
+
+//----------------------------------------------------------------------------
+template <typename FunctorT>
+void vtkArithmeticAccumulator<FunctorT>::AddSerialized(const double*& data)
+{
+  this->Value += *data++;
+  this->Modified();
+}
+
 //----------------------------------------------------------------------------
 template <typename FunctorT>
 void vtkArithmeticAccumulator<FunctorT>::ShallowCopy(vtkObject* accumulator)
@@ -94,6 +94,14 @@ public:
    */
   bool HasSameParameters(vtkAbstractAccumulator* accumulator) const override;
 
+  ///@{
+  /**
+   * Serialization of the accumulated data, see vtkAbstractAccumulator::Serialize.
+   */
+  void Serialize(std::vector<double>& buffer) const override;
+  void AddSerialized(const double*& data) override;
+  ///@}
+
   ///@{
   /**
    * Accessor/mutator on the function pointer specifying which quantity should be computed on the
@@ -24,6 +24,7 @@
 #include <cassert>
 #include <memory>
 #include <string>
+#include <vector>
 
 template <typename FunctorT>
 vtkStandardNewMacro(vtkBinsAccumulator<FunctorT>);
@@ -155,6 +156,42 @@ bool vtkBinsAccumulator<FunctorT>::HasSameParameters(vtkAbstractAccumulator* acc
     this->Functor == acc->GetFunctor();
 }
 
+//----------------------------------------------------------------------------
+template <typename FunctorT>
+void vtkBinsAccumulator<FunctorT>::Serialize(std::vector<double>& buffer) const
+{
+  buffer.push_back(static_cast<double>(this->Bins->size()));
+  for (const auto& bin : *(this->Bins))
+  {
+    buffer.push_back(static_cast<double>(bin.first));
+    buffer.push_back(bin.second);
+  }
+}
+
+//----------------------------------------------------------------------------
+template <typename FunctorT>
+void vtkBinsAccumulator<FunctorT>::AddSerialized(const double*& data)
+{
+  const std::size_t numberOfBins = static_cast<std::size_t>(*data++);
+  for (std::size_t binId = 0; binId < numberOfBins; ++binId, data += 2)
+  {
+    const long long key = static_cast<long long>(data[0]);
+    auto it = this->Bins->find(key);
+    if (it == this->Bins->end())
+    {
+      (*this->Bins)[key] = data[1];
+      this->Value += this->Functor(data[1]);
+    }
+    else
+    {
+      this->Value -= this->Functor(it->second);
+      it->second += data[1];
+      this->Value += this->Functor(it->second);
+    }
+  }
+  this->Modified();
+}
+
 //----------------------------------------------------------------------------
 template <typename FunctorT>
 void vtkBinsAccumulator<FunctorT>::ShallowCopy(vtkObject* accumulator)
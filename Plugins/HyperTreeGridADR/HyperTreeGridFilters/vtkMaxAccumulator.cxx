@@ -21,6 +21,7 @@
 #include <algorithm>
 #include <cassert>
 #include <limits>
+#include <vector>
 
 vtkStandardNewMacro(vtkMaxAccumulator);
 
@@ -66,6 +67,19 @@ bool vtkMaxAccumulator::HasSameParameters(vtkAbstractAccumulator* accumulator) c
   return acc != nullptr;
 }
 
+//----------------------------------------------------------------------------
+void vtkMaxAccumulator::Serialize(std::vector<double>& buffer) const
+{
+  buffer.push_back(this->Value);
+}
+
+//----------------------------------------------------------------------------
+void vtkMaxAccumulator::AddSerialized(const double*& data)
+{
+  this->Value = std::max(*data++, this->Value);
+  this->Modified();
+}
+
 //----------------------------------------------------------------------------
 void vtkMaxAccumulator::ShallowCopy(vtkObject* accumulator)
 {
@@ -69,6 +69,14 @@ public:
    */
   bool HasSameParameters(vtkAbstractAccumulator* accumulator) const override;
 
+  ///@{
+  /**
+   * Serialization of the accumulated data, see vtkAbstractAccumulator::Serialize.
+   */
+  void Serialize(std::vector<double>& buffer) const override;
+  void AddSerialized(const double*& data) override;
+  ///@}
+
 protected:
   ///@{
   /**
@@ -15,6 +15,7 @@
 
 #include "vtkQuantileAccumulator.h"
 
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 
 #include <algorithm>
@@ -176,6 +177,40 @@ vtkQuantileAccumulator::ListElement::ListElement(double value, double weight)
 {
 }
 
+//----------------------------------------------------------------------------
+void vtkQuantileAccumulator::Serialize(std::vector<double>& buffer) const
+{
+  buffer.push_back(static_cast<double>(this->PercentileIdx));
+  buffer.push_back(this->TotalWeight);
+  buffer.push_back(this->PercentileWeight);
+  buffer.push_back(static_cast<double>(this->SortedList->size()));
+  for (const ListElement& element : *this->SortedList)
+  {
+    buffer.push_back(element.Value);
+    buffer.push_back(element.Weight);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkQuantileAccumulator::AddSerialized(const double*& data)
+{
+  // The serialized list is already sorted, we rebuild the accumulator it was written from
+  // and merge it.
+  vtkNew<vtkQuantileAccumulator> accumulator;
+  accumulator->Percentile = this->Percentile;
+  accumulator->PercentileIdx = static_cast<std::size_t>(data[0]);
+  accumulator->TotalWeight = data[1];
+  accumulator->PercentileWeight = data[2];
+  const std::size_t size = static_cast<std::size_t>(data[3]);
+  data += 4;
+  accumulator->SortedList->reserve(size);
+  for (std::size_t i = 0; i < size; ++i, data += 2)
+  {
+    accumulator->SortedList->emplace_back(data[0], data[1]);
+  }
+  this->Add(accumulator.GetPointer());
+}
+
 //----------------------------------------------------------------------------
 void vtkQuantileAccumulator::ShallowCopy(vtkObject* accumulator)
 {
@@ -0,0 +1,284 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkQuantileSketchAccumulator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkQuantileSketchAccumulator.h"
+
+#include "vtkMath.h"
+#include "vtkObjectFactory.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace
+{
+//----------------------------------------------------------------------------
+// Scale function of the t-digest: centroids may only span one unit of k, which
+// makes them small near q = 0 and q = 1.
+double QuantileToScale(double q, double compression)
+{
+  return compression / (2.0 * vtkMath::Pi()) * std::asin(2.0 * q - 1.0);
+}
+
+//----------------------------------------------------------------------------
+double ScaleToQuantile(double k, double compression)
+{
+  double angle = std::min(std::max(2.0 * vtkMath::Pi() * k / compression, -vtkMath::Pi() / 2.0),
+    vtkMath::Pi() / 2.0);
+  return 0.5 * (std::sin(angle) + 1.0);
+}
+}
+
+vtkStandardNewMacro(vtkQuantileSketchAccumulator);
+
+//----------------------------------------------------------------------------
+vtkQuantileSketchAccumulator::vtkQuantileSketchAccumulator()
+  : Percentile(50.0)
+  , Compression(100.0)
+  , TotalWeight(0.0)
+  , Min(std::numeric_limits<double>::infinity())
+  , Max(-std::numeric_limits<double>::infinity())
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkQuantileSketchAccumulator::Add(vtkAbstractAccumulator* accumulator)
+{
+  vtkQuantileSketchAccumulator* sketchAccumulator =
+    vtkQuantileSketchAccumulator::SafeDownCast(accumulator);
+  assert(sketchAccumulator && "Cannot accumulate different accumulators");
+
+  // Centroids of the other sketch are merged like weighted values.
+  this->Buffer.insert(this->Buffer.end(), sketchAccumulator->Centroids.cbegin(),
+    sketchAccumulator->Centroids.cend());
+  this->Buffer.insert(
+    this->Buffer.end(), sketchAccumulator->Buffer.cbegin(), sketchAccumulator->Buffer.cend());
+  this->TotalWeight += sketchAccumulator->TotalWeight;
+  this->Min = std::min(this->Min, sketchAccumulator->Min);
+  this->Max = std::max(this->Max, sketchAccumulator->Max);
+  if (this->Buffer.size() > 5 * this->Compression)
+  {
+    this->Compress();
+  }
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkQuantileSketchAccumulator::Add(double value, double weight)
+{
+  this->Buffer.push_back(Centroid{ value, weight });
+  this->TotalWeight += weight;
+  this->Min = std::min(this->Min, value);
+  this->Max = std::max(this->Max, value);
+  if (this->Buffer.size() > 5 * this->Compression)
+  {
+    this->Compress();
+  }
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkQuantileSketchAccumulator::Compress() const
+{
+  if (this->Buffer.empty())
+  {
+    return;
+  }
+
+  this->Buffer.insert(this->Buffer.end(), this->Centroids.cbegin(), this->Centroids.cend());
+  std::sort(this->Buffer.begin(), this->Buffer.end());
+
+  double totalWeight = 0.0;
+  for (const Centroid& centroid : this->Buffer)
+  {
+    totalWeight += centroid.Weight;
+  }
+
+  this->Centroids.clear();
+  Centroid current = this->Buffer[0];
+  double weightSoFar = 0.0;
+  double quantileLimit =
+    ScaleToQuantile(QuantileToScale(0.0, this->Compression) + 1.0, this->Compression);
+  for (std::size_t i = 1; i < this->Buffer.size(); ++i)
+  {
+    const Centroid& next = this->Buffer[i];
+    double q = (weightSoFar + current.Weight + next.Weight) / totalWeight;
+    if (q <= quantileLimit)
+    {
+      current.Weight += next.Weight;
+      current.Mean += (next.Mean - current.Mean) * next.Weight / current.Weight;
+    }
+    else
+    {
+      weightSoFar += current.Weight;
+      this->Centroids.push_back(current);
+      quantileLimit = ScaleToQuantile(
+        QuantileToScale(weightSoFar / totalWeight, this->Compression) + 1.0, this->Compression);
+      current = next;
+    }
+  }
+  this->Centroids.push_back(current);
+  this->Buffer.clear();
+}
+
+//----------------------------------------------------------------------------
+void vtkQuantileSketchAccumulator::Initialize()
+{
+  this->Centroids.clear();
+  this->Buffer.clear();
+  this->TotalWeight = 0.0;
+  this->Min = std::numeric_limits<double>::infinity();
+  this->Max = -std::numeric_limits<double>::infinity();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+const std::vector<vtkQuantileSketchAccumulator::Centroid>&
+vtkQuantileSketchAccumulator::GetCentroids() const
+{
+  this->Compress();
+  return this->Centroids;
+}
+
+//----------------------------------------------------------------------------
+double vtkQuantileSketchAccumulator::GetValue() const
+{
+  this->Compress();
+  if (this->Centroids.empty() || this->TotalWeight <= 0.0)
+  {
+    return 0.0;
+  }
+  if (this->Centroids.size() == 1)
+  {
+    return this->Centroids[0].Mean;
+  }
+
+  // Each centroid is considered to be centered on its mean: interpolate between the
+  // centers surrounding the target rank, and between the extremes and the first / last
+  // centroid at the tails.
+  const double target =
+    std::min(std::max(this->Percentile / 100.0, 0.0), 1.0) * this->TotalWeight;
+  const Centroid& first = this->Centroids.front();
+  if (target < first.Weight / 2.0)
+  {
+    return this->Min + (first.Mean - this->Min) * target / (first.Weight / 2.0);
+  }
+
+  double weightSoFar = 0.0;
+  for (std::size_t i = 0; i + 1 < this->Centroids.size(); ++i)
+  {
+    const Centroid& left = this->Centroids[i];
+    const Centroid& right = this->Centroids[i + 1];
+    double leftCenter = weightSoFar + left.Weight / 2.0;
+    double rightCenter = weightSoFar + left.Weight + right.Weight / 2.0;
+    if (target < rightCenter)
+    {
+      return left.Mean +
+        (right.Mean - left.Mean) * (target - leftCenter) / (rightCenter - leftCenter);
+    }
+    weightSoFar += left.Weight;
+  }
+
+  const Centroid& last = this->Centroids.back();
+  double lastCenter = this->TotalWeight - last.Weight / 2.0;
+  return last.Mean +
+    (this->Max - last.Mean) * std::min((target - lastCenter) / (last.Weight / 2.0), 1.0);
+}
+
+//----------------------------------------------------------------------------
+bool vtkQuantileSketchAccumulator::HasSameParameters(vtkAbstractAccumulator* accumulator) const
+{
+  vtkQuantileSketchAccumulator* sketchAccumulator =
+    vtkQuantileSketchAccumulator::SafeDownCast(accumulator);
+  return sketchAccumulator != nullptr &&
+    this->Percentile == sketchAccumulator->GetPercentile() &&
+    this->Compression == sketchAccumulator->GetCompression();
+}
+
+//----------------------------------------------------------------------------
+void vtkQuantileSketchAccumulator::Serialize(std::vector<double>& buffer) const
+{
+  this->Compress();
+  buffer.push_back(this->TotalWeight);
+  buffer.push_back(this->Min);
+  buffer.push_back(this->Max);
+  buffer.push_back(static_cast<double>(this->Centroids.size()));
+  for (const Centroid& centroid : this->Centroids)
+  {
+    buffer.push_back(centroid.Mean);
+    buffer.push_back(centroid.Weight);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkQuantileSketchAccumulator::AddSerialized(const double*& data)
+{
+  this->TotalWeight += data[0];
+  this->Min = std::min(this->Min, data[1]);
+  this->Max = std::max(this->Max, data[2]);
+  const std::size_t numberOfCentroids = static_cast<std::size_t>(data[3]);
+  data += 4;
+  for (std::size_t centroidId = 0; centroidId < numberOfCentroids; ++centroidId, data += 2)
+  {
+    this->Buffer.push_back(Centroid{ data[0], data[1] });
+  }
+  if (this->Buffer.size() > 5 * this->Compression)
+  {
+    this->Compress();
+  }
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkQuantileSketchAccumulator::ShallowCopy(vtkObject* accumulator)
+{
+  this->DeepCopy(accumulator);
+}
+
+//----------------------------------------------------------------------------
+void vtkQuantileSketchAccumulator::DeepCopy(vtkObject* accumulator)
+{
+  this->Superclass::DeepCopy(accumulator);
+  vtkQuantileSketchAccumulator* sketchAccumulator =
+    vtkQuantileSketchAccumulator::SafeDownCast(accumulator);
+  if (sketchAccumulator)
+  {
+    this->Centroids = sketchAccumulator->Centroids;
+    this->Buffer = sketchAccumulator->Buffer;
+    this->TotalWeight = sketchAccumulator->TotalWeight;
+    this->Min = sketchAccumulator->Min;
+    this->Max = sketchAccumulator->Max;
+    this->SetPercentile(sketchAccumulator->GetPercentile());
+    this->SetCompression(sketchAccumulator->GetCompression());
+  }
+  else
+  {
+    vtkWarningMacro(<< "Could not DeepCopy " << accumulator->GetClassName() << " to "
+                    << this->GetClassName());
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkQuantileSketchAccumulator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Percentile " << this->Percentile << std::endl;
+  os << indent << "Compression " << this->Compression << std::endl;
+  os << indent << "TotalWeight " << this->TotalWeight << std::endl;
+  os << indent << "Number of centroids " << this->Centroids.size() << std::endl;
+  os << indent << "Number of buffered values " << this->Buffer.size() << std::endl;
+}
@@ -0,0 +1,181 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkQuantileSketchAccumulator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+/**
+ * @class   vtkQuantileSketchAccumulator
+ * @brief   accumulates input data in a bounded size sketch to estimate quantiles
+ *
+ * Accumulator for estimating a quantile of the input data with bounded memory, as an
+ * alternative to vtkQuantileAccumulator which stores every input value. Values are summarized
+ * with a merging t-digest: a sorted list of centroids (mean and weight), where centroids are
+ * smaller near the extremes of the distribution than near the median.
+ *
+ * The number of centroids is bounded by the Compression parameter, independently of the input
+ * size, and values are buffered and merged into the centroids in batches. Inserting data has a
+ * constant amortized complexity and merging two accumulators has a linear complexity in
+ * Compression. The rank error of the estimated quantile is of the order of 1 / Compression,
+ * and smaller for percentiles close to 0 or 100.
+ *
+ * @sa vtkQuantileAccumulator
+ */
+
+#ifndef vtkQuantileSketchAccumulator_h
+#define vtkQuantileSketchAccumulator_h
+
+#include "vtkAbstractAccumulator.h"
+#include "vtkFiltersHyperTreeGridADRModule.h" // For export macro
+
+#include <vector> // for std::vector
+
+class vtkObject;
+
+class VTKFILTERSHYPERTREEGRIDADR_EXPORT vtkQuantileSketchAccumulator
+  : public vtkAbstractAccumulator
+{
+public:
+  static vtkQuantileSketchAccumulator* New();
+
+  vtkTypeMacro(vtkQuantileSketchAccumulator, vtkAbstractAccumulator);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  using Superclass::Add;
+
+  /**
+   * A centroid of the sketch, summarizing Weight values around Mean.
+   */
+  struct Centroid
+  {
+    double Mean;
+    double Weight;
+
+    bool operator<(const Centroid& other) const { return this->Mean < other.Mean; }
+  };
+
+  ///@{
+  /**
+   * Methods for adding data to the accumulator.
+   */
+  void Add(vtkAbstractAccumulator* accumulator) override;
+  void Add(double value, double weight = 1.0) override;
+  ///@}
+
+  /**
+   * Set object into initial state
+   */
+  void Initialize() override;
+
+  ///@{
+  /**
+   * Copy implementations. As the sketch has a bounded size, ShallowCopy copies it as well.
+   */
+  void ShallowCopy(vtkObject* accumulator) override;
+  void DeepCopy(vtkObject* accumulator) override;
+  ///@}
+
+  /**
+   * Returns true if the parameters of accumulator is the same as the ones of this
+   */
+  bool HasSameParameters(vtkAbstractAccumulator* accumulator) const override;
+
+  ///@{
+  /**
+   * Serialization of the accumulated data, see vtkAbstractAccumulator::Serialize.
+   */
+  void Serialize(std::vector<double>& buffer) const override;
+  void AddSerialized(const double*& data) override;
+  ///@}
+
+  /**
+   * Returns the estimate of the quantile at Percentile.
+   */
+  double GetValue() const override;
+
+  /**
+   * Returns the centroids of the sketch, sorted by mean. Values still buffered are merged first.
+   */
+  const std::vector<Centroid>& GetCentroids() const;
+
+  ///@{
+  /**
+   * Set / Get on the Percentile to compute.
+   */
+  vtkGetMacro(Percentile, double);
+  vtkSetMacro(Percentile, double);
+  ///@}
+
+  ///@{
+  /**
+   * Set / Get the compression of the sketch, which bounds its number of centroids. Higher values
+   * give more accurate estimates for more memory. Default is 100.
+   */
+  vtkGetMacro(Compression, double);
+  vtkSetClampMacro(Compression, double, 10.0, 10000.0);
+  ///@}
+
+  /**
+   * Getter for the total weight accumulated.
+   */
+  vtkGetMacro(TotalWeight, double);
+
+protected:
+  /**
+   * Default constructor and destructor.
+   */
+  vtkQuantileSketchAccumulator();
+  ~vtkQuantileSketchAccumulator() override = default;
+
+  /**
+   * Merges the buffered values into the centroids.
+   */
+  void Compress() const;
+
+  /**
+   * Percentile to compute.
+   */
+  double Percentile;
+
+  /**
+   * Compression of the sketch.
+   */
+  double Compression;
+
+  /**
+   * Accumulated weight though calls of vtkQuantileSketchAccumulator::Add.
+   */
+  double TotalWeight;
+
+  ///@{
+  /**
+   * Extreme values accumulated, used to interpolate the tails of the distribution.
+   */
+  double Min;
+  double Max;
+  ///@}
+
+  ///@{
+  /**
+   * Centroids of the sketch, and values (or centroids of merged sketches) not merged yet.
+   * Merging is deferred until needed, hence mutable.
+   */
+  mutable std::vector<Centroid> Centroids;
+  mutable std::vector<Centroid> Buffer;
+  ///@}
+
+private:
+  vtkQuantileSketchAccumulator(const vtkQuantileSketchAccumulator&) = delete;
+  void operator=(const vtkQuantileSketchAccumulator&) = delete;
+};
+
+#endif
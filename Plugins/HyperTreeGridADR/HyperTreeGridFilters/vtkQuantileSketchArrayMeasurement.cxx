@@ -0,0 +1,136 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkQuantileSketchArrayMeasurement.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkQuantileSketchArrayMeasurement.h"
+
+#include "vtkObjectFactory.h"
+#include "vtkQuantileSketchAccumulator.h"
+
+#include <cassert>
+
+vtkStandardNewMacro(vtkQuantileSketchArrayMeasurement);
+vtkArrayMeasurementMacro(vtkQuantileSketchArrayMeasurement);
+
+//----------------------------------------------------------------------------
+vtkQuantileSketchArrayMeasurement::vtkQuantileSketchArrayMeasurement()
+{
+  this->Accumulators = vtkQuantileSketchArrayMeasurement::NewAccumulators();
+}
+
+//----------------------------------------------------------------------------
+void vtkQuantileSketchArrayMeasurement::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+}
+
+//----------------------------------------------------------------------------
+bool vtkQuantileSketchArrayMeasurement::Measure(vtkAbstractAccumulator** accumulators,
+  vtkIdType numberOfAccumulatedData, double totalWeight, double& value)
+{
+  if (!vtkQuantileSketchArrayMeasurement::IsMeasurable(numberOfAccumulatedData, totalWeight))
+  {
+    return false;
+  }
+
+  assert(accumulators && "input accumulator is not allocated");
+
+  vtkQuantileSketchAccumulator* quantileAccumulator =
+    vtkQuantileSketchAccumulator::SafeDownCast(accumulators[0]);
+
+  assert(quantileAccumulator && "input accumulator is of wrong type");
+
+  value = quantileAccumulator->GetValue();
+  return true;
+}
+
+//----------------------------------------------------------------------------
+std::vector<vtkAbstractAccumulator*> vtkQuantileSketchArrayMeasurement::NewAccumulators()
+{
+  return std::vector<vtkAbstractAccumulator*>{ vtkQuantileSketchAccumulator::New() };
+}
+
+//----------------------------------------------------------------------------
+double vtkQuantileSketchArrayMeasurement::GetPercentile() const
+{
+  assert(this->Accumulators.size() && "Accumulators not set");
+  vtkQuantileSketchAccumulator* acc =
+    vtkQuantileSketchAccumulator::SafeDownCast(this->Accumulators[0]);
+  return acc->GetPercentile();
+}
+
+//----------------------------------------------------------------------------
+void vtkQuantileSketchArrayMeasurement::SetPercentile(double percentile)
+{
+  assert(this->Accumulators.size() && "Accumulators not set");
+  vtkQuantileSketchAccumulator* acc =
+    vtkQuantileSketchAccumulator::SafeDownCast(this->Accumulators[0]);
+  acc->SetPercentile(percentile);
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+double vtkQuantileSketchArrayMeasurement::GetCompression() const
+{
+  assert(this->Accumulators.size() && "Accumulators not set");
+  vtkQuantileSketchAccumulator* acc =
+    vtkQuantileSketchAccumulator::SafeDownCast(this->Accumulators[0]);
+  return acc->GetCompression();
+}
+
+//----------------------------------------------------------------------------
+void vtkQuantileSketchArrayMeasurement::SetCompression(double compression)
+{
+  assert(this->Accumulators.size() && "Accumulators not set");
+  vtkQuantileSketchAccumulator* acc =
+    vtkQuantileSketchAccumulator::SafeDownCast(this->Accumulators[0]);
+  acc->SetCompression(compression);
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkQuantileSketchArrayMeasurement::ShallowCopy(vtkObject* o)
+{
+  this->Superclass::ShallowCopy(o);
+  vtkQuantileSketchArrayMeasurement* quantileArrayMeasurement =
+    vtkQuantileSketchArrayMeasurement::SafeDownCast(o);
+  if (quantileArrayMeasurement)
+  {
+    this->SetPercentile(quantileArrayMeasurement->GetPercentile());
+    this->SetCompression(quantileArrayMeasurement->GetCompression());
+  }
+  else
+  {
+    vtkWarningMacro(<< "Trying to shallow copy a " << o->GetClassName()
+                    << " into a vtkQuantileSketchArrayMeasurement");
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkQuantileSketchArrayMeasurement::DeepCopy(vtkObject* o)
+{
+  this->Superclass::DeepCopy(o);
+  vtkQuantileSketchArrayMeasurement* quantileArrayMeasurement =
+    vtkQuantileSketchArrayMeasurement::SafeDownCast(o);
+  if (quantileArrayMeasurement)
+  {
+    this->SetPercentile(quantileArrayMeasurement->GetPercentile());
+    this->SetCompression(quantileArrayMeasurement->GetCompression());
+  }
+  else
+  {
+    vtkWarningMacro(<< "Trying to deep copy a " << o->GetClassName()
+                    << " into a vtkQuantileSketchArrayMeasurement");
+  }
+}
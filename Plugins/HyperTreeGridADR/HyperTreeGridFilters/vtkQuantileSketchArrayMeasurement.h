@@ -0,0 +1,155 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkQuantileSketchArrayMeasurement.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+/**
+ * @class   vtkQuantileSketchArrayMeasurement
+ * @brief   estimates the quantile of an array with bounded memory
+ *
+ * Estimates the quantile of an array, either by giving the full array,
+ * or by feeding value per value. The user sets the Percentile, which is not necessary an integer.
+ *
+ * Unlike vtkQuantileArrayMeasurement, which keeps every input value, values are summarized in
+ * a sketch (see vtkQuantileSketchAccumulator) whose size is bounded by Compression. Inserting
+ * has a constant amortized complexity, merging is linear in Compression and overall algorithm
+ * is linear in the input size. The rank error of the estimate is of the order of
+ * 1 / Compression.
+ *
+ * @note If one wants to compute the median, one should call
+ * vtkQuantileSketchArrayMeasurement::SetPercentile(50). If one wants to compute the first quartile
+ * instead, one should call vtkQuantileSketchArrayMeasurement::SetPercentile(25). etc.
+ *
+ * @sa vtkQuantileArrayMeasurement, vtkQuantileSketchAccumulator
+ */
+
+#ifndef vtkQuantileSketchArrayMeasurement_h
+#define vtkQuantileSketchArrayMeasurement_h
+
+#include "vtkAbstractArrayMeasurement.h"
+#include "vtkFiltersHyperTreeGridADRModule.h" // For export macro
+
+class VTKFILTERSHYPERTREEGRIDADR_EXPORT vtkQuantileSketchArrayMeasurement
+  : public vtkAbstractArrayMeasurement
+{
+public:
+  static vtkQuantileSketchArrayMeasurement* New();
+
+  vtkTypeMacro(vtkQuantileSketchArrayMeasurement, vtkAbstractArrayMeasurement);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  using Superclass::Add;
+  using Superclass::CanMeasure;
+  using Superclass::Measure;
+
+  /**
+   * Minimum times the function Add should be called on accumulators or this class
+   * in order to measure something.
+   */
+  static constexpr vtkIdType MinimumNumberOfAccumulatedData = 1;
+
+  /**
+   * Number of accumulators required for measuring.
+   */
+  static constexpr vtkIdType NumberOfAccumulators = 1;
+
+  /**
+   * Notifies if the quantile can be measured given the amount of input data.
+   * The quantile needs at least one accumulated data with non-zero weight.
+   *
+   * @param numberOfAccumulatedData is the number of times Add was called in the accumulators / this
+   * class
+   * @param totalWeight is the accumulated weight while accumulated. If weights were not set when
+   * accumulated, it should be equal to numberOfAccumulatedData.
+   * @return true if there is enough data and if totalWeight != 0, false otherwise.
+   */
+  static bool IsMeasurable(vtkIdType numberOfAccumulatedData, double totalWeight);
+
+  /**
+   * Instantiates needed accumulators for measurement, i.e. one vtkQuantileSketchAccumulator*
+   * in our case.
+   *
+   * @return the array {vtkQuantileSketchAccumulator::New()}.
+   */
+  static std::vector<vtkAbstractAccumulator*> NewAccumulators();
+
+  /**
+   * Computes the quantile of the set of accumulators needed (i.e. one
+   * vtkQuantileSketchAccumulator*).
+   *
+   * @param accumulators is an array of accumulators. It should be composed of a single
+   * vtkQuantileSketchAccumulator*.
+   * @param numberOfAccumulatedData is the number of times the method Add was called in the
+   * accumulators.
+   * @param totalWeight is the cumulated weight when adding data. If weight was not set while
+   * accumulating. it should equal numberOfAccumulatedData.
+   * @param value is where the quantile measurement is written into.
+   * @return true if the data is measurable i.e. there is not enough data or totalWeight is null.
+   */
+  bool Measure(vtkAbstractAccumulator** accumulators, vtkIdType numberOfAccumulatedData,
+    double totalWeight, double& value) override;
+
+  ///@{
+  /**
+   * See the vtkAbstractArrayMeasurement API for description of this method.
+   */
+  bool CanMeasure(vtkIdType numberOfAccumulatedData, double totalWeight) const override;
+  std::vector<vtkAbstractAccumulator*> NewAccumulatorInstances() const override;
+  vtkIdType GetMinimumNumberOfAccumulatedData() const override;
+  vtkIdType GetNumberOfAccumulators() const override;
+  ///@}
+
+  /**
+   * ShallowCopy implementation.
+   */
+  void ShallowCopy(vtkObject* o) override;
+
+  /**
+   * DeepCopy implementation.
+   */
+  void DeepCopy(vtkObject* o) override;
+
+  ///@{
+  /**
+   * Set/Get macros to Percentile to measure. Note that it does not need to be an integer.
+   *
+   * @note Setting Percentile to 50 is equivalent with computing the median.
+   */
+  double GetPercentile() const;
+  void SetPercentile(double percentile);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the compression of the sketch. Higher values give more accurate estimates for
+   * more memory. Default is 100.
+   */
+  double GetCompression() const;
+  void SetCompression(double compression);
+  ///@}
+
+protected:
+  ///@{
+  /**
+   * Default constructors and destructors
+   */
+  vtkQuantileSketchArrayMeasurement();
+  ~vtkQuantileSketchArrayMeasurement() override = default;
+  ///@}
+
+private:
+  vtkQuantileSketchArrayMeasurement(const vtkQuantileSketchArrayMeasurement&) = delete;
+  void operator=(const vtkQuantileSketchArrayMeasurement&) = delete;
+};
+
+#endif
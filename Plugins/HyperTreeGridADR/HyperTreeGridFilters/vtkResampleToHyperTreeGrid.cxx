@@ -51,6 +51,7 @@
 #include "vtkPoints.h"
 #include "vtkPolygon.h"
 #include "vtkRedistributeDataSetFilter.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTuple.h"
 #include "vtkUnsignedCharArray.h"
@@ -61,6 +62,7 @@
 #include <cmath>
 #include <cstring>
 #include <limits>
+#include <numeric>
 #include <set>
 #include <vector>
 
@@ -84,6 +86,7 @@ vtkResampleToHyperTreeGrid::vtkResampleToHyperTreeGrid()
   this->InRange = true;
   this->NoEmptyCells = false;
   this->Extrapolate = true;
+  this->ExchangePartialStatistics = false;
 
   this->Controller = nullptr;
   this->SetController(vtkMultiProcessController::GetGlobalController());
@@ -109,6 +112,8 @@ void vtkResampleToHyperTreeGrid::PrintSelf(ostream& os, vtkIndent indent)
      << std::endl;
   os << indent << "MaxDepth: " << this->MaxDepth << std::endl;
   os << indent << "NoEmptyCells (boolean): " << this->NoEmptyCells << std::endl;
+  os << indent << "ExchangePartialStatistics (boolean): " << this->ExchangePartialStatistics
+     << std::endl;
   os << indent << "BranchFactor: " << this->BranchFactor << std::endl;
   os << indent << "MaxResolutionPerTree: " << this->MaxResolutionPerTree << std::endl;
 
@@ -204,9 +209,16 @@ int vtkResampleToHyperTreeGrid::RequestData(
     return 0;
   }
 
-  vtkSmartPointer<vtkDataObject> redistributedInputDO = numberOfProcesses > 1
-    ? (this->BroadcastHyperTreeOwnership(inputDO, processId))
-    : vtkSmartPointer<vtkDataObject>(inputDO);
+  vtkSmartPointer<vtkDataObject> redistributedInputDO = inputDO;
+  if (numberOfProcesses > 1 && this->ExchangePartialStatistics)
+  {
+    // Each process resamples its own points, partial statistics are merged afterwards.
+    this->AllReduceBounds();
+  }
+  else if (numberOfProcesses > 1)
+  {
+    redistributedInputDO = this->BroadcastHyperTreeOwnership(inputDO, processId);
+  }
 
   std::vector<vtkDataSet*> inputs = vtkCompositeDataSet::GetDataSets(redistributedInputDO);
 
@@ -378,6 +390,7 @@ int vtkResampleToHyperTreeGrid::RequestData(
   this->InputPointDataArrays.clear();
 
   this->LocalHyperTreeBoundingBox.clear();
+  this->HyperTreeOwners.clear();
 
   // Avoid keeping extra memory around.
   output->Squeeze();
@@ -413,12 +426,10 @@ vtkResampleToHyperTreeGrid::GridElement::~GridElement()
 }
 
 //----------------------------------------------------------------------------
-vtkSmartPointer<vtkDataObject> vtkResampleToHyperTreeGrid::BroadcastHyperTreeOwnership(
-  vtkDataObject* inputDO, vtkIdType processId)
+void vtkResampleToHyperTreeGrid::AllReduceBounds()
 {
-  double pt[3],
-    localBounds[6] = { -this->Bounds[0], this->Bounds[1], -this->Bounds[2], this->Bounds[3],
-      -this->Bounds[4], this->Bounds[5] };
+  double localBounds[6] = { -this->Bounds[0], this->Bounds[1], -this->Bounds[2], this->Bounds[3],
+    -this->Bounds[4], this->Bounds[5] };
   if (!vtkBoundingBox(this->Bounds).IsValid())
   {
     localBounds[0] = -std::numeric_limits<double>::infinity();
@@ -432,6 +443,14 @@ vtkSmartPointer<vtkDataObject> vtkResampleToHyperTreeGrid::BroadcastHyperTreeOwn
   this->Bounds[0] = -this->Bounds[0];
   this->Bounds[2] = -this->Bounds[2];
   this->Bounds[4] = -this->Bounds[4];
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkResampleToHyperTreeGrid::BroadcastHyperTreeOwnership(
+  vtkDataObject* inputDO, vtkIdType processId)
+{
+  double pt[3];
+  this->AllReduceBounds();
 
   double boundsEpsilon[3] = { std::max(std::fabs(this->Bounds[0]), std::fabs(this->Bounds[1])) *
       VTK_DBL_EPSILON,
@@ -552,6 +571,143 @@ vtkSmartPointer<vtkDataObject> vtkResampleToHyperTreeGrid::BroadcastHyperTreeOwn
   return redistributeFilter->GetOutputDataObject(0);
 }
 
+//----------------------------------------------------------------------------
+void vtkResampleToHyperTreeGrid::ReducePartialStatistics()
+{
+  const int numberOfProcesses = this->Controller->GetNumberOfProcesses();
+  const int processId = this->Controller->GetLocalProcessId();
+  const vtkIdType numberOfTrees = static_cast<vtkIdType>(this->GridOfMultiResolutionGrids.size());
+
+  // The process having the most points in one hyper tree owns this hyper tree. If 2 or more
+  // processes have the same number of points, the process of highest rank owns the hyper tree.
+  std::vector<vtkIdType> localNumberOfPointsPerTree(numberOfTrees, 0),
+    maxNumberOfPointsPerTree(numberOfTrees);
+  for (vtkIdType treeIdx = 0; treeIdx < numberOfTrees; ++treeIdx)
+  {
+    for (const auto& grid : this->GridOfMultiResolutionGrids[treeIdx])
+    {
+      for (const auto& mapElement : grid)
+      {
+        localNumberOfPointsPerTree[treeIdx] += mapElement.second.NumberOfPointsInSubtree;
+      }
+    }
+  }
+  this->Controller->AllReduce(localNumberOfPointsPerTree.data(), maxNumberOfPointsPerTree.data(),
+    numberOfTrees, vtkCommunicator::MAX_OP);
+
+  std::vector<int> localOwners(numberOfTrees, -1);
+  for (vtkIdType treeIdx = 0; treeIdx < numberOfTrees; ++treeIdx)
+  {
+    if (localNumberOfPointsPerTree[treeIdx] &&
+      localNumberOfPointsPerTree[treeIdx] == maxNumberOfPointsPerTree[treeIdx])
+    {
+      localOwners[treeIdx] = processId;
+    }
+  }
+  this->HyperTreeOwners.resize(numberOfTrees);
+  this->Controller->AllReduce(
+    localOwners.data(), this->HyperTreeOwners.data(), numberOfTrees, vtkCommunicator::MAX_OP);
+
+  // The grid elements of the trees owned by other processes are serialized as
+  // (tree, depth, index, number of points, weight, measurements...), and removed locally.
+  std::vector<std::vector<double>> sendBuffers(numberOfProcesses);
+  for (vtkIdType treeIdx = 0; treeIdx < numberOfTrees; ++treeIdx)
+  {
+    const int owner = this->HyperTreeOwners[treeIdx];
+    if (owner == processId || owner < 0)
+    {
+      continue;
+    }
+    std::vector<double>& buffer = sendBuffers[owner];
+    MultiResGridType& multiResolutionGrid = this->GridOfMultiResolutionGrids[treeIdx];
+    for (std::size_t depth = 0; depth < multiResolutionGrid.size(); ++depth)
+    {
+      for (const auto& mapElement : multiResolutionGrid[depth])
+      {
+        buffer.push_back(static_cast<double>(treeIdx));
+        buffer.push_back(static_cast<double>(depth));
+        buffer.push_back(static_cast<double>(mapElement.first));
+        buffer.push_back(static_cast<double>(mapElement.second.NumberOfPointsInSubtree));
+        buffer.push_back(mapElement.second.AccumulatedWeight);
+        for (const auto& arrayMeasurement : mapElement.second.ArrayMeasurements)
+        {
+          arrayMeasurement->Serialize(buffer);
+        }
+      }
+      multiResolutionGrid[depth].clear();
+    }
+  }
+
+  std::vector<vtkIdType> sendLengths(numberOfProcesses),
+    lengths(numberOfProcesses * numberOfProcesses);
+  for (int destId = 0; destId < numberOfProcesses; ++destId)
+  {
+    sendLengths[destId] = static_cast<vtkIdType>(sendBuffers[destId].size());
+  }
+  this->Controller->AllGather(sendLengths.data(), lengths.data(), numberOfProcesses);
+
+  // Each process gathers the partial statistics of the trees it owns. Processes to which nothing
+  // is sent are skipped.
+  for (int destId = 0; destId < numberOfProcesses; ++destId)
+  {
+    std::vector<vtkIdType> recvLengths(numberOfProcesses), offsets(numberOfProcesses, 0);
+    for (int sourceId = 0; sourceId < numberOfProcesses; ++sourceId)
+    {
+      recvLengths[sourceId] = lengths[sourceId * numberOfProcesses + destId];
+    }
+    std::partial_sum(recvLengths.begin(), recvLengths.end() - 1, offsets.begin() + 1);
+    const vtkIdType totalLength = offsets.back() + recvLengths.back();
+    if (!totalLength)
+    {
+      continue;
+    }
+
+    std::vector<double> recvBuffer(destId == processId ? totalLength : 0);
+    this->Controller->GatherV(sendBuffers[destId].data(), recvBuffer.data(),
+      sendLengths[destId], recvLengths.data(), offsets.data(), destId);
+    sendBuffers[destId] = std::vector<double>();
+
+    const double* data = recvBuffer.data();
+    const double* end = data + recvBuffer.size();
+    while (data != end)
+    {
+      const std::size_t treeIdx = static_cast<std::size_t>(data[0]);
+      const std::size_t depth = static_cast<std::size_t>(data[1]);
+      const vtkIdType idx = static_cast<vtkIdType>(data[2]);
+      const vtkIdType numberOfPoints = static_cast<vtkIdType>(data[3]);
+      const double weight = data[4];
+      data += 5;
+
+      auto& grid = this->GridOfMultiResolutionGrids[treeIdx][depth];
+      auto it = grid.find(idx);
+      if (it == grid.end())
+      {
+        GridElement& element = grid[idx];
+        element.NumberOfLeavesInSubtree = 1;
+        element.NumberOfPointsInSubtree = numberOfPoints;
+        element.AccumulatedWeight = weight;
+        element.UnmaskedChildrenHaveNoMaskedLeaves = true;
+        for (std::size_t l = 0; l < this->ArrayMeasurements.size(); ++l)
+        {
+          element.ArrayMeasurements.emplace_back(vtkSmartPointer<vtkAbstractArrayMeasurement>::Take(
+            this->ArrayMeasurements[l]->NewInstance()));
+          element.ArrayMeasurements[l]->DeepCopy(this->ArrayMeasurements[l]);
+          element.ArrayMeasurements[l]->AddSerialized(data);
+        }
+      }
+      else
+      {
+        it->second.NumberOfPointsInSubtree += numberOfPoints;
+        it->second.AccumulatedWeight += weight;
+        for (std::size_t l = 0; l < this->ArrayMeasurements.size(); ++l)
+        {
+          it->second.ArrayMeasurements[l]->AddSerialized(data);
+        }
+      }
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 bool vtkResampleToHyperTreeGrid::IntersectedVolume(
   const double boxBounds[6], vtkVoxel* voxel, double volumeUnit, double& volume) const
@@ -1002,6 +1158,59 @@ bool vtkResampleToHyperTreeGrid::IntersectedVolume(const double bboxBounds[6], v
   return volume >= VTK_DBL_EPSILON;
 }
 
+//----------------------------------------------------------------------------
+bool vtkResampleToHyperTreeGrid::LocatePoint(
+  const double point[3], vtkIdType& gridIdx, vtkIdType& idx) const
+{
+  if (!this->LocalHyperTreeBoundingBox.empty())
+  {
+    // Checking if the considered point is in bounds, i.e. is owned by this process
+    vtkIdType bidx = -1;
+    while (static_cast<std::size_t>(++bidx) != this->LocalHyperTreeBoundingBox.size() &&
+      (this->LocalHyperTreeBoundingBox[bidx].GetBound(0) > point[0] ||
+        this->LocalHyperTreeBoundingBox[bidx].GetBound(1) < point[0] ||
+        this->LocalHyperTreeBoundingBox[bidx].GetBound(2) > point[1] ||
+        this->LocalHyperTreeBoundingBox[bidx].GetBound(3) < point[1] ||
+        this->LocalHyperTreeBoundingBox[bidx].GetBound(4) > point[2] ||
+        this->LocalHyperTreeBoundingBox[bidx].GetBound(5) < point[2]))
+    {
+    }
+    if (static_cast<std::size_t>(bidx) == this->LocalHyperTreeBoundingBox.size())
+    {
+      return false;
+    }
+  }
+
+  // (i, j, k) are the coordinates of the point in the grid at highest resolution
+  vtkIdType i = this->CellDims[0] == 1
+    ? 0
+    : std::floor<vtkIdType>(
+        std::min<double>((point[0] - this->Bounds[0]) / (this->Bounds[1] - this->Bounds[0]) *
+            this->CellDims[0] * this->MaxResolutionPerTree,
+          this->MaxResolutionPerTree * this->CellDims[0] - 1)),
+            j = this->CellDims[1] == 1
+    ? 0
+    : std::floor<vtkIdType>(
+        std::min<double>((point[1] - this->Bounds[2]) / (this->Bounds[3] - this->Bounds[2]) *
+            this->CellDims[1] * this->MaxResolutionPerTree,
+          this->MaxResolutionPerTree * this->CellDims[1] - 1)),
+            k = this->CellDims[2] == 1
+    ? 0
+    : std::floor<vtkIdType>(
+        std::min<double>((point[2] - this->Bounds[4]) / (this->Bounds[5] - this->Bounds[4]) *
+            this->CellDims[2] * this->MaxResolutionPerTree,
+          this->MaxResolutionPerTree * this->CellDims[2] - 1));
+
+  // We bijectively convert the local coordinates within a hyper tree grid to an integer to pass
+  // it to the std::unordered_map at highest resolution
+  idx = this->MultiResGridCoordinatesToIndex(i % this->MaxResolutionPerTree,
+    j % this->MaxResolutionPerTree, k % this->MaxResolutionPerTree, this->MaxDepth);
+
+  gridIdx = this->GridCoordinatesToIndex(
+    i / this->MaxResolutionPerTree, j / this->MaxResolutionPerTree, k / this->MaxResolutionPerTree);
+  return true;
+}
+
 //----------------------------------------------------------------------------
 void vtkResampleToHyperTreeGrid::CreateGridOfMultiResolutionGrids(
   std::vector<vtkDataSet*>& dataSets, int fieldAssociation)
@@ -1023,93 +1232,113 @@ void vtkResampleToHyperTreeGrid::CreateGridOfMultiResolutionGrids(
     // First pass, we fill the highest resolution grid with input values
     if (fieldAssociation == vtkDataObject::FIELD_ASSOCIATION_POINTS)
     {
-      for (vtkIdType pointId = 0; pointId < dataSet->GetNumberOfPoints(); ++pointId)
+      const vtkIdType numberOfPoints = dataSet->GetNumberOfPoints();
+      const vtkIdType numberOfTrees =
+        static_cast<vtkIdType>(this->GridOfMultiResolutionGrids.size());
+
+      // Points are located in parallel, then sorted by hyper tree so that each tree is filled by
+      // only one thread. A tree receives its points in increasing order, as in a serial pass.
+      std::vector<vtkIdType> treeOfPoint(numberOfPoints);
+      if (numberOfPoints)
       {
-        double* point = dataSet->GetPoint(pointId);
-        // (i, j, k) are the coordinates of the corresponding hyper tree
-
-        if (!this->LocalHyperTreeBoundingBox.empty())
+        // vtkDataSet::GetPoint is thread safe once it has been called from a single thread.
+        double point[3];
+        dataSet->GetPoint(0, point);
+      }
+      vtkSMPTools::For(0, numberOfPoints, [&](vtkIdType begin, vtkIdType end) {
+        double point[3];
+        vtkIdType idx;
+        for (vtkIdType pointId = begin; pointId < end; ++pointId)
         {
-          // Checking if the considered point is in bounds, i.e. is owned by this process
-          vtkIdType bidx = -1;
-          while (static_cast<std::size_t>(++bidx) != this->LocalHyperTreeBoundingBox.size() &&
-            (this->LocalHyperTreeBoundingBox[bidx].GetBound(0) > point[0] ||
-              this->LocalHyperTreeBoundingBox[bidx].GetBound(1) < point[0] ||
-              this->LocalHyperTreeBoundingBox[bidx].GetBound(2) > point[1] ||
-              this->LocalHyperTreeBoundingBox[bidx].GetBound(3) < point[1] ||
-              this->LocalHyperTreeBoundingBox[bidx].GetBound(4) > point[2] ||
-              this->LocalHyperTreeBoundingBox[bidx].GetBound(5) < point[2]))
+          dataSet->GetPoint(pointId, point);
+          if (!this->LocatePoint(point, treeOfPoint[pointId], idx))
           {
-          }
-          if (static_cast<std::size_t>(bidx) == this->LocalHyperTreeBoundingBox.size())
-          {
-            continue;
+            treeOfPoint[pointId] = -1;
           }
         }
+      });
 
-        vtkIdType i = this->CellDims[0] == 1
-          ? 0
-          : std::floor<vtkIdType>(
-              std::min<double>((point[0] - this->Bounds[0]) / (this->Bounds[1] - this->Bounds[0]) *
-                  this->CellDims[0] * this->MaxResolutionPerTree,
-                this->MaxResolutionPerTree * this->CellDims[0] - 1)),
-                  j = this->CellDims[1] == 1
-          ? 0
-          : std::floor<vtkIdType>(
-              std::min<double>((point[1] - this->Bounds[2]) / (this->Bounds[3] - this->Bounds[2]) *
-                  this->CellDims[1] * this->MaxResolutionPerTree,
-                this->MaxResolutionPerTree * this->CellDims[1] - 1)),
-                  k = this->CellDims[2] == 1
-          ? 0
-          : std::floor<vtkIdType>(
-              std::min<double>((point[2] - this->Bounds[4]) / (this->Bounds[5] - this->Bounds[4]) *
-                  this->CellDims[2] * this->MaxResolutionPerTree,
-                this->MaxResolutionPerTree * this->CellDims[2] - 1));
-
-        // We bijectively convert the local coordinates within a hyper tree grid to an integer to
-        // pass
-        // it to the std::unordered_map at highest resolution
-        vtkIdType idx = this->MultiResGridCoordinatesToIndex(i % this->MaxResolutionPerTree,
-          j % this->MaxResolutionPerTree, k % this->MaxResolutionPerTree, this->MaxDepth);
-
-        vtkIdType gridIdx = this->GridCoordinatesToIndex(i / this->MaxResolutionPerTree,
-          j / this->MaxResolutionPerTree, k / this->MaxResolutionPerTree);
-
-        auto& grid = this->GridOfMultiResolutionGrids[gridIdx][this->MaxDepth];
-
-        auto it = grid.find(idx);
-        // if this is the first time we pass by this grid location, we create a new ArrayMeasurement
-        // instance
-        // NOTE: GridElement::CanSubdivide does not need to be set at the highest resolution
-        if (it == grid.end())
+      std::vector<vtkIdType> treeOffsets(numberOfTrees + 1, 0);
+      for (vtkIdType pointId = 0; pointId < numberOfPoints; ++pointId)
+      {
+        if (treeOfPoint[pointId] >= 0)
         {
-          GridElement& element = grid[idx];
-          element.NumberOfLeavesInSubtree = 1;
-          element.NumberOfPointsInSubtree = 1;
-          element.AccumulatedWeight = 1.0;
-          element.UnmaskedChildrenHaveNoMaskedLeaves = true;
-          for (std::size_t l = 0; l < this->ArrayMeasurements.size(); ++l)
+          ++treeOffsets[treeOfPoint[pointId] + 1];
+        }
+      }
+      std::partial_sum(treeOffsets.begin(), treeOffsets.end(), treeOffsets.begin());
+      std::vector<vtkIdType> sortedPointIds(treeOffsets.back());
+      {
+        std::vector<vtkIdType> nextPointIdx(treeOffsets.begin(), treeOffsets.end() - 1);
+        for (vtkIdType pointId = 0; pointId < numberOfPoints; ++pointId)
+        {
+          if (treeOfPoint[pointId] >= 0)
           {
-            element.ArrayMeasurements.emplace_back(
-              vtkSmartPointer<vtkAbstractArrayMeasurement>::Take(
-                this->ArrayMeasurements[l]->NewInstance()));
-            element.ArrayMeasurements[l]->DeepCopy(this->ArrayMeasurements[l]);
-            element.ArrayMeasurements[l]->Add(
-              dataList[l]->GetTuple(pointId), dataList[l]->GetNumberOfComponents());
+            sortedPointIds[nextPointIdx[treeOfPoint[pointId]]++] = pointId;
           }
         }
-        // if not, then the grid location is already created, just need to add the element into it
-        else
+      }
+      treeOfPoint = std::vector<vtkIdType>();
+
+      vtkSMPTools::For(0, numberOfTrees, [&](vtkIdType beginTree, vtkIdType endTree) {
+        double point[3];
+        std::vector<std::vector<double>> tuples(dataList.size());
+        for (std::size_t l = 0; l < dataList.size(); ++l)
         {
-          for (std::size_t l = 0; l < dataList.size(); ++l)
+          tuples[l].resize(dataList[l]->GetNumberOfComponents());
+        }
+
+        for (vtkIdType gridIdx = beginTree; gridIdx < endTree; ++gridIdx)
+        {
+          auto& grid = this->GridOfMultiResolutionGrids[gridIdx][this->MaxDepth];
+          for (vtkIdType sortedIdx = treeOffsets[gridIdx]; sortedIdx < treeOffsets[gridIdx + 1];
+               ++sortedIdx)
           {
-            it->second.ArrayMeasurements[l]->Add(
-              dataList[l]->GetTuple(pointId), dataList[l]->GetNumberOfComponents());
+            const vtkIdType pointId = sortedPointIds[sortedIdx];
+            dataSet->GetPoint(pointId, point);
+            vtkIdType treeIdx, idx;
+            this->LocatePoint(point, treeIdx, idx);
+            for (std::size_t l = 0; l < dataList.size(); ++l)
+            {
+              dataList[l]->GetTuple(pointId, tuples[l].data());
+            }
+
+            auto it = grid.find(idx);
+            // if this is the first time we pass by this grid location, we create a new
+            // ArrayMeasurement instance
+            // NOTE: GridElement::CanSubdivide does not need to be set at the highest resolution
+            if (it == grid.end())
+            {
+              GridElement& element = grid[idx];
+              element.NumberOfLeavesInSubtree = 1;
+              element.NumberOfPointsInSubtree = 1;
+              element.AccumulatedWeight = 1.0;
+              element.UnmaskedChildrenHaveNoMaskedLeaves = true;
+              for (std::size_t l = 0; l < this->ArrayMeasurements.size(); ++l)
+              {
+                element.ArrayMeasurements.emplace_back(
+                  vtkSmartPointer<vtkAbstractArrayMeasurement>::Take(
+                    this->ArrayMeasurements[l]->NewInstance()));
+                element.ArrayMeasurements[l]->DeepCopy(this->ArrayMeasurements[l]);
+                element.ArrayMeasurements[l]->Add(
+                  tuples[l].data(), dataList[l]->GetNumberOfComponents());
+              }
+            }
+            // if not, then the grid location is already created, just need to add the element
+            // into it
+            else
+            {
+              for (std::size_t l = 0; l < dataList.size(); ++l)
+              {
+                it->second.ArrayMeasurements[l]->Add(
+                  tuples[l].data(), dataList[l]->GetNumberOfComponents());
+              }
+              ++(it->second.NumberOfPointsInSubtree);
+              ++(it->second.AccumulatedWeight);
+            }
           }
-          ++(it->second.NumberOfPointsInSubtree);
-          ++(it->second.AccumulatedWeight);
         }
-      }
+      });
     }
     else if (fieldAssociation == vtkDataObject::FIELD_ASSOCIATION_CELLS)
     {
@@ -1287,106 +1516,21 @@ void vtkResampleToHyperTreeGrid::CreateGridOfMultiResolutionGrids(
     }
   }
 
-  // Now, we fill the multi-resolution grid bottom-up
-  for (std::size_t multiResGridIdx = 0; multiResGridIdx < this->GridOfMultiResolutionGrids.size();
-       ++multiResGridIdx)
+  if (this->Controller && this->Controller->GetNumberOfProcesses() > 1 &&
+    this->ExchangePartialStatistics)
   {
-    auto& multiResolutionGrid = this->GridOfMultiResolutionGrids[multiResGridIdx];
-    for (std::size_t depth = this->MaxDepth; depth; --depth)
-    {
-      // The strategy is the following:
-      // Given an iterator on the elements of the grid at resolution depth,
-      // we propagate the accumulated values to the lower resolution depth-1
-      // using correct indexing
-      for (const auto& mapElement : multiResolutionGrid[depth])
-      {
-        vtkTuple<vtkIdType, 3> coord =
-          this->IndexToMultiResGridCoordinates(mapElement.first, depth);
-        coord[0] /= this->BranchFactor;
-        coord[1] /= this->BranchFactor;
-        coord[2] /= this->BranchFactor;
-        vtkIdType idx =
-          this->MultiResGridCoordinatesToIndex(coord[0], coord[1], coord[2], depth - 1);
-
-        // Same as before: if the grid location is not created yet, we create it, if not,
-        // we merge the corresponding accumulated values
-        auto it = multiResolutionGrid[depth - 1].find(idx);
-        // if the grid element does not exist yet, we create it
-        if (it == multiResolutionGrid[depth - 1].end())
-        {
-          GridElement& element = multiResolutionGrid[depth - 1][idx];
-
-          // Initializing element
-          element.NumberOfLeavesInSubtree = mapElement.second.NumberOfLeavesInSubtree;
-          element.NumberOfPointsInSubtree = mapElement.second.NumberOfPointsInSubtree;
-          element.NumberOfNonMaskedChildren = 1;
-          element.AccumulatedWeight = mapElement.second.AccumulatedWeight;
-
-          // mapElement, from higher depth, can have no children with any masked leaves,
-          // but have a masked children, which we propagate upward.
-          element.UnmaskedChildrenHaveNoMaskedLeaves =
-            mapElement.second.UnmaskedChildrenHaveNoMaskedLeaves &&
-            mapElement.second.NumberOfNonMaskedChildren == this->NumberOfChildren;
-
-          // A leaf can be subivided if each of the hypothetical child:
-          // - Has at least MinimumNumberOfPointsInSubtree set by the user
-          // - Has enough points to be measured
-          // Here we check with the first child.
-          element.CanSubdivide =
-            mapElement.second.NumberOfPointsInSubtree >= this->MinimumNumberOfPointsInSubtree &&
-            (!this->ArrayMeasurement ||
-              this->ArrayMeasurement->CanMeasure(
-                mapElement.second.NumberOfPointsInSubtree, mapElement.second.AccumulatedWeight)) &&
-            (!this->ArrayMeasurementDisplay ||
-              this->ArrayMeasurementDisplay->CanMeasure(
-                mapElement.second.NumberOfPointsInSubtree, mapElement.second.AccumulatedWeight));
+    this->ReducePartialStatistics();
+  }
 
-          for (std::size_t l = 0; l < this->ArrayMeasurements.size(); ++l)
-          {
-            element.ArrayMeasurements.emplace_back(
-              vtkSmartPointer<vtkAbstractArrayMeasurement>::Take(
-                this->ArrayMeasurements[l]->NewInstance()));
-            element.ArrayMeasurements[l]->DeepCopy(this->ArrayMeasurements[l]);
-            element.ArrayMeasurements[l]->Add(mapElement.second.ArrayMeasurements[l]);
-          }
-        }
-        // else, the grid element is already created, we add data to it
-        else
-        {
-          // Adding information from subtree
-          it->second.NumberOfLeavesInSubtree += mapElement.second.NumberOfLeavesInSubtree;
-          it->second.NumberOfPointsInSubtree += mapElement.second.NumberOfPointsInSubtree;
-          it->second.AccumulatedWeight += mapElement.second.AccumulatedWeight;
-
-          // mapElement, from higher depth, can have no children with any masked leaves,
-          // but have a masked children, which we propagate upward.
-          it->second.UnmaskedChildrenHaveNoMaskedLeaves &=
-            mapElement.second.UnmaskedChildrenHaveNoMaskedLeaves &&
-            mapElement.second.NumberOfNonMaskedChildren == this->NumberOfChildren;
-          ++(it->second.NumberOfNonMaskedChildren);
-
-          // A leaf can be subivided if each of the hypothetical child:
-          // - Has at least MinimumNumberOfPointsInSubtree set by the user
-          // - Has enough points to be measured
-          // Here we accumulate for each child
-          it->second.CanSubdivide &=
-            it->second.NumberOfPointsInSubtree >= this->MinimumNumberOfPointsInSubtree &&
-            (!this->ArrayMeasurement ||
-              this->ArrayMeasurement->CanMeasure(
-                mapElement.second.NumberOfPointsInSubtree, mapElement.second.AccumulatedWeight)) &&
-            (!this->ArrayMeasurementDisplay ||
-              this->ArrayMeasurementDisplay->CanMeasure(
-                mapElement.second.NumberOfPointsInSubtree, mapElement.second.AccumulatedWeight));
-
-          // We add the accumulators from the child
-          for (std::size_t l = 0; l < this->ArrayMeasurements.size(); ++l)
-          {
-            it->second.ArrayMeasurements[l]->Add(mapElement.second.ArrayMeasurements[l]);
-          }
-        }
+  // Now, we fill the multi-resolution grids bottom-up. Hyper trees are independent from each
+  // other, so they are processed in parallel.
+  vtkSMPTools::For(0, static_cast<vtkIdType>(this->GridOfMultiResolutionGrids.size()),
+    [this](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType multiResGridIdx = begin; multiResGridIdx < end; ++multiResGridIdx)
+      {
+        this->MergeMultiResolutionGrid(this->GridOfMultiResolutionGrids[multiResGridIdx]);
       }
-    }
-  }
+    });
 
   if (this->NoEmptyCells ||
     (this->Extrapolate && !this->ArrayMeasurements.empty() &&
@@ -1491,6 +1635,13 @@ void vtkResampleToHyperTreeGrid::CreateGridOfMultiResolutionGrids(
                   continue;
                 }
               }
+              // When exchanging partial statistics, only the owner of a tree fills it.
+              if (!this->HyperTreeOwners.empty() &&
+                this->HyperTreeOwners[this->GridCoordinatesToIndex(i, j, k)] !=
+                  this->Controller->GetLocalProcessId())
+              {
+                continue;
+              }
 
               this->RecursivelyFillGaps(cell, this->Bounds, cellBounds, i, j, k, x, closestPoint,
                 pcoords, weights,
@@ -1504,6 +1655,141 @@ void vtkResampleToHyperTreeGrid::CreateGridOfMultiResolutionGrids(
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkResampleToHyperTreeGrid::MergeMultiResolutionGrid(MultiResGridType& multiResolutionGrid)
+{
+  // Measurements released by elements that will never be visited when generating the trees.
+  // They are reused for the elements created at coarser depths instead of allocating new ones.
+  std::vector<std::vector<vtkSmartPointer<vtkAbstractArrayMeasurement>>> measurementPool;
+
+  for (std::size_t depth = this->MaxDepth; depth; --depth)
+  {
+    // The strategy is the following:
+    // Given an iterator on the elements of the grid at resolution depth,
+    // we propagate the accumulated values to the lower resolution depth-1
+    // using correct indexing
+    for (const auto& mapElement : multiResolutionGrid[depth])
+    {
+      vtkTuple<vtkIdType, 3> coord = this->IndexToMultiResGridCoordinates(mapElement.first, depth);
+      coord[0] /= this->BranchFactor;
+      coord[1] /= this->BranchFactor;
+      coord[2] /= this->BranchFactor;
+      vtkIdType idx = this->MultiResGridCoordinatesToIndex(coord[0], coord[1], coord[2], depth - 1);
+
+      // Same as before: if the grid location is not created yet, we create it, if not,
+      // we merge the corresponding accumulated values
+      auto it = multiResolutionGrid[depth - 1].find(idx);
+      // if the grid element does not exist yet, we create it
+      if (it == multiResolutionGrid[depth - 1].end())
+      {
+        GridElement& element = multiResolutionGrid[depth - 1][idx];
+
+        // Initializing element
+        element.NumberOfLeavesInSubtree = mapElement.second.NumberOfLeavesInSubtree;
+        element.NumberOfPointsInSubtree = mapElement.second.NumberOfPointsInSubtree;
+        element.NumberOfNonMaskedChildren = 1;
+        element.AccumulatedWeight = mapElement.second.AccumulatedWeight;
+
+        // mapElement, from higher depth, can have no children with any masked leaves,
+        // but have a masked children, which we propagate upward.
+        element.UnmaskedChildrenHaveNoMaskedLeaves =
+          mapElement.second.UnmaskedChildrenHaveNoMaskedLeaves &&
+          mapElement.second.NumberOfNonMaskedChildren == this->NumberOfChildren;
+
+        // A leaf can be subivided if each of the hypothetical child:
+        // - Has at least MinimumNumberOfPointsInSubtree set by the user
+        // - Has enough points to be measured
+        // Here we check with the first child.
+        element.CanSubdivide =
+          mapElement.second.NumberOfPointsInSubtree >= this->MinimumNumberOfPointsInSubtree &&
+          (!this->ArrayMeasurement ||
+            this->ArrayMeasurement->CanMeasure(
+              mapElement.second.NumberOfPointsInSubtree, mapElement.second.AccumulatedWeight)) &&
+          (!this->ArrayMeasurementDisplay ||
+            this->ArrayMeasurementDisplay->CanMeasure(
+              mapElement.second.NumberOfPointsInSubtree, mapElement.second.AccumulatedWeight));
+
+        if (!measurementPool.empty())
+        {
+          // Recycled measurements are reset by copying the prototypes.
+          element.ArrayMeasurements = std::move(measurementPool.back());
+          measurementPool.pop_back();
+          for (std::size_t l = 0; l < this->ArrayMeasurements.size(); ++l)
+          {
+            element.ArrayMeasurements[l]->DeepCopy(this->ArrayMeasurements[l]);
+            element.ArrayMeasurements[l]->Add(mapElement.second.ArrayMeasurements[l]);
+          }
+        }
+        else
+        {
+          for (std::size_t l = 0; l < this->ArrayMeasurements.size(); ++l)
+          {
+            element.ArrayMeasurements.emplace_back(
+              vtkSmartPointer<vtkAbstractArrayMeasurement>::Take(
+                this->ArrayMeasurements[l]->NewInstance()));
+            element.ArrayMeasurements[l]->DeepCopy(this->ArrayMeasurements[l]);
+            element.ArrayMeasurements[l]->Add(mapElement.second.ArrayMeasurements[l]);
+          }
+        }
+      }
+      // else, the grid element is already created, we add data to it
+      else
+      {
+        // Adding information from subtree
+        it->second.NumberOfLeavesInSubtree += mapElement.second.NumberOfLeavesInSubtree;
+        it->second.NumberOfPointsInSubtree += mapElement.second.NumberOfPointsInSubtree;
+        it->second.AccumulatedWeight += mapElement.second.AccumulatedWeight;
+
+        // mapElement, from higher depth, can have no children with any masked leaves,
+        // but have a masked children, which we propagate upward.
+        it->second.UnmaskedChildrenHaveNoMaskedLeaves &=
+          mapElement.second.UnmaskedChildrenHaveNoMaskedLeaves &&
+          mapElement.second.NumberOfNonMaskedChildren == this->NumberOfChildren;
+        ++(it->second.NumberOfNonMaskedChildren);
+
+        // A leaf can be subivided if each of the hypothetical child:
+        // - Has at least MinimumNumberOfPointsInSubtree set by the user
+        // - Has enough points to be measured
+        // Here we accumulate for each child
+        it->second.CanSubdivide &=
+          it->second.NumberOfPointsInSubtree >= this->MinimumNumberOfPointsInSubtree &&
+          (!this->ArrayMeasurement ||
+            this->ArrayMeasurement->CanMeasure(
+              mapElement.second.NumberOfPointsInSubtree, mapElement.second.AccumulatedWeight)) &&
+          (!this->ArrayMeasurementDisplay ||
+            this->ArrayMeasurementDisplay->CanMeasure(
+              mapElement.second.NumberOfPointsInSubtree, mapElement.second.AccumulatedWeight));
+
+        // We add the accumulators from the child
+        for (std::size_t l = 0; l < this->ArrayMeasurements.size(); ++l)
+        {
+          it->second.ArrayMeasurements[l]->Add(mapElement.second.ArrayMeasurements[l]);
+        }
+      }
+    }
+
+    // Now that the parents are complete, the children of a parent which cannot be subdivided
+    // will never be measured: their measurements go to the pool. Subdivision can only be
+    // forbidden further afterwards, when filling gaps.
+    for (auto& mapElement : multiResolutionGrid[depth])
+    {
+      if (mapElement.second.ArrayMeasurements.empty())
+      {
+        continue;
+      }
+      vtkTuple<vtkIdType, 3> coord = this->IndexToMultiResGridCoordinates(mapElement.first, depth);
+      vtkIdType parentIdx = this->MultiResGridCoordinatesToIndex(coord[0] / this->BranchFactor,
+        coord[1] / this->BranchFactor, coord[2] / this->BranchFactor, depth - 1);
+      const GridElement& parent = multiResolutionGrid[depth - 1].at(parentIdx);
+      if (!parent.CanSubdivide || parent.NumberOfLeavesInSubtree <= 1)
+      {
+        measurementPool.emplace_back(std::move(mapElement.second.ArrayMeasurements));
+        mapElement.second.ArrayMeasurements.clear();
+      }
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 bool vtkResampleToHyperTreeGrid::RecursivelyFillGaps(vtkCell* cell, const double bounds[6],
   const double cellBounds[6], vtkIdType i, vtkIdType j, vtkIdType k, double x[3],
@@ -1746,8 +2032,9 @@ int vtkResampleToHyperTreeGrid::GenerateTrees(vtkHyperTreeGrid* htg)
   // Iterate over all hyper trees
   this->Progress = 0.;
 
-  vtkIdType treeOffset = 0;
-
+  // Trees are created first, as the hyper tree grid cannot create trees concurrently.
+  std::vector<vtkSmartPointer<vtkHyperTreeGridNonOrientedCursor>> cursors;
+  std::vector<vtkIdType> multiResGridIds;
   vtkIdType multiResGridIdx = 0;
   for (vtkIdType i = 0; i < htg->GetCellDims()[0]; ++i)
   {
@@ -1759,32 +2046,60 @@ int vtkResampleToHyperTreeGrid::GenerateTrees(vtkHyperTreeGrid* htg)
         {
           vtkIdType treeId;
           htg->GetIndexFromLevelZeroCoordinates(treeId, i, j, k);
-          // Build this tree:
-          vtkHyperTreeGridNonOrientedCursor* cursor = htg->NewNonOrientedCursor(treeId, true);
-          cursor->GetTree()->SetGlobalIndexStart(treeOffset);
-          // We subdivide each tree starting at position (0,0,0) at coarsest level
-          // We feed the corresponding multi resolution grid
-          // Top-down algorithm
-          this->SubdivideLeaves(
-            cursor, treeId, 0, 0, 0, this->GridOfMultiResolutionGrids[multiResGridIdx]);
-          treeOffset += cursor->GetTree()->GetNumberOfVertices();
-          cursor->Delete();
+          cursors.emplace_back(vtkSmartPointer<vtkHyperTreeGridNonOrientedCursor>::Take(
+            htg->NewNonOrientedCursor(treeId, true)));
+          multiResGridIds.emplace_back(multiResGridIdx);
         }
       }
     }
   }
 
+  // Then, each tree is subdivided independently. As global indices of the vertices of a tree
+  // depend on the size of the previous trees, values are stored by local index.
+  std::vector<TreeData> treeData(cursors.size());
+  vtkSMPTools::For(0, static_cast<vtkIdType>(cursors.size()), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cursorId = begin; cursorId < end; ++cursorId)
+    {
+      vtkHyperTreeGridNonOrientedCursor* cursor = cursors[cursorId];
+      treeData[cursorId].ScalarFields.resize(this->ArrayMeasurements.size());
+      // We subdivide each tree starting at position (0,0,0) at coarsest level
+      // We feed the corresponding multi resolution grid
+      // Top-down algorithm
+      this->SubdivideLeaves(cursor, cursor->GetTree()->GetTreeIndex(), 0, 0, 0,
+        this->GridOfMultiResolutionGrids[multiResGridIds[cursorId]], treeData[cursorId]);
+    }
+  });
+
+  vtkIdType treeOffset = 0;
+  for (std::size_t cursorId = 0; cursorId < cursors.size(); ++cursorId)
+  {
+    vtkHyperTree* tree = cursors[cursorId]->GetTree();
+    tree->SetGlobalIndexStart(treeOffset);
+    const TreeData& data = treeData[cursorId];
+    const vtkIdType numberOfVertices = tree->GetNumberOfVertices();
+    for (vtkIdType vertexId = 0; vertexId < numberOfVertices; ++vertexId)
+    {
+      for (std::size_t l = 0; l < this->ArrayMeasurements.size(); ++l)
+      {
+        this->ScalarFields[l]->InsertValue(treeOffset + vertexId, data.ScalarFields[l][vertexId]);
+      }
+      this->Mask->InsertValue(treeOffset + vertexId, data.Mask[vertexId]);
+    }
+    treeOffset += numberOfVertices;
+    treeData[cursorId] = TreeData();
+  }
+
   return 1;
 }
 
 //----------------------------------------------------------------------------
 void vtkResampleToHyperTreeGrid::SubdivideLeaves(vtkHyperTreeGridNonOrientedCursor* cursor,
-  vtkIdType treeId, vtkIdType i, vtkIdType j, vtkIdType k, MultiResGridType& multiResolutionGrid)
+  vtkIdType treeId, vtkIdType i, vtkIdType j, vtkIdType k, MultiResGridType& multiResolutionGrid,
+  TreeData& treeData)
 {
   vtkIdType level = cursor->GetLevel();
   vtkIdType vertexId = cursor->GetVertexId();
   vtkHyperTree* tree = cursor->GetTree();
-  vtkIdType idx = tree->GetGlobalIndexFromLocal(vertexId);
 
   auto it = multiResolutionGrid[level].find(this->MultiResGridCoordinatesToIndex(i, j, k, level));
 
@@ -1811,12 +2126,20 @@ void vtkResampleToHyperTreeGrid::SubdivideLeaves(vtkHyperTreeGridNonOrientedCurs
     }
   }
 
+  if (static_cast<std::size_t>(vertexId) >= treeData.Mask.size())
+  {
+    for (std::size_t l = 0; l < this->ArrayMeasurements.size(); ++l)
+    {
+      treeData.ScalarFields[l].resize(vertexId + 1);
+    }
+    treeData.Mask.resize(vertexId + 1);
+  }
   for (std::size_t l = 0; l < this->ArrayMeasurements.size(); ++l)
   {
-    this->ScalarFields[l]->InsertValue(idx, values[l]);
+    treeData.ScalarFields[l][vertexId] = values[l];
   }
 
-  this->Mask->InsertValue(idx, it == multiResolutionGrid[level].end());
+  treeData.Mask[vertexId] = it == multiResolutionGrid[level].end();
 
   if (cursor->IsLeaf())
   {
@@ -1844,7 +2167,8 @@ void vtkResampleToHyperTreeGrid::SubdivideLeaves(vtkHyperTreeGridNonOrientedCurs
   {
     cursor->ToChild(childIdx);
     this->SubdivideLeaves(cursor, treeId, i * tree->GetBranchFactor() + ii,
-      j * tree->GetBranchFactor() + jj, k * tree->GetBranchFactor() + kk, multiResolutionGrid);
+      j * tree->GetBranchFactor() + jj, k * tree->GetBranchFactor() + kk, multiResolutionGrid,
+      treeData);
     cursor->ToParent();
 
     if (this->CellDims[0] != 1)
@@ -228,6 +228,21 @@ public:
   vtkBooleanMacro(Extrapolate, bool);
   ///@}
 
+  ///@{
+  /**
+   * Getter / Setter on the boolean flag ExchangePartialStatistics, only used when running with
+   * more than one process. It is set to false by default, in which case the input points are
+   * redistributed so that each hyper tree lies on one process only. If set to true, each process
+   * accumulates its own points instead, and the accumulated statistics of hyper trees shared by
+   * several processes are sent to the process having the most points in the tree, which then
+   * builds it. This avoids moving the input points. Note that gaps are then only filled using the
+   * geometry of the process owning the tree.
+   */
+  vtkGetMacro(ExchangePartialStatistics, bool);
+  vtkSetMacro(ExchangePartialStatistics, bool);
+  vtkBooleanMacro(ExchangePartialStatistics, bool);
+  ///@}
+
   void AddDataArray(const char* name);
   void ClearDataArrays();
 
@@ -427,14 +442,25 @@ protected:
    */
   bool Extrapolate;
 
+  /**
+   * Only needed internally. Output values and mask of the vertices of one hyper tree, indexed by
+   * vertex id in the tree, so that trees can be generated concurrently.
+   */
+  struct TreeData
+  {
+    std::vector<std::vector<double>> ScalarFields;
+    std::vector<bool> Mask;
+  };
+
   /**
    * Method that divides recursively leafs of the output hyper tree grid depending of the
    * subdivision criterion
    * The cursor should correspond with the multiResolutionGrid and (i,j,k) should match the position
-   * of the cursor in the hyper tree grid.
+   * of the cursor in the hyper tree grid. The values of the visited vertices are stored in
+   * treeData.
    */
   void SubdivideLeaves(vtkHyperTreeGridNonOrientedCursor* cursor, vtkIdType treeId, vtkIdType i,
-    vtkIdType j, vtkIdType k, MultiResGridType& multiResolutionGrid);
+    vtkIdType j, vtkIdType k, MultiResGridType& multiResolutionGrid, TreeData& treeData);
 
   /**
    * Given an input dataSet and its corresponding scalar field data, fills a grid of multi
@@ -443,6 +469,20 @@ protected:
    */
   void CreateGridOfMultiResolutionGrids(std::vector<vtkDataSet*>& dataSet, int fieldAssociation);
 
+  /**
+   * Fills the lower resolutions of the multi resolution grid of one hyper tree, given its highest
+   * resolution. Measurements of elements that cannot be reached when subdividing are recycled for
+   * the coarser elements.
+   */
+  void MergeMultiResolutionGrid(MultiResGridType& multiResolutionGrid);
+
+  /**
+   * Computes the index gridIdx of the hyper tree containing point, and the index idx of the point
+   * in the multi resolution grid of this tree at highest resolution. Returns false if the point is
+   * not in a hyper tree of the local process.
+   */
+  bool LocatePoint(const double point[3], vtkIdType& gridIdx, vtkIdType& idx) const;
+
   ///@{
   /**
    * This method computes the intersection volume between a box and a vtkCell3D.
@@ -565,6 +605,28 @@ protected:
   vtkSmartPointer<vtkDataObject> BroadcastHyperTreeOwnership(
     vtkDataObject* input, vtkIdType processId);
 
+  /**
+   * Sets Bounds to the bounds of the input of all processes.
+   */
+  void AllReduceBounds();
+
+  /**
+   * Used when ExchangePartialStatistics is on. Assigns each hyper tree to the process having the
+   * most points in it, and sends the accumulated statistics of the other processes to it, before
+   * the multi resolution grids are filled bottom-up.
+   */
+  void ReducePartialStatistics();
+
+  /**
+   * Process owning each hyper tree when ExchangePartialStatistics is on, -1 for empty trees.
+   */
+  std::vector<int> HyperTreeOwners;
+
+  /**
+   * Flag to exchange partial statistics instead of redistributing the input points.
+   */
+  bool ExchangePartialStatistics;
+
   /**
    * Cache used to handle SetMaxState(bool) and SetMinState(bool)
    */
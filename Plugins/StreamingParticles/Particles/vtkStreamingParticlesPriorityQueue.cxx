@@ -25,8 +25,9 @@
 
 #include <algorithm>
 #include <cassert>
+#include <deque>
+#include <limits>
 #include <map>
-#include <queue>
 #include <set>
 #include <vector>
 
@@ -54,9 +55,10 @@ class vtkStreamingParticlesPriorityQueue::vtkInternals
 {
 public:
   vtkSmartPointer<vtkMultiBlockDataSet> Metadata;
-  std::queue<unsigned int> BlocksToRequest;
+  std::deque<unsigned int> BlocksToRequest;
   std::set<unsigned int> BlocksRequested;
   std::set<unsigned int> BlocksToPurge;
+  std::map<unsigned int, double> BlocksAmountOfDetail;
 
   double PreviousViewPlanes[24];
 
@@ -93,6 +95,7 @@ vtkStreamingParticlesPriorityQueue::vtkStreamingParticlesPriorityQueue()
   this->UseBlockDetailInformation = false;
   this->AnyProcessCanLoadAnyBlock = true;
   this->DetailLevelToLoad = 8.5e-5;
+  this->BytesPerPoint = 32.0;
   this->SetController(vtkMultiProcessController::GetGlobalController());
 }
 
@@ -215,6 +218,7 @@ void vtkStreamingParticlesPriorityQueue::UpdatePriorities(const double view_plan
       if (blockInfo->Has(vtkCompositeDataPipeline::BLOCK_AMOUNT_OF_DETAIL()))
       {
         item.AmountOfDetail = blockInfo->Get(vtkCompositeDataPipeline::BLOCK_AMOUNT_OF_DETAIL());
+        this->Internals->BlocksAmountOfDetail[block_index] = item.AmountOfDetail;
       }
       if (this->AnyProcessCanLoadAnyBlock ||
         (blockInfo->Has(vtkCompositeDataSet::CURRENT_PROCESS_CAN_LOAD_BLOCK()) &&
@@ -244,11 +248,17 @@ void vtkStreamingParticlesPriorityQueue::UpdatePriorities(const double view_plan
 
   std::deque<unsigned int> toRequest;
   std::map<unsigned, unsigned> keepInRequest;
+  std::map<unsigned, double> screenSizes;
   while (!queue.empty())
   {
     vtkStreamingPriorityQueueItem item = queue.top();
 
     queue.pop();
+
+    // Projected size of the block on screen: the visible part of its diagonal
+    // over its distance to the near plane. Blocks outside the frustum get 0.
+    screenSizes[item.Identifier] = item.ScreenCoverage * item.Bounds.GetDiagonalLength() /
+      std::max(item.Distance, 1e-3 * item.Bounds.GetDiagonalLength() + 1e-10);
     //    if (item.Distance + item.Refinement <= 0 || item.Refinement < 1)
     double diagonal = item.Bounds.GetDiagonalLength();
     // avoid division by 0
@@ -338,19 +348,28 @@ void vtkStreamingParticlesPriorityQueue::UpdatePriorities(const double view_plan
     if (keep != keepInRequest.end() && keep->second == *itr &&
       (all_levels_have_same_block_count || purge == this->Internals->BlocksToPurge.end()))
     {
-      this->Internals->BlocksToRequest.push(*itr);
+      this->Internals->BlocksToRequest.push_back(*itr);
     }
   }
+
+  // Request the blocks that are the largest on screen first, so that several
+  // blocks fetched in one pass refine what the user sees the most. Blocks of
+  // the same size keep the order of the coverage-based queue.
+  std::stable_sort(this->Internals->BlocksToRequest.begin(),
+    this->Internals->BlocksToRequest.end(), [&screenSizes](unsigned int a, unsigned int b) {
+      return screenSizes[a] > screenSizes[b];
+    });
+
   for (std::map<unsigned, unsigned>::iterator itr = blocksRequested.begin();
        itr != blocksRequested.end(); ++itr)
   {
     this->Internals->BlocksRequested.insert(itr->second);
   }
 
-  cout << "Update information  : " << endl
-       << "  To request        : " << this->Internals->BlocksToRequest.size() << endl
-       << "  Already requested : " << this->Internals->BlocksRequested.size() << endl
-       << "  To purge          : " << this->Internals->BlocksToPurge.size() << endl;
+  vtkDebugMacro(<< "Update information  : " << endl
+                << "  To request        : " << this->Internals->BlocksToRequest.size() << endl
+                << "  Already requested : " << this->Internals->BlocksRequested.size() << endl
+                << "  To purge          : " << this->Internals->BlocksToPurge.size());
 }
 
 //----------------------------------------------------------------------------
@@ -362,36 +381,60 @@ bool vtkStreamingParticlesPriorityQueue::IsEmpty()
 //----------------------------------------------------------------------------
 unsigned int vtkStreamingParticlesPriorityQueue::Pop()
 {
-  if (this->IsEmpty())
+  std::vector<unsigned int> blocks;
+  this->PopBlocks(std::numeric_limits<double>::max(), 1, 0.0, blocks);
+  return blocks.empty() ? VTK_UNSIGNED_INT_MAX : blocks[0];
+}
+
+//----------------------------------------------------------------------------
+void vtkStreamingParticlesPriorityQueue::PopBlocks(
+  double budget, unsigned int maxBlocks, double defaultBlockSize, std::vector<unsigned int>& blocks)
+{
+  blocks.clear();
+
+  // When any process can load any block, blocks are popped in groups of one
+  // block per process, the i-th block of a group going to process i. As every
+  // process has the same queue, they all pop the same groups.
+  int myid = 0;
+  int num_ranks = 1;
+  if (this->AnyProcessCanLoadAnyBlock && this->Controller)
   {
-    return VTK_UNSIGNED_INT_MAX;
+    myid = this->Controller->GetLocalProcessId();
+    num_ranks = this->Controller->GetNumberOfProcesses();
   }
 
-  if (this->AnyProcessCanLoadAnyBlock)
+  std::deque<unsigned int>& toRequest = this->Internals->BlocksToRequest;
+  std::vector<double> used(num_ranks, 0.0);
+  for (unsigned int count = 0; count < maxBlocks && !toRequest.empty(); ++count)
   {
-    int myid = this->Controller->GetLocalProcessId();
-    int num_ranks = this->Controller->GetNumberOfProcesses();
-    std::vector<unsigned int> items;
-    items.resize(num_ranks);
-    for (int i = 0; i < num_ranks; ++i)
+    const int groupSize = std::min(num_ranks, static_cast<int>(toRequest.size()));
+    std::vector<double> sizes(groupSize, defaultBlockSize);
+    bool overBudget = false;
+    for (int rank = 0; rank < groupSize; ++rank)
     {
-      items[i] = this->Internals->BlocksToRequest.front();
-      this->Internals->BlocksToRequest.pop();
-      this->Internals->BlocksRequested.insert(items[i]);
+      auto iter = this->Internals->BlocksAmountOfDetail.find(toRequest[rank]);
+      if (iter != this->Internals->BlocksAmountOfDetail.end() && iter->second > 0)
+      {
+        sizes[rank] = iter->second * this->BytesPerPoint;
+      }
+      overBudget |= (count > 0 && used[rank] + sizes[rank] > budget);
+    }
+    if (overBudget)
+    {
+      break;
     }
-    return items[myid];
-  }
-  else
-  {
-    unsigned int item;
-
-    item = this->Internals->BlocksToRequest.front();
-    this->Internals->BlocksToRequest.pop();
-    this->Internals->BlocksRequested.insert(item);
 
-    // As the queue is assumed to be of the local process's blocks now, return
-    // the first block in the queue (will be different on each process
-    return item;
+    for (int rank = 0; rank < groupSize; ++rank)
+    {
+      const unsigned int item = toRequest.front();
+      toRequest.pop_front();
+      this->Internals->BlocksRequested.insert(item);
+      used[rank] += sizes[rank];
+      if (rank == myid)
+      {
+        blocks.push_back(item);
+      }
+    }
   }
 }
 
@@ -436,4 +479,8 @@ void vtkStreamingParticlesPriorityQueue::PrintSelf(ostream& os, vtkIndent indent
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "Controller: " << this->Controller << endl;
+  os << indent << "UseBlockDetailInformation: " << this->UseBlockDetailInformation << endl;
+  os << indent << "AnyProcessCanLoadAnyBlock: " << this->AnyProcessCanLoadAnyBlock << endl;
+  os << indent << "DetailLevelToLoad: " << this->DetailLevelToLoad << endl;
+  os << indent << "BytesPerPoint: " << this->BytesPerPoint << endl;
 }
@@ -23,6 +23,11 @@
 // vtkStreamingParticlesPriorityQueue::Update() call to update the prorities for the
 // blocks currently in the queue.
 //
+// Blocks selected for the current view are requested in order of decreasing
+// projected size on screen, blocks outside the view frustum last. PopBlocks()
+// returns as many blocks as fit in a per-pass budget, in bytes, so that a single
+// streaming pass can fetch several blocks.
+//
 // This implementation is based on vtkAMRStreamingPriorityQueue.
 // .SECTION See Also
 // vtkStreamingParticlesRepresentation, vtkAMRStreamingPriorityQueue
@@ -33,6 +38,7 @@
 #include "vtkObject.h"
 #include "vtkStreamingParticlesModule.h" // for export macro
 #include <set>                           // needed for set
+#include <vector>                        // needed for vector
 
 class vtkMultiBlockDataSet;
 class vtkMultiProcessController;
@@ -82,6 +88,18 @@ public:
   // Test if the queue is empty before calling this method.
   unsigned int Pop();
 
+  // Description:
+  // Pops the blocks to request in the next streaming pass, in priority order.
+  // Blocks are popped until the next one would make their estimated size exceed
+  // budget (in bytes) or until maxBlocks blocks are popped. At least one block is
+  // popped if the queue is not empty. The size of a block is estimated from its
+  // vtkCompositeDataPipeline::BLOCK_AMOUNT_OF_DETAIL and BytesPerPoint, or is
+  // defaultBlockSize if the block does not provide this information. When
+  // AnyProcessCanLoadAnyBlock is true, the budget applies to each process and
+  // only the blocks assigned to the local process are returned.
+  void PopBlocks(double budget, unsigned int maxBlocks, double defaultBlockSize,
+    std::vector<unsigned int>& blocks);
+
   // Description:
   // After every Update() call, returns the list of blocks that should be purged
   // given the current view.
@@ -117,6 +135,13 @@ public:
   vtkGetMacro(DetailLevelToLoad, double);
   vtkSetMacro(DetailLevelToLoad, double);
 
+  // Description:
+  // Number of bytes per unit of vtkCompositeDataPipeline::BLOCK_AMOUNT_OF_DETAIL,
+  // used by PopBlocks() to estimate the size of a block. Default is 32, which is
+  // about the size of a point of a point cloud with its vertex cell.
+  vtkGetMacro(BytesPerPoint, double);
+  vtkSetMacro(BytesPerPoint, double);
+
 protected:
   vtkStreamingParticlesPriorityQueue();
   ~vtkStreamingParticlesPriorityQueue() override;
@@ -130,6 +155,7 @@ protected:
   bool UseBlockDetailInformation;
   bool AnyProcessCanLoadAnyBlock;
   double DetailLevelToLoad;
+  double BytesPerPoint;
 
 private:
   vtkStreamingParticlesPriorityQueue(const vtkStreamingParticlesPriorityQueue&) = delete;
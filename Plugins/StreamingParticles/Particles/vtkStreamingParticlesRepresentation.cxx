@@ -40,11 +40,16 @@
 
 #include <algorithm>
 #include <cassert>
+#include <list>
+#include <unordered_map>
 
 static char const BLOCKS_TO_PURGE_ARRAY_NAME[] = "__blocks_to_purge";
 
-static inline void purge_blocks(
-  vtkMultiBlockDataSet* data, const std::set<unsigned int>& blocksToPurge)
+// Calls functor(block_index, level_multiblock, index_in_level) for every block of
+// a multi-block with the Root / Level / DS structure described in
+// vtkStreamingParticlesPriorityQueue::UpdatePriorities().
+template <typename Functor>
+static inline void for_each_block(vtkMultiBlockDataSet* data, Functor&& functor)
 {
   unsigned int block_index = 0;
   unsigned int num_levels = data->GetNumberOfBlocks();
@@ -56,14 +61,87 @@ static inline void purge_blocks(
     unsigned int num_blocks = mb->GetNumberOfBlocks();
     for (unsigned int cc = 0; cc < num_blocks; cc++, block_index++)
     {
-      if (blocksToPurge.find(block_index) != blocksToPurge.end())
-      {
-        mb->SetBlock(cc, nullptr);
-      }
+      functor(block_index, mb, cc);
     }
   }
 }
 
+static inline void purge_blocks(
+  vtkMultiBlockDataSet* data, const std::set<unsigned int>& blocksToPurge)
+{
+  for_each_block(data, [&](unsigned int block_index, vtkMultiBlockDataSet* mb, unsigned int cc) {
+    if (blocksToPurge.find(block_index) != blocksToPurge.end())
+    {
+      mb->SetBlock(cc, nullptr);
+    }
+  });
+}
+
+//----------------------------------------------------------------------------
+class vtkStreamingParticlesRepresentation::vtkBlockCache
+{
+public:
+  // Returns the cached block, or nullptr. The block becomes the most recently
+  // used one.
+  vtkDataObject* Find(unsigned int block_index)
+  {
+    auto iter = this->Blocks.find(block_index);
+    if (iter == this->Blocks.end())
+    {
+      return nullptr;
+    }
+    this->Order.splice(this->Order.begin(), this->Order, iter->second.Position);
+    return iter->second.Data;
+  }
+
+  void Insert(unsigned int block_index, vtkDataObject* data, size_t size)
+  {
+    this->Erase(block_index);
+    this->Order.push_front(block_index);
+    this->Blocks[block_index] = Entry{ data, size, this->Order.begin() };
+    this->Size += size;
+  }
+
+  // Evicts the least recently used blocks until the cache fits in capacity.
+  void Shrink(size_t capacity)
+  {
+    while (this->Size > capacity && !this->Order.empty())
+    {
+      this->Erase(this->Order.back());
+    }
+  }
+
+  void Clear()
+  {
+    this->Blocks.clear();
+    this->Order.clear();
+    this->Size = 0;
+  }
+
+private:
+  struct Entry
+  {
+    vtkSmartPointer<vtkDataObject> Data;
+    size_t Size;
+    std::list<unsigned int>::iterator Position;
+  };
+
+  void Erase(unsigned int block_index)
+  {
+    auto iter = this->Blocks.find(block_index);
+    if (iter != this->Blocks.end())
+    {
+      this->Size -= iter->second.Size;
+      this->Order.erase(iter->second.Position);
+      this->Blocks.erase(iter);
+    }
+  }
+
+  std::unordered_map<unsigned int, Entry> Blocks;
+  std::list<unsigned int> Order;
+  size_t Size = 0;
+};
+
 vtkStandardNewMacro(vtkStreamingParticlesRepresentation);
 //----------------------------------------------------------------------------
 vtkStreamingParticlesRepresentation::vtkStreamingParticlesRepresentation()
@@ -71,7 +149,13 @@ vtkStreamingParticlesRepresentation::vtkStreamingParticlesRepresentation()
   this->StreamingCapablePipeline = false;
   this->InStreamingUpdate = false;
   this->UseOutline = false;
-  this->StreamingRequestSize = 1;
+  this->StreamingRequestSize = 16;
+  this->StreamingRequestBudget = 64.0;
+  this->CacheSize = 256;
+  this->StreamedBytes = 0.0;
+  this->NumberOfStreamedBlocks = 0.0;
+  this->EstimatedBlockSize = 0.0;
+  this->BlockCache = new vtkBlockCache();
 
   this->PriorityQueue = vtkSmartPointer<vtkStreamingParticlesPriorityQueue>::New();
   this->PriorityQueue->UseBlockDetailInformationOn();
@@ -87,7 +171,10 @@ vtkStreamingParticlesRepresentation::vtkStreamingParticlesRepresentation()
 }
 
 //----------------------------------------------------------------------------
-vtkStreamingParticlesRepresentation::~vtkStreamingParticlesRepresentation() = default;
+vtkStreamingParticlesRepresentation::~vtkStreamingParticlesRepresentation()
+{
+  delete this->BlockCache;
+}
 
 //----------------------------------------------------------------------------
 void vtkStreamingParticlesRepresentation::SetVisibility(bool val)
@@ -102,6 +189,18 @@ void vtkStreamingParticlesRepresentation::SetOpacity(double val)
   this->Actor->GetProperty()->SetOpacity(val);
 }
 
+//----------------------------------------------------------------------------
+void vtkStreamingParticlesRepresentation::SetCacheSize(int size)
+{
+  size = std::max(size, 0);
+  if (size != this->CacheSize)
+  {
+    this->CacheSize = size;
+    this->BlockCache->Shrink(static_cast<size_t>(size) * 1024 * 1024);
+    this->Modified();
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkStreamingParticlesRepresentation::SetUseBlockDetailInformation(bool newVal)
 {
@@ -313,6 +412,12 @@ int vtkStreamingParticlesRepresentation::RequestData(
       vtkMultiBlockDataSet* metadata = vtkMultiBlockDataSet::SafeDownCast(
         inInfo->Get(vtkCompositeDataPipeline::COMPOSITE_DATA_META_DATA()));
       this->PriorityQueue->Initialize(metadata);
+      this->MetaData = metadata;
+
+      // cached blocks are no longer valid either.
+      this->BlockCache->Clear();
+      this->StreamedBytes = 0.0;
+      this->NumberOfStreamedBlocks = 0.0;
     }
   }
 
@@ -410,9 +515,7 @@ bool vtkStreamingParticlesRepresentation::StreamingUpdate(const double view_plan
     this->RenderedData->Modified();
     if (this->PriorityQueue->IsEmpty())
     {
-      vtkNew<vtkMultiBlockDataSet> clone;
-      clone->CopyStructure(vtkMultiBlockDataSet::SafeDownCast(this->ProcessedPiece));
-      this->ProcessedPiece = clone.GetPointer();
+      this->ProcessedPiece = this->NewEmptyPiece();
       return true;
     }
   }
@@ -436,6 +539,12 @@ bool vtkStreamingParticlesRepresentation::StreamingUpdate(const double view_plan
   int needsToStream = !this->PriorityQueue->IsEmpty();
   int allNeedToStream;
   controller->AllReduce(&needsToStream, &allNeedToStream, 1, vtkCommunicator::LOGICAL_OR_OP);
+
+  // All processes must estimate the size of blocks the same way for the
+  // priority queue to distribute the blocks consistently.
+  double localBlockSize =
+    this->NumberOfStreamedBlocks > 0 ? this->StreamedBytes / this->NumberOfStreamedBlocks : 0.0;
+  controller->AllReduce(&localBlockSize, &this->EstimatedBlockSize, 1, vtkCommunicator::MAX_OP);
   // If this process doesn't need to fetch another block, return without executing the pipeline
   // The return value should be true if ANY process needs to fetch another block
   if (!needsToStream)
@@ -454,22 +563,33 @@ bool vtkStreamingParticlesRepresentation::StreamingUpdate(const double view_plan
     return false;
   }
 
-  // We've determined we need to request something. Do it.
-  this->InStreamingUpdate = true;
-  vtkStreamingStatusMacro(<< this << ": doing streaming-update.");
+  if (!this->StreamingRequest.empty())
+  {
+    // We've determined we need to request something. Do it.
+    this->InStreamingUpdate = true;
+    vtkStreamingStatusMacro(<< this << ": doing streaming-update.");
+
+    // This ensure that the representation re-executes.
+    this->MarkModified();
 
-  // This ensure that the representation re-executes.
-  this->MarkModified();
+    // Execute the pipeline.
+    this->Update();
+    this->InStreamingUpdate = false;
 
-  // Execute the pipeline.
-  this->Update();
+    this->CacheProcessedPiece();
+  }
+  else
+  {
+    // every block of this pass is cached, no need to execute the pipeline.
+    this->ProcessedPiece = this->NewEmptyPiece();
+  }
+  this->AddCachedBlocks();
 
   if (controller->GetLocalProcessId() == 0 && globalPurgeArray->GetNumberOfTuples() > 0)
   {
     this->ProcessedPiece->GetFieldData()->AddArray(globalPurgeArray);
   }
 
-  this->InStreamingUpdate = false;
   return true;
 }
 
@@ -479,17 +599,101 @@ bool vtkStreamingParticlesRepresentation::DetermineBlocksToStream()
   assert(this->PriorityQueue->IsEmpty() == false);
   assert(this->StreamingRequestSize > 0);
   this->StreamingRequest.clear();
+  this->CachedRequest.clear();
+
+  // Until blocks have been streamed, blocks without size information are
+  // assumed to fill the whole budget.
+  double budget = VTK_DOUBLE_MAX;
+  double blockSize = this->EstimatedBlockSize;
+  if (this->StreamingRequestBudget > 0)
+  {
+    budget = this->StreamingRequestBudget * 1024 * 1024;
+    blockSize = blockSize > 0 ? blockSize : budget;
+  }
 
-  for (int jj = 0; jj < this->StreamingRequestSize; jj++)
+  std::vector<unsigned int> blocks;
+  this->PriorityQueue->PopBlocks(budget, this->StreamingRequestSize, blockSize, blocks);
+  for (unsigned int cid : blocks)
   {
-    unsigned int cid = this->PriorityQueue->Pop();
-    if (cid != VTK_UNSIGNED_INT_MAX)
+    if (this->CacheSize > 0 && this->BlockCache->Find(cid) != nullptr)
+    {
+      vtkStreamingStatusMacro(<< this << ": reusing cached block: " << cid);
+      this->CachedRequest.push_back(cid);
+    }
+    else
     {
       vtkStreamingStatusMacro(<< this << ": requesting blocks: " << cid);
       this->StreamingRequest.push_back(static_cast<int>(cid));
     }
   }
-  return !this->StreamingRequest.empty();
+  return !blocks.empty();
+}
+
+//----------------------------------------------------------------------------
+void vtkStreamingParticlesRepresentation::CacheProcessedPiece()
+{
+  vtkMultiBlockDataSet* piece = vtkMultiBlockDataSet::SafeDownCast(this->ProcessedPiece);
+  if (piece == nullptr)
+  {
+    return;
+  }
+
+  const std::set<unsigned int> requested(
+    this->StreamingRequest.begin(), this->StreamingRequest.end());
+  for_each_block(piece, [&](unsigned int block_index, vtkMultiBlockDataSet* mb, unsigned int cc) {
+    vtkDataObject* block = mb->GetBlock(cc);
+    if (block == nullptr || requested.find(block_index) == requested.end())
+    {
+      return;
+    }
+    const size_t size = static_cast<size_t>(block->GetActualMemorySize()) * 1024;
+    this->StreamedBytes += size;
+    this->NumberOfStreamedBlocks++;
+    if (this->CacheSize > 0)
+    {
+      this->BlockCache->Insert(block_index, block, size);
+    }
+  });
+  this->BlockCache->Shrink(static_cast<size_t>(this->CacheSize) * 1024 * 1024);
+}
+
+//----------------------------------------------------------------------------
+void vtkStreamingParticlesRepresentation::AddCachedBlocks()
+{
+  vtkMultiBlockDataSet* piece = vtkMultiBlockDataSet::SafeDownCast(this->ProcessedPiece);
+  if (piece == nullptr || this->CachedRequest.empty())
+  {
+    return;
+  }
+
+  const std::set<unsigned int> cached(this->CachedRequest.begin(), this->CachedRequest.end());
+  for_each_block(piece, [&](unsigned int block_index, vtkMultiBlockDataSet* mb, unsigned int cc) {
+    if (cached.find(block_index) != cached.end())
+    {
+      mb->SetBlock(cc, this->BlockCache->Find(block_index));
+    }
+  });
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkMultiBlockDataSet> vtkStreamingParticlesRepresentation::NewEmptyPiece()
+{
+  auto piece = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+  if (this->MetaData == nullptr)
+  {
+    return piece;
+  }
+
+  const unsigned int num_levels = this->MetaData->GetNumberOfBlocks();
+  piece->SetNumberOfBlocks(num_levels);
+  for (unsigned int level = 0; level < num_levels; level++)
+  {
+    vtkMultiBlockDataSet* mb = vtkMultiBlockDataSet::SafeDownCast(this->MetaData->GetBlock(level));
+    vtkNew<vtkMultiBlockDataSet> levelPiece;
+    levelPiece->SetNumberOfBlocks(mb ? mb->GetNumberOfBlocks() : 0);
+    piece->SetBlock(level, levelPiece);
+  }
+  return piece;
 }
 
 //----------------------------------------------------------------------------
@@ -538,6 +742,8 @@ void vtkStreamingParticlesRepresentation::PrintSelf(ostream& os, vtkIndent inden
   os << indent << "StreamingCapablePipeline: " << this->StreamingCapablePipeline << endl;
   os << indent << "UseOutline: " << this->UseOutline << endl;
   os << indent << "StreamingRequestSize: " << this->StreamingRequestSize << endl;
+  os << indent << "StreamingRequestBudget: " << this->StreamingRequestBudget << endl;
+  os << indent << "CacheSize: " << this->CacheSize << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -75,11 +75,28 @@ public:
   void SetVisibility(bool val) override;
 
   // Description:
-  // Set the number of blocks to request at a given time on a single process
-  // when streaming.
+  // Set the maximum number of blocks to request at a given time on a single
+  // process when streaming. Defaults to 16.
   vtkSetClampMacro(StreamingRequestSize, int, 1, 10000);
   vtkGetMacro(StreamingRequestSize, int);
 
+  // Description:
+  // Set the amount of data, in MiB, to request at a given time on a single
+  // process when streaming. Blocks are requested in priority order until their
+  // estimated size reaches this budget, or StreamingRequestSize blocks are
+  // requested. At least one block is requested per pass. 0 disables the budget.
+  // Defaults to 64.
+  vtkSetClampMacro(StreamingRequestBudget, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(StreamingRequestBudget, double);
+
+  // Description:
+  // Set the size, in MiB, of the cache of streamed blocks on each process.
+  // Blocks purged from the view stay in the cache, least recently used blocks
+  // being evicted first, so that they are not read again when the camera comes
+  // back to them. 0 disables the cache. Defaults to 256.
+  void SetCacheSize(int size);
+  vtkGetMacro(CacheSize, int);
+
   // Description:
   // Helps with debugging.
   vtkSetMacro(UseOutline, bool);
@@ -179,9 +196,26 @@ protected:
 
   // Description:
   // Called in StreamingUpdate() to determine the blocks to stream in the
-  // current pass. Returns false if no blocks need to be streaming currently.
+  // current pass. Blocks found in the cache are put in CachedRequest, the other
+  // ones in StreamingRequest. Returns false if no blocks need to be streaming
+  // currently.
   bool DetermineBlocksToStream();
 
+  // Description:
+  // Called in StreamingUpdate() after the pipeline executed, to add the blocks
+  // just streamed to the cache.
+  void CacheProcessedPiece();
+
+  // Description:
+  // Called in StreamingUpdate() to add the blocks of CachedRequest to
+  // ProcessedPiece.
+  void AddCachedBlocks();
+
+  // Description:
+  // Returns a multi-block with the structure of the input meta-data and no
+  // leaves.
+  vtkSmartPointer<vtkMultiBlockDataSet> NewEmptyPiece();
+
   // Description:
   // This is the data object generated processed by the most recent call to
   // RequestData() while not streaming.
@@ -210,12 +244,26 @@ protected:
   vtkSmartPointer<vtkCompositePolyDataMapper2> Mapper;
   vtkSmartPointer<vtkPVLODActor> Actor;
 
+  // Description:
+  // Meta-data of the input, given to the PriorityQueue.
+  vtkSmartPointer<vtkMultiBlockDataSet> MetaData;
+
   // Description:
   // Used to keep track of data bounds.
   vtkBoundingBox DataBounds;
 
   std::vector<int> StreamingRequest;
+  std::vector<unsigned int> CachedRequest;
   int StreamingRequestSize;
+  double StreamingRequestBudget;
+  int CacheSize;
+
+  // Description:
+  // Size of the blocks streamed so far, used to estimate the size of the
+  // blocks that do not provide it in their meta-data.
+  double StreamedBytes;
+  double NumberOfStreamedBlocks;
+  double EstimatedBlockSize;
   bool UseOutline;
 
 private:
@@ -236,6 +284,11 @@ private:
   // and we need to clear our streaming buffers since the streamed data is no
   // longer valid.
   bool InStreamingUpdate;
+
+  // Description:
+  // Least recently used cache of the streamed blocks, keyed by block index.
+  class vtkBlockCache;
+  vtkBlockCache* BlockCache;
 };
 
 #endif
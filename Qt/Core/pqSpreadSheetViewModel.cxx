@@ -85,6 +85,7 @@ public:
     this->DecimalPrecision = vtkPVGeneralSettings::GetInstance()->GetRealNumberDisplayedPrecision();
     this->FixedRepresentation = false;
     this->ActiveRegion[0] = this->ActiveRegion[1] = -1;
+    this->ScrollDirection = 1;
     this->VTKView = nullptr;
 
     this->LastColumnCount = 0;
@@ -94,12 +95,14 @@ public:
   QItemSelectionModel SelectionModel;
   pqTimer Timer;
   pqTimer SelectionTimer;
+  pqTimer PrefetchTimer;
   int DecimalPrecision;
   bool FixedRepresentation;
   vtkIdType LastRowCount;
   vtkIdType LastColumnCount;
 
   int ActiveRegion[2];
+  int ScrollDirection;
   vtkSmartPointer<vtkEventQtSlotConnect> VTKConnect;
   QPointer<pqDataRepresentation> ActiveRepresentation;
   vtkWeakPointer<vtkSMProxy> ActiveRepresentationProxy;
@@ -126,6 +129,12 @@ pqSpreadSheetViewModel::pqSpreadSheetViewModel(vtkSMProxy* view, QObject* parent
   this->Internal->Timer.setInterval(500); // milliseconds.
   QObject::connect(&this->Internal->Timer, SIGNAL(timeout()), this, SLOT(delayedUpdate()));
 
+  // Prefetching is done one block at a time, when idle, so that user
+  // interaction is never blocked for more than a single block fetch.
+  this->Internal->PrefetchTimer.setSingleShot(true);
+  this->Internal->PrefetchTimer.setInterval(50); // milliseconds.
+  QObject::connect(&this->Internal->PrefetchTimer, SIGNAL(timeout()), this, SLOT(prefetch()));
+
   this->Internal->SelectionTimer.setSingleShot(true);
   this->Internal->SelectionTimer.setInterval(100); // milliseconds.
   QObject::connect(
@@ -206,6 +215,7 @@ void pqSpreadSheetViewModel::forceUpdate()
   this->Internal->SelectionModel.clear();
   this->Internal->Timer.stop();
   this->Internal->SelectionTimer.stop();
+  this->Internal->PrefetchTimer.stop();
 
   vtkIdType& rows = this->Internal->LastRowCount;
   vtkIdType& columns = this->Internal->LastColumnCount;
@@ -240,6 +250,24 @@ void pqSpreadSheetViewModel::delayedUpdate()
   {
     this->Internal->VTKView->GetValue(this->Internal->ActiveRegion[0], 0);
   }
+  if (this->Internal->ActiveRegion[1] >= 0 &&
+    this->Internal->ActiveRegion[1] < this->Internal->VTKView->GetNumberOfRows())
+  {
+    this->Internal->VTKView->GetValue(this->Internal->ActiveRegion[1], 0);
+  }
+  this->Internal->PrefetchTimer.start();
+}
+
+//-----------------------------------------------------------------------------
+void pqSpreadSheetViewModel::prefetch()
+{
+  // each successful prefetch fires vtkCommand::UpdateEvent which restarts the
+  // timer in onDataFetched, until there's nothing left to prefetch.
+  const auto& region = this->Internal->ActiveRegion;
+  if (region[0] >= 0 && region[1] >= region[0])
+  {
+    this->Internal->VTKView->Prefetch(region[0], region[1], this->Internal->ScrollDirection);
+  }
 }
 
 //-----------------------------------------------------------------------------
@@ -251,6 +279,10 @@ void pqSpreadSheetViewModel::triggerSelectionChanged()
 //-----------------------------------------------------------------------------
 void pqSpreadSheetViewModel::setActiveRegion(int row_top, int row_bottom)
 {
+  if (this->Internal->ActiveRegion[0] >= 0 && row_top != this->Internal->ActiveRegion[0])
+  {
+    this->Internal->ScrollDirection = row_top > this->Internal->ActiveRegion[0] ? 1 : -1;
+  }
   this->Internal->ActiveRegion[0] = row_top;
   this->Internal->ActiveRegion[1] = row_bottom;
 }
@@ -281,6 +313,8 @@ void pqSpreadSheetViewModel::onDataFetched(vtkObject*, unsigned long, void*, voi
   this->dataChanged(topLeft, bottomRight);
   // we always invalidate header data, just to be on a safe side.
   this->headerDataChanged(Qt::Horizontal, 0, this->columnCount() - 1);
+
+  this->Internal->PrefetchTimer.start();
 }
 namespace
 {
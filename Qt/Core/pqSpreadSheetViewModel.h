@@ -193,6 +193,11 @@ private Q_SLOTS:
    */
   void delayedUpdate();
 
+  /**
+   * called when idle to fetch blocks ahead of the visible region.
+   */
+  void prefetch();
+
   void triggerSelectionChanged();
 
   /**
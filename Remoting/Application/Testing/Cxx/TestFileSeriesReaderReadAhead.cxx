@@ -0,0 +1,142 @@
+/*=========================================================================
+
+Program:   ParaView
+Module:    TestFileSeriesReaderReadAhead.cxx
+
+Copyright (c) Kitware, Inc.
+All rights reserved.
+See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkDummyCommunicator.h"
+#include "vtkDummyController.h"
+#include "vtkFileSeriesReader.h"
+#include "vtkInitializationHelper.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPolyDataReader.h"
+#include "vtkProcessModule.h"
+#include "vtkTestUtilities.h"
+
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#define VERIFY(x, y)                                                                               \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    vtkLogF(ERROR, y);                                                                             \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+// A communicator of a single process pretending to be one of several, so that
+// the reader reads a piece of each file without MPI.
+class TestPieceCommunicator : public vtkDummyCommunicator
+{
+public:
+  static TestPieceCommunicator* New();
+  vtkTypeMacro(TestPieceCommunicator, vtkDummyCommunicator);
+
+  void SetPiece(int piece, int numberOfPieces)
+  {
+    this->MaximumNumberOfProcesses = numberOfPieces;
+    this->NumberOfProcesses = numberOfPieces;
+    this->LocalProcessId = piece;
+  }
+};
+vtkStandardNewMacro(TestPieceCommunicator);
+
+// Writes a small legacy polydata file.
+bool WriteFile(const std::string& fileName, int step)
+{
+  std::ofstream file(fileName.c_str());
+  file << "# vtk DataFile Version 3.0\n"
+       << "step " << step << "\n"
+       << "ASCII\n"
+       << "DATASET POLYDATA\n"
+       << "POINTS 4 float\n";
+  for (int cc = 0; cc < 4; ++cc)
+  {
+    file << cc << " " << step << " 0\n";
+  }
+  return static_cast<bool>(file);
+}
+
+// Reads time step `step` and gives the background thread time to read the
+// next files ahead.
+void ReadStep(vtkFileSeriesReader* reader, int step)
+{
+  reader->UpdateTimeStep(step);
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+}
+
+bool TestReadAheadPieces(const std::string& tempDir)
+{
+  vtkNew<TestPieceCommunicator> communicator;
+  communicator->SetPiece(0, 2);
+  vtkNew<vtkDummyController> controller;
+  controller->SetCommunicator(communicator);
+
+  vtkNew<vtkPolyDataReader> polyDataReader;
+  vtkNew<vtkFileSeriesReader> reader;
+  reader->SetReader(polyDataReader);
+  reader->SetFileNameMethod("SetFileName");
+  reader->SetController(controller);
+  reader->ReadAheadOn();
+  reader->SetReadAheadBufferSize(16);
+  for (int step = 0; step < 4; ++step)
+  {
+    const std::string fileName =
+      tempDir + "/TestFileSeriesReaderReadAhead_" + std::to_string(step) + ".vtk";
+    VERIFY(WriteFile(fileName, step), "failed to write the file series.");
+    reader->AddFileName(fileName.c_str());
+  }
+
+  // the first file cannot have been read ahead; it schedules the next ones.
+  ReadStep(reader, 0);
+  VERIFY(reader->GetNumberOfReadAheadHits() == 0 && reader->GetNumberOfReadAheadMisses() == 0,
+    "no read-ahead statistics expected before read-ahead starts.");
+
+  ReadStep(reader, 1);
+  VERIFY(reader->GetNumberOfReadAheadHits() == 1 && reader->GetNumberOfReadAheadMisses() == 0,
+    "the next file should have been read ahead.");
+
+  // the piece changes: only the previous piece of the next file was read.
+  communicator->SetPiece(1, 2);
+  ReadStep(reader, 2);
+  VERIFY(reader->GetNumberOfReadAheadHits() == 1 && reader->GetNumberOfReadAheadMisses() == 1,
+    "a file read ahead for another piece should not be a hit.");
+
+  // files scheduled after the change are read for the new piece.
+  ReadStep(reader, 3);
+  VERIFY(reader->GetNumberOfReadAheadHits() == 2 && reader->GetNumberOfReadAheadMisses() == 1,
+    "the next file should have been read ahead for the new piece.");
+
+  reader->SetController(nullptr);
+  return true;
+}
+}
+
+int TestFileSeriesReaderReadAhead(int argc, char* argv[])
+{
+  vtkInitializationHelper::SetApplicationName("TestFileSeriesReaderReadAhead");
+  vtkInitializationHelper::SetOrganizationName("Humanity");
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_BATCH);
+
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string tempDirectory = tempDir ? tempDir : "";
+  delete[] tempDir;
+
+  const bool success = !tempDirectory.empty() && TestReadAheadPieces(tempDirectory);
+  vtkInitializationHelper::Finalize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
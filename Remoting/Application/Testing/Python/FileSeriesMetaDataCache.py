@@ -0,0 +1,91 @@
+# Tests the metadata cache of vtkFileSeriesReader: a first read of a file
+# series writes the cache, a second read uses it instead of probing the files,
+# and changing a file invalidates it.
+
+from paraview.simple import *
+from paraview import smtesting
+
+import json
+import os
+import shutil
+
+smtesting.ProcessCommandLineArguments()
+
+VTP = """<?xml version="1.0"?>
+<VTKFile type="PolyData" version="1.0" byte_order="LittleEndian">
+  <PolyData>
+    <FieldData>
+      <DataArray type="Float64" Name="TimeValue" NumberOfTuples="1" format="ascii">%s</DataArray>
+    </FieldData>
+    <Piece NumberOfPoints="1" NumberOfVerts="0" NumberOfLines="0" NumberOfStrips="0" NumberOfPolys="0">
+      <Points>
+        <DataArray type="Float32" NumberOfComponents="3" format="ascii">0 0 0</DataArray>
+      </Points>
+    </Piece>
+  </PolyData>
+</VTKFile>
+"""
+
+root = os.path.join(smtesting.TempDir, "FileSeriesMetaDataCache")
+shutil.rmtree(root, ignore_errors=True)
+dataDir = os.path.join(root, "data")
+cacheDir = os.path.join(root, "cache")
+os.makedirs(dataDir)
+os.makedirs(cacheDir)
+
+def writeFile(index, time):
+    with open(os.path.join(dataDir, "series_%d.vtp" % index), "w") as f:
+        f.write(VTP % repr(time))
+
+files = []
+for i in range(4):
+    writeFile(i, float(i + 1))
+    files.append(os.path.join(dataDir, "series_%d.vtp" % i))
+
+def readTimeSteps():
+    reader = XMLPolyDataReader(FileName=files)
+    series = reader.GetClientSideObject()
+    series.SetUseMetaDataCache(True)
+    series.SetMetaDataCacheDirectory(cacheDir)
+    reader.UpdatePipelineInformation()
+    timesteps = list(reader.TimestepValues)
+    Delete(reader)
+    return timesteps
+
+def cacheFileName():
+    names = [name for name in os.listdir(cacheDir) if name.endswith(".pvseries-cache")]
+    if len(names) != 1:
+        raise smtesting.TestError("Expected a single cache file, got %s" % names)
+    return os.path.join(cacheDir, names[0])
+
+def check(timesteps, expected, what):
+    print("%s: %s" % (what, timesteps))
+    if timesteps != expected:
+        raise smtesting.TestError("%s: expected %s, got %s" % (what, expected, timesteps))
+
+# cache miss: the files are probed and the cache is written.
+check(readTimeSteps(), [1.0, 2.0, 3.0, 4.0], "cache miss")
+cache = cacheFileName()
+
+# cache hit: shift the cached times of all files but the first one, which is
+# always probed. The reader must report the cached values.
+with open(cache) as f:
+    contents = json.load(f)
+for entry in contents["files"][1:]:
+    time = entry["time"]
+    # packed as: number of time steps, has range, range, time steps
+    entry["time"] = time[:2] + [value + 100 for value in time[2:]]
+with open(cache, "w") as f:
+    json.dump(contents, f)
+check(readTimeSteps(), [1.0, 102.0, 103.0, 104.0], "cache hit")
+
+# stale cache: a file changed, so the files are probed again and the cache is
+# rewritten.
+writeFile(2, 30.0)
+stat = os.stat(files[2])
+os.utime(files[2], (stat.st_atime, stat.st_mtime + 10))
+check(readTimeSteps(), [1.0, 2.0, 4.0, 30.0], "stale cache")
+with open(cache) as f:
+    contents = json.load(f)
+if 30.0 not in contents["files"][2]["time"]:
+    raise smtesting.TestError("The stale cache was not rewritten")
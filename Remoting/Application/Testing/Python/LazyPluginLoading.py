@@ -0,0 +1,34 @@
+# This test verifies that plugins can be loaded lazily: with
+# PV_PLUGIN_LAZY_LOAD set, only rank 0 opens the plugin library when it is
+# loaded, and the other ranks open it when one of its filters is created.
+# It's designed to run on 2 ranks.
+
+from paraview.simple import *
+from paraview import smtesting
+
+pm = servermanager.vtkProcessModule.GetProcessModule()
+if pm.GetNumberOfLocalPartitions() != 2:
+    raise smtesting.TestError("Test must be run on 2 ranks!")
+if pm.GetSymmetricMPIMode():
+    raise smtesting.TestError("Test cannot be run in symmetric mode!")
+
+LoadDistributedPlugin("Moments", ns=globals())
+
+s = Sphere(ThetaResolution=16, PhiResolution=16)
+flux = Calculator(Input=s, AttributeType="Cell Data", ResultArrayName="flux", Function="1")
+vectors = MomentVectors(Input=flux)
+vectors.SelectInputScalars = ["CELLS", "flux"]
+vectors.UpdatePipeline()
+
+# each rank must have run the filter on its piece of the sphere.
+for rank in range(2):
+    inputInfo = flux.GetRankDataInformation(rank)
+    info = vectors.GetRankDataInformation(rank)
+    print("rank %d: %d cells" % (rank, info.GetNumberOfCells()))
+    if info.GetNumberOfCells() == 0 or info.GetNumberOfCells() != inputInfo.GetNumberOfCells():
+        raise smtesting.TestError("MomentVectors did not run on rank %d" % rank)
+    cellInfo = info.GetCellDataInformation()
+    hasVectors = any(cellInfo.GetArrayInformation(i).GetNumberOfComponents() == 3
+        for i in range(cellInfo.GetNumberOfArrays()))
+    if not hasVectors:
+        raise smtesting.TestError("No vectors were computed on rank %d" % rank)
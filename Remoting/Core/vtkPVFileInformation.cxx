@@ -356,7 +356,9 @@ vtkPVFileInformation::vtkPVFileInformation()
 {
   this->RootOnly = 1;
   this->Contents = vtkCollection::New();
-  this->SequenceParser = vtkFileSequenceParser::New();
+  // created on demand, since most instances are directory entries that never
+  // group their contents.
+  this->SequenceParser = nullptr;
   this->Type = INVALID;
   this->Name = nullptr;
   this->FullPath = nullptr;
@@ -378,7 +380,10 @@ vtkPVFileInformation::vtkPVFileInformation()
 vtkPVFileInformation::~vtkPVFileInformation()
 {
   this->Contents->Delete();
-  this->SequenceParser->Delete();
+  if (this->SequenceParser)
+  {
+    this->SequenceParser->Delete();
+  }
   this->SetName(nullptr);
   this->SetFullPath(nullptr);
   this->SetExtension(nullptr);
@@ -942,10 +947,17 @@ void vtkPVFileInformation::FetchUnixDirectoryListing()
       info->Type = DIRECTORY;
     }
 #else
-    if (d->d_type & DT_DIR)
+    // Use the type reported by the directory listing, when available, to
+    // avoid stat-ing every entry in DetectType(). Links and entries of unknown
+    // type are left INVALID to be resolved there.
+    if (d->d_type == DT_DIR)
     {
       info->Type = DIRECTORY;
     }
+    else if (d->d_type == DT_REG)
+    {
+      info->Type = SINGLE_FILE;
+    }
 #endif
 
     info->FastFileTypeDetection = this->FastFileTypeDetection;
@@ -1064,6 +1076,10 @@ void vtkPVFileInformation::OrganizeCollection(vtkPVFileInformationSet& info_set)
 
   if (this->GroupFileSequences)
   {
+    if (!this->SequenceParser)
+    {
+      this->SequenceParser = vtkFileSequenceParser::New();
+    }
     for (vtkPVFileInformationSet::iterator iter = info_set.begin(); iter != info_set.end();)
     {
       vtkSmartPointer<vtkPVFileInformation> obj = *iter;
@@ -14,10 +14,14 @@
 =========================================================================*/
 #include "vtkPVPluginLoader.h"
 
+#include "vtkCommunicator.h"
 #include "vtkDynamicLoader.h"
+#include "vtkMultiProcessController.h"
+#include "vtkMultiProcessStream.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPDirectory.h"
+#include "vtkPVDynamicInitializerPluginInterface.h"
 #include "vtkPVLogger.h"
 #include "vtkPVPlugin.h"
 #include "vtkPVPluginTracker.h"
@@ -27,11 +31,15 @@
 #include "vtkProcessModule.h"
 
 #include "vtksys/FStream.hxx"
+#include "vtksys/MD5.h"
 #include "vtksys/SystemTools.hxx"
 
+#include <algorithm>
 #include <cstdlib>
 #include <iterator>
+#include <map>
 #include <memory>
+#include <set>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -150,6 +158,90 @@ public:
   const char* GetEULA() override { return nullptr; }
 };
 
+// This is an helper class used on satellite ranks as a stand-in for plugins
+// whose shared library has not been opened yet. It provides the metadata and
+// server-manager XMLs gathered by the root rank.
+class vtkPVDeferredPlugin
+  : public vtkPVPlugin
+  , public vtkPVServerManagerPluginInterface
+{
+public:
+  std::string PluginName;
+  std::string PluginVersion;
+  std::string Description;
+  std::string RequiredPlugins;
+  bool RequiredOnServer = true;
+  bool RequiredOnClient = false;
+  std::vector<std::string> XMLs;
+
+  // Library to open when the plugin is needed. This may be a copy of the
+  // plugin library saved in the local library directory.
+  std::string LibraryFile;
+
+  // VTK classes named by the proxies in the plugin XMLs.
+  std::set<std::string> ClassNames;
+  bool Loaded = false;
+
+  vtkPVDeferredPlugin() = default;
+  vtkPVDeferredPlugin(const vtkPVDeferredPlugin&) = delete;
+  void operator=(const vtkPVDeferredPlugin&) = delete;
+
+  void CollectClassNames()
+  {
+    for (const auto& xml : this->XMLs)
+    {
+      vtkNew<vtkPVXMLParser> parser;
+      parser->SuppressErrorMessagesOn();
+      if (parser->Parse(xml.c_str()))
+      {
+        this->CollectClassNames(parser->GetRootElement());
+      }
+    }
+  }
+
+  const char* GetPluginName() override { return this->PluginName.c_str(); }
+  const char* GetPluginVersionString() override { return this->PluginVersion.c_str(); }
+  bool GetRequiredOnServer() override { return this->RequiredOnServer; }
+  bool GetRequiredOnClient() override { return this->RequiredOnClient; }
+  const char* GetRequiredPlugins() override { return this->RequiredPlugins.c_str(); }
+  const char* GetDescription() override { return this->Description.c_str(); }
+  void GetXMLs(std::vector<std::string>& xmls) override
+  {
+    xmls.insert(xmls.end(), this->XMLs.begin(), this->XMLs.end());
+  }
+
+  /**
+   * The interpreter is initialized once the actual library is loaded.
+   */
+  vtkClientServerInterpreterInitializer::InterpreterInitializationCallback
+  GetInitializeInterpreterCallback() override
+  {
+    return nullptr;
+  }
+
+  /**
+   * The EULA, if any, was confirmed on the root rank.
+   */
+  const char* GetEULA() override { return nullptr; }
+
+private:
+  void CollectClassNames(vtkPVXMLElement* elem)
+  {
+    if (elem == nullptr)
+    {
+      return;
+    }
+    if (const char* classname = elem->GetAttribute("class"))
+    {
+      this->ClassNames.insert(classname);
+    }
+    for (unsigned int cc = 0; cc < elem->GetNumberOfNestedElements(); ++cc)
+    {
+      this->CollectClassNames(elem->GetNestedElement(cc));
+    }
+  }
+};
+
 // Cleans successfully opened libs when the application quits.
 // BUG # 10293
 class vtkPVPluginLoaderCleaner
@@ -157,10 +249,16 @@ class vtkPVPluginLoaderCleaner
   typedef std::map<std::string, vtkLibHandle> HandlesType;
   HandlesType Handles;
   std::vector<vtkPVXMLOnlyPlugin*> XMLPlugins;
+  std::vector<vtkPVDeferredPlugin*> DeferredPlugins;
 
 public:
   void Register(const char* pname, vtkLibHandle& handle) { this->Handles[pname] = handle; }
   void Register(vtkPVXMLOnlyPlugin* plugin) { this->XMLPlugins.push_back(plugin); }
+  void Register(vtkPVDeferredPlugin* plugin) { this->DeferredPlugins.push_back(plugin); }
+  const std::vector<vtkPVDeferredPlugin*>& GetDeferredPlugins() const
+  {
+    return this->DeferredPlugins;
+  }
 
   ~vtkPVPluginLoaderCleaner()
   {
@@ -174,6 +272,10 @@ public:
     {
       delete *iter;
     }
+    for (auto plugin : this->DeferredPlugins)
+    {
+      delete plugin;
+    }
   }
   static vtkPVPluginLoaderCleaner* GetInstance()
   {
@@ -204,6 +306,95 @@ private:
   static vtkPVPluginLoaderCleaner* LibCleaner;
 };
 vtkPVPluginLoaderCleaner* vtkPVPluginLoaderCleaner::LibCleaner = nullptr;
+
+// Returns the plugin registered under the given name, if any.
+vtkPVPlugin* vtkFindRegisteredPlugin(const char* pname)
+{
+  vtkPVPluginTracker* tracker = vtkPVPluginTracker::GetInstance();
+  for (unsigned int cc = 0, max = tracker->GetNumberOfPlugins(); pname && cc < max; ++cc)
+  {
+    const char* name = tracker->GetPluginName(cc);
+    if (name && strcmp(name, pname) == 0)
+    {
+      return tracker->GetPlugin(cc);
+    }
+  }
+  return nullptr;
+}
+
+// Saves a plugin library received from the root rank under `dir` and returns
+// the path to the saved copy, or an empty string on failure. Copies are stored
+// in a sub-directory named after the checksum of the library so that ranks
+// sharing a node write identical files and stale copies are never reused.
+std::string vtkSavePluginLibrary(
+  const std::string& dir, const std::string& filename, const std::vector<char>& library, int rank)
+{
+  vtksysMD5* md5 = vtksysMD5_New();
+  vtksysMD5_Initialize(md5);
+  const size_t chunk = 1 << 30;
+  for (size_t offset = 0; offset < library.size(); offset += chunk)
+  {
+    vtksysMD5_Append(md5, reinterpret_cast<const unsigned char*>(library.data() + offset),
+      static_cast<int>(std::min(chunk, library.size() - offset)));
+  }
+  char hex[33];
+  vtksysMD5_FinalizeHex(md5, hex);
+  vtksysMD5_Delete(md5);
+  hex[32] = '\0';
+
+  const std::string subdir = dir + "/paraview-plugin-" + hex;
+  const std::string path = subdir + "/" + vtksys::SystemTools::GetFilenameName(filename);
+  if (vtksys::SystemTools::FileExists(path, true) &&
+    vtksys::SystemTools::FileLength(path) == static_cast<unsigned long>(library.size()))
+  {
+    return path;
+  }
+
+  if (!vtksys::SystemTools::MakeDirectory(subdir))
+  {
+    return std::string();
+  }
+
+  // write to a temporary file first so that other ranks on the same node never
+  // see a partially written library.
+  const std::string tmp = path + "." + std::to_string(rank) + ".tmp";
+  {
+    vtksys::ofstream os(tmp.c_str(), ios::binary);
+    os.write(library.data(), library.size());
+    if (!os)
+    {
+      os.close();
+      vtksys::SystemTools::RemoveFile(tmp);
+      return std::string();
+    }
+  }
+  if (!vtksys::SystemTools::RenameFile(tmp, path))
+  {
+    vtksys::SystemTools::RemoveFile(tmp);
+    return vtksys::SystemTools::FileExists(path, true) ? path : std::string();
+  }
+  return path;
+}
+
+// Reads a whole file in `buffer`.
+bool vtkReadPluginLibrary(const char* filename, std::vector<char>& buffer)
+{
+  vtksys::ifstream is(filename, ios::binary);
+  if (!is)
+  {
+    return false;
+  }
+  is.seekg(0, ios::end);
+  buffer.resize(static_cast<size_t>(is.tellg()));
+  is.seekg(0, ios::beg);
+  is.read(buffer.data(), buffer.size());
+  if (!is)
+  {
+    buffer.clear();
+    return false;
+  }
+  return true;
+}
 };
 
 //=============================================================================
@@ -212,6 +403,10 @@ using VectorOfCallbacks = std::vector<vtkPVPluginLoader::PluginLoaderCallback>;
 // cannot be objects or their constructor will interfere with the Initializer
 static VectorOfCallbacks* RegisteredPluginLoaderCallbacks = nullptr;
 static int nifty_counter = 0;
+
+// -1 until initialized from the environment.
+static int PluginLazyLoading = -1;
+static std::string* PluginLocalLibraryDirectory = nullptr;
 vtkPVPluginLoaderCleanerInitializer::vtkPVPluginLoaderCleanerInitializer()
 {
   if (nifty_counter++ == 0)
@@ -227,6 +422,8 @@ vtkPVPluginLoaderCleanerInitializer::~vtkPVPluginLoaderCleanerInitializer()
     vtkPVPluginLoaderCleaner::FinalizeInstance();
     delete ::RegisteredPluginLoaderCallbacks;
     ::RegisteredPluginLoaderCallbacks = nullptr;
+    delete ::PluginLocalLibraryDirectory;
+    ::PluginLocalLibraryDirectory = nullptr;
   }
 }
 
@@ -240,6 +437,7 @@ vtkPVPluginLoader::vtkPVPluginLoader()
   this->FileName = nullptr;
   this->SearchPaths = nullptr;
   this->Loaded = false;
+  this->Collective = false;
   this->SetErrorString("No plugin loaded yet.");
 
   std::string paths;
@@ -445,6 +643,37 @@ bool vtkPVPluginLoader::LoadPluginByName(const char* name)
 //-----------------------------------------------------------------------------
 bool vtkPVPluginLoader::LoadPluginInternal(const char* file, bool no_errors)
 {
+  bool openLibrary = false;
+  const bool status = this->LoadPluginFromFile(file, no_errors, openLibrary);
+
+#if BUILD_SHARED_LIBS
+  // Lazy loading and the local library directory need all ranks to open the
+  // library together, which is only guaranteed for collective loads. Since
+  // some ranks may already have the plugin, they first agree on opening it.
+  auto controller = vtkMultiProcessController::GetGlobalController();
+  if (this->Collective && controller != nullptr && controller->GetNumberOfProcesses() > 1 &&
+    (vtkPVPluginLoader::GetLazyLoading() || vtkPVPluginLoader::GetLocalLibraryDirectory()))
+  {
+    int local = openLibrary ? 1 : 0;
+    int all = 0;
+    controller->AllReduce(&local, &all, 1, vtkCommunicator::MIN_OP);
+    if (all == 1)
+    {
+      return this->LoadPluginLibraryInParallel(file, no_errors);
+    }
+  }
+  if (openLibrary)
+  {
+    return this->LoadPluginLibrary(file, file, no_errors);
+  }
+#endif // if BUILD_SHARED_LIBS
+  return status;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkPVPluginLoader::LoadPluginFromFile(const char* file, bool no_errors, bool& openLibrary)
+{
+  openLibrary = false;
   this->Loaded = false;
   if (!file || file[0] == '\0')
   {
@@ -515,7 +744,19 @@ bool vtkPVPluginLoader::LoadPluginInternal(const char* file, bool no_errors)
                               "cannot load dynamic plugins  in static builds.");
   return false;
 #else // ifndef BUILD_SHARED_LIBS
+  openLibrary = true;
+  return false;
+#endif // ifndef BUILD_SHARED_LIBS else
+}
 
+//-----------------------------------------------------------------------------
+bool vtkPVPluginLoader::LoadPluginLibrary(const char* file, const char* libraryfile, bool no_errors)
+{
+#if !BUILD_SHARED_LIBS
+  (void)file;
+  (void)libraryfile;
+  vtkPVPluginLoaderErrorMacro("Cannot load dynamic plugins in static builds.");
+#else // ifndef BUILD_SHARED_LIBS
   int flags = 0;
 #ifdef _WIN32
   // Windows doesn't have rpath or other mechanisms for specifying where
@@ -527,11 +768,11 @@ bool vtkPVPluginLoader::LoadPluginInternal(const char* file, bool no_errors)
   flags |= vtksys::DynamicLoader::RTLDGlobal;
 #endif
 
-  vtkLibHandle lib = vtkDynamicLoader::OpenLibrary(file, flags);
+  vtkLibHandle lib = vtkDynamicLoader::OpenLibrary(libraryfile, flags);
   if (!lib)
   {
     std::stringstream ostr;
-    ostr << file << ": " << vtkDynamicLoader::LastError();
+    ostr << libraryfile << ": " << vtkDynamicLoader::LastError();
     std::string str = ostr.str();
     vtkPVPluginLoaderErrorMacro(str.c_str());
     vtkVLogIfF(PARAVIEW_LOG_PLUGIN_VERBOSITY(), this->ErrorString != nullptr,
@@ -637,6 +878,122 @@ bool vtkPVPluginLoader::LoadPluginInternal(vtkPVPlugin* plugin)
   return true;
 }
 
+//-----------------------------------------------------------------------------
+bool vtkPVPluginLoader::LoadPluginLibraryInParallel(const char* file, bool no_errors)
+{
+  auto controller = vtkMultiProcessController::GetGlobalController();
+  const int rank = controller->GetLocalProcessId();
+  const char* localdir = vtkPVPluginLoader::GetLocalLibraryDirectory();
+
+  // The root rank loads the plugin from the original location and shares its
+  // metadata (and the library itself, if requested) with the other ranks.
+  vtkMultiProcessStream stream;
+  std::vector<char> library;
+  bool status = false;
+  if (rank == 0)
+  {
+    status = this->LoadPluginLibrary(file, file, no_errors);
+    vtkPVPlugin* plugin = status ? vtkFindRegisteredPlugin(this->PluginName) : nullptr;
+    status = (plugin != nullptr);
+    stream << status;
+    if (status)
+    {
+      std::vector<std::string> xmls;
+      if (auto smplugin = dynamic_cast<vtkPVServerManagerPluginInterface*>(plugin))
+      {
+        smplugin->GetXMLs(xmls);
+      }
+      const bool immediate = dynamic_cast<vtkPVDynamicInitializerPluginInterface*>(plugin) ||
+        dynamic_cast<vtkPVPythonPluginInterface*>(plugin);
+      stream << std::string(plugin->GetPluginName())
+             << std::string(plugin->GetPluginVersionString())
+             << std::string(plugin->GetDescription() ? plugin->GetDescription() : "")
+             << std::string(plugin->GetRequiredPlugins() ? plugin->GetRequiredPlugins() : "")
+             << plugin->GetRequiredOnServer() << plugin->GetRequiredOnClient() << immediate
+             << static_cast<unsigned int>(xmls.size());
+      for (const auto& xml : xmls)
+      {
+        stream << xml;
+      }
+      if (localdir && !vtkReadPluginLibrary(file, library))
+      {
+        vtkVLogF(PARAVIEW_LOG_PLUGIN_VERBOSITY(),
+          "Failed to read `%s`; other ranks will load it from its original location.", file);
+      }
+      stream << static_cast<vtkTypeUInt64>(library.size());
+    }
+    else
+    {
+      stream << std::string(this->ErrorString ? this->ErrorString : "");
+    }
+  }
+  controller->Broadcast(stream, 0);
+  if (rank == 0)
+  {
+    if (!library.empty())
+    {
+      controller->Broadcast(library.data(), static_cast<vtkIdType>(library.size()), 0);
+    }
+    return status;
+  }
+
+  stream >> status;
+  if (!status)
+  {
+    std::string error;
+    stream >> error;
+    vtkPVPluginLoaderErrorMacro(error.c_str());
+    return false;
+  }
+
+  auto plugin = new vtkPVDeferredPlugin();
+  vtkPVPluginLoaderCleaner::GetInstance()->Register(plugin);
+  bool immediate;
+  unsigned int numberOfXMLs;
+  stream >> plugin->PluginName >> plugin->PluginVersion >> plugin->Description >>
+    plugin->RequiredPlugins >> plugin->RequiredOnServer >> plugin->RequiredOnClient >> immediate >>
+    numberOfXMLs;
+  plugin->XMLs.resize(numberOfXMLs);
+  for (auto& xml : plugin->XMLs)
+  {
+    stream >> xml;
+  }
+  vtkTypeUInt64 librarySize;
+  stream >> librarySize;
+
+  plugin->LibraryFile = file;
+  if (librarySize > 0)
+  {
+    library.resize(static_cast<size_t>(librarySize));
+    controller->Broadcast(library.data(), static_cast<vtkIdType>(library.size()), 0);
+    const std::string localfile = vtkSavePluginLibrary(localdir, file, library, rank);
+    if (!localfile.empty())
+    {
+      plugin->LibraryFile = localfile;
+    }
+    else
+    {
+      vtkVLogF(PARAVIEW_LOG_PLUGIN_VERBOSITY(),
+        "Failed to save `%s` under `%s`; loading it from its original location.", file, localdir);
+    }
+  }
+
+  if (immediate || !vtkPVPluginLoader::GetLazyLoading())
+  {
+    plugin->Loaded = true;
+    return this->LoadPluginLibrary(file, plugin->LibraryFile.c_str(), no_errors);
+  }
+
+  vtkVLogF(PARAVIEW_LOG_PLUGIN_VERBOSITY(), "Deferring loading of `%s` until first use.", file);
+  plugin->CollectClassNames();
+  plugin->SetFileName(file);
+  this->SetPluginName(plugin->GetPluginName());
+  this->SetPluginVersion(plugin->GetPluginVersionString());
+  vtkPVPluginTracker::GetInstance()->RegisterDeferredPlugin(plugin);
+  this->Loaded = true;
+  return true;
+}
+
 //-----------------------------------------------------------------------------
 void vtkPVPluginLoader::LoadPluginConfigurationXMLFromString(const char* xmlcontents)
 {
@@ -652,6 +1009,7 @@ void vtkPVPluginLoader::PrintSelf(ostream& os, vtkIndent indent)
      << endl;
   os << indent << "FileName: " << (this->FileName ? this->FileName : "(none)") << endl;
   os << indent << "SearchPaths: " << (this->SearchPaths ? this->SearchPaths : "(none)") << endl;
+  os << indent << "Collective: " << this->Collective << endl;
 }
 
 //-----------------------------------------------------------------------------
@@ -700,3 +1058,84 @@ bool vtkPVPluginLoader::CallPluginLoaderCallbacks(const char* nameOrFile)
   }
   return false;
 }
+
+//-----------------------------------------------------------------------------
+void vtkPVPluginLoader::SetLazyLoading(bool val)
+{
+  ::PluginLazyLoading = val ? 1 : 0;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkPVPluginLoader::GetLazyLoading()
+{
+  if (::PluginLazyLoading == -1)
+  {
+    const char* env = vtksys::SystemTools::GetEnv("PV_PLUGIN_LAZY_LOAD");
+    ::PluginLazyLoading = (env && *env && strcmp(env, "0") != 0) ? 1 : 0;
+  }
+  return ::PluginLazyLoading == 1;
+}
+
+//-----------------------------------------------------------------------------
+void vtkPVPluginLoader::SetLocalLibraryDirectory(const char* dir)
+{
+  if (::PluginLocalLibraryDirectory == nullptr)
+  {
+    ::PluginLocalLibraryDirectory = new std::string();
+  }
+  *::PluginLocalLibraryDirectory = dir ? dir : "";
+}
+
+//-----------------------------------------------------------------------------
+const char* vtkPVPluginLoader::GetLocalLibraryDirectory()
+{
+  if (::PluginLocalLibraryDirectory == nullptr)
+  {
+    const char* env = vtksys::SystemTools::GetEnv("PV_PLUGIN_LOCAL_LIBRARY_DIR");
+    ::PluginLocalLibraryDirectory = new std::string(env ? env : "");
+  }
+  return ::PluginLocalLibraryDirectory->empty() ? nullptr : ::PluginLocalLibraryDirectory->c_str();
+}
+
+//-----------------------------------------------------------------------------
+bool vtkPVPluginLoader::LoadDeferredPlugins(const char* classname)
+{
+  std::vector<vtkPVDeferredPlugin*> pending;
+  for (auto plugin : vtkPVPluginLoaderCleaner::GetInstance()->GetDeferredPlugins())
+  {
+    if (!plugin->Loaded)
+    {
+      pending.push_back(plugin);
+    }
+  }
+  if (pending.empty())
+  {
+    return false;
+  }
+
+  // if a deferred plugin names the class in its XMLs, only that one needs to be
+  // loaded; otherwise, the class may be created internally by any of them.
+  std::vector<vtkPVDeferredPlugin*> toload;
+  for (auto plugin : pending)
+  {
+    if (classname && plugin->ClassNames.find(classname) != plugin->ClassNames.end())
+    {
+      toload.push_back(plugin);
+    }
+  }
+  if (toload.empty())
+  {
+    toload = pending;
+  }
+
+  bool loaded = false;
+  for (auto plugin : toload)
+  {
+    vtkVLogF(PARAVIEW_LOG_PLUGIN_VERBOSITY(), "Loading deferred plugin `%s` for `%s`.",
+      plugin->GetPluginName(), (classname ? classname : "(nullptr)"));
+    plugin->Loaded = true;
+    vtkNew<vtkPVPluginLoader> loader;
+    loaded |= loader->LoadPluginLibrary(plugin->GetFileName(), plugin->LibraryFile.c_str(), false);
+  }
+  return loaded;
+}
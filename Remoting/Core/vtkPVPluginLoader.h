@@ -27,6 +27,16 @@
  * This class only needed when loading plugins from shared libraries
  * dynamically. For statically importing plugins, one directly uses
  * PV_PLUGIN_IMPORT() macro defined in vtkPVPlugin.h.
+ *
+ * On parallel servers, loading the same shared libraries on every rank can
+ * overwhelm the parallel filesystem. Two options help with that. With lazy
+ * loading enabled, only the root rank opens the library. The other ranks
+ * register the plugin from the metadata gathered by the root rank and open
+ * the library the first time one of its VTK classes is instantiated. With a
+ * local library directory set, the root rank reads the library and broadcasts
+ * it. The other ranks save it to node-local storage and load it from there.
+ * See SetLazyLoading() and SetLocalLibraryDirectory(). Both only apply to
+ * collective loads (see SetCollective()).
  */
 
 #ifndef vtkPVPluginLoader_h
@@ -154,18 +164,90 @@ public:
    */
   static void PluginLibraryUnloaded(const char* pluginname);
 
+  ///@{
+  /**
+   * Set to true when LoadPlugin() is called on all ranks of a parallel server
+   * together, as vtkSMPluginLoaderProxy does. Lazy loading and the local
+   * library directory involve collective communication, so they are only used
+   * for such loads; other loads open the library on each rank. Default is false.
+   */
+  vtkSetMacro(Collective, bool);
+  vtkGetMacro(Collective, bool);
+  vtkBooleanMacro(Collective, bool);
+  ///@}
+
+  ///@{
+  /**
+   * When enabled, plugin shared libraries loaded on a parallel server are only
+   * opened on the root rank. Other ranks register the plugin using the metadata
+   * and server-manager XMLs gathered by the root rank, and open the library
+   * when one of its VTK classes is first needed (see LoadDeferredPlugins()).
+   * Plugins that run code when loaded or that provide Python modules are
+   * always loaded right away.
+   *
+   * Defaults to the value of the `PV_PLUGIN_LAZY_LOAD` environment variable,
+   * if set, and false otherwise.
+   */
+  static void SetLazyLoading(bool);
+  static bool GetLazyLoading();
+  ///@}
+
+  ///@{
+  /**
+   * When set to a non-empty directory, the root rank of a parallel server reads
+   * each plugin shared library and broadcasts it to the other ranks. Those ranks
+   * save it under this directory and load that copy. Use node-local storage,
+   * e.g. `/tmp`, so that only the root rank reads from the parallel filesystem.
+   * Dependencies of the plugin are still looked up next to the original library.
+   *
+   * Defaults to the value of the `PV_PLUGIN_LOCAL_LIBRARY_DIR` environment
+   * variable, if set.
+   */
+  static void SetLocalLibraryDirectory(const char* dir);
+  static const char* GetLocalLibraryDirectory();
+  ///@}
+
+  /**
+   * Loads the deferred plugins that provide the VTK class `classname` (see
+   * SetLazyLoading()). If no deferred plugin lists that class, all deferred
+   * plugins are loaded. Returns true if any plugin was loaded.
+   */
+  static bool LoadDeferredPlugins(const char* classname);
+
 protected:
   vtkPVPluginLoader();
   ~vtkPVPluginLoader() override;
 
   bool LoadPluginInternal(const char* filename, bool no_errors);
 
+  /**
+   * Called by LoadPluginInternal() to load the plugin `filename` when no
+   * shared library needs to be opened, e.g. an XML plugin or a plugin that is
+   * already loaded. Otherwise, sets `openLibrary` to true and returns false.
+   */
+  bool LoadPluginFromFile(const char* filename, bool no_errors, bool& openLibrary);
+
   /**
    * Called by LoadPluginInternal() to do the final steps in loading of a
    * plugin.
    */
   bool LoadPluginInternal(vtkPVPlugin* plugin);
 
+  /**
+   * Called by LoadPluginInternal() to open the shared library `libraryfile`
+   * and load the plugin it provides. `filename` is the name the plugin is
+   * tracked with; it differs from `libraryfile` when loading a copy saved in
+   * the local library directory.
+   */
+  bool LoadPluginLibrary(const char* filename, const char* libraryfile, bool no_errors);
+
+  /**
+   * Called by LoadPluginInternal() instead of LoadPluginLibrary() for
+   * collective loads on parallel servers when lazy loading or the local
+   * library directory is enabled. This must be called on all ranks.
+   */
+  bool LoadPluginLibraryInParallel(const char* filename, bool no_errors);
+
   vtkSetStringMacro(ErrorString);
   vtkSetStringMacro(PluginName);
   vtkSetStringMacro(PluginVersion);
@@ -178,6 +260,7 @@ protected:
   char* FileName;
   char* SearchPaths;
   bool Loaded;
+  bool Collective;
 
 private:
   vtkPVPluginLoader(const vtkPVPluginLoader&) = delete;
@@ -59,10 +59,12 @@ public:
   std::string PluginName;
   vtkPVPlugin* Plugin;
   bool AutoLoad;
+  bool Deferred;
   vtkItem()
   {
     this->Plugin = nullptr;
     this->AutoLoad = false;
+    this->Deferred = false;
   }
 };
 
@@ -537,6 +539,7 @@ void vtkPVPluginTracker::RegisterPlugin(vtkPVPlugin* plugin)
 {
   assert(plugin != nullptr);
 
+  bool wasDeferred = false;
   vtkPluginsList::iterator iter = this->PluginsList->LocateUsingPluginName(plugin->GetPluginName());
   if (iter == this->PluginsList->end())
   {
@@ -548,6 +551,8 @@ void vtkPVPluginTracker::RegisterPlugin(vtkPVPlugin* plugin)
   }
   else
   {
+    wasDeferred = iter->Deferred;
+    iter->Deferred = false;
     iter->Plugin = plugin;
     if (plugin->GetFileName())
     {
@@ -600,7 +605,21 @@ void vtkPVPluginTracker::RegisterPlugin(vtkPVPlugin* plugin)
     }
   }
 
-  this->InvokeEvent(vtkCommand::RegisterEvent, plugin);
+  // The XMLs of a deferred plugin were processed when its stand-in was registered.
+  if (!wasDeferred)
+  {
+    this->InvokeEvent(vtkCommand::RegisterEvent, plugin);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVPluginTracker::RegisterDeferredPlugin(vtkPVPlugin* plugin)
+{
+  this->RegisterPlugin(plugin);
+
+  vtkPluginsList::iterator iter = this->PluginsList->LocateUsingPluginName(plugin->GetPluginName());
+  assert(iter != this->PluginsList->end());
+  iter->Deferred = true;
 }
 
 //----------------------------------------------------------------------------
@@ -66,6 +66,16 @@ public:
    */
   void RegisterPlugin(vtkPVPlugin*);
 
+  /**
+   * Called by vtkPVPluginLoader to register a stand-in for a plugin whose
+   * shared library has not been loaded yet on this process. The stand-in
+   * provides the plugin metadata and server-manager XMLs, and is processed
+   * just like RegisterPlugin() does. When the actual plugin is registered
+   * later, vtkCommand::RegisterEvent is not fired again since its XMLs have
+   * already been processed.
+   */
+  void RegisterDeferredPlugin(vtkPVPlugin*);
+
   /**
    * This API is used to register available plugins without actually loading
    * them.
@@ -15,9 +15,12 @@
 #include "vtkSMCSVExporterProxy.h"
 
 #include "vtkCSVExporter.h"
+#include "vtkClientServerStream.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVSession.h"
 #include "vtkPVXYChartView.h"
 #include "vtkSMPropertyHelper.h"
+#include "vtkSMSession.h"
 #include "vtkSMViewProxy.h"
 #include "vtkSpreadSheetView.h"
 
@@ -69,7 +72,28 @@ void vtkSMCSVExporterProxy::Write()
   vtkObjectBase* obj = this->View->GetClientSideObject();
   if (vtkSpreadSheetView* sview = vtkSpreadSheetView::SafeDownCast(obj))
   {
-    sview->Export(exporter);
+    if (vtkSMPropertyHelper(this, "WriteOnDataServer", /*quiet*/ true).GetAsInt() != 0)
+    {
+      // let the data server processes write the file directly, in parallel,
+      // rather than fetching all rows to the client.
+      vtkClientServerStream stream;
+      stream << vtkClientServerStream::Invoke << VTKOBJECT(this->View) << "ExportOnDataServer"
+             << fileName.c_str() << exporter->GetFieldDelimiter() << exporter->GetFormatting()
+             << exporter->GetPrecision() << vtkClientServerStream::End;
+      vtkSMSession* session = this->View->GetSession();
+      session->ExecuteStream(vtkPVSession::DATA_SERVER, stream, false);
+
+      bool success = false;
+      session->GetLastResult(vtkPVSession::DATA_SERVER_ROOT).GetArgument(0, 0, &success);
+      if (!success)
+      {
+        vtkErrorMacro("Failed to export '" << fileName << "' on the data server.");
+      }
+    }
+    else
+    {
+      sview->Export(exporter);
+    }
   }
   else if (vtkPVContextView* cview = vtkPVContextView::SafeDownCast(obj))
   {
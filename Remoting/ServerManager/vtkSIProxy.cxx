@@ -22,6 +22,7 @@
 #include "vtkLogger.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVPluginLoader.h"
 #include "vtkPVSessionCore.h"
 #include "vtkPVXMLElement.h"
 #include "vtkPVXMLParser.h"
@@ -469,7 +470,13 @@ bool vtkSIProxy::CreateVTKObjects()
 //----------------------------------------------------------------------------
 vtkObjectBase* vtkSIProxy::NewVTKObject(const char* className)
 {
-  return this->Interpreter->NewInstance(className);
+  vtkObjectBase* obj = this->Interpreter->NewInstance(className);
+  if (obj == nullptr && vtkPVPluginLoader::LoadDeferredPlugins(className))
+  {
+    // the class is provided by a plugin whose loading was deferred on this rank.
+    obj = this->Interpreter->NewInstance(className);
+  }
+  return obj;
 }
 
 //----------------------------------------------------------------------------
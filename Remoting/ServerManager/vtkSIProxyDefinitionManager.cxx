@@ -17,6 +17,8 @@
 #include "vtkCollection.h"
 #include "vtkCollectionIterator.h"
 #include "vtkCommand.h"
+#include "vtkMultiProcessController.h"
+#include "vtkMultiProcessStream.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVPlugin.h"
@@ -24,6 +26,7 @@
 #include "vtkPVProxyDefinitionIterator.h"
 #include "vtkPVServerManagerPluginInterface.h"
 #include "vtkPVSession.h"
+#include "vtkPVVersion.h"
 #include "vtkPVXMLElement.h"
 #include "vtkPVXMLParser.h"
 #include "vtkProcessModule.h"
@@ -33,14 +36,20 @@
 #include "vtkStringList.h"
 #include "vtkTimerLog.h"
 
+#include <algorithm>
 #include <cassert>
+#include <fstream>
+#include <iterator>
 #include <map>
+#include <random>
 #include <set>
 #include <sstream>
 #include <string>
 #include <vector>
 
+#include <vtksys/MD5.h>
 #include <vtksys/RegularExpression.hxx>
+#include <vtksys/SystemTools.hxx>
 
 //****************************************************************************/
 //                    Internal Classes and typedefs
@@ -49,9 +58,106 @@ typedef vtkSmartPointer<vtkPVXMLElement> XMLElement;
 typedef std::map<std::string, XMLElement> StrToXmlMap;
 typedef std::map<std::string, StrToXmlMap> StrToStrToXmlMap;
 
+namespace
+{
+// Bump when the layout of cache files changes.
+constexpr int PROXY_DEFINITION_CACHE_FORMAT = 2;
+
+std::string ComputeXMLKey(const char* xmlContent)
+{
+  char hex[32];
+  vtksysMD5* md5 = vtksysMD5_New();
+  vtksysMD5_Initialize(md5);
+  vtksysMD5_Append(md5, reinterpret_cast<const unsigned char*>(xmlContent), -1);
+  vtksysMD5_FinalizeHex(md5, hex);
+  vtksysMD5_Delete(md5);
+  return std::string(hex, 32);
+}
+
+std::string GetCacheDirectory()
+{
+  const char* dir = vtksys::SystemTools::GetEnv("PV_PROXY_DEFINITION_CACHE_DIR");
+  return (dir && *dir) ? std::string(dir) : std::string();
+}
+
+std::string GetCacheFileName(const std::string& key)
+{
+  const std::string dir = GetCacheDirectory();
+  return dir.empty() ? dir : dir + "/" + key + ".pvxmlc";
+}
+
+// Cache files start with this header, followed by the serialized definition.
+std::string GetCacheHeader(const std::string& key)
+{
+  std::ostringstream header;
+  header << "pvxmlc" << PROXY_DEFINITION_CACHE_FORMAT << '\n'
+         << PARAVIEW_VERSION_FULL << '\n'
+         << key << '\n';
+  return header.str();
+}
+
+// Returns nullptr if the cache file is missing, stale or invalid, in which
+// case the XML is parsed instead.
+XMLElement ReadCachedDefinition(const std::string& key)
+{
+  const std::string fname = GetCacheFileName(key);
+  if (fname.empty() || !vtksys::SystemTools::FileExists(fname, /*isFile=*/true))
+  {
+    return nullptr;
+  }
+
+  std::ifstream file(fname, std::ios::binary);
+  std::vector<unsigned char> raw(
+    (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  const std::string header = GetCacheHeader(key);
+  if (raw.size() < header.size() || !std::equal(header.begin(), header.end(), raw.begin()))
+  {
+    return nullptr;
+  }
+
+  auto root = vtkSmartPointer<vtkPVXMLElement>::New();
+  return root->Deserialize(raw.data() + header.size(), raw.size() - header.size()) ? root
+                                                                                   : nullptr;
+}
+
+void WriteCachedDefinition(const std::string& key, vtkPVXMLElement* root)
+{
+  const std::string fname = GetCacheFileName(key);
+  if (fname.empty())
+  {
+    return;
+  }
+
+  const std::string header = GetCacheHeader(key);
+  std::vector<unsigned char> raw(header.begin(), header.end());
+  root->Serialize(raw);
+
+  // write to a unique temporary file and rename so that concurrent runs never
+  // see partially written files.
+  std::random_device rd;
+  const std::string tmpname = fname + "." + std::to_string(rd()) + ".tmp";
+  {
+    std::ofstream file(tmpname, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(raw.data()), raw.size());
+    if (!file)
+    {
+      vtksys::SystemTools::RemoveFile(tmpname);
+      return;
+    }
+  }
+  if (!vtksys::SystemTools::RenameFile(tmpname, fname))
+  {
+    vtksys::SystemTools::RemoveFile(tmpname);
+  }
+}
+}
+
 class vtkSIProxyDefinitionManager::vtkInternals
 {
 public:
+  // Definitions parsed ahead of time (received from the root rank), keyed on
+  // the MD5 of their XML contents.
+  std::map<std::string, XMLElement> Preparsed;
   // Keep State Flag of the ProcessType
   bool EnableXMLProxyDefinitionUpdate;
   // To know if override need to be taken into account and replaced in the parent
@@ -428,6 +534,8 @@ vtkSIProxyDefinitionManager::vtkSIProxyDefinitionManager()
 
   vtkPVPluginTracker* tracker = vtkPVPluginTracker::GetInstance();
 
+  this->BroadcastDefinitionsFromRoot();
+
   // Load the core xmls.
   // These are loaded from the vtkPVInitializerPlugin plugin.
   for (unsigned int cc = 0; cc < tracker->GetNumberOfPlugins(); cc++)
@@ -458,6 +566,8 @@ vtkSIProxyDefinitionManager::vtkSIProxyDefinitionManager()
   // definitions.
   tracker->AddObserver(
     vtkCommand::RegisterEvent, this, &vtkSIProxyDefinitionManager::OnPluginLoaded);
+
+  this->Internals->Preparsed.clear();
 }
 
 //---------------------------------------------------------------------------
@@ -769,9 +879,115 @@ bool vtkSIProxyDefinitionManager::LoadConfigurationXMLFromString(const char* xml
 bool vtkSIProxyDefinitionManager::LoadConfigurationXMLFromString(
   const char* xmlContent, bool attachHints)
 {
+  vtkSmartPointer<vtkPVXMLElement> root = this->ParseXML(xmlContent);
+  return root != nullptr && this->LoadConfigurationXML(root, attachHints);
+}
+
+//---------------------------------------------------------------------------
+vtkSmartPointer<vtkPVXMLElement> vtkSIProxyDefinitionManager::ParseXML(const char* xmlContent)
+{
+  if (xmlContent == nullptr)
+  {
+    return nullptr;
+  }
+
+  if (GetCacheDirectory().empty() && this->Internals->Preparsed.empty())
+  {
+    vtkNew<vtkPVXMLParser> parser;
+    return parser->Parse(xmlContent) ? parser->GetRootElement() : nullptr;
+  }
+
+  const std::string key = ComputeXMLKey(xmlContent);
+  auto iter = this->Internals->Preparsed.find(key);
+  if (iter != this->Internals->Preparsed.end())
+  {
+    XMLElement root = iter->second;
+    this->Internals->Preparsed.erase(iter);
+    return root;
+  }
+
+  if (XMLElement root = ReadCachedDefinition(key))
+  {
+    return root;
+  }
+
   vtkNew<vtkPVXMLParser> parser;
-  return (parser->Parse(xmlContent) != 0) &&
-    this->LoadConfigurationXML(parser->GetRootElement(), attachHints);
+  if (!parser->Parse(xmlContent))
+  {
+    return nullptr;
+  }
+  XMLElement root = parser->GetRootElement();
+  auto controller = vtkMultiProcessController::GetGlobalController();
+  if (controller == nullptr || controller->GetLocalProcessId() == 0)
+  {
+    WriteCachedDefinition(key, root);
+  }
+  return root;
+}
+
+//---------------------------------------------------------------------------
+void vtkSIProxyDefinitionManager::BroadcastDefinitionsFromRoot()
+{
+  auto controller = vtkMultiProcessController::GetGlobalController();
+  if (controller == nullptr || controller->GetNumberOfProcesses() <= 1)
+  {
+    return;
+  }
+
+  vtkTimerLog::MarkStartEvent("Broadcast proxy definitions");
+  vtkMultiProcessStream stream;
+  if (controller->GetLocalProcessId() == 0)
+  {
+    std::map<std::string, XMLElement> parsed;
+    vtkPVPluginTracker* tracker = vtkPVPluginTracker::GetInstance();
+    for (unsigned int cc = 0; cc < tracker->GetNumberOfPlugins(); cc++)
+    {
+      auto smplugin = dynamic_cast<vtkPVServerManagerPluginInterface*>(tracker->GetPlugin(cc));
+      if (smplugin == nullptr)
+      {
+        continue;
+      }
+      std::vector<std::string> xmls;
+      smplugin->GetXMLs(xmls);
+      for (const auto& xml : xmls)
+      {
+        if (XMLElement root = this->ParseXML(xml.c_str()))
+        {
+          parsed[ComputeXMLKey(xml.c_str())] = root;
+        }
+      }
+    }
+
+    stream << static_cast<unsigned int>(parsed.size());
+    for (const auto& pair : parsed)
+    {
+      stream << pair.first;
+      pair.second->Serialize(stream);
+    }
+    this->Internals->Preparsed = std::move(parsed);
+  }
+
+  controller->Broadcast(stream, 0);
+
+  if (controller->GetLocalProcessId() != 0)
+  {
+    unsigned int count = 0;
+    stream >> count;
+    for (unsigned int cc = 0; cc < count; ++cc)
+    {
+      std::string key;
+      stream >> key;
+      auto root = vtkSmartPointer<vtkPVXMLElement>::New();
+      if (!root->Deserialize(stream))
+      {
+        vtkErrorMacro("Failed to receive proxy definitions from root rank.");
+        this->Internals->Preparsed.clear();
+        break;
+      }
+      this->Internals->Preparsed[key] = root;
+    }
+  }
+  vtkTimerLog::MarkEndEvent("Broadcast proxy definitions");
 }
 
 //---------------------------------------------------------------------------
@@ -37,6 +37,14 @@
  * \li \c vtkCommand::UnRegisterEvent - Fired when a proxy definition is
  * removed. Since this class only support removing custom proxies, this event is
  * fired only when a custom proxy is removed.
+ *
+ * Parsing the XML definitions of ParaView and its plugins is a noticeable part
+ * of the startup time. When the environment variable
+ * `PV_PROXY_DEFINITION_CACHE_DIR` points to a writable directory, parsed
+ * definitions are cached there in a binary form keyed on the MD5 of the XML
+ * contents and the ParaView version, and reused by later runs. In parallel
+ * runs, the definitions known at construction time are parsed (or read from
+ * the cache) on the root rank only and broadcast to the other ranks.
  */
 
 #ifndef vtkSIProxyDefinitionManager_h
@@ -44,6 +52,7 @@
 
 #include "vtkRemotingServerManagerModule.h" //needed for exports
 #include "vtkSIObject.h"
+#include "vtkSmartPointer.h" // for vtkSmartPointer
 
 class vtkPVPlugin;
 class vtkPVProxyDefinitionIterator;
@@ -270,6 +279,20 @@ protected:
   bool LoadConfigurationXMLFromString(const char* xmlContent, bool attachShowInMenuHints);
   ///@}
 
+  /**
+   * Returns the root element for the given XML contents. Uses definitions
+   * received from the root rank or the on-disk cache when available and
+   * parses the XML otherwise.
+   */
+  vtkSmartPointer<vtkPVXMLElement> ParseXML(const char* xmlContent);
+
+  /**
+   * In parallel runs, parse the XML of all loaded plugins on the root rank and
+   * broadcast the result to the other ranks. This is collective on the global
+   * controller.
+   */
+  void BroadcastDefinitionsFromRoot();
+
   ///@{
   /**
    * Callback called when a plugin is loaded.
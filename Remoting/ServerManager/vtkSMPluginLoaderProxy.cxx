@@ -30,7 +30,11 @@ bool vtkSMPluginLoaderProxy::LoadPlugin(const char* filename)
 {
   this->CreateVTKObjects();
 
+  // the stream is executed by all ranks of the server, so the plugin may be
+  // loaded collectively.
   vtkClientServerStream stream;
+  stream << vtkClientServerStream::Invoke << VTKOBJECT(this) << "SetCollective" << 1
+         << vtkClientServerStream::End;
   stream << vtkClientServerStream::Invoke << VTKOBJECT(this) << "LoadPlugin" << filename
          << vtkClientServerStream::End;
   this->ExecuteStream(stream);
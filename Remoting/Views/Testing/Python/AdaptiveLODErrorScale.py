@@ -0,0 +1,44 @@
+from paraview.simple import *
+
+# Checks that the adaptive LOD screen-space error scale relaxes when
+# interactive renders are over LODFrameBudget and tightens back when they are
+# well within it.
+
+view = CreateView("RenderView")
+view.UseAdaptiveLOD = 1
+view.LODFrameBudget = 0.1
+Show(Sphere(), view)
+Render(view)
+
+rv = view.GetClientSideObject()
+assert rv.GetAdaptiveLODErrorScale() == 1.0
+
+def check(frameTime, expected):
+    rv.UpdateAdaptiveLODErrorScale(frameTime)
+    scale = rv.GetAdaptiveLODErrorScale()
+    assert scale == expected, \
+        "frame time %g: expected scale %g, got %g" % (frameTime, expected, scale)
+
+# over budget: coarser LOD levels.
+check(0.2, 2.0)
+check(0.2, 4.0)
+
+# the scale is part of the parameters pushed to the representations, and a
+# change requires new LOD geometry.
+params = [0.0] * 8
+rv.ComputeAdaptiveLODParameters(params)
+assert params[7] == 4.0
+assert rv.GetAdaptiveLODNeedsUpdate()
+
+# within budget but not by much: unchanged.
+check(0.07, 4.0)
+
+# well within budget: finer LOD levels, down to the requested error.
+check(0.01, 2.0)
+check(0.01, 1.0)
+check(0.01, 1.0)
+
+# the scale is bounded when renders stay over budget.
+for i in range(10):
+    rv.UpdateAdaptiveLODErrorScale(1.0)
+assert rv.GetAdaptiveLODErrorScale() == 64.0
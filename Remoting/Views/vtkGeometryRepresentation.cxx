@@ -61,6 +61,8 @@
 #include <vtk_jsoncpp.h>
 #include <vtksys/SystemTools.hxx>
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <numeric>
 #include <tuple>
@@ -423,6 +425,13 @@ int vtkGeometryRepresentation::ProcessViewRequest(
         // the rendering node as and when needed.
         vtkPVView::SetPieceLOD(inInfo, this, this->LODOutlineFilter->GetOutputDataObject(0));
       }
+      else if (inInfo->Has(vtkPVRenderView::LOD_NUMBER_OF_LEVELS()))
+      {
+        // The level to use may change without the data changing, so discard
+        // the previous LOD geometry to ensure the new one gets delivered.
+        vtkPVView::ClearPieceLOD(inInfo, this);
+        vtkPVView::SetPieceLOD(inInfo, this, this->GetAdaptiveLODLevel(inInfo, data));
+      }
       else
       {
         if (inInfo->Has(vtkPVRenderView::LOD_RESOLUTION()))
@@ -1552,6 +1561,65 @@ void vtkGeometryRepresentation::SetMaterial(const char* val)
 #endif
 }
 
+//----------------------------------------------------------------------------
+vtkDataObject* vtkGeometryRepresentation::GetAdaptiveLODLevel(
+  vtkInformation* inInfo, vtkDataObject* data)
+{
+  using vtkGeometryRepresentation_detail::DecimationFilterType;
+
+  const double resolution = inInfo->Has(vtkPVRenderView::LOD_RESOLUTION())
+    ? inInfo->Get(vtkPVRenderView::LOD_RESOLUTION())
+    : 0.5;
+  const int numLevels = std::max(inInfo->Get(vtkPVRenderView::LOD_NUMBER_OF_LEVELS()), 1);
+  if (this->LODLevelsDataTime != data->GetMTime() || this->LODLevelsResolution != resolution ||
+    static_cast<int>(this->LODLevels.size()) != numLevels)
+  {
+    this->LODLevels.clear();
+    this->LODLevels.resize(numLevels);
+    this->LODLevelsDataTime = data->GetMTime();
+    this->LODLevelsResolution = resolution;
+  }
+
+  // The finest level uses the view's LOD resolution, every coarser level halves it.
+  auto levelFactor = [&](int level) { return resolution * std::pow(0.5, numLevels - 1 - level); };
+
+  // Pick the coarsest level for which a clustering cell does not cover more
+  // pixels than tolerated. Without a valid projected size (e.g. empty data), use
+  // the finest level.
+  const double projectedSize = vtkPVRenderView::GetProjectedSize(inInfo, this->VisibleDataBounds);
+  const double tolerance = inInfo->Has(vtkPVRenderView::LOD_SCREEN_SPACE_ERROR())
+    ? inInfo->Get(vtkPVRenderView::LOD_SCREEN_SPACE_ERROR())
+    : 1.0;
+  int level = numLevels - 1;
+  if (projectedSize >= 0)
+  {
+    for (int cc = 0; cc < numLevels; ++cc)
+    {
+      if (projectedSize / DecimationFilterType::GetLODDivisions(levelFactor(cc)) <= tolerance)
+      {
+        level = cc;
+        break;
+      }
+    }
+  }
+
+  auto& levelData = this->LODLevels[level];
+  if (levelData == nullptr)
+  {
+    this->Decimator->SetLODFactor(levelFactor(level));
+    this->Decimator->SetInputDataObject(data);
+    this->Decimator->Update();
+
+    auto output = this->Decimator->GetOutputDataObject(0);
+    levelData.TakeReference(output->NewInstance());
+    levelData->ShallowCopy(output);
+  }
+
+  vtkVLogF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "%s: using LOD level %d/%d (projected size: %g px)",
+    this->GetLogName().c_str(), level, numLevels, projectedSize);
+  return levelData;
+}
+
 //----------------------------------------------------------------------------
 void vtkGeometryRepresentation::ComputeVisibleDataBounds()
 {
@@ -31,11 +31,13 @@
 #include "vtkPVDataRepresentation.h"
 #include "vtkProperty.h"            // needed for VTK_POINTS etc.
 #include "vtkRemotingViewsModule.h" // needed for exports
+#include "vtkSmartPointer.h"        // needed for vtkSmartPointer
 #include "vtkVector.h"              // for vtkVector.
 
 #include <set>           // needed for std::set
 #include <string>        // needed for std::string
 #include <unordered_map> // needed for std::unordered_map
+#include <vector>        // needed for std::vector
 
 class vtkCompositeDataDisplayAttributes;
 class vtkCompositePolyDataMapper2;
@@ -459,11 +461,24 @@ protected:
    */
   virtual void SetPointArrayToProcess(int p, const char* val);
 
+  /**
+   * Returns the decimated geometry to use for LOD rendering when the view
+   * requests adaptive LOD (see vtkPVRenderView::SetUseAdaptiveLOD). The level
+   * is picked using the projected size of this representation and the levels
+   * are built lazily, and kept until `data` or the LOD resolution change.
+   */
+  vtkDataObject* GetAdaptiveLODLevel(vtkInformation* inInfo, vtkDataObject* data);
+
   vtkAlgorithm* GeometryFilter;
   vtkAlgorithm* MultiBlockMaker;
   vtkGeometryRepresentation_detail::DecimationFilterType* Decimator;
   vtkPVGeometryFilter* LODOutlineFilter;
 
+  // Adaptive LOD hierarchy, coarsest level first.
+  std::vector<vtkSmartPointer<vtkDataObject>> LODLevels;
+  vtkMTimeType LODLevelsDataTime = 0;
+  double LODLevelsResolution = -1.0;
+
   vtkMapper* Mapper;
   vtkMapper* LODMapper;
   vtkPVLODActor* Actor;
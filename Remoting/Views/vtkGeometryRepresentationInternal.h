@@ -41,6 +41,12 @@ public:
 
   // See note on the vtkQuadricClustering implementation below.
   void SetLODFactor(double factor)
+  {
+    const int divs = DecimationFilterType::GetLODDivisions(factor);
+    this->SetNumberOfDivisions(divs, divs, divs);
+  }
+
+  static int GetLODDivisions(double factor)
   {
     factor = vtkMath::ClampValue(factor, 0., 1.);
 
@@ -48,8 +54,7 @@ public:
     // 0.0 --> 64
     // 0.5 --> 256 (default)
     // 1.0 --> 1024
-    int divs = static_cast<int>(std::pow(2, 4. * factor + 6.));
-    this->SetNumberOfDivisions(divs, divs, divs);
+    return static_cast<int>(std::pow(2, 4. * factor + 6.));
   }
 
 protected:
@@ -120,6 +125,12 @@ public:
   // grid with the VTKM filter, so we'll just reduce the mesh quality a bit
   // here.
   void SetLODFactor(double factor)
+  {
+    const int divs = DecimationFilterType::GetLODDivisions(factor);
+    this->SetNumberOfDivisions(divs, divs, divs);
+  }
+
+  static int GetLODDivisions(double factor)
   {
     factor = vtkMath::ClampValue(factor, 0., 1.);
 
@@ -127,8 +138,7 @@ public:
     // 0.0 --> 10
     // 0.5 --> 85 (default)
     // 1.0 --> 160
-    int divs = static_cast<int>(150 * factor) + 10;
-    this->SetNumberOfDivisions(divs, divs, divs);
+    return static_cast<int>(150 * factor) + 10;
   }
 
 protected:
@@ -20,6 +20,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkOpenGLRenderer.h"
 #include "vtkSquirtCompressor.h"
+#include "vtkTimerLog.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkZlibImageCompressor.h"
 #if VTK_MODULE_ENABLE_ParaView_nvpipe
@@ -29,6 +30,44 @@
 #include <cassert>
 #include <sstream>
 
+namespace
+{
+// Returns the quality setting of the compressor, between 0 (best) and 5, or -1
+// if the compressor has none.
+int vtkGetLossyLevel(vtkImageCompressor* compressor)
+{
+  if (auto lz4 = vtkLZ4Compressor::SafeDownCast(compressor))
+  {
+    return lz4->GetQuality();
+  }
+  else if (auto squirt = vtkSquirtCompressor::SafeDownCast(compressor))
+  {
+    return squirt->GetSquirtLevel();
+  }
+  else if (auto zlib = vtkZlibImageCompressor::SafeDownCast(compressor))
+  {
+    return zlib->GetColorSpace();
+  }
+  return -1;
+}
+
+void vtkSetLossyLevel(vtkImageCompressor* compressor, int level)
+{
+  if (auto lz4 = vtkLZ4Compressor::SafeDownCast(compressor))
+  {
+    lz4->SetQuality(level);
+  }
+  else if (auto squirt = vtkSquirtCompressor::SafeDownCast(compressor))
+  {
+    squirt->SetSquirtLevel(level);
+  }
+  else if (auto zlib = vtkZlibImageCompressor::SafeDownCast(compressor))
+  {
+    zlib->SetColorSpace(level);
+  }
+}
+}
+
 vtkStandardNewMacro(vtkPVClientServerSynchronizedRenderers);
 vtkCxxSetObjectMacro(vtkPVClientServerSynchronizedRenderers, Compressor, vtkImageCompressor);
 //----------------------------------------------------------------------------
@@ -59,11 +98,15 @@ void vtkPVClientServerSynchronizedRenderers::MasterEndRender()
   this->ParallelController->Receive(header, 4, 1, 0x023430);
   if (header[0] > 0)
   {
+    // the header is received once the server is done rendering, hence we only
+    // start timing the transfer now.
+    const double startTime = vtkTimerLog::GetUniversalTime();
     rawImage.Resize(header[1], header[2], header[3]);
     if (this->Compressor)
     {
       vtkUnsignedCharArray* data = vtkUnsignedCharArray::New();
       this->ParallelController->Receive(data, 1, 0x023430);
+      this->LastImageTransferSize = data->GetNumberOfValues();
       this->Compressor->SetImageResolution(header[1], header[2]);
       this->Decompress(data, rawImage.GetRawPtr());
       data->Delete();
@@ -71,8 +114,10 @@ void vtkPVClientServerSynchronizedRenderers::MasterEndRender()
     else
     {
       this->ParallelController->Receive(rawImage.GetRawPtr(), 1, 0x023430);
+      this->LastImageTransferSize = rawImage.GetRawPtr()->GetNumberOfValues();
     }
     rawImage.MarkValid();
+    this->LastImageTransferTime = vtkTimerLog::GetUniversalTime() - startTime;
   }
 }
 
@@ -114,7 +159,22 @@ vtkUnsignedCharArray* vtkPVClientServerSynchronizedRenderers::Compress(vtkUnsign
   {
     this->Compressor->SetLossLessMode(this->LossLessCompression);
     this->Compressor->SetInput(data);
-    if (this->Compressor->Compress() == 0)
+
+    // Temporarily lower the compressor quality if requested.
+    const int configuredLevel = vtkGetLossyLevel(this->Compressor);
+    const bool degrade = !this->LossLessCompression && configuredLevel >= 0 &&
+      this->LossyCompressionLevel > configuredLevel;
+    if (degrade)
+    {
+      vtkSetLossyLevel(this->Compressor, this->LossyCompressionLevel);
+    }
+    const int status = this->Compressor->Compress();
+    if (degrade)
+    {
+      vtkSetLossyLevel(this->Compressor, configuredLevel);
+    }
+
+    if (status == 0)
     {
       vtkErrorMacro("Image compression failed!");
       return data;
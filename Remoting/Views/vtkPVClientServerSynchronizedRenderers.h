@@ -52,6 +52,22 @@ public:
   vtkSetMacro(NVPipeSupport, bool);
   vtkGetMacro(NVPipeSupport, bool);
 
+  // Description:
+  // Lossy compression level, between 0 and 5, to use at least when
+  // LossLessCompression is unset. 0 leaves the compressor configuration
+  // untouched while higher values trade image quality for smaller images,
+  // using the compressor's own quality setting (squirt level, LZ4 quality or
+  // zlib color space reduction).
+  vtkSetClampMacro(LossyCompressionLevel, int, 0, 5);
+  vtkGetMacro(LossyCompressionLevel, int);
+
+  // Description:
+  // Time, in seconds, spent receiving and decompressing the most recent image
+  // on the client, and the number of bytes received for it. This excludes the
+  // time spent waiting for the server to render the image.
+  vtkGetMacro(LastImageTransferTime, double);
+  vtkGetMacro(LastImageTransferSize, vtkIdType);
+
   /**
    * Set and configure a compressor from it's own configuration stream. This
    * is used by ParaView to configure the compressor from application wide
@@ -80,6 +96,9 @@ protected:
   vtkImageCompressor* Compressor;
   bool LossLessCompression;
   bool NVPipeSupport;
+  int LossyCompressionLevel = 0;
+  double LastImageTransferTime = 0.0;
+  vtkIdType LastImageTransferSize = 0;
 
 private:
   vtkPVClientServerSynchronizedRenderers(const vtkPVClientServerSynchronizedRenderers&) = delete;
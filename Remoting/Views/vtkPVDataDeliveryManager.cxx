@@ -17,6 +17,7 @@
 
 #include "vtkAlgorithmOutput.h"
 #include "vtkInformation.h"
+#include "vtkMPIMoveData.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVDataRepresentation.h"
@@ -35,6 +36,12 @@ vtkPVDataDeliveryManager::vtkPVDataDeliveryManager()
 //----------------------------------------------------------------------------
 vtkPVDataDeliveryManager::~vtkPVDataDeliveryManager()
 {
+  // the view is going away, so are the streams of deliveries of its
+  // representations.
+  for (const auto& item : this->Internals->ItemsMap)
+  {
+    vtkPVDataDeliveryManager::ReleaseDeltaDeliveryStates(item.first.first, item.first.second);
+  }
   delete this->Internals;
   this->Internals = nullptr;
 }
@@ -76,6 +83,7 @@ void vtkPVDataDeliveryManager::UnRegisterRepresentation(vtkPVDataRepresentation*
     const vtkInternals::ReprPortType& key = iter->first;
     if (key.first == rid)
     {
+      vtkPVDataDeliveryManager::ReleaseDeltaDeliveryStates(rid, key.second);
       vtkInternals::ItemsMapType::iterator toerase = iter;
       ++iter;
       this->Internals->ItemsMap.erase(toerase);
@@ -135,6 +143,15 @@ void vtkPVDataDeliveryManager::SetPiece(vtkPVDataRepresentation* repr, vtkDataOb
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkPVDataDeliveryManager::ClearPiece(vtkPVDataRepresentation* repr, bool low_res, int port)
+{
+  if (auto item = this->Internals->GetItem(repr, low_res, port, /*create_if_needed=*/false))
+  {
+    item->SetDataObject(nullptr, this->Internals, this->GetCacheKey(repr));
+  }
+}
+
 //----------------------------------------------------------------------------
 vtkDataObject* vtkPVDataDeliveryManager::GetPiece(
   vtkPVDataRepresentation* repr, bool low_res, int port)
@@ -291,6 +308,24 @@ double vtkPVDataDeliveryManager::GetCacheKey(vtkPVDataRepresentation* repr) cons
   return repr->GetCacheKey();
 }
 
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkPVDataDeliveryManager::GetDeliveryStreamKey(
+  unsigned int reprId, bool low_res, int port)
+{
+  // representation ids are never 0, hence the key is never 0 either.
+  return (static_cast<vtkTypeUInt64>(reprId) << 32) |
+    (static_cast<vtkTypeUInt64>(port & 0x7fffffff) << 1) | (low_res ? 1 : 0);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataDeliveryManager::ReleaseDeltaDeliveryStates(unsigned int reprId, int port)
+{
+  vtkMPIMoveData::ReleaseDeltaDeliveryState(
+    vtkPVDataDeliveryManager::GetDeliveryStreamKey(reprId, false, port));
+  vtkMPIMoveData::ReleaseDeltaDeliveryState(
+    vtkPVDataDeliveryManager::GetDeliveryStreamKey(reprId, true, port));
+}
+
 //----------------------------------------------------------------------------
 void vtkPVDataDeliveryManager::ClearCache(vtkPVDataRepresentation* repr)
 {
@@ -87,6 +87,14 @@ public:
     unsigned long trueSize = 0, int port = 0);
   ///@}
 
+  /**
+   * Discards the data set by `SetPiece` so that the next call to `SetPiece`
+   * replaces it even if the representation's pipeline has not been updated
+   * since. Representations use this when the geometry to deliver changes
+   * without the data changing e.g. when switching between LOD levels.
+   */
+  void ClearPiece(vtkPVDataRepresentation* repr, bool low_res, int port = 0);
+
   ///@{
   bool HasPiece(vtkPVDataRepresentation* repr, bool low_res = false, int port = 0);
   ///@}
@@ -175,6 +183,19 @@ protected:
 
   double GetCacheKey(vtkPVDataRepresentation* repr) const;
 
+  /**
+   * Returns a key that identifies the stream of deliveries for a
+   * representation's port across updates. Used by vtkMPIMoveData for delta
+   * delivery. The key is the same on all processes.
+   */
+  static vtkTypeUInt64 GetDeliveryStreamKey(unsigned int reprId, bool low_res, int port);
+
+  /**
+   * Releases the delta delivery state of both resolutions of a
+   * representation's port, see vtkMPIMoveData::ReleaseDeltaDeliveryState.
+   */
+  static void ReleaseDeltaDeliveryStates(unsigned int reprId, int port);
+
   /**
    * This method is called to request that the subclass do appropriate transfer
    * for the indicated representation.
@@ -111,7 +111,9 @@
 #include "vtkOSPRayRendererNode.h"
 #endif
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <map>
 #include <set>
 #include <sstream>
@@ -320,6 +322,9 @@ vtkObjectFactoryNewMacro(vtkPVRenderView);
 vtkInformationKeyMacro(vtkPVRenderView, USE_LOD, Integer);
 vtkInformationKeyMacro(vtkPVRenderView, USE_OUTLINE_FOR_LOD, Integer);
 vtkInformationKeyMacro(vtkPVRenderView, LOD_RESOLUTION, Double);
+vtkInformationKeyMacro(vtkPVRenderView, LOD_NUMBER_OF_LEVELS, Integer);
+vtkInformationKeyMacro(vtkPVRenderView, LOD_SCREEN_SPACE_ERROR, Double);
+vtkInformationKeyRestrictedMacro(vtkPVRenderView, LOD_VIEW_PARAMETERS, DoubleVector, 7);
 vtkInformationKeyMacro(vtkPVRenderView, NEED_ORDERED_COMPOSITING, Integer);
 vtkInformationKeyMacro(vtkPVRenderView, RENDER_EMPTY_IMAGES, Integer);
 vtkInformationKeyMacro(vtkPVRenderView, REQUEST_STREAMING_UPDATE, Request);
@@ -359,6 +364,7 @@ vtkPVRenderView::vtkPVRenderView()
   this->LODRenderingThreshold = 0;
   this->LODResolution = 0.5;
   this->UseOutlineForLODRendering = false;
+  std::fill_n(this->AdaptiveLODParameters, 8, 0.0);
   this->UseLightKit = false;
   this->Interactor = nullptr;
   this->InteractorStyle = nullptr;
@@ -1444,6 +1450,13 @@ void vtkPVRenderView::UpdateLOD()
   {
     this->RequestInformation->Set(USE_OUTLINE_FOR_LOD(), 1);
   }
+  else if (this->UseAdaptiveLOD && this->AdaptiveLODParametersValid)
+  {
+    this->RequestInformation->Set(LOD_NUMBER_OF_LEVELS(), this->LODNumberOfLevels);
+    this->RequestInformation->Set(
+      LOD_SCREEN_SPACE_ERROR(), this->LODScreenSpaceError * this->AdaptiveLODParameters[7]);
+    this->RequestInformation->Set(LOD_VIEW_PARAMETERS(), this->AdaptiveLODParameters, 7);
+  }
 
   // reset flags that representations set in REQUEST_UPDATE_LOD() pass.
   this->DistributedRenderingRequiredLOD = false;
@@ -1471,6 +1484,187 @@ void vtkPVRenderView::UpdateLOD()
   vtkTimerLog::MarkEndEvent("RenderView::UpdateLOD");
 }
 
+//----------------------------------------------------------------------------
+void vtkPVRenderView::SetAdaptiveLODParameters(const double params[8])
+{
+  std::copy(params, params + 8, this->AdaptiveLODParameters);
+  this->AdaptiveLODParametersValid = true;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVRenderView::ComputeAdaptiveLODParameters(double params[8])
+{
+  vtkCamera* camera = this->GetActiveCamera();
+  camera->GetPosition(params);
+  params[3] = camera->GetViewAngle();
+  params[4] = camera->GetParallelProjection() ? 1.0 : 0.0;
+  params[5] = camera->GetParallelScale();
+  params[6] = std::max(this->GetRenderer()->GetSize()[1], 1);
+  params[7] = this->AdaptiveLODErrorScale;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVRenderView::GetAdaptiveLODNeedsUpdate()
+{
+  if (!this->AdaptiveLODParametersValid)
+  {
+    return true;
+  }
+
+  double params[8];
+  this->ComputeAdaptiveLODParameters(params);
+  if (params[7] != this->AdaptiveLODParameters[7] || params[4] != this->AdaptiveLODParameters[4])
+  {
+    return true;
+  }
+
+  // Consecutive levels differ roughly by a factor of 2 in resolution, so only
+  // a change of that order in the projected scene size can change the levels
+  // picked by the representations.
+  double bounds[6];
+  this->GeometryBounds.GetBounds(bounds);
+  vtkNew<vtkInformation> current;
+  current->Set(LOD_VIEW_PARAMETERS(), params, 7);
+  vtkNew<vtkInformation> previous;
+  previous->Set(LOD_VIEW_PARAMETERS(), this->AdaptiveLODParameters, 7);
+  const double currentSize = vtkPVRenderView::GetProjectedSize(current, bounds);
+  const double previousSize = vtkPVRenderView::GetProjectedSize(previous, bounds);
+  if (currentSize <= 0 || previousSize <= 0)
+  {
+    return false;
+  }
+  const double ratio = currentSize / previousSize;
+  return ratio > 2.0 || ratio < 0.5;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVRenderView::UpdateAdaptiveLODErrorScale(double frameTime)
+{
+  // Relax the screen-space error when over budget and tighten it back, one
+  // level at a time, while renders are comfortably within budget. This
+  // progressively refines the LOD geometry as the interaction slows down.
+  if (frameTime > this->LODFrameBudget)
+  {
+    this->AdaptiveLODErrorScale = std::min(this->AdaptiveLODErrorScale * 2.0, 64.0);
+  }
+  else if (frameTime < 0.5 * this->LODFrameBudget)
+  {
+    this->AdaptiveLODErrorScale = std::max(this->AdaptiveLODErrorScale * 0.5, 1.0);
+  }
+}
+
+//----------------------------------------------------------------------------
+double vtkPVRenderView::GetProjectedSize(vtkInformation* info, const double bounds[6])
+{
+  vtkBoundingBox bbox(bounds);
+  if (!info || !info->Has(LOD_VIEW_PARAMETERS()) || !bbox.IsValid())
+  {
+    return -1.0;
+  }
+
+  const double* params = info->Get(LOD_VIEW_PARAMETERS());
+  const double diagonal = bbox.GetDiagonalLength();
+  if (diagonal <= 0.0)
+  {
+    return 0.0;
+  }
+  const double height = params[6];
+  if (params[4] != 0.0)
+  {
+    return diagonal * height / (2.0 * std::max(params[5], 1e-12));
+  }
+
+  double center[3];
+  bbox.GetCenter(center);
+  // Clamp the distance so that a camera inside the bounds picks the finest
+  // level instead of dividing by zero.
+  const double distance =
+    std::max(std::sqrt(vtkMath::Distance2BetweenPoints(params, center)), 1e-6 * diagonal);
+  const double halfAngle = vtkMath::RadiansFromDegrees(params[3]) / 2.0;
+  return diagonal * height / (2.0 * distance * std::max(std::tan(halfAngle), 1e-6));
+}
+
+//----------------------------------------------------------------------------
+void vtkPVRenderView::SetScheduledCompressionLevel(int level)
+{
+  this->ScheduledCompressionLevel = vtkMath::ClampValue(level, 0, 5);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVRenderView::ScheduleNextInteractiveRender(double frameTime, bool distributed)
+{
+  this->LastFrameTime = frameTime;
+  this->LastRenderTime = this->GetRenderer()->GetLastRenderTimeInSeconds();
+  this->LastImageTransferTime =
+    distributed ? this->SynchronizedRenderers->GetLastImageTransferTime() : 0.0;
+  this->LastCompositeTime =
+    std::max(frameTime - this->LastRenderTime - this->LastImageTransferTime, 0.0);
+
+  const double budget = 1.0 / this->TargetFrameRate;
+  const bool canCoarsenLOD = this->UseAdaptiveLOD && this->UsedLODForLastRender;
+  const int minReductionFactor = this->InteractiveRenderImageReductionFactor;
+  const int maxReductionFactor = 8;
+  const char* decision = "none";
+  if (frameTime > 1.1 * budget)
+  {
+    // Over budget: degrade the stage that is most expensive first.
+    const bool transferBound = this->LastImageTransferTime > 0.5 * frameTime;
+    if (distributed && transferBound && this->ScheduledCompressionLevel < 5)
+    {
+      ++this->ScheduledCompressionLevel;
+      decision = "increase compression level";
+    }
+    else if (canCoarsenLOD && this->AdaptiveLODErrorScale < 64.0)
+    {
+      this->AdaptiveLODErrorScale *= 2.0;
+      decision = "coarsen LOD";
+    }
+    else if (distributed &&
+      std::max(this->ScheduledImageReductionFactor, minReductionFactor) < maxReductionFactor)
+    {
+      this->ScheduledImageReductionFactor =
+        std::max(this->ScheduledImageReductionFactor, minReductionFactor) + 1;
+      decision = "increase image reduction factor";
+    }
+    else if (distributed && this->ScheduledCompressionLevel < 5)
+    {
+      ++this->ScheduledCompressionLevel;
+      decision = "increase compression level";
+    }
+  }
+  else if (frameTime < 0.6 * budget)
+  {
+    // Well within budget: restore image quality first, then geometry.
+    if (this->ScheduledCompressionLevel > 0)
+    {
+      --this->ScheduledCompressionLevel;
+      decision = "decrease compression level";
+    }
+    else if (this->ScheduledImageReductionFactor > minReductionFactor)
+    {
+      --this->ScheduledImageReductionFactor;
+      decision = "decrease image reduction factor";
+    }
+    else if (this->AdaptiveLODErrorScale > 1.0)
+    {
+      this->AdaptiveLODErrorScale = std::max(this->AdaptiveLODErrorScale * 0.5, 1.0);
+      decision = "refine LOD";
+    }
+  }
+
+  vtkTimerLog::FormatAndMarkEvent("Frame scheduler: frame %.4fs (render %.4fs, composite %.4fs, "
+                                  "transfer %.4fs), target %.4fs: %s",
+    frameTime, this->LastRenderTime, this->LastCompositeTime, this->LastImageTransferTime, budget,
+    decision);
+  vtkVLogF(PARAVIEW_LOG_RENDERING_VERBOSITY(),
+    "frame scheduler: frame=%.4fs, render=%.4fs, composite=%.4fs, transfer=%.4fs, "
+    "target=%.4fs, decision='%s', image-reduction-factor=%d, compression-level=%d, "
+    "lod-error-scale=%g",
+    frameTime, this->LastRenderTime, this->LastCompositeTime, this->LastImageTransferTime, budget,
+    decision, std::max(this->ScheduledImageReductionFactor, minReductionFactor),
+    this->ScheduledCompressionLevel, this->AdaptiveLODErrorScale);
+}
+
 //----------------------------------------------------------------------------
 void vtkPVRenderView::StillRender()
 {
@@ -1498,8 +1692,21 @@ void vtkPVRenderView::InteractiveRender()
   this->Internals->OSPRayCount = 0;
   this->Internals->PreRender(this->RenderView);
 
+  const double startTime = vtkTimerLog::GetUniversalTime();
   this->Render(true, this->SuppressRendering);
 
+  const double elapsed = vtkTimerLog::GetUniversalTime() - startTime;
+  if (this->UseFrameRateScheduler)
+  {
+    this->ScheduleNextInteractiveRender(elapsed,
+      this->UsedLODForLastRender ? this->UseDistributedRenderingForLODRender
+                                 : this->UseDistributedRenderingForRender);
+  }
+  else if (this->UseAdaptiveLOD && this->UsedLODForLastRender)
+  {
+    this->UpdateAdaptiveLODErrorScale(elapsed);
+  }
+
   vtkTimerLog::MarkEndEvent("Interactive Render");
 }
 
@@ -1636,9 +1843,15 @@ void vtkPVRenderView::Render(bool interactive, bool skip_rendering)
     vtkPVView::REQUEST_RENDER(), this->RequestInformation, this->ReplyInformationVector);
 
   // set the image reduction factor.
-  this->SynchronizedRenderers->SetImageReductionFactor(
-    (interactive ? this->InteractiveRenderImageReductionFactor
-                 : this->StillRenderImageReductionFactor));
+  int imageReductionFactor = interactive ? this->InteractiveRenderImageReductionFactor
+                                         : this->StillRenderImageReductionFactor;
+  if (interactive && this->UseFrameRateScheduler)
+  {
+    imageReductionFactor = std::max(imageReductionFactor, this->ScheduledImageReductionFactor);
+  }
+  this->SynchronizedRenderers->SetImageReductionFactor(imageReductionFactor);
+  this->SynchronizedRenderers->SetLossyCompressionLevel(
+    interactive && this->UseFrameRateScheduler ? this->ScheduledCompressionLevel : 0);
 
   this->UsedLODForLastRender = use_lod_rendering;
 
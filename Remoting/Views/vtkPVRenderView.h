@@ -288,6 +288,116 @@ public:
   vtkGetMacro(UseOutlineForLODRendering, bool);
   ///@}
 
+  ///@{
+  /**
+   * When set to true, representations that support it keep a hierarchy of
+   * `LODNumberOfLevels` decimated levels for LOD rendering instead of a single
+   * one. Each representation then picks the coarsest level for which the
+   * projected size of a decimation cell stays below `LODScreenSpaceError`
+   * pixels. `UseOutlineForLODRendering` takes precedence over this flag.
+   * \note CallOnAllProcesses
+   */
+  vtkSetMacro(UseAdaptiveLOD, bool);
+  vtkGetMacro(UseAdaptiveLOD, bool);
+  vtkBooleanMacro(UseAdaptiveLOD, bool);
+  vtkSetClampMacro(LODNumberOfLevels, int, 1, 8);
+  vtkGetMacro(LODNumberOfLevels, int);
+  vtkSetClampMacro(LODScreenSpaceError, double, 0.1, VTK_DOUBLE_MAX);
+  vtkGetMacro(LODScreenSpaceError, double);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the time, in seconds, an interactive render is allowed to take
+   * when `UseAdaptiveLOD` is enabled. Interactive renders slower than this
+   * budget relax the screen-space error (coarser levels), while renders well
+   * within the budget tighten it back progressively towards
+   * `LODScreenSpaceError`.
+   */
+  vtkSetClampMacro(LODFrameBudget, double, 0.001, VTK_DOUBLE_MAX);
+  vtkGetMacro(LODFrameBudget, double);
+  ///@}
+
+  /**
+   * Adjusts the screen-space error scale given the time, in seconds, taken by
+   * an interactive render using LOD: the scale doubles, up to 64, when over
+   * `LODFrameBudget` and halves, down to 1, when within half the budget.
+   * Called after each such render when the frame-rate scheduler is disabled.
+   */
+  void UpdateAdaptiveLODErrorScale(double frameTime);
+
+  ///@{
+  /**
+   * Camera parameters used by representations to estimate their projected
+   * size when picking a LOD level. The camera is only available on the client,
+   * hence vtkSMRenderViewProxy fills these using `ComputeAdaptiveLODParameters`
+   * on the client and pushes them to all processes before `UpdateLOD`.
+   *
+   * The parameters are the camera position, view angle, parallel projection
+   * flag, parallel scale, viewport height in pixels and the screen-space error
+   * scale resulting from the frame budget.
+   * \note CallOnAllProcesses
+   */
+  void SetAdaptiveLODParameters(const double params[8]);
+  void ComputeAdaptiveLODParameters(double params[8]);
+  ///@}
+
+  /**
+   * Returns true if the camera or the frame budget changed enough since the
+   * last `SetAdaptiveLODParameters` for the representations to pick different
+   * LOD levels. Only meaningful on the client.
+   */
+  bool GetAdaptiveLODNeedsUpdate();
+
+  ///@{
+  /**
+   * When set to true, interactive renders are scheduled to reach
+   * `TargetFrameRate` instead of relying only on the static LOD and remote
+   * rendering thresholds. After every interactive render, the view measures the
+   * render, composite and image transfer times and adjusts, one step at a
+   * time, the LOD screen-space error (when `UseAdaptiveLOD` is enabled), the
+   * image reduction factor and the lossy image compression level. The stage
+   * taking most of the frame is degraded first when over budget, and quality
+   * is restored when renders are well within budget. When enabled, this
+   * replaces `LODFrameBudget`.
+   * \note CallOnAllProcesses
+   */
+  vtkSetMacro(UseFrameRateScheduler, bool);
+  vtkGetMacro(UseFrameRateScheduler, bool);
+  vtkBooleanMacro(UseFrameRateScheduler, bool);
+  vtkSetClampMacro(TargetFrameRate, double, 0.1, 1000.0);
+  vtkGetMacro(TargetFrameRate, double);
+  ///@}
+
+  ///@{
+  /**
+   * Instrumentation for the frame-rate scheduler. Timings, in seconds, are
+   * those of the most recent interactive render as measured on the process
+   * driving it. The render time is the time spent rendering geometry locally,
+   * the image transfer time is the time spent receiving and decompressing the
+   * image from the server, and the composite time is the remainder of the frame
+   * which includes parallel rendering and compositing on the server.
+   * The scheduled values are the decisions in effect for the next interactive
+   * render.
+   */
+  vtkGetMacro(LastFrameTime, double);
+  vtkGetMacro(LastRenderTime, double);
+  vtkGetMacro(LastCompositeTime, double);
+  vtkGetMacro(LastImageTransferTime, double);
+  vtkGetMacro(ScheduledImageReductionFactor, int);
+  vtkGetMacro(ScheduledCompressionLevel, int);
+  vtkGetMacro(AdaptiveLODErrorScale, double);
+  ///@}
+
+  /**
+   * Sets the lossy image compression level to use for interactive renders.
+   * Images are compressed on the server while the scheduler runs on the
+   * client, hence vtkSMRenderViewProxy calls this on all processes whenever
+   * the scheduler changes the level.
+   * \note CallOnAllProcesses
+   */
+  void SetScheduledCompressionLevel(int level);
+
   /**
    * Passes the compressor configuration to the client-server synchronizer, if
    * any. This affects the image compression used to relay images back to the
@@ -335,6 +445,24 @@ public:
    */
   static vtkInformationIntegerKey* USE_OUTLINE_FOR_LOD();
 
+  /**
+   * Set in REQUEST_UPDATE_LOD() pass when `UseAdaptiveLOD` is enabled.
+   * LOD_NUMBER_OF_LEVELS is the number of levels in the LOD hierarchy,
+   * LOD_SCREEN_SPACE_ERROR the tolerated projected size of a decimation cell in
+   * pixels and LOD_VIEW_PARAMETERS the camera parameters needed by
+   * `GetProjectedSize`.
+   */
+  static vtkInformationIntegerKey* LOD_NUMBER_OF_LEVELS();
+  static vtkInformationDoubleKey* LOD_SCREEN_SPACE_ERROR();
+  static vtkInformationDoubleVectorKey* LOD_VIEW_PARAMETERS();
+
+  /**
+   * Returns the size, in pixels, of the diagonal of `bounds` once projected
+   * using the LOD_VIEW_PARAMETERS() in `info`. Returns a negative value if the
+   * key is missing or the bounds are invalid.
+   */
+  static double GetProjectedSize(vtkInformation* info, const double bounds[6]);
+
   /**
    * Representation can publish this key in their REQUEST_INFORMATION()
    * pass to indicate that the representation needs to disable
@@ -1145,6 +1273,13 @@ protected:
    */
   bool ShouldUseLODRendering(double geometry);
 
+  /**
+   * Called after each interactive render when `UseFrameRateScheduler` is
+   * enabled to record the frame timings and adjust the decisions for the next
+   * interactive render.
+   */
+  void ScheduleNextInteractiveRender(double frameTime, bool distributed);
+
   /**
    * Returns true if the local process is invovled in rendering composited
    * geometry i.e. geometry rendered in view that is composited together.
@@ -1309,6 +1444,21 @@ protected:
   bool UsedLODForLastRender;
   bool UseLODForInteractiveRender;
   bool UseOutlineForLODRendering;
+  bool UseAdaptiveLOD = false;
+  int LODNumberOfLevels = 4;
+  double LODScreenSpaceError = 4.0;
+  double LODFrameBudget = 0.066;
+  double AdaptiveLODErrorScale = 1.0;
+  double AdaptiveLODParameters[8];
+  bool AdaptiveLODParametersValid = false;
+  bool UseFrameRateScheduler = false;
+  double TargetFrameRate = 15.0;
+  double LastFrameTime = 0.0;
+  double LastRenderTime = 0.0;
+  double LastCompositeTime = 0.0;
+  double LastImageTransferTime = 0.0;
+  int ScheduledImageReductionFactor = 1;
+  int ScheduledCompressionLevel = 0;
   bool UseDistributedRenderingForRender;
   bool UseDistributedRenderingForLODRender;
 
@@ -638,6 +638,8 @@ void vtkPVRenderViewDataDeliveryManager::MoveData(
     dataMover->SetSkipDataServerGatherToZero(
       info->Get(vtkPVRVDMKeys::GATHER_BEFORE_DELIVERING_TO_CLIENT()) == 0);
   }
+  dataMover->SetDeltaDeliveryKey(
+    this->GetDeliveryStreamKey(repr->GetUniqueIdentifier(), low_res, port));
   dataMover->SetInputData(dataObj);
   dataMover->Update();
   item->SetDeliveredDataObject(viewMode, cacheKey, dataMover->GetOutputDataObject(0));
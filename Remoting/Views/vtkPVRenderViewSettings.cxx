@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkPVRenderViewSettings.h"
 
+#include "vtkMPIMoveData.h"
 #include "vtkMapper.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVRenderView.h"
@@ -116,6 +117,28 @@ void vtkPVRenderViewSettings::SetZShift(double val)
   this->Modified();
 }
 
+//----------------------------------------------------------------------------
+void vtkPVRenderViewSettings::SetGeometryCompressionMode(int mode)
+{
+  vtkMPIMoveData::SetCompressionMode(mode);
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVRenderViewSettings::SetDeltaGeometryDelivery(bool enable)
+{
+  vtkMPIMoveData::SetUseDeltaDelivery(enable);
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVRenderViewSettings::SetDeliveryCacheSize(int megabytes)
+{
+  vtkMPIMoveData::SetDeliveryCacheSize(
+    megabytes > 0 ? static_cast<vtkTypeUInt64>(megabytes) * 1024 * 1024 : 0);
+  this->Modified();
+}
+
 //----------------------------------------------------------------------------
 void vtkPVRenderViewSettings::PrintSelf(ostream& os, vtkIndent indent)
 {
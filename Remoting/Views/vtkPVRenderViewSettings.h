@@ -61,6 +61,25 @@ public:
   void SetZShift(double a);
   ///@}
 
+  /**
+   * Set the compression used for geometry delivered to the client or render
+   * server. Forwards to vtkMPIMoveData::SetCompressionMode.
+   */
+  void SetGeometryCompressionMode(int mode);
+
+  /**
+   * Enable sending only changed arrays when delivering geometry to the client.
+   * Forwards to vtkMPIMoveData::SetUseDeltaDelivery.
+   */
+  void SetDeltaGeometryDelivery(bool enable);
+
+  /**
+   * Set the memory budget, in megabytes, for the cache of geometry delivered
+   * to the client that is shared by all representations and views. 0 disables
+   * the cache. Forwards to vtkMPIMoveData::SetDeliveryCacheSize.
+   */
+  void SetDeliveryCacheSize(int megabytes);
+
   ///@{
   /**
    * Set the number of cells (in millions) when the representations show try to
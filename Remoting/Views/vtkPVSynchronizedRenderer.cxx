@@ -255,6 +255,25 @@ void vtkPVSynchronizedRenderer::ConfigureCompressor(const char* configuration)
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkPVSynchronizedRenderer::SetLossyCompressionLevel(int level)
+{
+  vtkPVClientServerSynchronizedRenderers* cssync =
+    vtkPVClientServerSynchronizedRenderers::SafeDownCast(this->CSSynchronizer);
+  if (cssync)
+  {
+    cssync->SetLossyCompressionLevel(level);
+  }
+}
+
+//----------------------------------------------------------------------------
+double vtkPVSynchronizedRenderer::GetLastImageTransferTime()
+{
+  vtkPVClientServerSynchronizedRenderers* cssync =
+    vtkPVClientServerSynchronizedRenderers::SafeDownCast(this->CSSynchronizer);
+  return cssync ? cssync->GetLastImageTransferTime() : 0.0;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVSynchronizedRenderer::SetImageProcessingPass(vtkImageProcessingPass* pass)
 {
@@ -139,6 +139,17 @@ public:
   void SetLossLessCompression(bool);
   ///@}
 
+  ///@{
+  /**
+   * Forwarded to the client-server synchronizer, if any. See
+   * vtkPVClientServerSynchronizedRenderers::SetLossyCompressionLevel() and
+   * vtkPVClientServerSynchronizedRenderers::GetLastImageTransferTime(). The
+   * transfer time is 0 when not in client-server mode.
+   */
+  void SetLossyCompressionLevel(int);
+  double GetLastImageTransferTime();
+  ///@}
+
   /**
    * Activates or de-activated the use of Depth Buffer in an ImageProcessingPass
    */
@@ -954,6 +954,15 @@ void vtkPVView::SetPieceLOD(vtkInformation* info, vtkPVDataRepresentation* repr,
   }
 }
 
+//-----------------------------------------------------------------------------
+void vtkPVView::ClearPieceLOD(vtkInformation* info, vtkPVDataRepresentation* repr, int port)
+{
+  if (auto dm = vtkPVView::GetDeliveryManager(info))
+  {
+    dm->ClearPiece(repr, true, port);
+  }
+}
+
 //-----------------------------------------------------------------------------
 vtkDataObject* vtkPVView::GetPieceLOD(vtkInformation* info, vtkPVDataRepresentation* repr, int port)
 {
@@ -266,6 +266,7 @@ public:
     vtkInformation* info, vtkPVDataRepresentation* repr, int port = 0);
   static vtkDataObject* GetDeliveredPieceLOD(
     vtkInformation* info, vtkPVDataRepresentation* repr, int port = 0);
+  static void ClearPieceLOD(vtkInformation* info, vtkPVDataRepresentation* repr, int port = 0);
 
   /**
    * Called on all processes to request data-delivery for the list of
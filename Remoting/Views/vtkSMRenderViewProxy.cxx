@@ -216,6 +216,20 @@ void vtkSMRenderViewProxy::UpdateLOD()
   if (this->ObjectsCreated && this->NeedsUpdateLOD)
   {
     vtkClientServerStream stream;
+    vtkPVRenderView* view = vtkPVRenderView::SafeDownCast(this->GetClientSideObject());
+    if (!view)
+    {
+      return;
+    }
+    if (view->GetUseAdaptiveLOD())
+    {
+      // The camera only lives on the client, pass along what the
+      // representations need to pick their LOD level.
+      double params[8];
+      view->ComputeAdaptiveLODParameters(params);
+      stream << vtkClientServerStream::Invoke << VTKOBJECT(this) << "SetAdaptiveLODParameters"
+             << vtkClientServerStream::InsertArray(params, 8) << vtkClientServerStream::End;
+    }
     stream << vtkClientServerStream::Invoke << VTKOBJECT(this) << "UpdateLOD"
            << vtkClientServerStream::End;
     this->GetSession()->PrepareProgress();
@@ -279,10 +293,27 @@ vtkTypeUInt32 vtkSMRenderViewProxy::PreRender(bool interactive)
   if (interactive && rv->GetUseLODForInteractiveRender())
   {
     // for interactive renders, we need to determine if we are going to use LOD.
-    // If so, we may need to update the LOD geometries.
+    // If so, we may need to update the LOD geometries. With adaptive LOD, the
+    // geometries also depend on the camera and the frame budget.
+    if (rv->GetUseAdaptiveLOD() && rv->GetAdaptiveLODNeedsUpdate())
+    {
+      this->NeedsUpdateLOD = true;
+    }
     this->UpdateLOD();
   }
 
+  if (interactive && rv->GetUseFrameRateScheduler() &&
+    rv->GetScheduledCompressionLevel() != this->ScheduledCompressionLevel)
+  {
+    // Images are compressed on the server, let it know about the level picked
+    // by the scheduler on the client.
+    this->ScheduledCompressionLevel = rv->GetScheduledCompressionLevel();
+    vtkClientServerStream stream;
+    stream << vtkClientServerStream::Invoke << VTKOBJECT(this) << "SetScheduledCompressionLevel"
+           << this->ScheduledCompressionLevel << vtkClientServerStream::End;
+    this->ExecuteStream(stream);
+  }
+
   return interactive ? rv->GetInteractiveRenderProcesses() : rv->GetStillRenderProcesses();
 }
 
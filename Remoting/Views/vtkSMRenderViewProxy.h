@@ -324,6 +324,9 @@ protected:
 
   bool NeedsUpdateLOD;
 
+  // Compression level last pushed to all processes for the frame-rate scheduler.
+  int ScheduledCompressionLevel = 0;
+
 private:
   vtkSMRenderViewProxy(const vtkSMRenderViewProxy&) = delete;
   void operator=(const vtkSMRenderViewProxy&) = delete;
@@ -23,6 +23,7 @@
 #include "vtkCompositeDataSet.h"
 #include "vtkDataArrayRange.h"
 #include "vtkDataSetAttributes.h"
+#include "vtkExtractMatchingRows.h"
 #include "vtkFieldData.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
@@ -31,9 +32,11 @@
 #include "vtkMemberFunctionCommand.h"
 #include "vtkMultiProcessController.h"
 #include "vtkMultiProcessStream.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVMergeTables.h"
 #include "vtkPVSession.h"
+#include "vtkPartitionedDataSet.h"
 #include "vtkProcessModule.h"
 #include "vtkReductionFilter.h"
 #include "vtkSmartPointer.h"
@@ -45,10 +48,13 @@
 #include "vtkUnsignedCharArray.h"
 #include "vtkVariant.h"
 
+#include "vtksys/FStream.hxx"
+
 #include <algorithm>
 #include <cstring>
 #include <iterator>
 #include <map>
+#include <numeric>
 #include <set>
 #include <string>
 #include <vector>
@@ -143,6 +149,41 @@ const char* get_userfriendly_name(
   return name;
 }
 
+/// a column written by vtkSpreadSheetView::ExportOnDataServer.
+struct vtkExportColumn
+{
+  std::string Name;
+  std::string Label;
+  int NumberOfComponents;
+};
+
+void PushColumns(vtkMultiProcessStream& stream, const std::vector<vtkExportColumn>& columns)
+{
+  stream << static_cast<unsigned int>(columns.size());
+  for (const auto& column : columns)
+  {
+    stream << column.Name << column.Label << column.NumberOfComponents;
+  }
+}
+
+/// appends the columns read from the stream that are not in `columns` yet.
+void PopColumns(vtkMultiProcessStream& stream, std::vector<vtkExportColumn>& columns)
+{
+  unsigned int count = 0;
+  stream >> count;
+  for (unsigned int cc = 0; cc < count; ++cc)
+  {
+    vtkExportColumn column;
+    stream >> column.Name >> column.Label >> column.NumberOfComponents;
+    if (std::find_if(columns.begin(), columns.end(), [&](const vtkExportColumn& other) {
+          return other.Name == column.Name;
+        }) == columns.end())
+    {
+      columns.push_back(std::move(column));
+    }
+  }
+}
+
 /**
  * A subclass of vtkPVMergeTables to handle reduction for "vtkBlockNameIndices"
  * and "vtkBlockNames" arrays correctly.
@@ -300,6 +341,11 @@ class vtkSpreadSheetView::vtkInternals
   CacheType CachedBlocks;
 
 public:
+  bool IsCached(vtkIdType blockId) const
+  {
+    return this->CachedBlocks.find(blockId) != this->CachedBlocks.end();
+  }
+
   void ClearCache()
   {
     this->CachedBlocks.clear();
@@ -410,7 +456,8 @@ public:
       this->CachedBlocks.erase(iter);
     }
 
-    if (static_cast<vtkIdType>(this->CachedBlocks.size()) == max)
+    while (!this->CachedBlocks.empty() &&
+      static_cast<vtkIdType>(this->CachedBlocks.size()) >= max)
     {
       // remove least-recent-used block.
       iter = this->CachedBlocks.begin();
@@ -496,6 +543,7 @@ public:
 
   std::vector<std::string> OrderedColumnList;
   bool OrderColumnsByList = false;
+  vtkMTimeType RowFilterMTime = 0;
 };
 
 namespace
@@ -576,9 +624,11 @@ vtkSpreadSheetView::vtkSpreadSheetView()
   , GenerateCellConnectivity(false)
   , TableStreamer(vtkSortedTableStreamer::New())
   , TableSelectionMarker(vtkMarkSelectedRows::New())
+  , RowFilter(vtkExtractMatchingRows::New())
   , ReductionFilter(vtkReductionFilter::New())
   , DeliveryFilter(vtkClientServerMoveData::New())
   , NumberOfRows(0)
+  , NumberOfPrefetchBlocks(2)
   , CRMICallbackTag(0)
   , PRMICallbackTag(0)
   , Identifier(0)
@@ -624,6 +674,7 @@ vtkSpreadSheetView::~vtkSpreadSheetView()
 
   this->TableStreamer->Delete();
   this->TableSelectionMarker->Delete();
+  this->RowFilter->Delete();
   this->ReductionFilter->Delete();
   this->DeliveryFilter->Delete();
 
@@ -842,13 +893,26 @@ int vtkSpreadSheetView::StreamToClient()
 
   this->TableSelectionMarker->SetInputConnection(0, dataPort);
   this->TableSelectionMarker->SetInputConnection(1, cur->GetExtractedDataProducer());
-  this->TableStreamer->SetInputConnection(this->TableSelectionMarker->GetOutputPort());
+  this->RowFilter->SetInputConnection(this->TableSelectionMarker->GetOutputPort());
+  this->TableStreamer->SetInputConnection(this->RowFilter->GetOutputPort());
   if (dataPort)
   {
     dataPort->GetProducer()->Update();
     this->DeliveryFilter->SetInputConnection(this->ReductionFilter->GetOutputPort());
-    num_rows =
-      vtkCountNumberOfRows(dataPort->GetProducer()->GetOutputDataObject(dataPort->GetIndex()));
+    const char* expression = this->RowFilter->GetExpression();
+    if (expression && expression[0] != '\0')
+    {
+      // the number of rows is what remains after filtering, hence we need to
+      // execute the row filter here rather than on first block fetch.
+      this->TableSelectionMarker->SetFieldAssociation(this->FieldAssociation);
+      this->RowFilter->Update();
+      num_rows = vtkCountNumberOfRows(this->RowFilter->GetOutputDataObject(0));
+    }
+    else
+    {
+      num_rows =
+        vtkCountNumberOfRows(dataPort->GetProducer()->GetOutputDataObject(dataPort->GetIndex()));
+    }
   }
   else
   {
@@ -857,6 +921,14 @@ int vtkSpreadSheetView::StreamToClient()
 
   this->AllReduce(num_rows, num_rows, vtkCommunicator::SUM_OP);
 
+  // a changed row filter may select a different set of rows, even if the
+  // count remains the same.
+  if (this->Internals->RowFilterMTime != this->RowFilter->GetMTime())
+  {
+    this->Internals->RowFilterMTime = this->RowFilter->GetMTime();
+    this->SomethingUpdated = true;
+  }
+
   if (this->NumberOfRows != static_cast<vtkIdType>(num_rows))
   {
     this->SomethingUpdated = true;
@@ -886,12 +958,53 @@ vtkTable* vtkSpreadSheetView::FetchBlock(vtkIdType blockindex)
     block = this->FetchBlockCallback(blockindex);
     // use the block returned from the AddToCache since that is cleaned up
     // to have columns in correct order.
-    block = this->Internals->AddToCache(blockindex, block, 10);
+    block = this->Internals->AddToCache(
+      blockindex, block, std::max(10, 2 * this->NumberOfPrefetchBlocks + 2));
     this->InvokeEvent(vtkCommand::UpdateEvent, &blockindex);
   }
   return block;
 }
 
+//----------------------------------------------------------------------------
+bool vtkSpreadSheetView::Prefetch(vtkIdType firstRow, vtkIdType lastRow, int direction)
+{
+  auto& internals = *this->Internals;
+  if (this->NumberOfPrefetchBlocks <= 0 || internals.ActiveRepresentation == nullptr ||
+    this->NumberOfRows <= 0 || firstRow < 0 || lastRow < firstRow)
+  {
+    return false;
+  }
+
+  const vtkIdType blockSize = this->TableStreamer->GetBlockSize();
+  const vtkIdType maxBlockId = (this->NumberOfRows - 1) / blockSize;
+  const vtkIdType firstBlock = firstRow / blockSize;
+  const vtkIdType lastBlock = std::min(lastRow / blockSize, maxBlockId);
+
+  // blocks ahead in the scroll direction first, then the one just behind.
+  std::vector<vtkIdType> candidates;
+  for (int cc = 1; cc <= this->NumberOfPrefetchBlocks; ++cc)
+  {
+    candidates.push_back(direction >= 0 ? lastBlock + cc : firstBlock - cc);
+  }
+  candidates.push_back(direction >= 0 ? firstBlock - 1 : lastBlock + 1);
+
+  for (const vtkIdType blockId : candidates)
+  {
+    if (blockId < 0 || blockId > maxBlockId || internals.IsCached(blockId))
+    {
+      continue;
+    }
+
+    // prefetching must not change which block is deemed most recently
+    // accessed since that's used to pick the block for column meta-data.
+    const vtkIdType mrbId = internals.MostRecentlyAccessedBlock;
+    this->FetchBlock(blockId);
+    internals.MostRecentlyAccessedBlock = mrbId;
+    return true;
+  }
+  return false;
+}
+
 //----------------------------------------------------------------------------
 vtkTable* vtkSpreadSheetView::FetchBlockCallback(vtkIdType blockindex)
 {
@@ -1092,6 +1205,216 @@ bool vtkSpreadSheetView::Export(vtkCSVExporter* exporter)
   return true;
 }
 
+//----------------------------------------------------------------------------
+bool vtkSpreadSheetView::ExportOnDataServer(
+  const char* fileName, const char* fieldDelimiter, int formatting, int precision)
+{
+  auto controller = vtkMultiProcessController::GetGlobalController();
+  const int rank = controller ? controller->GetLocalProcessId() : 0;
+  const int numRanks = controller ? controller->GetNumberOfProcesses() : 1;
+  if (fileName == nullptr || fileName[0] == '\0')
+  {
+    return false;
+  }
+
+  // Produce the local rows. This is the same pipeline as the one used to
+  // stream blocks to the client, minus sorting and reduction.
+  vtkPartitionedDataSet* localData = nullptr;
+  vtkSpreadSheetRepresentation* cur = this->Internals->ActiveRepresentation;
+  if (vtkAlgorithmOutput* dataPort = cur ? vtkGetDataProducer(this, cur) : nullptr)
+  {
+    this->TableSelectionMarker->SetInputConnection(0, dataPort);
+    this->TableSelectionMarker->SetInputConnection(1, cur->GetExtractedDataProducer());
+    this->TableSelectionMarker->SetFieldAssociation(this->FieldAssociation);
+    this->RowFilter->SetInputConnection(this->TableSelectionMarker->GetOutputPort());
+    this->RowFilter->Update();
+    localData = vtkPartitionedDataSet::SafeDownCast(this->RowFilter->GetOutputDataObject(0));
+  }
+
+  std::vector<vtkTable*> tables;
+  vtkIdType localRows = 0;
+  for (unsigned int cc = 0, max = localData ? localData->GetNumberOfPartitions() : 0; cc < max;
+       ++cc)
+  {
+    auto table = vtkTable::SafeDownCast(localData->GetPartitionAsDataObject(cc));
+    if (table && table->GetNumberOfRows() > 0)
+    {
+      tables.push_back(table);
+      localRows += table->GetNumberOfRows();
+    }
+  }
+
+  // The header is written by the first process with rows.
+  std::vector<vtkIdType> allRows(numRanks, localRows);
+  if (controller && numRanks > 1)
+  {
+    controller->AllGather(&localRows, allRows.data(), 1);
+  }
+  const int headerRank = static_cast<int>(
+    std::find_if(allRows.begin(), allRows.end(), [](vtkIdType count) { return count > 0; }) -
+    allRows.begin());
+
+  // Agree on the columns to write and their order: each process lists its
+  // visible columns, the first process merges them in rank order and
+  // broadcasts the result. Columns missing on a process are written blank.
+  std::vector<vtkExportColumn> columns;
+  for (vtkTable* table : tables)
+  {
+    auto* rowData = table->GetRowData();
+    for (vtkIdType idx = 0; idx < rowData->GetNumberOfArrays(); ++idx)
+    {
+      auto array = rowData->GetAbstractArray(idx);
+      if (array == nullptr || array->GetName() == nullptr)
+      {
+        continue;
+      }
+      auto name = array->GetName();
+      auto colInfo = array->GetInformation();
+      const std::string label = colInfo->Has(vtkSplitColumnComponents::ORIGINAL_ARRAY_NAME())
+        ? std::string(colInfo->Get(vtkSplitColumnComponents::ORIGINAL_ARRAY_NAME()))
+        : std::string(::get_userfriendly_name(name, this));
+      if (!this->IsColumnInternal(name) && !this->IsColumnHiddenByName(name) &&
+        !this->IsColumnHiddenByLabel(label) &&
+        std::find_if(columns.begin(), columns.end(), [&](const vtkExportColumn& column) {
+          return column.Name == name;
+        }) == columns.end())
+      {
+        columns.push_back(vtkExportColumn{
+          name, ::get_userfriendly_name(name, this), array->GetNumberOfComponents() });
+      }
+    }
+  }
+  if (controller && numRanks > 1)
+  {
+    vtkMultiProcessStream localColumns;
+    ::PushColumns(localColumns, columns);
+    std::vector<vtkMultiProcessStream> allColumns;
+    controller->Gather(localColumns, allColumns, 0);
+
+    vtkMultiProcessStream globalColumns;
+    if (rank == 0)
+    {
+      columns.clear();
+      for (auto& stream : allColumns)
+      {
+        ::PopColumns(stream, columns);
+      }
+      ::PushColumns(globalColumns, columns);
+    }
+    controller->Broadcast(globalColumns, 0);
+    columns.clear();
+    ::PopColumns(globalColumns, columns);
+  }
+
+  // Format the local rows in memory.
+  vtkNew<vtkCSVExporter> exporter;
+  exporter->SetFieldDelimiter(fieldDelimiter);
+  exporter->SetFormatting(formatting);
+  exporter->SetPrecision(precision);
+  exporter->WriteToOutputStringOn();
+  exporter->Open(vtkCSVExporter::STREAM_ROWS);
+  for (const auto& column : columns)
+  {
+    exporter->SetColumnLabel(column.Name.c_str(), column.Label.c_str());
+    exporter->SetColumnLabel(("__vtkValidMask__" + column.Name).c_str(), nullptr);
+  }
+  if (rank == headerRank)
+  {
+    vtkNew<vtkFieldData> header;
+    for (const auto& column : columns)
+    {
+      vtkNew<vtkCharArray> array;
+      array->SetName(column.Name.c_str());
+      array->SetNumberOfComponents(column.NumberOfComponents);
+      header->AddArray(array);
+    }
+    exporter->WriteHeader(header);
+  }
+  for (vtkTable* table : tables)
+  {
+    auto* rowData = table->GetRowData();
+    const vtkIdType numRows = table->GetNumberOfRows();
+    vtkNew<vtkFieldData> data;
+    for (const auto& column : columns)
+    {
+      const std::string maskName = "__vtkValidMask__" + column.Name;
+      auto array = rowData->GetAbstractArray(column.Name.c_str());
+      if (array && array->GetNumberOfComponents() == column.NumberOfComponents)
+      {
+        data->AddArray(array);
+        if (auto mask = rowData->GetAbstractArray(maskName.c_str()))
+        {
+          data->AddArray(mask);
+        }
+        continue;
+      }
+
+      // missing (or incompatible) column, all values are masked out.
+      vtkNew<vtkCharArray> blank;
+      blank->SetName(column.Name.c_str());
+      blank->SetNumberOfComponents(column.NumberOfComponents);
+      blank->SetNumberOfTuples(numRows);
+      blank->FillValue(0);
+      vtkNew<vtkUnsignedCharArray> mask;
+      mask->SetName(maskName.c_str());
+      mask->SetNumberOfTuples(numRows);
+      mask->FillValue(0);
+      data->AddArray(blank);
+      data->AddArray(mask);
+    }
+    exporter->WriteData(data);
+  }
+  exporter->Close();
+  const std::string content = exporter->GetOutputString();
+
+  // Compute where this process' portion goes in the file.
+  const vtkIdType localSize = static_cast<vtkIdType>(content.size());
+  std::vector<vtkIdType> allSizes(numRanks, localSize);
+  if (controller && numRanks > 1)
+  {
+    controller->AllGather(&localSize, allSizes.data(), 1);
+  }
+  const vtkIdType offset =
+    std::accumulate(allSizes.begin(), allSizes.begin() + rank, static_cast<vtkIdType>(0));
+
+  // The first process creates (or truncates) the file, then every process
+  // writes its portion, in parallel.
+  int status = 1;
+  if (rank == 0)
+  {
+    vtksys::ofstream ofs(fileName, std::ios::out | std::ios::binary);
+    status = ofs ? 1 : 0;
+  }
+  if (controller && numRanks > 1)
+  {
+    controller->Broadcast(&status, 1, 0);
+  }
+  if (!status)
+  {
+    vtkErrorMacro("Failed to open for writing: " << fileName);
+    return false;
+  }
+
+  if (localSize > 0)
+  {
+    vtksys::ofstream ofs(fileName, std::ios::in | std::ios::out | std::ios::binary);
+    ofs.seekp(static_cast<std::streamoff>(offset));
+    ofs.write(content.data(), static_cast<std::streamsize>(localSize));
+    status = ofs ? 1 : 0;
+  }
+
+  int globalStatus = status;
+  if (controller && numRanks > 1)
+  {
+    controller->AllReduce(&status, &globalStatus, 1, vtkCommunicator::MIN_OP);
+  }
+  if (!globalStatus)
+  {
+    vtkErrorMacro("Failed to write '" << fileName << "' on all processes.");
+  }
+  return globalStatus != 0;
+}
+
 //***************************************************************************
 // Forwarded to vtkSortedTableStreamer.
 //----------------------------------------------------------------------------
@@ -1114,3 +1437,24 @@ void vtkSpreadSheetView::SetBlockSize(vtkIdType val)
   this->TableStreamer->SetBlockSize(val);
   this->ClearCache();
 }
+
+//***************************************************************************
+// Forwarded to vtkExtractMatchingRows.
+//----------------------------------------------------------------------------
+void vtkSpreadSheetView::SetRowFilterExpression(const char* expression)
+{
+  const char* current = this->RowFilter->GetExpression();
+  if ((current ? current : "") == std::string(expression ? expression : ""))
+  {
+    return;
+  }
+  this->RowFilter->SetExpression(expression);
+  this->ClearCache();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+const char* vtkSpreadSheetView::GetRowFilterExpression()
+{
+  return this->RowFilter->GetExpression();
+}
@@ -31,6 +31,7 @@
 
 class vtkCSVExporter;
 class vtkClientServerMoveData;
+class vtkExtractMatchingRows;
 class vtkMarkSelectedRows;
 class vtkReductionFilter;
 class vtkSortedTableStreamer;
@@ -229,11 +230,64 @@ public:
    */
   void SetBlockSize(vtkIdType val);
 
+  //***************************************************************************
+  // Forwarded to vtkExtractMatchingRows.
+  /**
+   * Set an expression used to filter the rows shown in the view. Rows are
+   * filtered on the data server, before sorting and delivery, so only
+   * matching rows are ever transferred to the client. The expression uses the
+   * same syntax as the Calculator filter; columns are referred to by name.
+   * Set to an empty string or nullptr to show all rows.
+   * \note CallOnAllProcesses
+   */
+  void SetRowFilterExpression(const char*);
+  const char* GetRowFilterExpression();
+
+  ///@{
+  /**
+   * Get/Set the number of blocks to fetch ahead of the visible region, in the
+   * scroll direction, when the application is idle. Set to 0 to disable
+   * prefetching. Default is 2.
+   */
+  vtkSetClampMacro(NumberOfPrefetchBlocks, int, 0, 8);
+  vtkGetMacro(NumberOfPrefetchBlocks, int);
+  ///@}
+
+  /**
+   * Fetches at most one block near the visible rows `[firstRow, lastRow]`
+   * that is not yet available on the client. Blocks ahead of the visible
+   * region in the scroll `direction` (positive for downwards) are fetched
+   * first, followed by the block just before it. Returns true if a block was
+   * fetched, false if there is nothing left to prefetch.
+   *
+   * This is intended to be called repeatedly by the UI when idle; each call
+   * results in a single, synchronous, block fetch.
+   */
+  bool Prefetch(vtkIdType firstRow, vtkIdType lastRow, int direction);
+
   /**
    * Export the contents of this view using the exporter.
    */
   virtual bool Export(vtkCSVExporter* exporter);
 
+  /**
+   * Export the rows of this view to a CSV file directly from the data server
+   * processes, without delivering them to the client. Each process formats
+   * its own rows and writes them to `fileName` at an offset computed from
+   * the sizes of the preceding processes' portions, so `fileName` must be
+   * on a file system shared by all data server processes.
+   *
+   * The row filter is honored but rows are written in the order they are
+   * stored on the processes, i.e. sorting is ignored. All processes write the
+   * same columns in the same order; values of columns a process does not have
+   * are left blank.
+   *
+   * This must be called on all data server processes. Returns true if all
+   * processes succeeded.
+   */
+  virtual bool ExportOnDataServer(
+    const char* fileName, const char* fieldDelimiter, int formatting, int precision);
+
   /**
    * Allow user to clear the cache if he needs to.
    */
@@ -263,9 +317,11 @@ protected:
   bool GenerateCellConnectivity;
   vtkSortedTableStreamer* TableStreamer;
   vtkMarkSelectedRows* TableSelectionMarker;
+  vtkExtractMatchingRows* RowFilter;
   vtkReductionFilter* ReductionFilter;
   vtkClientServerMoveData* DeliveryFilter;
   vtkIdType NumberOfRows;
+  int NumberOfPrefetchBlocks;
 
   unsigned long CRMICallbackTag;
   unsigned long PRMICallbackTag;
@@ -32,6 +32,22 @@ bool check_group(vtkFileSequenceParser* parser, const char* fname, const char* s
   return true;
 }
 
+bool check_index(vtkFileSequenceParser* parser, const char* fname, const char* seqname, int index)
+{
+  if (!check_group(parser, fname, seqname))
+  {
+    return false;
+  }
+  if (parser->GetSequenceIndex() != index)
+  {
+    cout << "ERROR: sequence index mismatch for '" << fname << "' " << endl
+         << "  expected : " << index << endl
+         << "      got  : " << parser->GetSequenceIndex() << endl;
+    return false;
+  }
+  return true;
+}
+
 bool check_no_group(vtkFileSequenceParser* parser, const char* fname)
 {
   if (parser->ParseFileSequence(fname))
@@ -59,8 +75,14 @@ int TestFileSequenceParser(int, char* argv[])
   check_group(seqParser.Get(), "prefix021suffix.ext", "prefix..suffix.ext");
   check_group(seqParser.Get(), "plt0001000", "plt..");
 
+  // names that only differ by their digits share how they are parsed.
+  bool success = true;
+  success &= check_index(seqParser.Get(), "run1_0001.vtu", "run1_..vtu", 1);
+  success &= check_index(seqParser.Get(), "run2_0042.vtu", "run2_..vtu", 42);
+  success &= check_index(seqParser.Get(), "plt0001001", "plt..", 1001);
+
   check_no_group(seqParser.Get(), "foo.3dm");
   check_no_group(seqParser.Get(), "foo.2dm");
 
-  return EXIT_SUCCESS;
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
 }
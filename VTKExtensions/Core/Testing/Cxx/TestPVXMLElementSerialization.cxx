@@ -0,0 +1,99 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPVXMLElementSerialization.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include <vtkMultiProcessStream.h>
+#include <vtkNew.h>
+#include <vtkPVXMLElement.h>
+#include <vtkPVXMLParser.h>
+
+#include <cstring>
+#include <vector>
+
+int TestPVXMLElementSerialization(int, char*[])
+{
+  const char* xml = "<ServerManagerConfiguration>"
+                    "  <ProxyGroup name=\"sources\">"
+                    "    <SourceProxy name=\"Sphere\" class=\"vtkSphereSource\">"
+                    "      <DoubleVectorProperty name=\"Radius\" default_values=\"0.5\" />"
+                    "      <Documentation>A &lt;sphere&gt;.</Documentation>"
+                    "    </SourceProxy>"
+                    "  </ProxyGroup>"
+                    "</ServerManagerConfiguration>";
+
+  vtkNew<vtkPVXMLParser> parser;
+  if (!parser->Parse(xml))
+  {
+    cerr << "ERROR: failed to parse xml." << endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkMultiProcessStream stream;
+  parser->GetRootElement()->Serialize(stream);
+
+  // go through raw data, as done when caching to disk.
+  std::vector<unsigned char> raw;
+  stream.GetRawData(raw);
+  vtkMultiProcessStream restoredStream;
+  restoredStream.SetRawData(raw);
+
+  vtkNew<vtkPVXMLElement> restored;
+  if (!restored->Deserialize(restoredStream))
+  {
+    cerr << "ERROR: failed to deserialize." << endl;
+    return EXIT_FAILURE;
+  }
+
+  if (!restored->Equals(parser->GetRootElement()))
+  {
+    cerr << "ERROR: restored element does not match the parsed one." << endl;
+    restored->PrintXML();
+    return EXIT_FAILURE;
+  }
+
+  vtkPVXMLElement* group = restored->FindNestedElementByName("ProxyGroup");
+  vtkPVXMLElement* proxy = group ? group->FindNestedElementByName("SourceProxy") : nullptr;
+  if (proxy == nullptr || strcmp(proxy->GetAttribute("class"), "vtkSphereSource") != 0)
+  {
+    cerr << "ERROR: restored nested elements or attributes are incorrect." << endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkMultiProcessStream empty;
+  vtkNew<vtkPVXMLElement> invalid;
+  if (invalid->Deserialize(empty))
+  {
+    cerr << "ERROR: deserializing an empty stream should fail." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // truncated and corrupted buffers must be rejected, as with a damaged cache file.
+  std::vector<unsigned char> buffer;
+  parser->GetRootElement()->Serialize(buffer);
+  for (size_t length : { size_t(0), size_t(8), size_t(16), buffer.size() / 2, buffer.size() - 1 })
+  {
+    if (invalid->Deserialize(buffer.data(), length))
+    {
+      cerr << "ERROR: deserializing a buffer truncated to " << length << " bytes should fail."
+           << endl;
+      return EXIT_FAILURE;
+    }
+  }
+  buffer[buffer.size() / 2] ^= 0x5a;
+  if (invalid->Deserialize(buffer.data(), buffer.size()) || invalid->GetName() != nullptr)
+  {
+    cerr << "ERROR: deserializing a corrupted buffer should fail." << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -16,11 +16,41 @@
 
 #include "vtkObjectFactory.h"
 
+#include <algorithm>
+#include <array>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vtksys/RegularExpression.hxx>
 #include <vtksys/SystemTools.hxx>
 
+class vtkFileSequenceParser::vtkInternals
+{
+public:
+  // Positions of the groups matched by one of the patterns. `Pattern` is the
+  // index of the pattern that matched, or -1 if none did.
+  struct MatchType
+  {
+    int Pattern = -1;
+    std::array<std::pair<std::size_t, std::size_t>, 5> Groups;
+  };
+
+  // Matches keyed on the file name with all digits replaced by '0'. Cleared
+  // when it grows too large, e.g. when listing a directory with many
+  // unrelated files.
+  std::unordered_map<std::string, MatchType> Matches;
+  static constexpr std::size_t MAX_CACHED_MATCHES = 4096;
+
+  static void RecordGroups(
+    const vtksys::RegularExpression* regEx, int numberOfGroups, MatchType& match)
+  {
+    for (int cc = 1; cc <= numberOfGroups; ++cc)
+    {
+      match.Groups[cc] = std::make_pair(regEx->start(cc), regEx->end(cc));
+    }
+  }
+};
+
 vtkStandardNewMacro(vtkFileSequenceParser);
 //-----------------------------------------------------------------------------
 vtkFileSequenceParser::vtkFileSequenceParser()
@@ -48,6 +78,7 @@ vtkFileSequenceParser::vtkFileSequenceParser()
   reg_ex_last(new vtksys::RegularExpression("^(.*[^0-9])([0-9]+)([^0-9]*)$"))
   , SequenceIndex(-1)
   , SequenceName(nullptr)
+  , Internals(new vtkFileSequenceParser::vtkInternals())
 {
 }
 
@@ -60,6 +91,7 @@ vtkFileSequenceParser::~vtkFileSequenceParser()
   delete this->reg_ex4;
   delete this->reg_ex5;
   delete this->reg_ex_last;
+  delete this->Internals;
 
   this->SetSequenceName(nullptr);
 }
@@ -67,62 +99,105 @@ vtkFileSequenceParser::~vtkFileSequenceParser()
 //-----------------------------------------------------------------------------
 bool vtkFileSequenceParser::ParseFileSequence(const char* file)
 {
-  bool match = false;
-  if (this->reg_ex->find(file))
-  {
-    this->SetSequenceName(this->reg_ex->match(1).c_str());
-    this->SequenceIndexString = this->reg_ex->match(2);
-    match = true;
-  }
-  else if (this->reg_ex2->find(file))
-  {
-    this->SetSequenceName(std::string(
-      this->reg_ex2->match(1) + this->reg_ex2->match(2) + ".." + this->reg_ex2->match(4))
-                            .c_str());
-    this->SequenceIndexString = this->reg_ex2->match(3);
-    match = true;
-  }
-  else if (this->reg_ex3->find(file))
+  const std::string fname(file);
+  auto isDigit = [](char c) { return c >= '0' && c <= '9'; };
+
+  // all patterns require a number.
+  if (std::none_of(fname.begin(), fname.end(), isDigit))
   {
-    this->SetSequenceName(std::string(
-      this->reg_ex3->match(1) + this->reg_ex3->match(2) + ".." + this->reg_ex3->match(4))
-                            .c_str());
-    this->SequenceIndexString = this->reg_ex3->match(3);
-    match = true;
+    return false;
   }
-  else if (this->reg_ex4->find(file))
+
+  // None of the patterns distinguishes between digits, hence names that only
+  // differ by their digits match the same way.
+  std::string key(fname);
+  std::replace_if(key.begin(), key.end(), isDigit, '0');
+
+  using MatchType = vtkInternals::MatchType;
+  auto& matches = this->Internals->Matches;
+  auto iter = matches.find(key);
+  if (iter == matches.end())
   {
-    this->SetSequenceName(std::string(
-      ".." + this->reg_ex4->match(2) + this->reg_ex4->match(3) + "." + this->reg_ex4->match(4))
-                            .c_str());
-    this->SequenceIndexString = this->reg_ex4->match(1);
-    match = true;
+    if (matches.size() >= vtkInternals::MAX_CACHED_MATCHES)
+    {
+      matches.clear();
+    }
+
+    MatchType match;
+    const std::string keyWithoutExt = vtksys::SystemTools::GetFilenameWithoutExtension(key);
+    if (this->reg_ex->find(key))
+    {
+      match.Pattern = 0;
+      vtkInternals::RecordGroups(this->reg_ex, 2, match);
+    }
+    else if (this->reg_ex2->find(key))
+    {
+      match.Pattern = 1;
+      vtkInternals::RecordGroups(this->reg_ex2, 4, match);
+    }
+    else if (this->reg_ex3->find(key))
+    {
+      match.Pattern = 2;
+      vtkInternals::RecordGroups(this->reg_ex3, 4, match);
+    }
+    else if (this->reg_ex4->find(key))
+    {
+      match.Pattern = 3;
+      vtkInternals::RecordGroups(this->reg_ex4, 4, match);
+    }
+    else if (this->reg_ex5->find(key))
+    {
+      match.Pattern = 4;
+      vtkInternals::RecordGroups(this->reg_ex5, 4, match);
+    }
+    else if (this->reg_ex_last->find(keyWithoutExt))
+    {
+      match.Pattern = 5;
+      vtkInternals::RecordGroups(this->reg_ex_last, 3, match);
+    }
+    iter = matches.insert(std::make_pair(key, match)).first;
   }
-  else if (this->reg_ex5->find(file))
+
+  const MatchType& match = iter->second;
+  if (match.Pattern < 0)
   {
-    this->SetSequenceName(std::string(
-      ".." + this->reg_ex5->match(2) + this->reg_ex5->match(3) + "." + this->reg_ex5->match(4))
-                            .c_str());
-    this->SequenceIndexString = this->reg_ex5->match(1);
-    match = true;
+    return false;
   }
-  else
+
+  // the fallback pattern is matched against the file name without extension.
+  const std::string subject =
+    match.Pattern == 5 ? vtksys::SystemTools::GetFilenameWithoutExtension(fname) : fname;
+  auto group = [&](int cc) {
+    return subject.substr(match.Groups[cc].first, match.Groups[cc].second - match.Groups[cc].first);
+  };
+
+  switch (match.Pattern)
   {
-    std::string fname_wo_ext = vtksys::SystemTools::GetFilenameWithoutExtension(file);
-    std::string ext = vtksys::SystemTools::GetFilenameExtension(file);
-    if (this->reg_ex_last->find(fname_wo_ext))
-    {
+    case 0:
+      this->SetSequenceName(group(1).c_str());
+      this->SequenceIndexString = group(2);
+      break;
+
+    case 1:
+    case 2:
+      this->SetSequenceName((group(1) + group(2) + ".." + group(4)).c_str());
+      this->SequenceIndexString = group(3);
+      break;
+
+    case 3:
+    case 4:
+      this->SetSequenceName((".." + group(2) + group(3) + "." + group(4)).c_str());
+      this->SequenceIndexString = group(1);
+      break;
+
+    default:
       this->SetSequenceName(
-        (this->reg_ex_last->match(1) + ".." + this->reg_ex_last->match(3) + ext).c_str());
-      this->SequenceIndexString = this->reg_ex_last->match(2);
-      match = true;
-    }
-  }
-  if (match)
-  {
-    this->SequenceIndex = atoi(this->SequenceIndexString.c_str());
+        (group(1) + ".." + group(3) + vtksys::SystemTools::GetFilenameExtension(fname)).c_str());
+      this->SequenceIndexString = group(2);
+      break;
   }
-  return match;
+  this->SequenceIndex = atoi(this->SequenceIndexString.c_str());
+  return true;
 }
 
 //-----------------------------------------------------------------------------
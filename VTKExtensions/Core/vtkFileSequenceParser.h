@@ -21,7 +21,11 @@
  * extract the base portion of the file name that is common to all the files
  * in the sequence. It will also provide the current sequence index of the
  * provided file name.
- * by several vtkPVUpdateSuppressor objects.
+ *
+ * None of the patterns used to detect sequences distinguishes between digits,
+ * so file names that only differ by their digits are parsed the same way. The
+ * parser caches how such names match, so that parsing the files of a sequence
+ * only evaluates the patterns once per distinct file name layout.
  */
 
 #ifndef vtkFileSequenceParser_h
@@ -91,6 +95,9 @@ protected:
 private:
   vtkFileSequenceParser(const vtkFileSequenceParser&) = delete;
   void operator=(const vtkFileSequenceParser&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
 };
 
 #endif
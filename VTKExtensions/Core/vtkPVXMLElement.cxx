@@ -15,11 +15,14 @@
 #include "vtkPVXMLElement.h"
 
 #include "vtkCollection.h"
+#include "vtkMultiProcessStream.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkSmartPointer.h"
 
 vtkStandardNewMacro(vtkPVXMLElement);
 
+#include <algorithm>
 #include <cctype>
 #include <sstream>
 #include <string>
@@ -39,6 +42,66 @@ struct vtkPVXMLElementInternals
   std::string CharacterData;
 };
 
+namespace
+{
+// Length and checksum that precede serialized elements.
+constexpr size_t vtkPVXMLElementHeaderSize = 16;
+
+void AppendUInt(std::vector<unsigned char>& buffer, vtkTypeUInt64 value, int numBytes)
+{
+  // little endian, independently of the platform.
+  for (int cc = 0; cc < numBytes; ++cc)
+  {
+    buffer.push_back(static_cast<unsigned char>(value >> (8 * cc)));
+  }
+}
+
+void AppendString(std::vector<unsigned char>& buffer, const std::string& value)
+{
+  AppendUInt(buffer, static_cast<vtkTypeUInt64>(value.size()), 4);
+  buffer.insert(buffer.end(), value.begin(), value.end());
+}
+
+bool ReadUInt(const unsigned char*& cursor, const unsigned char* end, vtkTypeUInt64& value,
+  int numBytes)
+{
+  if (end - cursor < numBytes)
+  {
+    return false;
+  }
+  value = 0;
+  for (int cc = 0; cc < numBytes; ++cc)
+  {
+    value |= static_cast<vtkTypeUInt64>(cursor[cc]) << (8 * cc);
+  }
+  cursor += numBytes;
+  return true;
+}
+
+bool ReadString(const unsigned char*& cursor, const unsigned char* end, std::string& value)
+{
+  vtkTypeUInt64 length = 0;
+  if (!ReadUInt(cursor, end, length, 4) || static_cast<vtkTypeUInt64>(end - cursor) < length)
+  {
+    return false;
+  }
+  value.assign(reinterpret_cast<const char*>(cursor), static_cast<size_t>(length));
+  cursor += length;
+  return true;
+}
+
+// 64-bit FNV-1a.
+vtkTypeUInt64 ComputeChecksum(const unsigned char* data, size_t length)
+{
+  vtkTypeUInt64 hash = 14695981039346656037ull;
+  for (size_t cc = 0; cc < length; ++cc)
+  {
+    hash = (hash ^ data[cc]) * 1099511628211ull;
+  }
+  return hash;
+}
+}
+
 // Function to check if a string is full of whitespace characters.
 static bool vtkIsSpace(const std::string& str)
 {
@@ -749,6 +812,139 @@ void vtkPVXMLElement::CopyAttributesTo(vtkPVXMLElement* other)
     this->Internal->CharacterData.c_str(), static_cast<int>(this->Internal->CharacterData.size()));
 }
 
+//----------------------------------------------------------------------------
+void vtkPVXMLElement::Serialize(vtkMultiProcessStream& stream)
+{
+  std::vector<unsigned char> buffer;
+  this->Serialize(buffer);
+  stream.Push(buffer.data(), static_cast<unsigned int>(buffer.size()));
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVXMLElement::Deserialize(vtkMultiProcessStream& stream)
+{
+  if (stream.Empty())
+  {
+    return false;
+  }
+
+  unsigned char* buffer = nullptr;
+  unsigned int length = 0;
+  stream.Pop(buffer, length);
+  const bool status = this->Deserialize(buffer, length);
+  delete[] buffer;
+  return status;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVXMLElement::Serialize(std::vector<unsigned char>& buffer)
+{
+  const size_t start = buffer.size();
+  buffer.resize(start + vtkPVXMLElementHeaderSize);
+  this->SerializeElement(buffer);
+
+  const size_t length = buffer.size() - start - vtkPVXMLElementHeaderSize;
+  std::vector<unsigned char> header;
+  AppendUInt(header, static_cast<vtkTypeUInt64>(length), 8);
+  AppendUInt(
+    header, ComputeChecksum(buffer.data() + start + vtkPVXMLElementHeaderSize, length), 8);
+  std::copy(header.begin(), header.end(), buffer.begin() + start);
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVXMLElement::Deserialize(const unsigned char* buffer, size_t length)
+{
+  auto reset = [this]() {
+    this->SetName(nullptr);
+    this->SetId(nullptr);
+    this->Internal->AttributeNames.clear();
+    this->Internal->AttributeValues.clear();
+    this->Internal->CharacterData.clear();
+    this->RemoveAllNestedElements();
+  };
+  reset();
+
+  const unsigned char* cursor = buffer;
+  const unsigned char* end = buffer + length;
+  vtkTypeUInt64 payloadLength = 0, checksum = 0;
+  if (buffer == nullptr || !ReadUInt(cursor, end, payloadLength, 8) ||
+    !ReadUInt(cursor, end, checksum, 8) ||
+    payloadLength != static_cast<vtkTypeUInt64>(end - cursor) ||
+    checksum != ComputeChecksum(cursor, static_cast<size_t>(payloadLength)))
+  {
+    return false;
+  }
+
+  if (!this->DeserializeElement(cursor, end) || cursor != end)
+  {
+    reset();
+    return false;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVXMLElement::SerializeElement(std::vector<unsigned char>& buffer)
+{
+  AppendString(buffer, this->Name ? this->Name : "");
+  AppendString(buffer, this->Id ? this->Id : "");
+  AppendUInt(buffer, static_cast<vtkTypeUInt64>(this->Internal->AttributeNames.size()), 4);
+  for (size_t cc = 0; cc < this->Internal->AttributeNames.size(); ++cc)
+  {
+    AppendString(buffer, this->Internal->AttributeNames[cc]);
+    AppendString(buffer, this->Internal->AttributeValues[cc]);
+  }
+  AppendString(buffer, this->Internal->CharacterData);
+  AppendUInt(buffer, static_cast<vtkTypeUInt64>(this->Internal->NestedElements.size()), 4);
+  for (auto& nested : this->Internal->NestedElements)
+  {
+    nested->SerializeElement(buffer);
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVXMLElement::DeserializeElement(const unsigned char*& cursor, const unsigned char* end)
+{
+  std::string name, id;
+  vtkTypeUInt64 numberOfAttributes = 0;
+  if (!ReadString(cursor, end, name) || !ReadString(cursor, end, id) ||
+    !ReadUInt(cursor, end, numberOfAttributes, 4))
+  {
+    return false;
+  }
+  this->SetName(name.empty() ? nullptr : name.c_str());
+  this->SetId(id.empty() ? nullptr : id.c_str());
+
+  // counts are not trusted to reserve memory, each entry is read and checked.
+  for (vtkTypeUInt64 cc = 0; cc < numberOfAttributes; ++cc)
+  {
+    std::string attrName, attrValue;
+    if (!ReadString(cursor, end, attrName) || !ReadString(cursor, end, attrValue))
+    {
+      return false;
+    }
+    this->Internal->AttributeNames.push_back(std::move(attrName));
+    this->Internal->AttributeValues.push_back(std::move(attrValue));
+  }
+
+  vtkTypeUInt64 numberOfNestedElements = 0;
+  if (!ReadString(cursor, end, this->Internal->CharacterData) ||
+    !ReadUInt(cursor, end, numberOfNestedElements, 4))
+  {
+    return false;
+  }
+  for (vtkTypeUInt64 cc = 0; cc < numberOfNestedElements; ++cc)
+  {
+    vtkNew<vtkPVXMLElement> nested;
+    if (!nested->DeserializeElement(cursor, end))
+    {
+      return false;
+    }
+    this->AddNestedElement(nested);
+  }
+  return true;
+}
+
 //----------------------------------------------------------------------------
 bool vtkPVXMLElement::Equals(vtkPVXMLElement* other)
 {
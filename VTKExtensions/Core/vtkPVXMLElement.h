@@ -26,8 +26,10 @@
 #include "vtkPVVTKExtensionsCoreModule.h" // needed for export macro
 
 #include <string> // for std::string
+#include <vector> // for std::vector
 
 class vtkCollection;
+class vtkMultiProcessStream;
 class vtkPVXMLParser;
 
 struct vtkPVXMLElementInternals;
@@ -263,6 +265,22 @@ public:
    */
   void CopyAttributesTo(vtkPVXMLElement* other);
 
+  ///@{
+  /**
+   * Save this element and its nested elements to a compact binary stream and
+   * restore them. Restoring is much cheaper than parsing the equivalent XML,
+   * which makes this suitable to cache parsed documents or to send them to
+   * other processes. The serialized bytes start with their length and a
+   * checksum, and every read is checked against the size of the buffer.
+   * Deserialize returns false if the data is truncated or corrupted, in which
+   * case the element is left empty.
+   */
+  void Serialize(vtkMultiProcessStream& stream);
+  bool Deserialize(vtkMultiProcessStream& stream);
+  void Serialize(std::vector<unsigned char>& buffer);
+  bool Deserialize(const unsigned char* buffer, size_t length);
+  ///@}
+
 protected:
   vtkPVXMLElement();
   ~vtkPVXMLElement() override;
@@ -285,6 +303,10 @@ protected:
   vtkPVXMLElement* LookupElementUpScope(const char* id);
   void SetParent(vtkPVXMLElement* parent);
 
+  // Serialize this element and its nested elements without the header.
+  void SerializeElement(std::vector<unsigned char>& buffer);
+  bool DeserializeElement(const unsigned char*& cursor, const unsigned char* end);
+
   friend class vtkPVXMLParser;
 
 private:
@@ -0,0 +1,130 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestExtractMatchingRows.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkDoubleArray.h"
+#include "vtkExtractMatchingRows.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPartitionedDataSet.h"
+#include "vtkSmartPointer.h"
+#include "vtkTable.h"
+
+#include <vector>
+
+#define VERIFY(x, y)                                                                               \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    vtkLogF(ERROR, y);                                                                             \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+// A table of 6 rows with an "Id" column (0 to 5), a "Value" column (Id * 10)
+// and a 3-component "Vector" column (Id, -Id, 1).
+vtkSmartPointer<vtkPartitionedDataSet> BuildInput()
+{
+  vtkNew<vtkIntArray> ids;
+  ids->SetName("Id");
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("Value");
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName("Vector");
+  vectors->SetNumberOfComponents(3);
+  for (int row = 0; row < 6; ++row)
+  {
+    ids->InsertNextValue(row);
+    values->InsertNextValue(row * 10.0);
+    vectors->InsertNextTuple3(row, -row, 1);
+  }
+
+  vtkNew<vtkTable> table;
+  table->AddColumn(ids);
+  table->AddColumn(values);
+  table->AddColumn(vectors);
+
+  auto input = vtkSmartPointer<vtkPartitionedDataSet>::New();
+  input->SetPartition(0, table);
+  return input;
+}
+
+// Runs the filter on a new input and returns its output table.
+vtkSmartPointer<vtkTable> Extract(const char* expression)
+{
+  vtkNew<vtkExtractMatchingRows> filter;
+  filter->SetInputData(BuildInput());
+  filter->SetExpression(expression);
+  filter->Update();
+
+  auto output = vtkPartitionedDataSet::SafeDownCast(filter->GetOutputDataObject(0));
+  if (output == nullptr || output->GetNumberOfPartitions() != 1)
+  {
+    return nullptr;
+  }
+  return vtkTable::SafeDownCast(output->GetPartitionAsDataObject(0));
+}
+
+// Checks that `table` has all the input columns and the rows `ids`.
+bool VerifyRows(vtkTable* table, const std::vector<int>& ids)
+{
+  VERIFY(table != nullptr, "expected a single output table.");
+  VERIFY(table->GetNumberOfColumns() == 3, "expected all input columns.");
+  VERIFY(table->GetNumberOfRows() == static_cast<vtkIdType>(ids.size()),
+    "unexpected number of rows.");
+  auto idColumn = vtkIntArray::SafeDownCast(table->GetColumnByName("Id"));
+  auto valueColumn = vtkDoubleArray::SafeDownCast(table->GetColumnByName("Value"));
+  auto vectorColumn = vtkDoubleArray::SafeDownCast(table->GetColumnByName("Vector"));
+  VERIFY(idColumn && valueColumn && vectorColumn, "missing output columns.");
+  VERIFY(vectorColumn->GetNumberOfComponents() == 3, "expected a 3-component Vector column.");
+  for (vtkIdType row = 0; row < table->GetNumberOfRows(); ++row)
+  {
+    const int id = ids[row];
+    VERIFY(idColumn->GetValue(row) == id, "unexpected row.");
+    VERIFY(valueColumn->GetValue(row) == id * 10.0, "Value does not match the row.");
+    VERIFY(vectorColumn->GetComponent(row, 1) == -id, "Vector does not match the row.");
+  }
+  return true;
+}
+
+bool TestExtractMatchingRowsExpressions()
+{
+  // matching rows.
+  VERIFY(VerifyRows(Extract("Value > 25"), { 3, 4, 5 }), "scalar expression.");
+  VERIFY(VerifyRows(Extract("Id == 1 || Id == 4"), { 1, 4 }), "or expression.");
+  VERIFY(VerifyRows(Extract("Vector_1 >= -1"), { 0, 1 }), "component expression.");
+  VERIFY(VerifyRows(Extract("mag(Vector) > 3"), { 3, 4, 5 }), "vector expression.");
+
+  // no matching rows: the columns are kept.
+  VERIFY(VerifyRows(Extract("Value < 0"), {}), "expression matching no rows.");
+
+  // no expression: all rows are passed.
+  VERIFY(VerifyRows(Extract(nullptr), { 0, 1, 2, 3, 4, 5 }), "no expression.");
+  VERIFY(VerifyRows(Extract(""), { 0, 1, 2, 3, 4, 5 }), "empty expression.");
+
+  // an invalid expression passes no rows but keeps the columns.
+  const int warningDisplay = vtkObject::GetGlobalWarningDisplay();
+  vtkObject::GlobalWarningDisplayOff();
+  auto invalid = Extract("Unknown > 1");
+  vtkObject::SetGlobalWarningDisplay(warningDisplay);
+  VERIFY(VerifyRows(invalid, {}), "invalid expression.");
+  return true;
+}
+}
+
+int TestExtractMatchingRows(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  return TestExtractMatchingRowsExpressions() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
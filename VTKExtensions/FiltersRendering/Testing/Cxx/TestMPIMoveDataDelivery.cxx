@@ -0,0 +1,389 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestMPIMoveDataDelivery.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Tests the delivery of data from the data server to the client by
+// vtkMPIMoveData. Rank 0 acts as the data server and rank 1 as the client,
+// connected by a socket as in client-server mode. Both ranks build the same
+// data: rank 0 delivers it and rank 1 compares what it received. Covers delta
+// delivery, the delivery cache and compression.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkDummyController.h"
+#include "vtkIdTypeArray.h"
+#include "vtkLogger.h"
+#include "vtkMPIController.h"
+#include "vtkMPIMoveData.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkServerSocket.h"
+#include "vtkSmartPointer.h"
+#include "vtkSocketCommunicator.h"
+#include "vtkSocketController.h"
+
+#include <string>
+
+#define VERIFY(x, y)                                                                               \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    vtkLogF(ERROR, y);                                                                             \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+// A strip of `numberOfQuads` quads with a point and a cell array. Point values
+// are `value` plus the point index.
+vtkSmartPointer<vtkPolyData> BuildStrip(vtkIdType numberOfQuads, double value)
+{
+  auto strip = vtkSmartPointer<vtkPolyData>::New();
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("Values");
+  for (vtkIdType cc = 0; cc <= numberOfQuads; ++cc)
+  {
+    points->InsertNextPoint(cc, 0, 0);
+    points->InsertNextPoint(cc, 1, 0);
+    values->InsertNextValue(value + 2 * cc);
+    values->InsertNextValue(value + 2 * cc + 1);
+  }
+  strip->SetPoints(points);
+  strip->GetPointData()->SetScalars(values);
+
+  vtkNew<vtkCellArray> quads;
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName("CellIds");
+  for (vtkIdType cc = 0; cc < numberOfQuads; ++cc)
+  {
+    const vtkIdType quad[4] = { 2 * cc, 2 * cc + 2, 2 * cc + 3, 2 * cc + 1 };
+    quads->InsertNextCell(4, quad);
+    ids->InsertNextValue(cc);
+  }
+  strip->SetPolys(quads);
+  strip->GetCellData()->AddArray(ids);
+  return strip;
+}
+
+// A strip with an additional array of pseudo-random values, large enough to
+// make most of the payload incompressible.
+vtkSmartPointer<vtkPolyData> BuildNoisyStrip(vtkIdType numberOfQuads)
+{
+  auto strip = BuildStrip(numberOfQuads, 0);
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(8775070);
+  vtkNew<vtkDoubleArray> noise;
+  noise->SetName("Noise");
+  noise->SetNumberOfComponents(16);
+  noise->SetNumberOfTuples(strip->GetNumberOfPoints());
+  for (vtkIdType cc = 0; cc < noise->GetNumberOfValues(); ++cc)
+  {
+    random->Next();
+    noise->SetValue(cc, random->GetValue());
+  }
+  strip->GetPointData()->AddArray(noise);
+  return strip;
+}
+
+bool CompareArrays(vtkDataArray* a, vtkDataArray* b)
+{
+  VERIFY(a && b, "missing array.");
+  VERIFY(a->GetNumberOfTuples() == b->GetNumberOfTuples() &&
+      a->GetNumberOfComponents() == b->GetNumberOfComponents(),
+    "array sizes differ.");
+  for (vtkIdType cc = 0; cc < a->GetNumberOfValues(); ++cc)
+  {
+    VERIFY(a->GetComponent(cc / a->GetNumberOfComponents(), cc % a->GetNumberOfComponents()) ==
+        b->GetComponent(cc / b->GetNumberOfComponents(), cc % b->GetNumberOfComponents()),
+      "array values differ.");
+  }
+  return true;
+}
+
+bool CompareAttributes(vtkDataSetAttributes* a, vtkDataSetAttributes* b)
+{
+  VERIFY(a->GetNumberOfArrays() == b->GetNumberOfArrays(), "number of arrays differ.");
+  for (int cc = 0; cc < a->GetNumberOfArrays(); ++cc)
+  {
+    vtkDataArray* array = a->GetArray(cc);
+    VERIFY(array && array->GetName(), "unnamed array.");
+    VERIFY(CompareArrays(array, b->GetArray(array->GetName())), "attribute arrays differ.");
+  }
+  VERIFY((a->GetScalars() == nullptr) == (b->GetScalars() == nullptr), "active scalars differ.");
+  if (a->GetScalars())
+  {
+    VERIFY(std::string(a->GetScalars()->GetName()) == b->GetScalars()->GetName(),
+      "active scalars differ.");
+  }
+  return true;
+}
+
+bool ComparePolyData(vtkPolyData* received, vtkPolyData* expected)
+{
+  VERIFY(received, "nothing received.");
+  VERIFY(
+    received->GetNumberOfPoints() == expected->GetNumberOfPoints(), "number of points differ.");
+  VERIFY(received->GetNumberOfPolys() == expected->GetNumberOfPolys(), "number of cells differ.");
+  VERIFY(CompareArrays(received->GetPoints()->GetData(), expected->GetPoints()->GetData()),
+    "points differ.");
+  VERIFY(CompareArrays(received->GetPolys()->GetOffsetsArray(),
+           expected->GetPolys()->GetOffsetsArray()),
+    "cells differ.");
+  VERIFY(CompareArrays(received->GetPolys()->GetConnectivityArray(),
+           expected->GetPolys()->GetConnectivityArray()),
+    "cells differ.");
+  VERIFY(CompareAttributes(received->GetPointData(), expected->GetPointData()),
+    "point data differ.");
+  VERIFY(CompareAttributes(received->GetCellData(), expected->GetCellData()), "cell data differ.");
+  return true;
+}
+
+// Delivers `data` from rank 0 to rank 1, in collect mode, and checks on rank 1
+// that the received data matches `data`.
+bool Deliver(vtkMultiProcessController* link, int rank, vtkPolyData* data, vtkTypeUInt64 key)
+{
+  vtkNew<vtkDummyController> local;
+  vtkNew<vtkMPIMoveData> move;
+  move->SetController(local);
+  move->SetClientDataServerSocketController(link);
+  move->SetMoveModeToCollect();
+  move->SetOutputDataType(VTK_POLY_DATA);
+  move->SetDeltaDeliveryKey(key);
+  if (rank == 0)
+  {
+    move->SetServerToDataServer();
+    move->SetInputData(data);
+  }
+  else
+  {
+    move->SetServerToClient();
+  }
+  move->Update();
+  return rank == 0 ||
+    ComparePolyData(vtkPolyData::SafeDownCast(move->GetOutputDataObject(0)), data);
+}
+
+struct CacheStatistics
+{
+  vtkTypeUInt64 Hits = 0;
+  vtkTypeUInt64 Misses = 0;
+  vtkTypeUInt64 BytesSaved = 0;
+  vtkTypeUInt64 UsedBytes = 0;
+};
+
+CacheStatistics GetCacheStatistics()
+{
+  CacheStatistics statistics;
+  vtkMPIMoveData::GetDeliveryCacheStatistics(
+    statistics.Hits, statistics.Misses, statistics.BytesSaved, statistics.UsedBytes);
+  return statistics;
+}
+
+bool TestDeltaDelivery(vtkMultiProcessController* link, int rank)
+{
+  // only the sender decides to send deltas.
+  vtkMPIMoveData::SetUseDeltaDelivery(rank == 0);
+  const vtkTypeUInt64 key = 42;
+
+  auto first = BuildStrip(100, 0);
+  vtkTypeUInt64 saved = vtkMPIMoveData::GetDeltaDeliveryBytesSaved();
+  VERIFY(Deliver(link, rank, first, key), "first delivery.");
+  VERIFY(vtkMPIMoveData::GetDeltaDeliveryBytesSaved() == saved, "the first delivery is full.");
+
+  // unchanged data, everything is reused by the client.
+  VERIFY(Deliver(link, rank, BuildStrip(100, 0), key), "unchanged delivery.");
+  if (rank == 0)
+  {
+    VERIFY(vtkMPIMoveData::GetDeltaDeliveryBytesSaved() > saved, "unchanged data was sent.");
+  }
+  saved = vtkMPIMoveData::GetDeltaDeliveryBytesSaved();
+
+  // changed point values, only these are sent.
+  VERIFY(Deliver(link, rank, BuildStrip(100, 1000), key), "changed delivery.");
+  if (rank == 0)
+  {
+    VERIFY(vtkMPIMoveData::GetDeltaDeliveryBytesSaved() > saved, "unchanged arrays were sent.");
+  }
+  saved = vtkMPIMoveData::GetDeltaDeliveryBytesSaved();
+
+  // resized data, the topology changed so it is sent in full.
+  VERIFY(Deliver(link, rank, BuildStrip(150, 1000), key), "resized delivery.");
+  VERIFY(vtkMPIMoveData::GetDeltaDeliveryBytesSaved() == saved, "resized data was not sent.");
+
+  // the resized data becomes the base of the next deltas.
+  VERIFY(Deliver(link, rank, BuildStrip(150, 2000), key), "changed resized delivery.");
+  if (rank == 0)
+  {
+    VERIFY(vtkMPIMoveData::GetDeltaDeliveryBytesSaved() > saved, "no delta after resizing.");
+  }
+  saved = vtkMPIMoveData::GetDeltaDeliveryBytesSaved();
+
+  // once released, the next delivery is full again.
+  vtkMPIMoveData::ReleaseDeltaDeliveryState(key);
+  VERIFY(Deliver(link, rank, BuildStrip(150, 2000), key), "delivery after release.");
+  VERIFY(vtkMPIMoveData::GetDeltaDeliveryBytesSaved() == saved, "delta against released state.");
+
+  vtkMPIMoveData::ReleaseDeltaDeliveryState(key);
+  vtkMPIMoveData::SetUseDeltaDelivery(false);
+  return true;
+}
+
+bool TestDeliveryCache(vtkMultiProcessController* link, int rank)
+{
+  vtkMPIMoveData::SetDeliveryCacheSize(64 * 1024 * 1024);
+
+  auto first = BuildStrip(100, 0);
+  auto second = BuildStrip(100, 1000);
+  CacheStatistics before = GetCacheStatistics();
+  VERIFY(Deliver(link, rank, first, 0), "first delivery.");
+  VERIFY(Deliver(link, rank, second, 0), "second delivery.");
+  CacheStatistics after = GetCacheStatistics();
+  VERIFY(after.Misses == before.Misses + 2 && after.Hits == before.Hits, "expected 2 misses.");
+  VERIFY(after.UsedBytes > before.UsedBytes, "nothing cached.");
+
+  // same contents as the first delivery, in a different data object.
+  before = after;
+  VERIFY(Deliver(link, rank, BuildStrip(100, 0), 0), "cached delivery.");
+  after = GetCacheStatistics();
+  VERIFY(after.Hits == before.Hits + 1 && after.Misses == before.Misses, "expected a hit.");
+  if (rank == 0)
+  {
+    VERIFY(after.BytesSaved > before.BytesSaved, "no bytes saved on a hit.");
+  }
+
+  // changed and resized data are not in the cache.
+  before = after;
+  VERIFY(Deliver(link, rank, BuildStrip(100, 2000), 0), "changed delivery.");
+  VERIFY(Deliver(link, rank, BuildStrip(150, 0), 0), "resized delivery.");
+  after = GetCacheStatistics();
+  VERIFY(after.Misses == before.Misses + 2 && after.Hits == before.Hits, "expected 2 misses.");
+
+  // nothing fits in a tiny budget.
+  vtkMPIMoveData::SetDeliveryCacheSize(1);
+  before = after;
+  VERIFY(Deliver(link, rank, first, 0), "delivery with a tiny budget.");
+  VERIFY(Deliver(link, rank, first, 0), "delivery with a tiny budget.");
+  after = GetCacheStatistics();
+  VERIFY(after.Misses == before.Misses + 2 && after.Hits == before.Hits, "expected 2 misses.");
+  VERIFY(after.UsedBytes == 0, "the cache exceeds its budget.");
+
+  vtkMPIMoveData::SetDeliveryCacheSize(0);
+  return true;
+}
+
+bool TestCompression(vtkMultiProcessController* link, int rank)
+{
+  // the client never compresses, it detects compressed data on its own.
+  auto compressible = BuildStrip(20000, 0);
+  auto noisy = BuildNoisyStrip(5000);
+  for (int mode : { vtkMPIMoveData::COMPRESSION_LZ4, vtkMPIMoveData::COMPRESSION_ZLIB })
+  {
+    vtkMPIMoveData::SetCompressionMode(rank == 0 ? mode : vtkMPIMoveData::COMPRESSION_NONE);
+    VERIFY(Deliver(link, rank, compressible, 0), "compressed delivery.");
+    if (rank == 0)
+    {
+      VERIFY(vtkMPIMoveData::GetLastCompressionMode() == mode, "data was not compressed.");
+    }
+    // compression does not help, the data is sent compressed anyway.
+    VERIFY(Deliver(link, rank, noisy, 0), "incompressible delivery.");
+    if (rank == 0)
+    {
+      VERIFY(vtkMPIMoveData::GetLastCompressionMode() == mode, "data was not compressed.");
+    }
+  }
+
+  vtkMPIMoveData::SetCompressionMode(
+    rank == 0 ? vtkMPIMoveData::COMPRESSION_ADAPTIVE : vtkMPIMoveData::COMPRESSION_NONE);
+  VERIFY(Deliver(link, rank, BuildStrip(10, 0), 0), "small adaptive delivery.");
+  if (rank == 0)
+  {
+    VERIFY(vtkMPIMoveData::GetLastCompressionMode() == vtkMPIMoveData::COMPRESSION_NONE,
+      "small data should not be compressed.");
+  }
+  for (int cc = 0; cc < 3; ++cc)
+  {
+    VERIFY(Deliver(link, rank, compressible, 0), "adaptive delivery.");
+    VERIFY(Deliver(link, rank, noisy, 0), "incompressible adaptive delivery.");
+  }
+  if (rank == 0)
+  {
+    VERIFY(vtkMPIMoveData::GetEstimatedLinkBandwidth() > 0, "invalid link bandwidth.");
+  }
+
+  vtkMPIMoveData::SetCompressionMode(vtkMPIMoveData::COMPRESSION_NONE);
+  return true;
+}
+}
+
+int TestMPIMoveDataDelivery(int argc, char* argv[])
+{
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  const int rank = controller->GetLocalProcessId();
+  if (controller->GetNumberOfProcesses() != 2)
+  {
+    vtkLogF(ERROR, "this test requires 2 ranks.");
+    vtkMultiProcessController::SetGlobalController(nullptr);
+    controller->Finalize();
+    return EXIT_FAILURE;
+  }
+
+  // connect the data server (rank 0) and the client (rank 1).
+  vtkNew<vtkSocketCommunicator> communicator;
+  int connected = 0;
+  if (rank == 0)
+  {
+    vtkNew<vtkServerSocket> server;
+    int port = server->CreateServer(0) == 0 ? server->GetServerPort() : -1;
+    controller->Send(&port, 1, 1, 1001);
+    connected = port > 0 && communicator->WaitForConnection(server, 60000) != 0;
+  }
+  else
+  {
+    int port = -1;
+    controller->Receive(&port, 1, 0, 1001);
+    connected = port > 0 && communicator->ConnectTo("localhost", port) != 0;
+  }
+  vtkNew<vtkSocketController> link;
+  link->SetCommunicator(communicator);
+
+  int success = connected;
+  int allConnected = 0;
+  controller->AllReduce(&connected, &allConnected, 1, vtkCommunicator::LOGICAL_AND_OP);
+  if (allConnected)
+  {
+    success = TestDeltaDelivery(link, rank) && TestDeliveryCache(link, rank) &&
+      TestCompression(link, rank);
+    communicator->CloseConnection();
+  }
+  else
+  {
+    vtkLogF(ERROR, "failed to connect the ranks.");
+  }
+
+  int allSuccess = 0;
+  controller->AllReduce(&success, &allSuccess, 1, vtkCommunicator::LOGICAL_AND_OP);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  controller->Finalize();
+  return allSuccess ? EXIT_SUCCESS : EXIT_FAILURE;
+}
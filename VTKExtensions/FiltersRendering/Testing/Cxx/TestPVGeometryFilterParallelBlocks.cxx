@@ -0,0 +1,231 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPVGeometryFilterParallelBlocks.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkLogger.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPVGeometryFilter.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+#define VERIFY(x, y)                                                                               \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    vtkLogF(ERROR, y);                                                                             \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+// Builds a 2x2x2 grid of hexahedra shifted by `offset`, with a point and a
+// cell array. If `points` is not null, the grid uses it instead of new points.
+vtkSmartPointer<vtkUnstructuredGrid> BuildGrid(double offset, vtkPoints* points = nullptr)
+{
+  auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  if (points == nullptr)
+  {
+    vtkNew<vtkPoints> newPoints;
+    for (int k = 0; k < 3; ++k)
+    {
+      for (int j = 0; j < 3; ++j)
+      {
+        for (int i = 0; i < 3; ++i)
+        {
+          newPoints->InsertNextPoint(i + offset, j, k);
+        }
+      }
+    }
+    grid->SetPoints(newPoints);
+  }
+  else
+  {
+    grid->SetPoints(points);
+  }
+
+  auto id = [](int i, int j, int k) { return static_cast<vtkIdType>(i + 3 * (j + 3 * k)); };
+  for (int k = 0; k < 2; ++k)
+  {
+    for (int j = 0; j < 2; ++j)
+    {
+      for (int i = 0; i < 2; ++i)
+      {
+        vtkIdType hex[8] = { id(i, j, k), id(i + 1, j, k), id(i + 1, j + 1, k), id(i, j + 1, k),
+          id(i, j, k + 1), id(i + 1, j, k + 1), id(i + 1, j + 1, k + 1), id(i, j + 1, k + 1) };
+        grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+      }
+    }
+  }
+
+  vtkNew<vtkDoubleArray> pointValues;
+  pointValues->SetName("PointValues");
+  pointValues->SetNumberOfTuples(grid->GetNumberOfPoints());
+  for (vtkIdType cc = 0; cc < grid->GetNumberOfPoints(); ++cc)
+  {
+    pointValues->SetValue(cc, offset * 100 + cc);
+  }
+  grid->GetPointData()->SetScalars(pointValues);
+
+  vtkNew<vtkDoubleArray> cellValues;
+  cellValues->SetName("CellValues");
+  cellValues->SetNumberOfTuples(grid->GetNumberOfCells());
+  for (vtkIdType cc = 0; cc < grid->GetNumberOfCells(); ++cc)
+  {
+    cellValues->SetValue(cc, offset * 1000 + cc);
+  }
+  grid->GetCellData()->AddArray(cellValues);
+  return grid;
+}
+
+// An image data block.
+vtkSmartPointer<vtkImageData> BuildImage()
+{
+  auto image = vtkSmartPointer<vtkImageData>::New();
+  image->SetDimensions(4, 4, 4);
+  image->SetOrigin(0, 0, -10);
+  return image;
+}
+
+bool CompareArrays(vtkDataArray* a, vtkDataArray* b)
+{
+  VERIFY(a && b, "missing array.");
+  VERIFY(a->GetNumberOfTuples() == b->GetNumberOfTuples() &&
+      a->GetNumberOfComponents() == b->GetNumberOfComponents(),
+    "array sizes differ.");
+  for (vtkIdType cc = 0; cc < a->GetNumberOfValues(); ++cc)
+  {
+    VERIFY(a->GetComponent(cc / a->GetNumberOfComponents(), cc % a->GetNumberOfComponents()) ==
+        b->GetComponent(cc / b->GetNumberOfComponents(), cc % b->GetNumberOfComponents()),
+      "array values differ.");
+  }
+  return true;
+}
+
+bool CompareAttributes(vtkDataSetAttributes* a, vtkDataSetAttributes* b)
+{
+  VERIFY(a->GetNumberOfArrays() == b->GetNumberOfArrays(), "number of arrays differ.");
+  for (int cc = 0; cc < a->GetNumberOfArrays(); ++cc)
+  {
+    vtkDataArray* array = a->GetArray(cc);
+    VERIFY(array && array->GetName(), "unnamed output array.");
+    VERIFY(CompareArrays(array, b->GetArray(array->GetName())), "attribute arrays differ.");
+  }
+  return true;
+}
+
+bool ComparePolyData(vtkPolyData* a, vtkPolyData* b)
+{
+  VERIFY(a && b, "missing output block.");
+  VERIFY(a->GetNumberOfPoints() == b->GetNumberOfPoints(), "number of points differ.");
+  VERIFY(a->GetNumberOfVerts() == b->GetNumberOfVerts() &&
+      a->GetNumberOfLines() == b->GetNumberOfLines() &&
+      a->GetNumberOfPolys() == b->GetNumberOfPolys() &&
+      a->GetNumberOfStrips() == b->GetNumberOfStrips(),
+    "number of cells differ.");
+  if (a->GetNumberOfPoints() > 0)
+  {
+    VERIFY(CompareArrays(a->GetPoints()->GetData(), b->GetPoints()->GetData()), "points differ.");
+  }
+  VERIFY(CompareArrays(a->GetPolys()->GetConnectivityArray(),
+           b->GetPolys()->GetConnectivityArray()),
+    "polygons differ.");
+  VERIFY(CompareArrays(a->GetLines()->GetConnectivityArray(),
+           b->GetLines()->GetConnectivityArray()),
+    "lines differ.");
+  VERIFY(CompareAttributes(a->GetPointData(), b->GetPointData()), "point data differ.");
+  VERIFY(CompareAttributes(a->GetCellData(), b->GetCellData()), "cell data differ.");
+  return true;
+}
+
+// Runs the filter on `input` serially and concurrently and checks that both
+// outputs and outline flags are identical.
+bool CompareSerialAndParallel(vtkMultiBlockDataSet* input, int useOutline)
+{
+  vtkNew<vtkPVGeometryFilter> serial;
+  serial->SetUseOutline(useOutline);
+  serial->SetExecuteBlocksInParallel(false);
+  serial->SetInputData(input);
+  serial->Update();
+
+  vtkNew<vtkPVGeometryFilter> parallel;
+  parallel->SetUseOutline(useOutline);
+  parallel->SetExecuteBlocksInParallel(true);
+  parallel->SetInputData(input);
+  parallel->Update();
+
+  VERIFY(serial->GetOutlineFlag() == useOutline, "serial: incorrect outline flag.");
+  VERIFY(parallel->GetOutlineFlag() == useOutline, "parallel: incorrect outline flag.");
+
+  auto serialOutput = vtkMultiBlockDataSet::SafeDownCast(serial->GetOutputDataObject(0));
+  auto parallelOutput = vtkMultiBlockDataSet::SafeDownCast(parallel->GetOutputDataObject(0));
+  VERIFY(serialOutput && parallelOutput, "expected multiblock outputs.");
+
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(serialOutput->NewIterator());
+  int numberOfBlocks = 0;
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    auto a = vtkPolyData::SafeDownCast(iter->GetCurrentDataObject());
+    auto b = vtkPolyData::SafeDownCast(parallelOutput->GetDataSet(iter));
+    VERIFY(ComparePolyData(a, b), "serial and parallel outputs differ.");
+    ++numberOfBlocks;
+  }
+  VERIFY(numberOfBlocks == static_cast<int>(input->GetNumberOfBlocks()),
+    "unexpected number of output blocks.");
+  return true;
+}
+
+bool TestParallelBlocks()
+{
+  vtkNew<vtkMultiBlockDataSet> input;
+  input->SetBlock(0, BuildImage());
+  for (unsigned int cc = 1; cc < 32; ++cc)
+  {
+    input->SetBlock(cc, BuildGrid(3.0 * cc));
+  }
+  VERIFY(CompareSerialAndParallel(input, 0), "independent blocks.");
+  VERIFY(CompareSerialAndParallel(input, 1), "independent blocks, outlines.");
+
+  // blocks sharing points or arrays are processed serially, with the same
+  // result.
+  vtkNew<vtkMultiBlockDataSet> shared;
+  shared->SetBlock(0, BuildImage());
+  auto first = BuildGrid(0);
+  for (unsigned int cc = 1; cc < 32; ++cc)
+  {
+    auto grid = BuildGrid(3.0 * cc, cc % 2 ? first->GetPoints() : nullptr);
+    if (cc % 3 == 0)
+    {
+      grid->GetCellData()->AddArray(first->GetCellData()->GetArray("CellValues"));
+    }
+    shared->SetBlock(cc, grid);
+  }
+  VERIFY(CompareSerialAndParallel(shared, 0), "blocks sharing data.");
+  return true;
+}
+}
+
+int TestPVGeometryFilterParallelBlocks(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  return TestParallelBlocks() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,180 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPVGeometryFilterStaticMesh.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPVGeometryFilter.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+#define VERIFY(x, y)                                                                               \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    vtkLogF(ERROR, y);                                                                             \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+// Builds a 2x2x2 grid of hexahedra with a point and a cell array.
+void BuildGrid(vtkUnstructuredGrid* grid)
+{
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k < 3; ++k)
+  {
+    for (int j = 0; j < 3; ++j)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        points->InsertNextPoint(i, j, k);
+      }
+    }
+  }
+  grid->SetPoints(points);
+
+  auto id = [](int i, int j, int k) { return static_cast<vtkIdType>(i + 3 * (j + 3 * k)); };
+  for (int k = 0; k < 2; ++k)
+  {
+    for (int j = 0; j < 2; ++j)
+    {
+      for (int i = 0; i < 2; ++i)
+      {
+        vtkIdType hex[8] = { id(i, j, k), id(i + 1, j, k), id(i + 1, j + 1, k), id(i, j + 1, k),
+          id(i, j, k + 1), id(i + 1, j, k + 1), id(i + 1, j + 1, k + 1), id(i, j + 1, k + 1) };
+        grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+      }
+    }
+  }
+
+  vtkNew<vtkDoubleArray> pointValues;
+  pointValues->SetName("PointValues");
+  pointValues->SetNumberOfTuples(grid->GetNumberOfPoints());
+  pointValues->Fill(0.0);
+  grid->GetPointData()->SetScalars(pointValues);
+
+  vtkNew<vtkDoubleArray> cellValues;
+  cellValues->SetName("CellValues");
+  cellValues->SetNumberOfTuples(grid->GetNumberOfCells());
+  cellValues->Fill(0.0);
+  grid->GetCellData()->AddArray(cellValues);
+}
+
+// Sets the values of the input arrays as a function of `time`.
+void SetTime(vtkUnstructuredGrid* grid, double time)
+{
+  auto pointValues = vtkDoubleArray::SafeDownCast(grid->GetPointData()->GetArray("PointValues"));
+  for (vtkIdType cc = 0; cc < pointValues->GetNumberOfTuples(); ++cc)
+  {
+    pointValues->SetValue(cc, time * 100 + cc);
+  }
+  pointValues->Modified();
+
+  auto cellValues = vtkDoubleArray::SafeDownCast(grid->GetCellData()->GetArray("CellValues"));
+  for (vtkIdType cc = 0; cc < cellValues->GetNumberOfTuples(); ++cc)
+  {
+    cellValues->SetValue(cc, time * 1000 + cc);
+  }
+  cellValues->Modified();
+}
+
+// Checks that the output arrays match the input through the original ids.
+bool CheckValues(vtkUnstructuredGrid* grid, vtkPolyData* surface)
+{
+  auto pointIds =
+    vtkIdTypeArray::SafeDownCast(surface->GetPointData()->GetArray("vtkOriginalPointIds"));
+  auto cellIds =
+    vtkIdTypeArray::SafeDownCast(surface->GetCellData()->GetArray("vtkOriginalCellIds"));
+  auto pointValues =
+    vtkDoubleArray::SafeDownCast(surface->GetPointData()->GetArray("PointValues"));
+  auto cellValues = vtkDoubleArray::SafeDownCast(surface->GetCellData()->GetArray("CellValues"));
+  VERIFY(pointIds && cellIds && pointValues && cellValues, "missing output arrays.");
+  VERIFY(surface->GetPointData()->GetScalars() == pointValues, "active scalars not preserved.");
+
+  auto inPointValues = grid->GetPointData()->GetArray("PointValues");
+  for (vtkIdType cc = 0; cc < surface->GetNumberOfPoints(); ++cc)
+  {
+    VERIFY(pointValues->GetValue(cc) == inPointValues->GetTuple1(pointIds->GetValue(cc)),
+      "incorrect point values.");
+  }
+  auto inCellValues = grid->GetCellData()->GetArray("CellValues");
+  for (vtkIdType cc = 0; cc < surface->GetNumberOfCells(); ++cc)
+  {
+    VERIFY(cellValues->GetValue(cc) == inCellValues->GetTuple1(cellIds->GetValue(cc)),
+      "incorrect cell values.");
+  }
+  return true;
+}
+
+bool TestStaticMesh()
+{
+  vtkNew<vtkUnstructuredGrid> grid;
+  BuildGrid(grid);
+  SetTime(grid, 0);
+
+  vtkNew<vtkPVGeometryFilter> filter;
+  filter->SetUseOutline(0);
+  filter->SetInputData(grid);
+  filter->Update();
+
+  auto surface = vtkPolyData::SafeDownCast(filter->GetOutputDataObject(0));
+  VERIFY(surface->GetNumberOfCells() == 24, "expected 24 external faces.");
+  VERIFY(CheckValues(grid, surface), "time 0: incorrect values.");
+  vtkSmartPointer<vtkPoints> surfacePoints = surface->GetPoints();
+
+  // only the fields change: the cached surface must be reused.
+  SetTime(grid, 1);
+  filter->Update();
+  surface = vtkPolyData::SafeDownCast(filter->GetOutputDataObject(0));
+  VERIFY(surface->GetPoints() == surfacePoints, "cached surface was not reused.");
+  VERIFY(surface->GetNumberOfCells() == 24, "time 1: expected 24 external faces.");
+  VERIFY(CheckValues(grid, surface), "time 1: incorrect values.");
+
+  // moving points must invalidate the cache.
+  grid->GetPoints()->SetPoint(0, -1, -1, -1);
+  grid->GetPoints()->Modified();
+  filter->Update();
+  surface = vtkPolyData::SafeDownCast(filter->GetOutputDataObject(0));
+  VERIFY(surface->GetPoints() != surfacePoints, "cached surface reused for a modified mesh.");
+  VERIFY(CheckValues(grid, surface), "modified mesh: incorrect values.");
+
+  // results must match those obtained without the cache.
+  SetTime(grid, 2);
+  filter->Update();
+  vtkNew<vtkPolyData> cached;
+  cached->DeepCopy(filter->GetOutputDataObject(0));
+
+  filter->CacheStaticMeshSurfaceOff();
+  filter->Update();
+  surface = vtkPolyData::SafeDownCast(filter->GetOutputDataObject(0));
+  VERIFY(surface->GetNumberOfPoints() == cached->GetNumberOfPoints() &&
+      surface->GetNumberOfCells() == cached->GetNumberOfCells() &&
+      surface->GetPointData()->GetNumberOfArrays() ==
+        cached->GetPointData()->GetNumberOfArrays() &&
+      surface->GetCellData()->GetNumberOfArrays() == cached->GetCellData()->GetNumberOfArrays(),
+    "cached and uncached results differ.");
+  return true;
+}
+}
+
+int TestPVGeometryFilterStaticMesh(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  return TestStaticMesh() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
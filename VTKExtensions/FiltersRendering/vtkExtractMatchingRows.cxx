@@ -0,0 +1,208 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkExtractMatchingRows.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkExtractMatchingRows.h"
+
+#include "vtkArrayCalculator.h"
+#include "vtkDataArray.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkFieldData.h"
+#include "vtkIdList.h"
+#include "vtkInformation.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPartitionedDataSet.h"
+#include "vtkTable.h"
+
+#include <sstream>
+#include <string>
+
+namespace
+{
+constexpr const char* RESULT_ARRAY_NAME = "__vtkRowMatches__";
+
+void AddVariable(vtkArrayCalculator* calc, const std::string& name, const char* arrayName,
+  int component, bool vector)
+{
+  const std::string validName = vtkArrayCalculator::CheckValidVariableName(name.c_str());
+  const std::string quotedName = "\"" + name + "\"";
+  for (const auto& varName : { validName, quotedName })
+  {
+    if (vector)
+    {
+      calc->AddVectorVariable(varName.c_str(), arrayName);
+    }
+    else
+    {
+      calc->AddScalarVariable(varName.c_str(), arrayName, component);
+    }
+    if (validName == quotedName)
+    {
+      break;
+    }
+  }
+}
+
+void AddVariables(vtkArrayCalculator* calc, vtkTable* table)
+{
+  for (vtkIdType cc = 0, max = table->GetNumberOfColumns(); cc < max; ++cc)
+  {
+    auto array = vtkDataArray::SafeDownCast(table->GetColumn(cc));
+    if (!array || !array->GetName())
+    {
+      continue;
+    }
+
+    const char* arrayName = array->GetName();
+    const int numComps = array->GetNumberOfComponents();
+    if (numComps == 1)
+    {
+      ::AddVariable(calc, arrayName, arrayName, 0, false);
+      continue;
+    }
+
+    for (int comp = 0; comp < numComps; ++comp)
+    {
+      std::ostringstream name;
+      name << arrayName << "_" << comp;
+      ::AddVariable(calc, name.str(), arrayName, comp, false);
+    }
+    if (numComps == 3)
+    {
+      ::AddVariable(calc, arrayName, arrayName, 0, true);
+    }
+  }
+}
+}
+
+vtkStandardNewMacro(vtkExtractMatchingRows);
+//----------------------------------------------------------------------------
+vtkExtractMatchingRows::vtkExtractMatchingRows()
+  : Expression(nullptr)
+{
+}
+
+//----------------------------------------------------------------------------
+vtkExtractMatchingRows::~vtkExtractMatchingRows()
+{
+  this->SetExpression(nullptr);
+}
+
+//----------------------------------------------------------------------------
+int vtkExtractMatchingRows::FillInputPortInformation(int, vtkInformation* info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkPartitionedDataSet");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkExtractMatchingRows::FillOutputPortInformation(int, vtkInformation* info)
+{
+  info->Set(vtkDataObject::DATA_TYPE_NAME(), "vtkPartitionedDataSet");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkExtractMatchingRows::RequestData(
+  vtkInformation*, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  auto input = vtkPartitionedDataSet::GetData(inputVector[0], 0);
+  auto output = vtkPartitionedDataSet::GetData(outputVector, 0);
+
+  if (this->Expression == nullptr || this->Expression[0] == '\0')
+  {
+    output->CompositeShallowCopy(input);
+    return 1;
+  }
+
+  output->CopyStructure(input);
+  for (unsigned int cc = 0, max = input->GetNumberOfPartitions(); cc < max; ++cc)
+  {
+    auto inputTable = vtkTable::SafeDownCast(input->GetPartitionAsDataObject(cc));
+    if (!inputTable)
+    {
+      continue;
+    }
+
+    vtkTable* result = this->ExtractRows(inputTable);
+    if (result == nullptr)
+    {
+      // the expression is invalid (the error has been reported); pass no rows
+      // but keep the columns so that the spreadsheet still shows them.
+      result = vtkTable::New();
+      result->GetFieldData()->ShallowCopy(inputTable->GetFieldData());
+      result->GetRowData()->CopyAllocate(inputTable->GetRowData(), 0);
+    }
+    output->SetPartition(cc, result);
+    result->FastDelete();
+  }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+vtkTable* vtkExtractMatchingRows::ExtractRows(vtkTable* input)
+{
+  vtkNew<vtkTable> clone;
+  clone->ShallowCopy(input);
+
+  vtkNew<vtkArrayCalculator> calc;
+  calc->SetAttributeTypeToRowData();
+  calc->SetResultArrayName(RESULT_ARRAY_NAME);
+  calc->SetFunction(this->Expression);
+  calc->ReplaceInvalidValuesOn();
+  calc->SetReplacementValue(0.0);
+  ::AddVariables(calc, clone);
+  calc->SetInputDataObject(clone);
+  calc->Update();
+
+  auto calcOutput = vtkTable::SafeDownCast(calc->GetOutputDataObject(0));
+  auto matches = calcOutput
+    ? vtkDataArray::SafeDownCast(calcOutput->GetColumnByName(RESULT_ARRAY_NAME))
+    : nullptr;
+  if (matches == nullptr || matches->GetNumberOfTuples() != input->GetNumberOfRows())
+  {
+    vtkErrorMacro("Failed to evaluate expression '" << this->Expression << "'.");
+    return nullptr;
+  }
+
+  const vtkIdType numRows = input->GetNumberOfRows();
+  vtkNew<vtkIdList> srcIds;
+  srcIds->Allocate(numRows);
+  for (vtkIdType row = 0; row < numRows; ++row)
+  {
+    if (matches->GetComponent(row, 0) != 0.0)
+    {
+      srcIds->InsertNextId(row);
+    }
+  }
+
+  auto table = vtkTable::New();
+  table->GetFieldData()->ShallowCopy(input->GetFieldData());
+  vtkDataSetAttributes* inRD = input->GetRowData();
+  vtkDataSetAttributes* outRD = table->GetRowData();
+  const vtkIdType numMatches = srcIds->GetNumberOfIds();
+  outRD->CopyAllocate(inRD, numMatches);
+  for (vtkIdType idx = 0; idx < numMatches; ++idx)
+  {
+    outRD->CopyData(inRD, srcIds->GetId(idx), idx);
+  }
+  return table;
+}
+
+//----------------------------------------------------------------------------
+void vtkExtractMatchingRows::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Expression: " << (this->Expression ? this->Expression : "(none)") << endl;
+}
@@ -0,0 +1,79 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkExtractMatchingRows.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class vtkExtractMatchingRows
+ * @brief extract rows matching an expression.
+ *
+ * vtkExtractMatchingRows is an internal filter used by vtkSpreadSheetView. It
+ * takes a `vtkPartitionedDataSet` of `vtkTable`s, as generated by
+ * vtkDataTabulator or vtkMarkSelectedRows, and only passes the rows for which
+ * `Expression` evaluates to a non-zero value. The expression is evaluated
+ * using vtkArrayCalculator and may refer to any numeric column by name. For
+ * multi-component columns, `<name>_<component>` refers to a single component
+ * and, for 3-component columns, `<name>` to the vector.
+ *
+ * When `Expression` is empty, the input is passed through unchanged. If the
+ * expression cannot be evaluated, an error is reported and no rows are passed;
+ * the output tables keep the columns of the input.
+ *
+ * @sa vtkMarkSelectedRows, vtkSortedTableStreamer
+ */
+
+#ifndef vtkExtractMatchingRows_h
+#define vtkExtractMatchingRows_h
+
+#include "vtkDataObjectAlgorithm.h"
+#include "vtkPVVTKExtensionsFiltersRenderingModule.h" // needed for export macro
+
+class vtkTable;
+
+class VTKPVVTKEXTENSIONSFILTERSRENDERING_EXPORT vtkExtractMatchingRows
+  : public vtkDataObjectAlgorithm
+{
+public:
+  static vtkExtractMatchingRows* New();
+  vtkTypeMacro(vtkExtractMatchingRows, vtkDataObjectAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Get/Set the expression rows must satisfy to be passed to the output.
+   */
+  vtkSetStringMacro(Expression);
+  vtkGetStringMacro(Expression);
+  ///@}
+
+protected:
+  vtkExtractMatchingRows();
+  ~vtkExtractMatchingRows() override;
+
+  int FillInputPortInformation(int port, vtkInformation* info) override;
+  int FillOutputPortInformation(int port, vtkInformation* info) override;
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
+  /**
+   * Returns a new table with the rows of `input` matching the expression or
+   * nullptr if the expression could not be evaluated.
+   */
+  vtkTable* ExtractRows(vtkTable* input);
+
+  char* Expression;
+
+private:
+  vtkExtractMatchingRows(const vtkExtractMatchingRows&) = delete;
+  void operator=(const vtkExtractMatchingRows&) = delete;
+};
+
+#endif
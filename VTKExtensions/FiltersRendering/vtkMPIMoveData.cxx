@@ -15,9 +15,11 @@
 #include "vtkMPIMoveData.h"
 
 #include "vtkAllToNRedistributeCompositePolyData.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCharArray.h"
 #include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
 #include "vtkDataObjectTypes.h"
 #include "vtkGenericDataObjectReader.h"
 #include "vtkGenericDataObjectWriter.h"
@@ -28,28 +30,271 @@
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiProcessController.h"
 #include "vtkMultiProcessControllerHelper.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkOutlineFilter.h"
 #include "vtkPVLogger.h"
 #include "vtkPVSession.h"
 #include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
 #include "vtkProcessModule.h"
 #include "vtkSmartPointer.h"
 #include "vtkSocketCommunicator.h"
 #include "vtkSocketController.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkStringArray.h"
 #include "vtkTimerLog.h"
+#include "vtkUnstructuredGrid.h"
 
+#include "vtk_lz4.h"
 #include "vtk_zlib.h"
-#include <sstream>
-#include <vector>
 
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <list>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
 #include <vector>
 
-bool vtkMPIMoveData::UseZLibCompression = false;
+int vtkMPIMoveData::CompressionMode = vtkMPIMoveData::COMPRESSION_NONE;
+bool vtkMPIMoveData::UseDeltaDelivery = false;
+vtkTypeUInt64 vtkMPIMoveData::DeliveryCacheSize = 0;
 
 namespace
 {
+// Buffers smaller than this are latency bound; compressing them is not worth it
+// and timing them gives meaningless bandwidth estimates.
+constexpr vtkIdType vtkMPIMoveDataMinimumCompressionSize = 64 * 1024;
+
+// Number of adaptive selections after which a compressor that was not picked
+// is used once more, so that its estimates follow changes of the data and the
+// link instead of staying at the values measured when it was last used.
+constexpr int vtkMPIMoveDataEstimateRefreshPeriod = 20;
+
+// Running estimates used by COMPRESSION_ADAPTIVE. These describe the link and
+// the CPU rather than a particular pipeline, hence are shared by all instances.
+// Compressor estimates are seeded with conservative values so that the first
+// delivery already makes a sensible choice; they are refined on every use.
+struct vtkMPIMoveDataCompressionStatistics
+{
+  // bytes per second, assume a 1 Gbit/s link until measured.
+  double LinkBandwidth = 125e6;
+  // uncompressed bytes per second, indexed by compression mode.
+  double Throughput[3] = { 0.0, 500e6, 40e6 };
+  // compressed size / uncompressed size, indexed by compression mode.
+  double Ratio[3] = { 1.0, 0.6, 0.4 };
+  // adaptive selections since each compression mode was last picked.
+  int SelectionsSinceUsed[3] = { 0, 0, 0 };
+  int LastMode = vtkMPIMoveData::COMPRESSION_NONE;
+};
+
+vtkMPIMoveDataCompressionStatistics& GetCompressionStatistics()
+{
+  static vtkMPIMoveDataCompressionStatistics statistics;
+  return statistics;
+}
+
+void UpdateEstimate(double& estimate, double measurement)
+{
+  // exponential moving average, so a single outlier does not flip decisions.
+  estimate = 0.7 * estimate + 0.3 * measurement;
+}
+
+void UpdateLinkBandwidth(vtkIdType length, double seconds)
+{
+  if (length >= vtkMPIMoveDataMinimumCompressionSize && seconds > 0.0)
+  {
+    UpdateEstimate(GetCompressionStatistics().LinkBandwidth, length / seconds);
+  }
+}
+
+int SelectCompressionMode(int requestedMode, vtkIdType length, bool overSocket)
+{
+  if (requestedMode != vtkMPIMoveData::COMPRESSION_ADAPTIVE)
+  {
+    return requestedMode;
+  }
+  if (!overSocket || length < vtkMPIMoveDataMinimumCompressionSize)
+  {
+    return vtkMPIMoveData::COMPRESSION_NONE;
+  }
+
+  // Estimated time to deliver the buffer is the time to compress it plus the
+  // time to push the compressed bytes through the link.
+  auto& stats = GetCompressionStatistics();
+  int bestMode = vtkMPIMoveData::COMPRESSION_NONE;
+  double bestTime = length / stats.LinkBandwidth;
+  for (int mode : { vtkMPIMoveData::COMPRESSION_LZ4, vtkMPIMoveData::COMPRESSION_ZLIB })
+  {
+    const double time =
+      length / stats.Throughput[mode] + length * stats.Ratio[mode] / stats.LinkBandwidth;
+    if (time < bestTime)
+    {
+      bestTime = time;
+      bestMode = mode;
+    }
+  }
+
+  // Estimates are only refreshed when a compressor runs: try a compressor
+  // again once in a while so that it can be picked again if it became faster.
+  for (int mode : { vtkMPIMoveData::COMPRESSION_LZ4, vtkMPIMoveData::COMPRESSION_ZLIB })
+  {
+    if (mode != bestMode &&
+      stats.SelectionsSinceUsed[mode] >= vtkMPIMoveDataEstimateRefreshPeriod)
+    {
+      bestMode = mode;
+      break;
+    }
+  }
+  for (int& count : stats.SelectionsSinceUsed)
+  {
+    ++count;
+  }
+  stats.SelectionsSinceUsed[bestMode] = 0;
+  return bestMode;
+}
+
+// Compressed buffers start with an 8 byte header: 4 characters identifying the
+// compressor followed by the uncompressed length, little endian.
+void WriteCompressionHeader(char* buffer, const char* magic, vtkIdType length)
+{
+  memcpy(buffer, magic, 4);
+  int in_size = static_cast<int>(length);
+  for (int cc = 0; cc < 4; cc++)
+  {
+    buffer[4 + cc] = (in_size & 0x0ff);
+    in_size = in_size >> 8;
+  }
+}
+
+vtkIdType ReadCompressionHeader(const char* buffer)
+{
+  vtkIdType length = 0;
+  for (int cc = 0; cc < 4; cc++)
+  {
+    length = length | ((0xff & (buffer[4 + cc])) << 8 * cc);
+  }
+  return length;
+}
+
+// Returns a new[]-allocated buffer holding the header and compressed bytes, or
+// nullptr if the data cannot be compressed with the given mode.
+char* CompressBuffer(const char* input, vtkIdType length, int mode, vtkIdType& compressedLength)
+{
+  if (length > LZ4_MAX_INPUT_SIZE || length > INT_MAX)
+  {
+    return nullptr;
+  }
+
+  const double start = vtkTimerLog::GetUniversalTime();
+  char* buffer = nullptr;
+  if (mode == vtkMPIMoveData::COMPRESSION_LZ4)
+  {
+    vtkTimerLog::MarkStartEvent("LZ4 compress");
+    const int bound = LZ4_compressBound(static_cast<int>(length));
+    buffer = new char[bound + 8];
+    const int out_size =
+      LZ4_compress_default(input, buffer + 8, static_cast<int>(length), bound);
+    vtkTimerLog::MarkEndEvent("LZ4 compress");
+    if (out_size <= 0)
+    {
+      delete[] buffer;
+      return nullptr;
+    }
+    WriteCompressionHeader(buffer, "lz4r", length);
+    compressedLength = out_size + 8;
+  }
+  else if (mode == vtkMPIMoveData::COMPRESSION_ZLIB)
+  {
+    vtkTimerLog::MarkStartEvent("Zlib compress");
+    uLongf out_size = compressBound(length);
+    buffer = new char[out_size + 8];
+    const int status = compress2(reinterpret_cast<Bytef*>(buffer + 8), &out_size,
+      reinterpret_cast<const Bytef*>(input), length,
+      /* compression_level */ Z_DEFAULT_COMPRESSION);
+    vtkTimerLog::MarkEndEvent("Zlib compress");
+    if (status != Z_OK)
+    {
+      delete[] buffer;
+      return nullptr;
+    }
+    // "zlib" is the header used before other compressors were supported.
+    WriteCompressionHeader(buffer, "zlib", length);
+    compressedLength = out_size + 8;
+  }
+  else
+  {
+    return nullptr;
+  }
+
+  const double elapsed = vtkTimerLog::GetUniversalTime() - start;
+  auto& stats = GetCompressionStatistics();
+  if (length >= vtkMPIMoveDataMinimumCompressionSize && elapsed > 0.0)
+  {
+    UpdateEstimate(stats.Throughput[mode], length / elapsed);
+    UpdateEstimate(stats.Ratio[mode], static_cast<double>(compressedLength) / length);
+  }
+  return buffer;
+}
+
+// If `buffer` was compressed by CompressBuffer, sets `result` to a
+// new[]-allocated buffer with the decompressed data, otherwise sets it to
+// nullptr. Returns false if `buffer` is compressed but cannot be decompressed.
+bool DecompressBuffer(
+  const char* buffer, vtkIdType length, char*& result, vtkIdType& uncompressedLength)
+{
+  result = nullptr;
+  if (length <= 8)
+  {
+    return true;
+  }
+
+  const bool isZLib = strncmp(buffer, "zlib", 4) == 0;
+  const bool isLZ4 = strncmp(buffer, "lz4r", 4) == 0;
+  if (!isZLib && !isLZ4)
+  {
+    return true;
+  }
+
+  uncompressedLength = ReadCompressionHeader(buffer);
+  if (uncompressedLength <= 0)
+  {
+    return false;
+  }
+  result = new char[uncompressedLength];
+  bool success = false;
+  if (isZLib)
+  {
+    uLongf destLen = uncompressedLength;
+    vtkTimerLog::MarkStartEvent("Zlib uncompress");
+    const int status = uncompress(reinterpret_cast<Bytef*>(result), &destLen,
+      reinterpret_cast<const Bytef*>(buffer + 8), length - 8);
+    vtkTimerLog::MarkEndEvent("Zlib uncompress");
+    success = status == Z_OK && static_cast<vtkIdType>(destLen) == uncompressedLength;
+  }
+  else
+  {
+    vtkTimerLog::MarkStartEvent("LZ4 uncompress");
+    const int size = LZ4_decompress_safe(buffer + 8, result, static_cast<int>(length - 8),
+      static_cast<int>(uncompressedLength));
+    vtkTimerLog::MarkEndEvent("LZ4 uncompress");
+    success = size == uncompressedLength;
+  }
+
+  if (!success)
+  {
+    delete[] result;
+    result = nullptr;
+  }
+  return success;
+}
+
 bool vtkMPIMoveDataMerge(std::vector<vtkSmartPointer<vtkDataObject>>& pieces, vtkDataObject* result)
 {
   return vtkMultiProcessControllerHelper::MergePieces(pieces, result);
@@ -79,6 +324,347 @@ void unsetGlobalIdsAttribute(vtkDataObject* piece)
     it->Delete();
   }
 }
+
+//============================================================================
+// Delta delivery.
+//
+// When the cell topology of a delivery matches the previous delivery with the
+// same key, the sender transmits an empty data object of the same type whose
+// field data holds the changed arrays and a manifest. Manifest entries are
+// "<op><component>" where op is '=' (reuse from the previous delivery) or
+// '+' (sent in this payload), and component is "points", "p:<name>",
+// "c:<name>" or "f:<name>". Entries "a:p:<attribute>:<name>" and
+// "a:c:<attribute>:<name>" restore active attributes.
+const char* vtkMPIMoveDataDeltaManifestName = "__vtkMPIMoveData_DeltaManifest";
+
+struct vtkMPIMoveDataDeltaState
+{
+  // sender side: hashes of what was sent for this key.
+  int DataType = -1;
+  vtkTypeUInt64 TopologyHash = 0;
+  std::map<std::string, vtkTypeUInt64> ComponentHashes;
+
+  // receiver side: the last data object received for this key.
+  vtkSmartPointer<vtkDataObject> Received;
+};
+
+std::map<vtkTypeUInt64, vtkMPIMoveDataDeltaState>& GetDeltaStates()
+{
+  static std::map<vtkTypeUInt64, vtkMPIMoveDataDeltaState> states;
+  return states;
+}
+
+vtkTypeUInt64& GetDeltaBytesSaved()
+{
+  static vtkTypeUInt64 saved = 0;
+  return saved;
+}
+
+inline vtkTypeUInt64 HashMix(vtkTypeUInt64 hash, vtkTypeUInt64 value)
+{
+  value *= 0x87c37b91114253d5ULL;
+  value = (value << 31) | (value >> 33);
+  value *= 0x4cf5ad432745937fULL;
+  hash ^= value;
+  hash = (hash << 27) | (hash >> 37);
+  return hash * 5 + 0x52dce729;
+}
+
+vtkTypeUInt64 HashBytes(const char* bytes, size_t numBytes, vtkTypeUInt64 seed)
+{
+  if (numBytes == 0)
+  {
+    // Empty arrays may not have any memory, `bytes` can be null.
+    const vtkTypeUInt64 hash = HashMix(seed, 0);
+    return hash == 0 ? 1 : hash;
+  }
+
+  vtkTypeUInt64 hash = seed;
+  size_t cc = 0;
+  for (; cc + sizeof(vtkTypeUInt64) <= numBytes; cc += sizeof(vtkTypeUInt64))
+  {
+    vtkTypeUInt64 word;
+    memcpy(&word, bytes + cc, sizeof(word));
+    hash = HashMix(hash, word);
+  }
+  vtkTypeUInt64 tail = 0;
+  memcpy(&tail, bytes + cc, numBytes - cc);
+  hash = HashMix(hash, tail ^ numBytes);
+  return hash == 0 ? 1 : hash;
+}
+
+// Hash the contents of an array. Returns 0 when the array cannot be hashed
+// cheaply, which is treated as "always changed".
+vtkTypeUInt64 HashArray(vtkAbstractArray* array, vtkTypeUInt64 seed)
+{
+  auto da = vtkDataArray::SafeDownCast(array);
+  if (da == nullptr || !da->HasStandardMemoryLayout())
+  {
+    return 0;
+  }
+
+  vtkTypeUInt64 hash = HashMix(seed, static_cast<vtkTypeUInt64>(da->GetDataType()));
+  hash = HashMix(hash, static_cast<vtkTypeUInt64>(da->GetNumberOfComponents()));
+  hash = HashMix(hash, static_cast<vtkTypeUInt64>(da->GetNumberOfTuples()));
+
+  const size_t numBytes =
+    static_cast<size_t>(da->GetNumberOfValues()) * static_cast<size_t>(da->GetDataTypeSize());
+  return HashBytes(static_cast<const char*>(da->GetVoidPointer(0)), numBytes, hash);
+}
+
+vtkTypeUInt64 HashCellArray(vtkCellArray* cells, vtkTypeUInt64 seed)
+{
+  if (cells == nullptr)
+  {
+    return HashMix(seed, 0);
+  }
+  const vtkTypeUInt64 offsets = HashArray(cells->GetOffsetsArray(), seed);
+  const vtkTypeUInt64 connectivity = HashArray(cells->GetConnectivityArray(), offsets);
+  return (offsets == 0 || connectivity == 0) ? 0 : connectivity;
+}
+
+// Hash of the cell topology, 0 if it is not supported for delta delivery.
+vtkTypeUInt64 HashTopology(vtkDataObject* data)
+{
+  if (auto pd = vtkPolyData::SafeDownCast(data))
+  {
+    vtkTypeUInt64 hash = HashMix(0, VTK_POLY_DATA);
+    for (vtkCellArray* cells : { pd->GetVerts(), pd->GetLines(), pd->GetPolys(), pd->GetStrips() })
+    {
+      hash = HashCellArray(cells, hash);
+      if (hash == 0)
+      {
+        return 0;
+      }
+    }
+    return hash;
+  }
+  if (auto ug = vtkUnstructuredGrid::SafeDownCast(data))
+  {
+    if (ug->GetFaces() != nullptr)
+    {
+      // polyhedral cells are rare enough to always be sent in full.
+      return 0;
+    }
+    vtkTypeUInt64 hash = HashCellArray(ug->GetCells(), HashMix(0, VTK_UNSTRUCTURED_GRID));
+    return hash == 0 ? 0 : HashArray(ug->GetCellTypesArray(), hash);
+  }
+  return 0;
+}
+
+// Collect the delta-able components of `ds` with their hash. Returns false if
+// some array cannot be addressed by name.
+using vtkMPIMoveDataComponents = std::vector<std::pair<std::string, vtkAbstractArray*>>;
+bool CollectComponents(vtkPointSet* ds, vtkMPIMoveDataComponents& components)
+{
+  if (ds->GetPoints())
+  {
+    components.emplace_back("points", ds->GetPoints()->GetData());
+  }
+  std::set<std::string> names;
+  const std::pair<const char*, vtkFieldData*> fields[] = { { "p:", ds->GetPointData() },
+    { "c:", ds->GetCellData() }, { "f:", ds->GetFieldData() } };
+  for (const auto& field : fields)
+  {
+    for (int cc = 0, max = field.second->GetNumberOfArrays(); cc < max; ++cc)
+    {
+      vtkAbstractArray* array = field.second->GetAbstractArray(cc);
+      if (array == nullptr || array->GetName() == nullptr)
+      {
+        return false;
+      }
+      std::string name = std::string(field.first) + array->GetName();
+      if (!names.insert(name).second)
+      {
+        return false;
+      }
+      components.emplace_back(name, array);
+    }
+  }
+  return true;
+}
+
+// Hash of the arrays of a data object and of its active attributes.
+vtkTypeUInt64 HashFields(vtkDataObject* data, vtkTypeUInt64 hash)
+{
+  auto ds = vtkDataSet::SafeDownCast(data);
+  vtkFieldData* fields[] = { ds ? ds->GetPointData() : nullptr, ds ? ds->GetCellData() : nullptr,
+    data->GetFieldData() };
+  for (vtkFieldData* fd : fields)
+  {
+    if (fd == nullptr)
+    {
+      hash = HashMix(hash, 0);
+      continue;
+    }
+    hash = HashMix(hash, static_cast<vtkTypeUInt64>(fd->GetNumberOfArrays()));
+    for (int cc = 0, max = fd->GetNumberOfArrays(); cc < max; ++cc)
+    {
+      vtkAbstractArray* array = fd->GetAbstractArray(cc);
+      if (array == nullptr || array->GetName() == nullptr)
+      {
+        return 0;
+      }
+      hash = HashArray(array, HashBytes(array->GetName(), strlen(array->GetName()), hash));
+      if (hash == 0)
+      {
+        return 0;
+      }
+    }
+    if (auto dsa = vtkDataSetAttributes::SafeDownCast(fd))
+    {
+      int indices[vtkDataSetAttributes::NUM_ATTRIBUTES];
+      dsa->GetAttributeIndices(indices);
+      for (int index : indices)
+      {
+        hash = HashMix(hash, static_cast<vtkTypeUInt64>(index + 1));
+      }
+    }
+  }
+  return hash;
+}
+
+// Hash of the contents of a data object, computed from its arrays without
+// marshaling it. Returns 0 when it cannot be hashed cheaply.
+vtkTypeUInt64 HashDataObject(vtkDataObject* data)
+{
+  if (data == nullptr)
+  {
+    return 0;
+  }
+
+  vtkTypeUInt64 hash = HashMix(0, static_cast<vtkTypeUInt64>(data->GetDataObjectType()));
+  if (auto cd = vtkCompositeDataSet::SafeDownCast(data))
+  {
+    auto iter = vtk::TakeSmartPointer(cd->NewIterator());
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      const vtkTypeUInt64 leaf = HashDataObject(iter->GetCurrentDataObject());
+      if (leaf == 0)
+      {
+        return 0;
+      }
+      hash = HashMix(HashMix(hash, iter->GetCurrentFlatIndex()), leaf);
+    }
+    return HashFields(data, hash);
+  }
+  if (auto ps = vtkPointSet::SafeDownCast(data))
+  {
+    const vtkTypeUInt64 topology = HashTopology(data);
+    if (topology == 0)
+    {
+      return 0;
+    }
+    hash = HashMix(hash, topology);
+    if (ps->GetPoints())
+    {
+      hash = HashArray(ps->GetPoints()->GetData(), hash);
+      if (hash == 0)
+      {
+        return 0;
+      }
+    }
+    return HashFields(data, hash);
+  }
+  if (auto id = vtkImageData::SafeDownCast(data))
+  {
+    hash = HashBytes(reinterpret_cast<const char*>(id->GetExtent()), 6 * sizeof(int), hash);
+    hash = HashBytes(reinterpret_cast<const char*>(id->GetOrigin()), 3 * sizeof(double), hash);
+    hash = HashBytes(reinterpret_cast<const char*>(id->GetSpacing()), 3 * sizeof(double), hash);
+    return HashFields(data, hash);
+  }
+  return 0;
+}
+
+//============================================================================
+// Delivery cache.
+//
+// Keeps the data delivered to the client keyed by a hash of its contents so
+// that identical data delivered for another representation or view is not
+// sent again. The hash is computed from the arrays before marshaling, so hits
+// skip marshaling and compression altogether. The data server keeps the same LRU bookkeeping as
+// the client (without the data) and sends a reference instead of the data on
+// hits. Both sides apply the same sequence of operations with the budget
+// chosen by the sender, so their evictions always match.
+class vtkMPIMoveDataDeliveryCache
+{
+public:
+  bool Contains(vtkTypeUInt64 hash) const { return this->Entries.count(hash) != 0; }
+
+  vtkDataObject* Get(vtkTypeUInt64 hash) const
+  {
+    auto iter = this->Entries.find(hash);
+    return iter != this->Entries.end() ? iter->second.Data.GetPointer() : nullptr;
+  }
+
+  // Record a use of `hash`, inserting it if needed, then evict least recently
+  // used entries until the total size fits within `budget`.
+  void Use(vtkTypeUInt64 hash, vtkTypeUInt64 size, vtkTypeUInt64 budget, vtkDataObject* data)
+  {
+    auto iter = this->Entries.find(hash);
+    if (iter != this->Entries.end())
+    {
+      this->Order.erase(iter->second.Position);
+      this->Order.push_front(hash);
+      iter->second.Position = this->Order.begin();
+    }
+    else
+    {
+      this->Order.push_front(hash);
+      auto& entry = this->Entries[hash];
+      entry.Size = size;
+      entry.Position = this->Order.begin();
+      if (data)
+      {
+        entry.Data.TakeReference(data->NewInstance());
+        entry.Data->ShallowCopy(data);
+      }
+      this->TotalSize += size;
+    }
+
+    while (this->TotalSize > budget && !this->Order.empty())
+    {
+      auto evicted = this->Entries.find(this->Order.back());
+      this->TotalSize -= evicted->second.Size;
+      this->Entries.erase(evicted);
+      this->Order.pop_back();
+    }
+  }
+
+  vtkTypeUInt64 TotalSize = 0;
+  vtkTypeUInt64 Hits = 0;
+  vtkTypeUInt64 Misses = 0;
+  vtkTypeUInt64 BytesSaved = 0;
+
+private:
+  struct vtkEntry
+  {
+    vtkTypeUInt64 Size = 0;
+    vtkSmartPointer<vtkDataObject> Data;
+    std::list<vtkTypeUInt64>::iterator Position;
+  };
+  std::list<vtkTypeUInt64> Order; // most recently used first.
+  std::map<vtkTypeUInt64, vtkEntry> Entries;
+};
+
+vtkMPIMoveDataDeliveryCache& GetDeliveryCache()
+{
+  static vtkMPIMoveDataDeliveryCache cache;
+  return cache;
+}
+
+vtkFieldData* GetFieldForComponent(vtkDataSet* ds, const std::string& component)
+{
+  switch (component[0])
+  {
+    case 'p':
+      return ds->GetPointData();
+    case 'c':
+      return ds->GetCellData();
+    default:
+      return ds->GetFieldData();
+  }
+}
 };
 
 vtkStandardNewMacro(vtkMPIMoveData);
@@ -115,6 +701,7 @@ vtkMPIMoveData::vtkMPIMoveData()
   this->UpdatePiece = 0;
 
   this->SkipDataServerGatherToZero = false;
+  this->DeltaDeliveryKey = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -165,16 +752,88 @@ void vtkMPIMoveData::InitializeForCommunicationForParaView()
   this->SetMPIMToNSocketConnection(session->GetMPIMToNSocketConnection());
 }
 
+//----------------------------------------------------------------------------
+void vtkMPIMoveData::SetCompressionMode(int mode)
+{
+  vtkMPIMoveData::CompressionMode =
+    std::max<int>(COMPRESSION_NONE, std::min<int>(mode, COMPRESSION_ADAPTIVE));
+}
+
+//----------------------------------------------------------------------------
+int vtkMPIMoveData::GetCompressionMode()
+{
+  return vtkMPIMoveData::CompressionMode;
+}
+
 //----------------------------------------------------------------------------
 void vtkMPIMoveData::SetUseZLibCompression(bool b)
 {
-  vtkMPIMoveData::UseZLibCompression = b;
+  vtkMPIMoveData::SetCompressionMode(b ? COMPRESSION_ZLIB : COMPRESSION_NONE);
 }
 
 //----------------------------------------------------------------------------
 bool vtkMPIMoveData::GetUseZLibCompression()
 {
-  return vtkMPIMoveData::UseZLibCompression;
+  return vtkMPIMoveData::CompressionMode == COMPRESSION_ZLIB;
+}
+
+//----------------------------------------------------------------------------
+void vtkMPIMoveData::SetUseDeltaDelivery(bool b)
+{
+  vtkMPIMoveData::UseDeltaDelivery = b;
+}
+
+//----------------------------------------------------------------------------
+bool vtkMPIMoveData::GetUseDeltaDelivery()
+{
+  return vtkMPIMoveData::UseDeltaDelivery;
+}
+
+//----------------------------------------------------------------------------
+void vtkMPIMoveData::ReleaseDeltaDeliveryState(vtkTypeUInt64 key)
+{
+  GetDeltaStates().erase(key);
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkMPIMoveData::GetDeltaDeliveryBytesSaved()
+{
+  return GetDeltaBytesSaved();
+}
+
+//----------------------------------------------------------------------------
+void vtkMPIMoveData::SetDeliveryCacheSize(vtkTypeUInt64 bytes)
+{
+  vtkMPIMoveData::DeliveryCacheSize = bytes;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkMPIMoveData::GetDeliveryCacheSize()
+{
+  return vtkMPIMoveData::DeliveryCacheSize;
+}
+
+//----------------------------------------------------------------------------
+void vtkMPIMoveData::GetDeliveryCacheStatistics(
+  vtkTypeUInt64& hits, vtkTypeUInt64& misses, vtkTypeUInt64& bytesSaved, vtkTypeUInt64& usedBytes)
+{
+  const auto& cache = GetDeliveryCache();
+  hits = cache.Hits;
+  misses = cache.Misses;
+  bytesSaved = cache.BytesSaved;
+  usedBytes = cache.TotalSize;
+}
+
+//----------------------------------------------------------------------------
+double vtkMPIMoveData::GetEstimatedLinkBandwidth()
+{
+  return GetCompressionStatistics().LinkBandwidth;
+}
+
+//----------------------------------------------------------------------------
+int vtkMPIMoveData::GetLastCompressionMode()
+{
+  return GetCompressionStatistics().LastMode;
 }
 
 //----------------------------------------------------------------------------
@@ -704,11 +1363,13 @@ void vtkMPIMoveData::DataServerSendToRenderServer(vtkDataObject* output)
   // int fixme;
   // We might be able to eliminate this marshal.
   this->ClearBuffer();
-  this->MarshalDataToBuffer(output);
+  this->MarshalDataToBuffer(output, /*overSocket=*/true);
 
   com->Send(&(this->NumberOfBuffers), 1, 1, 23480);
   com->Send(this->BufferLengths, this->NumberOfBuffers, 1, 23481);
+  const double start = vtkTimerLog::GetUniversalTime();
   com->Send(this->Buffers, this->BufferTotalLength, 1, 23482);
+  UpdateLinkBandwidth(this->BufferTotalLength, vtkTimerLog::GetUniversalTime() - start);
 }
 
 //-----------------------------------------------------------------------------
@@ -765,10 +1426,12 @@ void vtkMPIMoveData::DataServerZeroSendToRenderServerZero(vtkDataObject* data)
     // int fixme;
     // We might be able to eliminate this marshal.
     this->ClearBuffer();
-    this->MarshalDataToBuffer(data);
+    this->MarshalDataToBuffer(data, /*overSocket=*/true);
     com->Send(&(this->NumberOfBuffers), 1, 1, 23480);
     com->Send(this->BufferLengths, this->NumberOfBuffers, 1, 23481);
+    const double start = vtkTimerLog::GetUniversalTime();
     com->Send(this->Buffers, this->BufferTotalLength, 1, 23482);
+    UpdateLinkBandwidth(this->BufferTotalLength, vtkTimerLog::GetUniversalTime() - start);
     this->ClearBuffer();
   }
 }
@@ -826,11 +1489,52 @@ void vtkMPIMoveData::DataServerSendToClient(vtkDataObject* output)
     vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "send-to-client");
     vtkTimerLog::MarkStartEvent("Dataserver sending to client");
     this->ClearBuffer();
-    this->MarshalDataToBuffer(output);
-    this->ClientDataServerSocketController->Send(&(this->NumberOfBuffers), 1, 1, 23490);
-    this->ClientDataServerSocketController->Send(
-      this->BufferLengths, this->NumberOfBuffers, 1, 23491);
-    this->ClientDataServerSocketController->Send(this->Buffers, this->BufferTotalLength, 1, 23492);
+    int payloadType = DELTA_PAYLOAD_NONE;
+    auto payload = this->PrepareDeltaPayload(output, payloadType);
+
+    // header: content hash (0 when not cached), size accounted in the cache,
+    // whether the data is sent or referenced from the client's cache, budget,
+    // type of delta delivery payload.
+    auto& cache = GetDeliveryCache();
+    vtkTypeUInt64 header[5] = { 0, 0, 0, vtkMPIMoveData::DeliveryCacheSize,
+      static_cast<vtkTypeUInt64>(payloadType) };
+    if (vtkMPIMoveData::DeliveryCacheSize > 0 && payload == output)
+    {
+      // hash before marshaling, so that hits skip marshaling and compression.
+      header[0] = HashDataObject(output);
+      if (header[0] != 0)
+      {
+        header[1] = static_cast<vtkTypeUInt64>(output->GetActualMemorySize()) * 1024;
+        header[2] = cache.Contains(header[0]) ? 1 : 0;
+      }
+    }
+    this->ClientDataServerSocketController->Send(header, 5, 1, 23493);
+    if (header[0] != 0)
+    {
+      cache.Use(header[0], header[1], header[3], nullptr);
+    }
+
+    if (header[2] == 1)
+    {
+      // the in-memory size of the data is used as an estimate of what would
+      // have been sent, as it was not marshaled.
+      cache.Hits++;
+      cache.BytesSaved += header[1];
+      vtkVLogF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "delivery cache hit, saved ~%llu bytes",
+        static_cast<unsigned long long>(header[1]));
+    }
+    else
+    {
+      cache.Misses += header[0] != 0 ? 1 : 0;
+      this->MarshalDataToBuffer(payload, /*overSocket=*/true);
+      this->ClientDataServerSocketController->Send(&(this->NumberOfBuffers), 1, 1, 23490);
+      this->ClientDataServerSocketController->Send(
+        this->BufferLengths, this->NumberOfBuffers, 1, 23491);
+      const double start = vtkTimerLog::GetUniversalTime();
+      this->ClientDataServerSocketController->Send(
+        this->Buffers, this->BufferTotalLength, 1, 23492);
+      UpdateLinkBandwidth(this->BufferTotalLength, vtkTimerLog::GetUniversalTime() - start);
+    }
     this->ClearBuffer();
     vtkTimerLog::MarkEndEvent("Dataserver sending to client");
   }
@@ -849,6 +1553,28 @@ void vtkMPIMoveData::ClientReceiveFromDataServer(vtkDataObject* output)
 
   vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "receive-from-dataserver");
 
+  vtkTypeUInt64 header[5];
+  com->Receive(header, 5, 1, 23493);
+  const int payloadType = static_cast<int>(header[4]);
+  auto& cache = GetDeliveryCache();
+  if (header[2] == 1)
+  {
+    // data server determined we already have this data.
+    cache.Use(header[0], header[1], header[3], nullptr);
+    vtkDataObject* cached = cache.Get(header[0]);
+    if (cached == nullptr)
+    {
+      vtkErrorMacro("Delivery cache is out of sync with the data server.");
+      output->Initialize();
+      return;
+    }
+    cache.Hits++;
+    vtkVLogF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "delivery cache hit");
+    output->ShallowCopy(cached);
+    this->ApplyDeltaPayload(output, payloadType);
+    return;
+  }
+
   this->ClearBuffer();
   com->Receive(&(this->NumberOfBuffers), 1, 1, 23490);
   this->BufferLengths = new vtkIdType[this->NumberOfBuffers];
@@ -865,6 +1591,199 @@ void vtkMPIMoveData::ClientReceiveFromDataServer(vtkDataObject* output)
   com->Receive(this->Buffers, this->BufferTotalLength, 1, 23492);
   this->ReconstructDataFromBuffer(output);
   this->ClearBuffer();
+  if (header[0] != 0)
+  {
+    cache.Misses++;
+    cache.Use(header[0], header[1], header[3], output);
+  }
+  this->ApplyDeltaPayload(output, payloadType);
+}
+
+//-----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkMPIMoveData::PrepareDeltaPayload(
+  vtkDataObject* data, int& payloadType)
+{
+  payloadType = DELTA_PAYLOAD_NONE;
+  auto ds = vtkPointSet::SafeDownCast(data);
+  if (this->DeltaDeliveryKey == 0 || ds == nullptr || !vtkMPIMoveData::UseDeltaDelivery)
+  {
+    // nothing is hashed nor kept when delta delivery is not used.
+    GetDeltaStates().erase(this->DeltaDeliveryKey);
+    return data;
+  }
+
+  auto& state = GetDeltaStates()[this->DeltaDeliveryKey];
+  const vtkTypeUInt64 topologyHash = HashTopology(data);
+  vtkMPIMoveDataComponents components;
+  if (topologyHash == 0 || !CollectComponents(ds, components))
+  {
+    // send in full; forget what was sent so far so that we never send a delta
+    // against data the receiver does not have.
+    GetDeltaStates().erase(this->DeltaDeliveryKey);
+    return data;
+  }
+
+  const bool canReuse =
+    state.DataType == data->GetDataObjectType() && state.TopologyHash == topologyHash;
+
+  vtkNew<vtkStringArray> manifest;
+  manifest->SetName(vtkMPIMoveDataDeltaManifestName);
+  vtkSmartPointer<vtkDataObject> payload;
+  payload.TakeReference(data->NewInstance());
+  auto payloadFD = payload->GetFieldData();
+
+  std::map<std::string, vtkTypeUInt64> hashes;
+  vtkTypeUInt64 saved = 0;
+  for (const auto& component : components)
+  {
+    const vtkTypeUInt64 hash = HashArray(component.second, 0);
+    hashes[component.first] = hash;
+    auto iter = state.ComponentHashes.find(component.first);
+    if (canReuse && hash != 0 && iter != state.ComponentHashes.end() && iter->second == hash)
+    {
+      manifest->InsertNextValue("=" + component.first);
+      saved += component.second->GetActualMemorySize() * 1024;
+    }
+    else if (canReuse)
+    {
+      manifest->InsertNextValue("+" + component.first);
+      vtkSmartPointer<vtkAbstractArray> copy;
+      copy.TakeReference(component.second->NewInstance());
+      if (auto dacopy = vtkDataArray::SafeDownCast(copy))
+      {
+        dacopy->ShallowCopy(vtkDataArray::SafeDownCast(component.second));
+      }
+      else
+      {
+        copy->DeepCopy(component.second);
+      }
+      copy->SetName(component.first.c_str());
+      payloadFD->AddArray(copy);
+    }
+  }
+
+  const std::pair<const char*, vtkDataSetAttributes*> attributes[] = {
+    { "p:", ds->GetPointData() }, { "c:", ds->GetCellData() }
+  };
+  for (const auto& field : attributes)
+  {
+    for (int attr = 0; attr < vtkDataSetAttributes::NUM_ATTRIBUTES; ++attr)
+    {
+      if (auto array = field.second->GetAbstractAttribute(attr))
+      {
+        manifest->InsertNextValue(
+          std::string("a:") + field.first + std::to_string(attr) + ":" + array->GetName());
+      }
+    }
+  }
+
+  state.DataType = data->GetDataObjectType();
+  state.TopologyHash = topologyHash;
+  state.ComponentHashes = std::move(hashes);
+  if (!canReuse)
+  {
+    payloadType = DELTA_PAYLOAD_BASE;
+    return data;
+  }
+
+  payloadFD->AddArray(manifest);
+  payloadType = DELTA_PAYLOAD_DELTA;
+  GetDeltaBytesSaved() += saved;
+  vtkVLogF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "delta delivery, saved %llu bytes",
+    static_cast<unsigned long long>(saved));
+  return payload;
+}
+
+//-----------------------------------------------------------------------------
+void vtkMPIMoveData::ApplyDeltaPayload(vtkDataObject* data, int payloadType)
+{
+  if (this->DeltaDeliveryKey == 0)
+  {
+    return;
+  }
+  if (payloadType == DELTA_PAYLOAD_NONE)
+  {
+    // the data server does not use delta delivery for this key, do not keep
+    // the data alive for nothing.
+    GetDeltaStates().erase(this->DeltaDeliveryKey);
+    return;
+  }
+
+  auto& state = GetDeltaStates()[this->DeltaDeliveryKey];
+  auto payload = vtkPointSet::SafeDownCast(data);
+  auto manifest = payload ? vtkStringArray::SafeDownCast(payload->GetFieldData()->GetAbstractArray(
+                              vtkMPIMoveDataDeltaManifestName))
+                          : nullptr;
+  if (payloadType == DELTA_PAYLOAD_BASE || manifest == nullptr)
+  {
+    // full delivery, becomes the base for the next delta.
+    state.Received.TakeReference(data->NewInstance());
+    state.Received->ShallowCopy(data);
+    return;
+  }
+
+  auto base = vtkPointSet::SafeDownCast(state.Received);
+  if (base == nullptr || base->GetDataObjectType() != data->GetDataObjectType())
+  {
+    vtkErrorMacro("Received a delta delivery without matching previous data. "
+                  "Client and server are out of sync.");
+    data->Initialize();
+    return;
+  }
+
+  vtkSmartPointer<vtkPointSet> result;
+  result.TakeReference(base->NewInstance());
+  result->CopyStructure(base);
+  vtkFieldData* payloadFD = payload->GetFieldData();
+  for (vtkIdType cc = 0, max = manifest->GetNumberOfValues(); cc < max; ++cc)
+  {
+    const std::string& entry = manifest->GetValue(cc);
+    const char op = entry[0];
+    const std::string component = entry.substr(1);
+    if (op == 'a')
+    {
+      // a:<p|c>:<attribute>:<name>
+      const auto sep = entry.find(':', 4);
+      auto dsa = vtkDataSetAttributes::SafeDownCast(GetFieldForComponent(result, entry.substr(2)));
+      dsa->SetActiveAttribute(
+        entry.substr(sep + 1).c_str(), std::atoi(entry.substr(4, sep - 4).c_str()));
+      continue;
+    }
+
+    vtkAbstractArray* array = nullptr;
+    if (op == '+')
+    {
+      array = payloadFD->GetAbstractArray(component.c_str());
+    }
+    else if (component == "points")
+    {
+      array = base->GetPoints() ? base->GetPoints()->GetData() : nullptr;
+    }
+    else
+    {
+      array = GetFieldForComponent(base, component)->GetAbstractArray(component.c_str() + 2);
+    }
+    if (array == nullptr)
+    {
+      vtkErrorMacro("Missing array '" << component << "' in delta delivery.");
+      continue;
+    }
+
+    if (component == "points")
+    {
+      vtkNew<vtkPoints> points;
+      points->SetData(vtkDataArray::SafeDownCast(array));
+      result->SetPoints(points);
+    }
+    else
+    {
+      array->SetName(component.c_str() + 2);
+      GetFieldForComponent(result, component)->AddArray(array);
+    }
+  }
+
+  data->ShallowCopy(result);
+  state.Received = result;
 }
 
 //-----------------------------------------------------------------------------
@@ -945,7 +1864,7 @@ void vtkMPIMoveData::ClearBuffer()
 }
 
 //-----------------------------------------------------------------------------
-void vtkMPIMoveData::MarshalDataToBuffer(vtkDataObject* data)
+void vtkMPIMoveData::MarshalDataToBuffer(vtkDataObject* data, bool overSocket)
 {
   vtkImageData* imageData = vtkImageData::SafeDownCast(data);
 
@@ -979,35 +1898,25 @@ void vtkMPIMoveData::MarshalDataToBuffer(vtkDataObject* data)
   char* buffer = nullptr;
   vtkIdType buffer_length = 0;
 
-  if (vtkMPIMoveData::UseZLibCompression)
+  const vtkIdType raw_length = writer->GetOutputStringLength();
+  int mode = SelectCompressionMode(vtkMPIMoveData::CompressionMode, raw_length, overSocket);
+  if (mode != vtkMPIMoveData::COMPRESSION_NONE)
   {
-    vtkTimerLog::MarkStartEvent("Zlib compress");
-    // Use z-lib compression.
-    uLongf out_size = compressBound(writer->GetOutputStringLength());
-    buffer = new char[out_size + 8];
-    memcpy(buffer, "zlib0000", 8);
-
-    compress2(reinterpret_cast<Bytef*>(buffer + 8), &out_size,
-      reinterpret_cast<const Bytef*>(writer->GetOutputString()), writer->GetOutputStringLength(),
-      /* compression_level */ Z_DEFAULT_COMPRESSION);
-    vtkTimerLog::MarkEndEvent("Zlib compress");
-    int in_size = static_cast<int>(writer->GetOutputStringLength());
-    for (int cc = 0; cc < 4; cc++)
+    buffer = CompressBuffer(writer->GetOutputString(), raw_length, mode, buffer_length);
+    if (buffer == nullptr)
     {
-      // the first 4 bytes in the header are "zlib" which helps the receiver
-      // identify that zlib compression has been used.
-      // the next 4 bytes are the original length since zlib doesn't provide
-      // that to the receiver.
-      buffer[4 + cc] = (in_size & 0x0ff);
-      in_size = in_size >> 8;
+      vtkWarningMacro("Compression failed, sending uncompressed data.");
+      mode = vtkMPIMoveData::COMPRESSION_NONE;
     }
-    buffer_length = out_size + 8;
   }
-  else
+  if (buffer == nullptr)
   {
-    buffer_length = writer->GetOutputStringLength();
+    buffer_length = raw_length;
     buffer = writer->RegisterAndGetOutputString();
   }
+  GetCompressionStatistics().LastMode = mode;
+  vtkVLogF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "marshaled %lld bytes to %lld (mode %d)",
+    static_cast<long long>(raw_length), static_cast<long long>(buffer_length), mode);
 
   // Get string.
   this->NumberOfBuffers = 1;
@@ -1039,25 +1948,16 @@ void vtkMPIMoveData::ReconstructDataFromBuffer(vtkDataObject* data)
     char* bufferArray = this->Buffers + this->BufferOffsets[idx];
     vtkIdType bufferLength = this->BufferLengths[idx];
 
+    vtkIdType uncompressed_length = 0;
     char* realBuffer = nullptr;
-    if (bufferLength > 4 && strncmp(bufferArray, "zlib", 4) == 0)
+    if (!DecompressBuffer(bufferArray, bufferLength, realBuffer, uncompressed_length))
+    {
+      vtkErrorMacro("Failed to decompress received data, discarding it.");
+      data->Initialize();
+      return;
+    }
+    if (realBuffer)
     {
-      // sender used zlib compression. Decompress it.
-      vtkIdType compressed_length = bufferLength - 8; // remove the zlib header.
-      vtkIdType uncompressed_length = 0;
-      for (int cc = 0; cc < 4; cc++)
-      {
-        uncompressed_length = uncompressed_length | ((0xff & (bufferArray[4 + cc])) << 8 * cc);
-      }
-
-      // using zlib compression.
-      realBuffer = new char[uncompressed_length];
-      uLongf destLen = uncompressed_length;
-      vtkTimerLog::MarkStartEvent("Zlib uncompress");
-      uncompress(reinterpret_cast<Bytef*>(realBuffer), &destLen,
-        reinterpret_cast<const Bytef*>(bufferArray + 8), compressed_length);
-      vtkTimerLog::MarkEndEvent("Zlib uncompress");
-
       bufferArray = realBuffer;
       bufferLength = uncompressed_length;
     }
@@ -1124,6 +2024,7 @@ void vtkMPIMoveData::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Server: " << this->Server << endl;
   os << indent << "MoveMode: " << this->MoveMode << endl;
   os << indent << "SkipDataServerGatherToZero: " << this->SkipDataServerGatherToZero << endl;
+  os << indent << "CompressionMode: " << vtkMPIMoveData::CompressionMode << endl;
   os << indent << "OutputDataType: ";
   if (this->OutputDataType == VTK_POLY_DATA)
   {
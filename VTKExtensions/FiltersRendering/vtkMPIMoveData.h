@@ -28,6 +28,7 @@
 
 #include "vtkPVVTKExtensionsFiltersRenderingModule.h" //needed for exports
 #include "vtkPassInputTypeAlgorithm.h"
+#include "vtkSmartPointer.h" // for vtkSmartPointer
 
 class vtkMultiProcessController;
 class vtkSocketController;
@@ -103,16 +104,51 @@ public:
   vtkGetMacro(OutputDataType, int);
   ///@}
 
+  enum CompressionModes
+  {
+    COMPRESSION_NONE = 0,
+    COMPRESSION_LZ4 = 1,
+    COMPRESSION_ZLIB = 2,
+    COMPRESSION_ADAPTIVE = 3
+  };
+
   ///@{
   /**
-   * When set to true, zlib compression is used. False by default.
+   * Select the compressor used for marshaled data. COMPRESSION_NONE by default.
+   * COMPRESSION_LZ4 is fast and is a good fit for fast links,
+   * COMPRESSION_ZLIB gives better ratios at a much higher CPU cost.
+   * COMPRESSION_ADAPTIVE picks none, LZ4 or zlib for each delivery to the client
+   * or render server using running estimates of the link bandwidth and of the
+   * throughput and ratio of each compressor. In adaptive mode, data exchanged
+   * between MPI ranks is never compressed.
+   *
    * This value has any effect only on the data-sender processes. The receiver
-   * always checks the received data to see if zlib decompression is required.
+   * always checks the received data to see if decompression is required.
+   */
+  static void SetCompressionMode(int mode);
+  static int GetCompressionMode();
+  ///@}
+
+  ///@{
+  /**
+   * When set to true, zlib compression is used. False by default.
+   * This is a shortcut for `SetCompressionMode(COMPRESSION_ZLIB)`.
    */
   static void SetUseZLibCompression(bool b);
   static bool GetUseZLibCompression();
   ///@}
 
+  ///@{
+  /**
+   * Statistics used by COMPRESSION_ADAPTIVE. The link bandwidth (in bytes per
+   * second) is measured on sends to the client or render server, and the
+   * compression mode actually used for the most recent marshaled buffer is
+   * recorded.
+   */
+  static double GetEstimatedLinkBandwidth();
+  static int GetLastCompressionMode();
+  ///@}
+
   /**
    * vtkMPIMoveData doesn't necessarily generate a valid output data on all the
    * involved processes (depending on the MoveMode and Server ivars). This
@@ -131,6 +167,67 @@ public:
   vtkGetMacro(SkipDataServerGatherToZero, bool);
   ///@}
 
+  ///@{
+  /**
+   * Key identifying a stream of deliveries of the same data (e.g. a
+   * representation's port) across updates. When non-zero and delta delivery is
+   * enabled, the data server only sends point and cell arrays (and points)
+   * that changed since the previous delivery with the same key; unchanged
+   * arrays and the cell topology are reused from the data the client already
+   * holds. Only vtkPolyData and vtkUnstructuredGrid sent to the client are
+   * supported, other cases are delivered in full. 0 by default.
+   *
+   * The key must be set identically on all processes involved in the delivery.
+   */
+  vtkSetMacro(DeltaDeliveryKey, vtkTypeUInt64);
+  vtkGetMacro(DeltaDeliveryKey, vtkTypeUInt64);
+  ///@}
+
+  ///@{
+  /**
+   * Enable/disable delta delivery (see SetDeltaDeliveryKey). This value has
+   * any effect only on the data-sender processes. False by default.
+   */
+  static void SetUseDeltaDelivery(bool b);
+  static bool GetUseDeltaDelivery();
+  ///@}
+
+  /**
+   * Release the state kept for delta delivery with the given key. Must be
+   * called on all processes when the stream of deliveries ends, e.g. when a
+   * representation is removed.
+   */
+  static void ReleaseDeltaDeliveryState(vtkTypeUInt64 key);
+
+  /**
+   * Returns the number of bytes that did not need to be sent thanks to
+   * delta delivery since the process started. This is an estimate based on
+   * the in-memory size of the reused arrays.
+   */
+  static vtkTypeUInt64 GetDeltaDeliveryBytesSaved();
+
+  ///@{
+  /**
+   * Memory budget, in bytes, for the cache of data delivered to the client.
+   * When non-zero, delivered data is identified by a hash of its contents and
+   * data already held by the client (e.g. the same geometry shown by another
+   * representation or in another view) is not sent again; the client reuses
+   * its cached copy. Least recently used entries are evicted when the budget
+   * is exceeded. This value has any effect only on the data-sender processes.
+   * 0 (disabled) by default.
+   */
+  static void SetDeliveryCacheSize(vtkTypeUInt64 bytes);
+  static vtkTypeUInt64 GetDeliveryCacheSize();
+  ///@}
+
+  /**
+   * Returns statistics for the delivery cache on this process: number of
+   * cache hits and misses, bytes not sent thanks to the cache (on the sender)
+   * and memory accounted in the cache.
+   */
+  static void GetDeliveryCacheStatistics(vtkTypeUInt64& hits, vtkTypeUInt64& misses,
+    vtkTypeUInt64& bytesSaved, vtkTypeUInt64& usedBytes);
+
   enum MoveModes
   {
     PASS_THROUGH = 0,
@@ -171,14 +268,37 @@ protected:
   char* Buffers;
   vtkIdType BufferTotalLength;
 
+  /**
+   * Kind of payload sent for delta delivery, see PrepareDeltaPayload.
+   */
+  enum DeltaPayloadTypes
+  {
+    DELTA_PAYLOAD_NONE = 0,
+    DELTA_PAYLOAD_BASE = 1,
+    DELTA_PAYLOAD_DELTA = 2
+  };
+
+  /**
+   * On the sender, returns the payload to marshal for `data`: either `data`
+   * itself or a reduced data object only holding changed arrays, and sets
+   * `payloadType` to DELTA_PAYLOAD_DELTA in the latter case. A full payload
+   * is DELTA_PAYLOAD_BASE if the next deliveries may be deltas against it, and
+   * DELTA_PAYLOAD_NONE if delta delivery is not used. On the receiver,
+   * rebuilds the full data object from a delta payload, and keeps a base
+   * payload for the next deltas. Nothing is kept for other payloads.
+   */
+  vtkSmartPointer<vtkDataObject> PrepareDeltaPayload(vtkDataObject* data, int& payloadType);
+  void ApplyDeltaPayload(vtkDataObject* data, int payloadType);
+
   void ClearBuffer();
-  void MarshalDataToBuffer(vtkDataObject* data);
+  void MarshalDataToBuffer(vtkDataObject* data, bool overSocket = false);
   void ReconstructDataFromBuffer(vtkDataObject* data);
 
   int MoveMode;
   int Server;
 
   bool SkipDataServerGatherToZero;
+  vtkTypeUInt64 DeltaDeliveryKey;
 
   enum Servers
   {
@@ -196,7 +316,9 @@ private:
   vtkMPIMoveData(const vtkMPIMoveData&) = delete;
   void operator=(const vtkMPIMoveData&) = delete;
 
-  static bool UseZLibCompression;
+  static int CompressionMode;
+  static bool UseDeltaDelivery;
+  static vtkTypeUInt64 DeliveryCacheSize;
 };
 
 #endif
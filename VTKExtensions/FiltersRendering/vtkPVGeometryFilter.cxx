@@ -37,6 +37,8 @@
 #include "vtkGeometryFilter.h"
 #include "vtkHyperTreeGrid.h"
 #include "vtkHyperTreeGridGeometry.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationIntegerVectorKey.h"
@@ -53,10 +55,14 @@
 #include "vtkPVTrivialProducer.h"
 #include "vtkPartitionedDataSetCollection.h"
 #include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkRectilinearGridOutlineFilter.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredGrid.h"
@@ -64,13 +70,19 @@
 #include "vtkTimerLog.h"
 #include "vtkTriangleFilter.h"
 #include "vtkUniformGrid.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnsignedIntArray.h"
 #include "vtkUnstructuredGrid.h"
 #include "vtkUnstructuredGridGeometryFilter.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstring>
+#include <map>
 #include <string>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 template <typename T>
@@ -143,6 +155,327 @@ public:
   int Commutative() override { return 1; }
 };
 
+namespace
+{
+//----------------------------------------------------------------------------
+// Records the names of the arrays in `dsa` (except the original ids arrays)
+// and the names of its active attributes. Returns false if an array has no
+// name since it could not be located on the next input.
+bool vtkRecordArrays(
+  vtkDataSetAttributes* dsa, std::vector<std::string>& names, std::vector<std::string>& attributes)
+{
+  names.clear();
+  attributes.assign(vtkDataSetAttributes::NUM_ATTRIBUTES, std::string());
+  for (int cc = 0, max = dsa->GetNumberOfArrays(); cc < max; ++cc)
+  {
+    const char* name = dsa->GetAbstractArray(cc)->GetName();
+    if (name == nullptr || *name == '\0')
+    {
+      return false;
+    }
+    if (strcmp(name, "vtkOriginalCellIds") != 0 && strcmp(name, "vtkOriginalPointIds") != 0)
+    {
+      names.emplace_back(name);
+    }
+  }
+  for (int cc = 0; cc < vtkDataSetAttributes::NUM_ATTRIBUTES; ++cc)
+  {
+    if (vtkAbstractArray* array = dsa->GetAbstractAttribute(cc))
+    {
+      attributes[cc] = array->GetName();
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// Fills `out` with the arrays named `names` gathered from `in` using `ids`.
+bool vtkGatherArrays(vtkDataSetAttributes* in, vtkDataSetAttributes* out, vtkIdList* ids,
+  const std::vector<std::string>& names, const std::vector<std::string>& attributes)
+{
+  std::vector<vtkAbstractArray*> inArrays;
+  std::vector<vtkSmartPointer<vtkAbstractArray>> outArrays;
+  for (const auto& name : names)
+  {
+    vtkAbstractArray* inArray = in->GetAbstractArray(name.c_str());
+    if (inArray == nullptr)
+    {
+      return false;
+    }
+    auto outArray = vtk::TakeSmartPointer(inArray->NewInstance());
+    outArray->SetName(name.c_str());
+    outArray->SetNumberOfComponents(inArray->GetNumberOfComponents());
+    outArray->CopyComponentNames(inArray);
+    outArray->SetNumberOfTuples(ids->GetNumberOfIds());
+    inArrays.push_back(inArray);
+    outArrays.push_back(outArray);
+  }
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(inArrays.size()), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      inArrays[cc]->GetTuples(ids, outArrays[cc]);
+    }
+  });
+
+  out->Initialize();
+  for (const auto& outArray : outArrays)
+  {
+    out->AddArray(outArray);
+  }
+  for (int cc = 0; cc < vtkDataSetAttributes::NUM_ATTRIBUTES; ++cc)
+  {
+    if (!attributes[cc].empty())
+    {
+      out->SetActiveAttribute(attributes[cc].c_str(), cc);
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// Converts an original ids array produced by vtkGeometryFilter to a vtkIdList.
+vtkSmartPointer<vtkIdList> vtkToIdList(vtkDataArray* array, vtkIdType count)
+{
+  auto ids = vtkIdTypeArray::SafeDownCast(array);
+  if (ids == nullptr || ids->GetNumberOfTuples() != count)
+  {
+    return nullptr;
+  }
+  vtkNew<vtkIdList> list;
+  list->SetNumberOfIds(count);
+  std::copy(ids->GetPointer(0), ids->GetPointer(0) + count, list->GetPointer(0));
+  return list.GetPointer();
+}
+
+//----------------------------------------------------------------------------
+// Adds an original ids array named `name` built from `ids` to `dsa`.
+void vtkAddOriginalIds(vtkDataSetAttributes* dsa, vtkIdList* ids, const char* name)
+{
+  vtkNew<vtkIdTypeArray> array;
+  array->SetName(name);
+  array->SetNumberOfTuples(ids->GetNumberOfIds());
+  std::copy(ids->GetPointer(0), ids->GetPointer(0) + ids->GetNumberOfIds(), array->GetPointer(0));
+  dsa->AddArray(array);
+}
+
+//----------------------------------------------------------------------------
+// Returns a string identifying the point and cell arrays of the dataset.
+std::string vtkGetArraysSignature(vtkDataSet* ds)
+{
+  std::string signature;
+  for (vtkDataSetAttributes* dsa : { static_cast<vtkDataSetAttributes*>(ds->GetPointData()),
+         static_cast<vtkDataSetAttributes*>(ds->GetCellData()) })
+  {
+    for (int cc = 0, max = dsa->GetNumberOfArrays(); cc < max; ++cc)
+    {
+      const char* name = dsa->GetAbstractArray(cc)->GetName();
+      signature += name ? name : "";
+      signature += '\n';
+    }
+    signature += '\n';
+  }
+  return signature;
+}
+
+//----------------------------------------------------------------------------
+// Adds the block and every object it holds that computes cached values on
+// demand (points, cells, attribute arrays) to `objects`. Returns true if one
+// of them was already there, i.e. is shared with a block added before.
+bool vtkInsertBlockObjects(vtkDataObject* block, std::unordered_set<vtkObject*>& objects)
+{
+  bool shared = false;
+  auto insert = [&](vtkObject* object) {
+    if (object)
+    {
+      shared |= !objects.insert(object).second;
+    }
+  };
+  auto insertCells = [&](vtkCellArray* cells) {
+    if (cells)
+    {
+      insert(cells);
+      insert(cells->GetOffsetsArray());
+      insert(cells->GetConnectivityArray());
+    }
+  };
+  auto insertArrays = [&](vtkFieldData* fd) {
+    for (int cc = 0, max = fd ? fd->GetNumberOfArrays() : 0; cc < max; ++cc)
+    {
+      insert(fd->GetAbstractArray(cc));
+    }
+  };
+
+  insert(block);
+  insertArrays(block->GetFieldData());
+  if (auto ds = vtkDataSet::SafeDownCast(block))
+  {
+    insertArrays(ds->GetPointData());
+    insertArrays(ds->GetCellData());
+  }
+  if (auto ps = vtkPointSet::SafeDownCast(block))
+  {
+    if (vtkPoints* points = ps->GetPoints())
+    {
+      insert(points);
+      insert(points->GetData());
+    }
+  }
+  if (auto pd = vtkPolyData::SafeDownCast(block))
+  {
+    insertCells(pd->GetVerts());
+    insertCells(pd->GetLines());
+    insertCells(pd->GetPolys());
+    insertCells(pd->GetStrips());
+  }
+  else if (auto ug = vtkUnstructuredGrid::SafeDownCast(block))
+  {
+    insertCells(ug->GetCells());
+    insert(ug->GetCellTypesArray());
+  }
+  else if (auto esg = vtkExplicitStructuredGrid::SafeDownCast(block))
+  {
+    insertCells(esg->GetCells());
+  }
+  else if (auto rg = vtkRectilinearGrid::SafeDownCast(block))
+  {
+    insert(rg->GetXCoordinates());
+    insert(rg->GetYCoordinates());
+    insert(rg->GetZCoordinates());
+  }
+  return shared;
+}
+}
+
+//----------------------------------------------------------------------------
+// Surface extracted from a linear vtkUnstructuredGrid with what is needed to
+// reuse it for a later input with the same mesh.
+class vtkPVGeometryFilterSurfaceCache
+{
+public:
+  using KeyType = std::vector<std::pair<const void*, vtkMTimeType>>;
+
+  static KeyType GetKey(vtkUnstructuredGrid* input, bool removeGhostInterfaces)
+  {
+    KeyType key;
+    for (vtkObject* obj : { static_cast<vtkObject*>(input->GetPoints()),
+           static_cast<vtkObject*>(input->GetCells()),
+           static_cast<vtkObject*>(input->GetCellTypesArray()),
+           static_cast<vtkObject*>(input->GetFaces()),
+           static_cast<vtkObject*>(input->GetFaceLocations()),
+           static_cast<vtkObject*>(input->GetPointGhostArray()),
+           static_cast<vtkObject*>(input->GetCellGhostArray()) })
+    {
+      key.emplace_back(obj, obj ? obj->GetMTime() : 0);
+    }
+    key.emplace_back(nullptr, removeGhostInterfaces ? 1 : 0);
+    return key;
+  }
+
+  void Clear()
+  {
+    this->Key.clear();
+    this->Surface = nullptr;
+    this->PointIds = nullptr;
+    this->CellIds = nullptr;
+  }
+
+  /**
+   * Returns true if the input mesh matches the one the cache was built for.
+   */
+  bool Matches(const KeyType& key) const { return !this->Key.empty() && key == this->Key; }
+
+  /**
+   * Produces the output using the cached surface, gathering the attribute
+   * arrays from the input. Returns false if it could not be done.
+   */
+  bool Reuse(vtkUnstructuredGrid* input, vtkPolyData* output, bool passCellIds, bool passPointIds)
+  {
+    if (!this->Surface || vtkGetArraysSignature(input) != this->ArraysSignature)
+    {
+      return false;
+    }
+
+    output->CopyStructure(this->Surface);
+    if (!vtkGatherArrays(input->GetPointData(), output->GetPointData(), this->PointIds,
+          this->PointArrays, this->PointAttributes) ||
+      !vtkGatherArrays(input->GetCellData(), output->GetCellData(), this->CellIds,
+        this->CellArrays, this->CellAttributes))
+    {
+      output->Initialize();
+      return false;
+    }
+    if (passPointIds)
+    {
+      vtkAddOriginalIds(output->GetPointData(), this->PointIds, "vtkOriginalPointIds");
+    }
+    if (passCellIds)
+    {
+      vtkAddOriginalIds(output->GetCellData(), this->CellIds, "vtkOriginalCellIds");
+    }
+    return true;
+  }
+
+  /**
+   * Caches the surface `output` extracted from `input` with original ids
+   * enabled. The original ids arrays that were not requested are removed from
+   * `output`.
+   */
+  void Store(const KeyType& key, vtkUnstructuredGrid* input, vtkPolyData* output,
+    bool passCellIds, bool passPointIds)
+  {
+    this->Clear();
+    this->PointIds = vtkToIdList(
+      output->GetPointData()->GetArray("vtkOriginalPointIds"), output->GetNumberOfPoints());
+    this->CellIds = vtkToIdList(
+      output->GetCellData()->GetArray("vtkOriginalCellIds"), output->GetNumberOfCells());
+    if (!passPointIds)
+    {
+      output->GetPointData()->RemoveArray("vtkOriginalPointIds");
+    }
+    if (!passCellIds)
+    {
+      output->GetCellData()->RemoveArray("vtkOriginalCellIds");
+    }
+    if (!this->PointIds || !this->CellIds ||
+      !vtkRecordArrays(output->GetPointData(), this->PointArrays, this->PointAttributes) ||
+      !vtkRecordArrays(output->GetCellData(), this->CellArrays, this->CellAttributes))
+    {
+      this->Clear();
+      return;
+    }
+
+    this->Surface = vtkSmartPointer<vtkPolyData>::New();
+    this->Surface->CopyStructure(output);
+    this->ArraysSignature = vtkGetArraysSignature(input);
+    this->Key = key;
+  }
+
+private:
+  KeyType Key;
+  std::string ArraysSignature;
+  vtkSmartPointer<vtkPolyData> Surface;
+  vtkSmartPointer<vtkIdList> PointIds;
+  vtkSmartPointer<vtkIdList> CellIds;
+  std::vector<std::string> PointArrays;
+  std::vector<std::string> PointAttributes;
+  std::vector<std::string> CellArrays;
+  std::vector<std::string> CellAttributes;
+};
+
+//----------------------------------------------------------------------------
+class vtkPVGeometryFilter::vtkInternals
+{
+public:
+  // Surface caches, indexed by the flat index of the block (0 for non-composite
+  // inputs).
+  std::map<unsigned int, vtkPVGeometryFilterSurfaceCache> SurfaceCaches;
+
+  // Cache to use for the dataset being processed by UnstructuredGridExecute(),
+  // if any.
+  vtkPVGeometryFilterSurfaceCache* CurrentSurfaceCache = nullptr;
+};
+
 //----------------------------------------------------------------------------
 vtkPVGeometryFilter::vtkPVGeometryFilter()
 {
@@ -189,6 +522,9 @@ vtkPVGeometryFilter::vtkPVGeometryFilter()
 
   this->HideInternalAMRFaces = true;
   this->UseNonOverlappingAMRMetaDataForOutlines = true;
+  this->ExecuteBlocksInParallel = true;
+  this->CacheStaticMeshSurface = true;
+  this->Internals = new vtkInternals();
 }
 
 //----------------------------------------------------------------------------
@@ -226,6 +562,7 @@ vtkPVGeometryFilter::~vtkPVGeometryFilter()
   }
   this->OutlineSource->Delete();
   this->SetController(nullptr);
+  delete this->Internals;
 }
 
 //----------------------------------------------------------------------------
@@ -524,7 +861,12 @@ int vtkPVGeometryFilter::RequestData(
   }
   int* wholeExtent =
     vtkStreamingDemandDrivenPipeline::GetWholeExtent(inputVector[0]->GetInformationObject(0));
+
+  auto& caches = this->Internals->SurfaceCaches;
+  caches.erase(caches.upper_bound(0), caches.end());
+  this->Internals->CurrentSurfaceCache = this->CacheStaticMeshSurface ? &caches[0] : nullptr;
   this->ExecuteBlock(input, output, 1, procid, numProcs, 0, wholeExtent);
+  this->Internals->CurrentSurfaceCache = nullptr;
   this->CleanupOutputData(output, 1);
   return 1;
 }
@@ -682,6 +1024,27 @@ void vtkPVGeometryFilter::AddCompositeIndex(vtkPolyData* pd, unsigned int index)
   pd->GetPointData()->AddArray(pindex);
 }
 
+//----------------------------------------------------------------------------
+vtkPVGeometryFilter* vtkPVGeometryFilter::NewBlockWorker()
+{
+  vtkPVGeometryFilter* worker = this->NewInstance();
+  worker->UseOutline = this->UseOutline;
+  worker->GenerateFeatureEdges = this->GenerateFeatureEdges;
+  worker->BlockColorsDistinctValues = this->BlockColorsDistinctValues;
+  worker->GenerateCellNormals = this->GenerateCellNormals;
+  worker->Triangulate = this->Triangulate;
+  worker->GenerateProcessIds = this->GenerateProcessIds;
+  worker->HideInternalAMRFaces = this->HideInternalAMRFaces;
+  worker->UseNonOverlappingAMRMetaDataForOutlines = this->UseNonOverlappingAMRMetaDataForOutlines;
+  worker->CacheStaticMeshSurface = this->CacheStaticMeshSurface;
+  worker->SetController(this->Controller);
+  worker->SetPassThroughCellIds(this->PassThroughCellIds);
+  worker->SetPassThroughPointIds(this->PassThroughPointIds);
+  worker->SetNonlinearSubdivisionLevel(this->NonlinearSubdivisionLevel);
+  worker->GeometryFilter->SetRemoveGhostInterfaces(!this->GenerateFeatureEdges);
+  return worker;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVGeometryFilter::AddBlockColors(vtkDataObject* pd, unsigned int index)
 {
@@ -911,29 +1274,124 @@ int vtkPVGeometryFilter::RequestDataObjectTree(
 
   int* wholeExtent =
     vtkStreamingDemandDrivenPipeline::GetWholeExtent(inputVector[0]->GetInformationObject(0));
-  int numInputs = 0;
+
+  // Gather the blocks first so that they can be processed concurrently. Results
+  // are added to the output in traversal order afterwards, so the output does
+  // not depend on how blocks were scheduled.
+  std::vector<vtkDataObject*> blocks;
+  std::vector<unsigned int> flatIndices;
+  blocks.reserve(totNumBlocks);
+  flatIndices.reserve(totNumBlocks);
+  std::unordered_set<vtkObject*> uniqueData;
+  bool sharesData = false;
   for (inIter->InitTraversal(); !inIter->IsDoneWithTraversal(); inIter->GoToNextItem())
   {
-    vtkDataObject* block = inIter->GetCurrentDataObject();
-    if (!block)
+    if (vtkDataObject* block = inIter->GetCurrentDataObject())
     {
-      continue;
+      blocks.push_back(block);
+      flatIndices.push_back(inIter->GetCurrentFlatIndex());
+      sharesData |= vtkInsertBlockObjects(block, uniqueData);
+    }
+  }
+
+  // Locate the surface cache of each block, dropping those of blocks that are
+  // no longer present. This is done before executing blocks concurrently.
+  std::vector<vtkPVGeometryFilterSurfaceCache*> caches(blocks.size(), nullptr);
+  if (this->CacheStaticMeshSurface)
+  {
+    std::map<unsigned int, vtkPVGeometryFilterSurfaceCache> currentCaches;
+    for (size_t cc = 0; cc < blocks.size(); ++cc)
+    {
+      auto iter = this->Internals->SurfaceCaches.find(flatIndices[cc]);
+      if (iter != this->Internals->SurfaceCaches.end())
+      {
+        currentCaches[flatIndices[cc]] = std::move(iter->second);
+      }
+    }
+    this->Internals->SurfaceCaches.swap(currentCaches);
+    for (size_t cc = 0; cc < blocks.size(); ++cc)
+    {
+      caches[cc] = &this->Internals->SurfaceCaches[flatIndices[cc]];
     }
+  }
 
+  const vtkIdType numBlocks = static_cast<vtkIdType>(blocks.size());
+  std::vector<vtkSmartPointer<vtkPolyData>> outputs(blocks.size());
+  std::vector<int> outlineFlags(blocks.size(), 0);
+  auto executeBlock = [&](vtkPVGeometryFilter* self, vtkIdType cc) {
+    self->Internals->CurrentSurfaceCache = caches[cc];
+    self->OutlineFlag = 0;
     vtkNew<vtkPolyData> tmpOut;
-    this->ExecuteBlock(block, tmpOut, 0, 0, 1, 0, wholeExtent);
-    this->CleanupOutputData(tmpOut, 0);
-    // skip empty nodes.
+    self->ExecuteBlock(blocks[cc], tmpOut, 0, 0, 1, 0, wholeExtent);
+    self->CleanupOutputData(tmpOut, 0);
     if (tmpOut->GetNumberOfPoints() > 0)
     {
-      output->SetDataSet(inIter, tmpOut);
+      self->AddCompositeIndex(tmpOut, flatIndices[cc]);
+    }
+    self->Internals->CurrentSurfaceCache = nullptr;
+    outlineFlags[cc] = self->OutlineFlag;
+    outputs[cc] = tmpOut.GetPointer();
+  };
+
+  // blocks sharing the same dataset, points, cells or arrays cannot be
+  // processed concurrently since some queries (bounds, ranges, links, etc.)
+  // update internal caches.
+  const int numThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+  if (this->ExecuteBlocksInParallel && numThreads > 1 && numBlocks > 1 && !sharesData)
+  {
+    vtkTimerLog::MarkStartEvent("vtkPVGeometryFilter::ExecuteBlocksInParallel");
+    vtkSMPThreadLocal<vtkSmartPointer<vtkPVGeometryFilter>> workers;
+
+    // process blocks in batches so progress is reported from this thread.
+    const vtkIdType batchSize = std::max<vtkIdType>(numBlocks / 10, numThreads);
+    for (vtkIdType batchBegin = 0; batchBegin < numBlocks && !this->AbortExecute;
+         batchBegin += batchSize)
+    {
+      const vtkIdType batchEnd = std::min(batchBegin + batchSize, numBlocks);
+      vtkSMPTools::For(batchBegin, batchEnd, 1, [&](vtkIdType begin, vtkIdType end) {
+        auto& worker = workers.Local();
+        if (worker == nullptr)
+        {
+          worker.TakeReference(this->NewBlockWorker());
+        }
+        for (vtkIdType cc = begin; cc < end; ++cc)
+        {
+          executeBlock(worker, cc);
+        }
+      });
+      this->UpdateProgress(static_cast<double>(batchEnd) / numBlocks);
+    }
+    vtkTimerLog::MarkEndEvent("vtkPVGeometryFilter::ExecuteBlocksInParallel");
+  }
+  else
+  {
+    for (vtkIdType cc = 0; cc < numBlocks; ++cc)
+    {
+      executeBlock(this, cc);
+      this->UpdateProgress(static_cast<float>(cc + 1) / totNumBlocks);
+    }
+  }
+  // the output has an outline if any block was rendered as one.
+  this->OutlineFlag = 0;
+  for (int flag : outlineFlags)
+  {
+    this->OutlineFlag |= flag;
+  }
 
-      const unsigned int current_flat_index = inIter->GetCurrentFlatIndex();
-      this->AddCompositeIndex(tmpOut, current_flat_index);
+  vtkIdType blockIndex = 0;
+  for (inIter->InitTraversal(); !inIter->IsDoneWithTraversal(); inIter->GoToNextItem())
+  {
+    if (inIter->GetCurrentDataObject() == nullptr)
+    {
+      continue;
     }
 
-    numInputs++;
-    this->UpdateProgress(static_cast<float>(numInputs) / totNumBlocks);
+    vtkPolyData* tmpOut = outputs[blockIndex++];
+    // skip empty nodes.
+    if (tmpOut && tmpOut->GetNumberOfPoints() > 0)
+    {
+      output->SetDataSet(inIter, tmpOut);
+    }
   }
   vtkTimerLog::MarkEndEvent("vtkPVGeometryFilter::ExecuteCompositeDataSet");
 
@@ -1382,6 +1840,25 @@ void vtkPVGeometryFilter::UnstructuredGridExecute(
   {
     this->OutlineFlag = 0;
 
+    // Reuse the surface extracted previously if the mesh has not changed.
+    vtkPVGeometryFilterSurfaceCache* cache = nullptr;
+    vtkPVGeometryFilterSurfaceCache::KeyType cacheKey;
+    auto unstructuredGrid = vtkUnstructuredGrid::SafeDownCast(input);
+    if (this->CacheStaticMeshSurface && !this->Triangulate && unstructuredGrid != nullptr &&
+      this->Internals->CurrentSurfaceCache != nullptr)
+    {
+      cache = this->Internals->CurrentSurfaceCache;
+      cacheKey = vtkPVGeometryFilterSurfaceCache::GetKey(
+        unstructuredGrid, this->GeometryFilter->GetRemoveGhostInterfaces());
+      if (cache->Matches(cacheKey) &&
+        cache->Reuse(unstructuredGrid, output, this->PassThroughCellIds != 0,
+          this->PassThroughPointIds != 0))
+      {
+        return;
+      }
+      cache->Clear();
+    }
+
     bool handleSubdivision = (this->Triangulate != 0) && (input->GetNumberOfCells() > 0);
     if (!handleSubdivision && (this->NonlinearSubdivisionLevel > 0))
     {
@@ -1460,11 +1937,28 @@ void vtkPVGeometryFilter::UnstructuredGridExecute(
       }
     }
 
+    // The surface of linear meshes can be cached; that needs the original ids
+    // to gather attributes from later inputs.
+    const bool storeSurface = (cache != nullptr && !handleSubdivision);
+    if (storeSurface)
+    {
+      this->GeometryFilter->PassThroughCellIdsOn();
+      this->GeometryFilter->PassThroughPointIdsOn();
+    }
+
     if (input->GetNumberOfCells() > 0)
     {
       this->GeometryFilter->UnstructuredGridExecute(input, output);
     }
 
+    if (storeSurface)
+    {
+      this->GeometryFilter->SetPassThroughCellIds(this->PassThroughCellIds);
+      this->GeometryFilter->SetPassThroughPointIds(this->PassThroughPointIds);
+      cache->Store(cacheKey, unstructuredGrid, output, this->PassThroughCellIds != 0,
+        this->PassThroughPointIds != 0);
+    }
+
     if (this->Triangulate && (output->GetNumberOfPolys() > 0))
     {
       // Triangulate the polygonal mesh if requested to avoid rendering
@@ -1741,6 +2235,10 @@ void vtkPVGeometryFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "HideInternalAMRFaces: " << (this->HideInternalAMRFaces ? "on" : "off") << endl;
   os << indent << "UseNonOverlappingAMRMetaDataForOutlines: "
      << (this->UseNonOverlappingAMRMetaDataForOutlines ? "on" : "off") << endl;
+  os << indent << "ExecuteBlocksInParallel: " << (this->ExecuteBlocksInParallel ? "on" : "off")
+     << endl;
+  os << indent << "CacheStaticMeshSurface: " << (this->CacheStaticMeshSurface ? "on" : "off")
+     << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -1767,6 +2265,20 @@ void vtkPVGeometryFilter::SetPassThroughPointIds(int newvalue)
   }
 }
 
+//-----------------------------------------------------------------------------
+void vtkPVGeometryFilter::SetCacheStaticMeshSurface(bool newvalue)
+{
+  if (this->CacheStaticMeshSurface != newvalue)
+  {
+    this->CacheStaticMeshSurface = newvalue;
+    if (!newvalue)
+    {
+      this->Internals->SurfaceCaches.clear();
+    }
+    this->Modified();
+  }
+}
+
 //-----------------------------------------------------------------------------
 void vtkPVGeometryFilter::SetNonlinearSubdivisionLevel(int newvalue)
 {
@@ -227,6 +227,35 @@ public:
   vtkBooleanMacro(UseNonOverlappingAMRMetaDataForOutlines, bool);
   ///@}
 
+  ///@{
+  /**
+   * When set to true (default), the blocks of a vtkDataObjectTree input are
+   * processed concurrently using vtkSMPTools. Each thread uses its own copy of
+   * the internal filters. The output is identical to the one produced when
+   * blocks are processed serially. Inputs in which several blocks share a
+   * dataset, points, cells or arrays are always processed serially.
+   */
+  vtkSetMacro(ExecuteBlocksInParallel, bool);
+  vtkGetMacro(ExecuteBlocksInParallel, bool);
+  vtkBooleanMacro(ExecuteBlocksInParallel, bool);
+  ///@}
+
+  ///@{
+  /**
+   * When set to true (default), the surface extracted from linear
+   * vtkUnstructuredGrid datasets (or blocks) is cached together with the
+   * original point and cell ids of its points and cells. On subsequent
+   * executions, if the points, cells and ghost arrays of the input are the same
+   * arrays, unmodified since, the cached surface is reused and only point and
+   * cell data arrays are gathered from the input. This makes playing animations
+   * of time-varying fields on static meshes much faster, at the cost of keeping
+   * the id maps in memory. Turning this off releases the cache.
+   */
+  virtual void SetCacheStaticMeshSurface(bool);
+  vtkGetMacro(CacheStaticMeshSurface, bool);
+  vtkBooleanMacro(CacheStaticMeshSurface, bool);
+  ///@}
+
   // These keys are put in the output composite-data metadata for multipieces
   // since this filter merges multipieces together.
   static vtkInformationIntegerVectorKey* POINT_OFFSETS();
@@ -342,12 +371,24 @@ protected:
   bool HideInternalAMRFaces;
   bool UseNonOverlappingAMRMetaDataForOutlines;
   bool GenerateFeatureEdges;
+  bool ExecuteBlocksInParallel;
+  bool CacheStaticMeshSurface;
 
 private:
   vtkPVGeometryFilter(const vtkPVGeometryFilter&) = delete;
   void operator=(const vtkPVGeometryFilter&) = delete;
 
   void AddCompositeIndex(vtkPolyData* pd, unsigned int index);
+
+  /**
+   * Returns a new instance of the same class configured like this one, used
+   * to execute blocks on a thread in RequestDataObjectTree(). The caller must
+   * delete it.
+   */
+  vtkPVGeometryFilter* NewBlockWorker();
+
+  class vtkInternals;
+  vtkInternals* Internals;
   ///@{
   /**
    * Adds a field array called "vtkBlockColors". The array is
@@ -47,6 +47,7 @@
 #include "vtkMinimalStandardRandomSequence.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkUnsignedIntArray.h"
 
 #include <algorithm>
@@ -61,6 +62,13 @@
 #include <string>
 using std::ostringstream;
 
+namespace
+{
+// Name of the temporary column holding the global rank of each row in the
+// subset tables exchanged when extracting a block.
+const char* const GLOBAL_RANK_ARRAY_NAME = "__vtkSortedTableStreamerRank__";
+}
+
 //****************************************************************************
 class vtkSortedTableStreamer::InternalsBase
 {
@@ -430,6 +438,7 @@ public:
     {
       this->Array = nullptr;
       this->Histo = nullptr;
+      this->ArraySize = 0;
     }
 
     ~ArraySorter() { this->Clear(); }
@@ -446,6 +455,7 @@ public:
         delete this->Histo;
         this->Histo = nullptr;
       }
+      this->ArraySize = 0;
     }
     void FillArray(vtkIdType numTuples)
     {
@@ -552,11 +562,44 @@ public:
     }
   };
 
+  // Key identifying a value uniquely across all processes. Ties between equal
+  // values are broken using the process id and the position in the locally
+  // sorted array, which keeps the global order consistent with the local one.
+  struct SortKey
+  {
+    T Value;
+    int ProcessId;
+    vtkIdType Position;
+  };
+
+  class SortKeyCompare
+  {
+  public:
+    bool Inverted;
+
+    SortKeyCompare(bool inverted)
+      : Inverted(inverted)
+    {
+    }
+
+    bool operator()(const SortKey& a, const SortKey& b) const
+    {
+      if (a.Value != b.Value)
+      {
+        return this->Inverted ? a.Value > b.Value : a.Value < b.Value;
+      }
+      if (a.ProcessId != b.ProcessId)
+      {
+        return a.ProcessId < b.ProcessId;
+      }
+      return a.Position < b.Position;
+    }
+  };
+
   Internals()
   {
     // Only used for testing
     this->LocalSorter = nullptr;
-    this->GlobalHistogram = nullptr;
     this->Debug = false;
   }
 
@@ -581,14 +624,9 @@ public:
 
     // Create internal objects
     this->LocalSorter = new ArraySorter();
-    this->GlobalHistogram = new Histogram(HISTOGRAM_SIZE);
   }
 
-  ~Internals() override
-  {
-    delete this->LocalSorter;
-    delete this->GlobalHistogram;
-  }
+  ~Internals() override { delete this->LocalSorter; }
 
   // --------------------------------------------------------------------------
   bool IsSortable() override
@@ -662,9 +700,7 @@ public:
   {
     // We are building the cache so no need to build it next time
     this->NeedToBuildCache = false;
-
-    // Communication buffer
-    vtkIdType* bufferHistogramValues = new vtkIdType[this->NumProcs * HISTOGRAM_SIZE];
+    this->GlobalRanks.clear();
 
     // Is there something to sort ???
     if (!sortableArray)
@@ -674,45 +710,263 @@ public:
       {
         this->LocalSorter->FillArray(this->DataToSort->GetNumberOfTuples());
       }
+      return 1;
+    }
+
+    if (this->DataToSort)
+    {
+      this->LocalSorter->Update(static_cast<T*>(this->DataToSort->GetVoidPointer(0)),
+        this->DataToSort->GetNumberOfTuples(), this->DataToSort->GetNumberOfComponents(),
+        this->SelectedComponent, HISTOGRAM_SIZE, this->CommonRange, invertOrder);
     }
     else
     {
-      if (this->DataToSort)
+      this->LocalSorter->Clear();
+    }
+
+    this->BuildGlobalRanks(invertOrder);
+    return 1;
+  }
+
+  // --------------------------------------------------------------------------
+  // Parallel sample sort of the keys of all processes. On return,
+  // `GlobalRanks[i]` is the index, in the globally sorted table, of the row
+  // referred to by `LocalSorter->Array[i]`. Since the local array is sorted,
+  // `GlobalRanks` is sorted as well and the rows of any block can be located
+  // locally, with a binary search.
+  //
+  // Only keys are exchanged, never rows:
+  //  1. every process picks regularly spaced samples from its sorted keys,
+  //  2. samples are gathered everywhere and NumProcs-1 splitters are chosen,
+  //  3. keys are sent to the process owning their bucket (all-to-all),
+  //  4. each process sorts its bucket, deduces the ranks and sends them back.
+  void BuildGlobalRanks(bool invertOrder)
+  {
+    const vtkIdType numLocal = this->LocalSorter->ArraySize;
+    this->GlobalRanks.resize(numLocal);
+    if (this->NumProcs == 1)
+    {
+      std::iota(this->GlobalRanks.begin(), this->GlobalRanks.end(), 0);
+      return;
+    }
+
+    const SortKeyCompare compare(invertOrder);
+    std::vector<SortKey> localKeys(numLocal);
+    for (vtkIdType idx = 0; idx < numLocal; ++idx)
+    {
+      localKeys[idx] = SortKey{ this->LocalSorter->Array[idx].Value, this->Me, idx };
+    }
+
+    // ------------------------------------------------------------------------
+    // Regular sampling and splitter selection
+    // ------------------------------------------------------------------------
+    const vtkIdType numSamples =
+      std::min(numLocal, std::max<vtkIdType>(this->NumProcs, MIN_SAMPLES_PER_PROCESS));
+    std::vector<T> sampleValues(numSamples + 1);
+    std::vector<vtkIdType> samplePositions(numSamples + 1);
+    for (vtkIdType idx = 0; idx < numSamples; ++idx)
+    {
+      samplePositions[idx] = ((2 * idx + 1) * numLocal) / (2 * numSamples);
+      sampleValues[idx] = localKeys[samplePositions[idx]].Value;
+    }
+
+    std::vector<vtkIdType> sampleCounts(this->NumProcs);
+    std::vector<vtkIdType> sampleOffsets(this->NumProcs, 0);
+    this->MPI->AllGather(&numSamples, sampleCounts.data(), 1);
+    std::partial_sum(sampleCounts.begin(), sampleCounts.end() - 1, sampleOffsets.begin() + 1);
+    const vtkIdType totalSamples = sampleOffsets.back() + sampleCounts.back();
+
+    std::vector<T> allSampleValues(totalSamples + 1);
+    std::vector<vtkIdType> allSamplePositions(totalSamples + 1);
+    this->MPI->AllGatherV(sampleValues.data(), allSampleValues.data(), numSamples,
+      sampleCounts.data(), sampleOffsets.data());
+    this->MPI->AllGatherV(samplePositions.data(), allSamplePositions.data(), numSamples,
+      sampleCounts.data(), sampleOffsets.data());
+
+    std::vector<SortKey> samples;
+    samples.reserve(totalSamples);
+    for (int pid = 0; pid < this->NumProcs; ++pid)
+    {
+      for (vtkIdType idx = sampleOffsets[pid], max = idx + sampleCounts[pid]; idx < max; ++idx)
       {
-        // Sort and build local histogram
-        this->LocalSorter->Update(static_cast<T*>(this->DataToSort->GetVoidPointer(0)),
-          this->DataToSort->GetNumberOfTuples(), this->DataToSort->GetNumberOfComponents(),
-          this->SelectedComponent, HISTOGRAM_SIZE, this->CommonRange, invertOrder);
+        samples.push_back(SortKey{ allSampleValues[idx], pid, allSamplePositions[idx] });
       }
-      else
+    }
+    std::sort(samples.begin(), samples.end(), compare);
+
+    // bucket `pid` holds the local keys in [bucketStart[pid], bucketStart[pid + 1]).
+    std::vector<vtkIdType> bucketStart(this->NumProcs + 1, 0);
+    bucketStart[this->NumProcs] = numLocal;
+    for (int pid = 1; pid < this->NumProcs; ++pid)
+    {
+      if (totalSamples > 0)
+      {
+        const SortKey& splitter = samples[(pid * totalSamples) / this->NumProcs];
+        bucketStart[pid] = static_cast<vtkIdType>(
+          std::upper_bound(localKeys.begin(), localKeys.end(), splitter, compare) -
+          localKeys.begin());
+      }
+    }
+
+    // ------------------------------------------------------------------------
+    // Send keys to the process owning their bucket
+    // ------------------------------------------------------------------------
+    std::vector<SortKey> bucket;
+    std::vector<vtkIdType> receivedCounts(this->NumProcs, 0);
+    std::vector<vtkIdType> receivedFirstPosition(this->NumProcs, 0);
+    auto appendToBucket = [&](int pid, const T* values, const vtkIdType* positions,
+                            vtkIdType count) {
+      receivedCounts[pid] = count;
+      receivedFirstPosition[pid] = count > 0 ? positions[0] : 0;
+      for (vtkIdType idx = 0; idx < count; ++idx)
       {
-        // Build empty local histogram
-        this->LocalSorter->Clear();
-        this->LocalSorter->Histo = new Histogram(HISTOGRAM_SIZE);
-        this->LocalSorter->Histo->SetScalarRange(this->CommonRange);
-        this->LocalSorter->Histo->Inverted = invertOrder;
+        bucket.push_back(SortKey{ values[idx], pid, positions[idx] });
       }
+    };
 
-      // Initialize the global histogram with same range
-      this->LocalSorter->Histo->CopyRangeTo(*this->GlobalHistogram);
+    {
+      const vtkIdType begin = bucketStart[this->Me];
+      std::vector<T> values(bucketStart[this->Me + 1] - begin);
+      std::vector<vtkIdType> positions(values.size());
+      for (size_t idx = 0; idx < values.size(); ++idx)
+      {
+        values[idx] = localKeys[begin + idx].Value;
+        positions[idx] = begin + static_cast<vtkIdType>(idx);
+      }
+      appendToBucket(
+        this->Me, values.data(), positions.data(), static_cast<vtkIdType>(values.size()));
+    }
 
-      // Make sure that the global histogram is properly initialized
-      this->GlobalHistogram->ClearHistogramValues();
-      this->GlobalHistogram->Inverted = invertOrder;
+    this->PairwiseExchange([&](int partner) {
+      const vtkIdType begin = bucketStart[partner];
+      const vtkIdType sendCount = bucketStart[partner + 1] - begin;
+      std::vector<T> sendValues(sendCount + 1);
+      std::vector<vtkIdType> sendPositions(sendCount + 1);
+      for (vtkIdType idx = 0; idx < sendCount; ++idx)
+      {
+        sendValues[idx] = localKeys[begin + idx].Value;
+        sendPositions[idx] = begin + idx;
+      }
 
-      // Send local histogram and receive every histogram from everybody
-      this->MPI->AllGather(this->LocalSorter->Histo->Values, bufferHistogramValues, HISTOGRAM_SIZE);
+      auto send = [&]() {
+        this->MPI->Send(&sendCount, 1, partner, VTK_KEY_EXCHANGE_TAG);
+        if (sendCount > 0)
+        {
+          this->MPI->Send(sendValues.data(), sendCount, partner, VTK_KEY_EXCHANGE_TAG);
+          this->MPI->Send(sendPositions.data(), sendCount, partner, VTK_KEY_EXCHANGE_TAG);
+        }
+      };
+      auto receive = [&]() {
+        vtkIdType recvCount = 0;
+        this->MPI->Receive(&recvCount, 1, partner, VTK_KEY_EXCHANGE_TAG);
+        std::vector<T> recvValues(recvCount + 1);
+        std::vector<vtkIdType> recvPositions(recvCount + 1);
+        if (recvCount > 0)
+        {
+          this->MPI->Receive(recvValues.data(), recvCount, partner, VTK_KEY_EXCHANGE_TAG);
+          this->MPI->Receive(recvPositions.data(), recvCount, partner, VTK_KEY_EXCHANGE_TAG);
+        }
+        appendToBucket(partner, recvValues.data(), recvPositions.data(), recvCount);
+      };
 
-      // Merge all histogram into the GlobalHistogram
-      for (int idx = 0, nb = this->NumProcs * HISTOGRAM_SIZE; idx < nb; ++idx)
+      if (this->Me < partner)
       {
-        this->GlobalHistogram->TotalValues += bufferHistogramValues[idx];
-        this->GlobalHistogram->Values[idx % HISTOGRAM_SIZE] += bufferHistogramValues[idx];
+        send();
+        receive();
       }
+      else
+      {
+        receive();
+        send();
+      }
+    });
+
+    // ------------------------------------------------------------------------
+    // Sort the bucket and send the ranks back to the owners of the keys
+    // ------------------------------------------------------------------------
+    std::sort(bucket.begin(), bucket.end(), compare);
+
+    const vtkIdType bucketSize = static_cast<vtkIdType>(bucket.size());
+    std::vector<vtkIdType> bucketSizes(this->NumProcs);
+    this->MPI->AllGather(&bucketSize, bucketSizes.data(), 1);
+    const vtkIdType rankOffset =
+      std::accumulate(bucketSizes.begin(), bucketSizes.begin() + this->Me, vtkIdType(0));
+
+    std::vector<std::vector<vtkIdType>> ranks(this->NumProcs);
+    for (int pid = 0; pid < this->NumProcs; ++pid)
+    {
+      ranks[pid].resize(receivedCounts[pid] + 1);
+    }
+    for (vtkIdType idx = 0; idx < bucketSize; ++idx)
+    {
+      const SortKey& key = bucket[idx];
+      ranks[key.ProcessId][key.Position - receivedFirstPosition[key.ProcessId]] = rankOffset + idx;
     }
 
-    delete[] bufferHistogramValues;
-    return 1;
+    std::copy(ranks[this->Me].begin(), ranks[this->Me].begin() + receivedCounts[this->Me],
+      this->GlobalRanks.begin() + bucketStart[this->Me]);
+
+    this->PairwiseExchange([&](int partner) {
+      const vtkIdType recvCount = bucketStart[partner + 1] - bucketStart[partner];
+      auto send = [&]() {
+        if (receivedCounts[partner] > 0)
+        {
+          this->MPI->Send(
+            ranks[partner].data(), receivedCounts[partner], partner, VTK_KEY_EXCHANGE_TAG);
+        }
+      };
+      auto receive = [&]() {
+        if (recvCount > 0)
+        {
+          this->MPI->Receive(this->GlobalRanks.data() + bucketStart[partner], recvCount, partner,
+            VTK_KEY_EXCHANGE_TAG);
+        }
+      };
+
+      if (this->Me < partner)
+      {
+        send();
+        receive();
+      }
+      else
+      {
+        receive();
+        send();
+      }
+    });
+  }
+
+  // --------------------------------------------------------------------------
+  // Calls `exchange(partner)` for every other process, following a round-robin
+  // schedule: in each round, every process is paired with at most one other
+  // process, which both do their blocking sends and receives in opposite
+  // order. This avoids deadlocks without relying on non-blocking
+  // communication, which vtkCommunicator doesn't provide.
+  template <typename Functor>
+  void PairwiseExchange(Functor&& exchange)
+  {
+    // add a virtual process when the number of processes is odd.
+    const int numSlots = this->NumProcs + (this->NumProcs % 2);
+    for (int round = 0; round < numSlots - 1; ++round)
+    {
+      int partner;
+      if (this->Me == numSlots - 1)
+      {
+        partner = round;
+      }
+      else
+      {
+        partner = ((2 * round - this->Me) % (numSlots - 1) + (numSlots - 1)) % (numSlots - 1);
+        if (partner == this->Me)
+        {
+          partner = numSlots - 1;
+        }
+      }
+      if (partner < this->NumProcs)
+      {
+        exchange(partner);
+      }
+    }
   }
 
   // --------------------------------------------------------------------------
@@ -855,7 +1109,7 @@ public:
   {
     // ------------------------------------------------------------------------
     // Make sure that the Cache is built
-    //    This will sort the local array, that's why we don't want to do it
+    //    This sorts the data globally, that's why we don't want to do it
     //    at each execution. Specially when we only change the requested block.
     // ------------------------------------------------------------------------
     if (this->NeedToBuildCache)
@@ -864,29 +1118,14 @@ public:
     }
 
     // ------------------------------------------------------------------------
-    // Search for lower bound
-    // ------------------------------------------------------------------------
-    vtkIdType nbElementsToRemoveFromHead = 0;
-    vtkIdType localOffset = 0;
-    vtkIdType nbElementsInBar = 0;
-    this->SearchGlobalIndexLocation((block * blockSize), this->LocalSorter->Histo,
-      this->GlobalHistogram, nbElementsToRemoveFromHead, localOffset, nbElementsInBar);
-
-    // ------------------------------------------------------------------------
-    // Search for upper bound
+    // Locate the local rows that belong to the requested block
     // ------------------------------------------------------------------------
-    vtkIdType upperOffset = 0;
-    vtkIdType globalUpperOffset = 0;
-    vtkIdType searchIdx = (this->GlobalHistogram->TotalValues < (block + 1) * blockSize)
-      ? this->GlobalHistogram->TotalValues
-      : ((block + 1) * blockSize);
-    searchIdx--; // It is not a size it is an index (so -1)
-
-    this->SearchGlobalIndexLocation(searchIdx, this->LocalSorter->Histo, this->GlobalHistogram,
-      globalUpperOffset, upperOffset, nbElementsInBar);
-
-    // We have to include our searched index (so +1)
-    vtkIdType localSize = (upperOffset + nbElementsInBar) - localOffset + 1;
+    const vtkIdType lowerRank = block * blockSize;
+    const vtkIdType upperRank = lowerRank + blockSize;
+    auto begin = std::lower_bound(this->GlobalRanks.begin(), this->GlobalRanks.end(), lowerRank);
+    auto end = std::lower_bound(begin, this->GlobalRanks.end(), upperRank);
+    const vtkIdType localOffset = static_cast<vtkIdType>(begin - this->GlobalRanks.begin());
+    const vtkIdType localSize = static_cast<vtkIdType>(end - begin);
 
     // ------------------------------------------------------------------------
     // Build local subset table
@@ -895,6 +1134,12 @@ public:
     localSubset.TakeReference(
       this->NewSubsetTable(input, this->LocalSorter, localOffset, localSize));
 
+    vtkNew<vtkIdTypeArray> ranks;
+    ranks->SetName(GLOBAL_RANK_ARRAY_NAME);
+    ranks->SetNumberOfTuples(localSize);
+    std::copy(begin, end, ranks->GetPointer(0));
+    localSubset->GetRowData()->AddArray(ranks);
+
     // ------------------------------------------------------------------------
     // Find the process that will merge all subset table
     // ------------------------------------------------------------------------
@@ -908,7 +1153,7 @@ public:
       vtkSmartPointer<vtkIdTypeArray> processIdArray = vtkSmartPointer<vtkIdTypeArray>::New();
       processIdArray->SetName("vtkOriginalProcessIds");
       processIdArray->SetNumberOfComponents(1);
-      processIdArray->Allocate((blockSize < localSize) ? localSize : blockSize);
+      processIdArray->Allocate(blockSize);
       for (vtkIdType idx = 0; idx < localSubset->GetNumberOfRows(); idx++)
       {
         processIdArray->InsertNextTuple1(mergePid);
@@ -939,29 +1184,8 @@ public:
         this->MergeTable(i, tmp.GetPointer(), localSubset.GetPointer(), blockSize);
       }
 
-      // Sort new table/array
-      if (!this->DataToSort)
-      {
-        // This mean that no output can be provided
-        // cout << "ERROR the merge process have no DataArray." << endl;
-        return 1;
-      }
-      vtkDataArray* subsetArray =
-        vtkDataArray::SafeDownCast(localSubset->GetColumnByName(this->DataToSort->GetName()));
-
-      if (!subsetArray)
-      {
-        vtkSortedTableStreamer::PrintInfo(localSubset.GetPointer());
-      }
-
-      ArraySorter sorter;
-      sorter.Update(static_cast<T*>(subsetArray->GetVoidPointer(0)),
-        subsetArray->GetNumberOfTuples(), subsetArray->GetNumberOfComponents(),
-        this->SelectedComponent, HISTOGRAM_SIZE, this->CommonRange, revertOrder);
-
-      // trim it (remove head and tail that don't belong to the result)
-      localSubset.TakeReference(this->NewSubsetTable(
-        localSubset.GetPointer(), &sorter, nbElementsToRemoveFromHead, blockSize));
+      // Rows are placed using their global rank, no need to sort again.
+      localSubset.TakeReference(this->NewTableOrderedByRank(localSubset.GetPointer()));
 
       // Add extra information such as structured indices, block number...
       this->DecorateTable(input, localSubset.GetPointer(), mergePid);
@@ -979,70 +1203,47 @@ public:
   }
 
   // --------------------------------------------------------------------------
-  // nbGlobalToSkip is the number of elements that should be skipped at the end
-  // if you exactly want to reach the searchedGlobalIndex.
-  // localOffset is the corresponding local index in the sorted table to the
-  // global index of (searchedGlobalIndex - nbGlobalToSkip)
-  // nbInLocalBar is the local number of elements that are available
-  // in the histogram bar where the searchedGlobalIndex has been found.
-  // nbInLocalBar is used when you want to get an upper bound that
-  // will include the searchedGlobalIndex.
-  void SearchGlobalIndexLocation(vtkIdType searchedGlobalIndex, Histogram* localHistogram,
-    Histogram* globalHistogram, vtkIdType& nbGlobalToSkip, vtkIdType& localOffset,
-    vtkIdType& nbInLocalBar)
+  // Returns a new table with the rows of `srcTable` ordered by the global rank
+  // column, which is not copied.
+  static vtkTable* NewTableOrderedByRank(vtkTable* srcTable)
   {
-    // Communication buffer
-    vtkIdType* bufferHistogramValues = new vtkIdType[this->NumProcs * HISTOGRAM_SIZE];
-
-    // Local internal working var
-    vtkIdType histogramBarIdx = -1;
-    double currentRange[2];
-    vtkIdType idx, idxEnd;
-
-    // Setup initial histogram range and values
-    Histogram _globalHistogram;
-    Histogram _localHistogram;
-    localHistogram->CopyTo(_localHistogram);
-    globalHistogram->CopyTo(_globalHistogram);
-
-    // Reset local offsets
-    localOffset = 0;
-    nbGlobalToSkip = searchedGlobalIndex;
-
-    do
+    auto rankArray =
+      vtkIdTypeArray::SafeDownCast(srcTable->GetColumnByName(GLOBAL_RANK_ARRAY_NAME));
+    const vtkIdType numRows = srcTable->GetNumberOfRows();
+    std::vector<vtkIdType> order(numRows);
+    std::iota(order.begin(), order.end(), 0);
+    if (rankArray)
     {
-      nbGlobalToSkip -= _globalHistogram.GetNewRange(nbGlobalToSkip, histogramBarIdx, currentRange);
-
-      localOffset += _localHistogram.GetNumberOfElements(0, histogramBarIdx);
-      nbInLocalBar = _localHistogram.GetNumberOfElements(histogramBarIdx, histogramBarIdx + 1);
-
-      // Based on a narrowed range, build local histogram to get closer to the
-      // real index of the object
-      _localHistogram.SetScalarRange(currentRange);
-      _localHistogram.ClearHistogramValues();
+      std::sort(order.begin(), order.end(), [rankArray](vtkIdType a, vtkIdType b) {
+        return rankArray->GetValue(a) < rankArray->GetValue(b);
+      });
+    }
 
-      idxEnd = localOffset + nbInLocalBar;
-      for (idx = localOffset; idx < idxEnd; ++idx)
+    vtkTable* subTable = vtkTable::New();
+    for (vtkIdType colIdx = 0; colIdx < srcTable->GetNumberOfColumns(); ++colIdx)
+    {
+      vtkAbstractArray* srcArray = srcTable->GetColumn(colIdx);
+      if (srcArray == rankArray)
       {
-        _localHistogram.AddValue(this->LocalSorter->Array[idx].Value);
+        continue;
       }
 
-      // Exchange local histo with everyone
-      this->MPI->AllGather(_localHistogram.Values, bufferHistogramValues, HISTOGRAM_SIZE);
-
-      // Build global histogram
-      _globalHistogram.SetScalarRange(currentRange);
-      _globalHistogram.ClearHistogramValues();
-
-      idxEnd = this->NumProcs * HISTOGRAM_SIZE;
-      for (idx = 0; idx < idxEnd; ++idx)
+      vtkAbstractArray* subArray = srcArray->NewInstance();
+      subArray->SetNumberOfComponents(srcArray->GetNumberOfComponents());
+      subArray->SetName(srcArray->GetName());
+      subArray->SetNumberOfTuples(numRows);
+      if (auto sinfo = srcArray->GetInformation())
       {
-        _globalHistogram.TotalValues += bufferHistogramValues[idx];
-        _globalHistogram.Values[idx % HISTOGRAM_SIZE] += bufferHistogramValues[idx];
+        subArray->CopyInformation(sinfo);
       }
-    } while (nbGlobalToSkip > 0 && _globalHistogram.CanBeReduced());
-
-    delete[] bufferHistogramValues;
+      for (vtkIdType idx = 0; idx < numRows; ++idx)
+      {
+        subArray->SetTuple(idx, order[idx], srcArray);
+      }
+      subTable->GetRowData()->AddArray(subArray);
+      subArray->FastDelete();
+    }
+    return subTable;
   }
 
   // --------------------------------------------------------------------------
@@ -1320,8 +1521,8 @@ private:
   vtkMTimeType DataMTime;     // Keep the original data MTime
   vtkDataArray* DataToSort;   // DataArray to sort
   ArraySorter* LocalSorter;   // Local ArraySorter based on global range
-  Histogram* GlobalHistogram; // Globaly merged Histogram based on global range
   double CommonRange[2];      // Scalar range used across processes
+  std::vector<vtkIdType> GlobalRanks; // Global rank of each LocalSorter item
   int Me;                     // Current process ID
   int NumProcs;               // Number of processes involved
   vtkCommunicator* MPI;       // MPI communicator to send/receive/gather
@@ -1330,6 +1531,10 @@ private:
   bool Debug;
 
   const static int VTK_TABLE_EXCHANGE_TAG = 50;
+  const static int VTK_KEY_EXCHANGE_TAG = 51;
+  // Minimum number of keys sampled on each process to choose the splitters of
+  // the sample sort. More samples give better balanced buckets.
+  const static int MIN_SAMPLES_PER_PROCESS = 64;
   // HISTOGRAM_SIZE could be computed dynamically based on the type of the
   // array to sort but to make sure that unsigned char won't be distributed
   // correctly we set the histogram size to be their max number of element
@@ -20,6 +20,12 @@
  * This filter is used quickly get a sorted subset of a given vtkTable.
  * By sorted we mean a subset build from a global sort even if some optimisation
  * allow us to skip a global table sorting.
+ *
+ * In parallel, the first request after the data, the column to sort or the
+ * order changes runs a distributed sample sort of the sort keys (rows are not
+ * moved) which gives every process the global rank of each of its rows. Any
+ * block can then be extracted with a single gather of the matching rows on
+ * one process.
  */
 
 #ifndef vtkSortedTableStreamer_h
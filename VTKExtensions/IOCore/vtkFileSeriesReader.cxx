@@ -34,6 +34,8 @@
 #include "vtkInformationVector.h"
 #include "vtkLogger.h"
 #include "vtkMath.h"
+#include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
@@ -46,10 +48,21 @@
 #define VTK_CREATE(type, name) vtkSmartPointer<type> name = vtkSmartPointer<type>::New()
 
 #include <algorithm>
+#include <atomic>
 #include <cctype> // for isprint().
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <tuple>
 #include <vector>
 
 #include "vtk_jsoncpp.h"
@@ -59,6 +72,7 @@ vtkStandardNewMacro(vtkFileSeriesReader);
 vtkInformationKeyMacro(vtkFileSeriesReader, FILE_SERIES_NUMBER_OF_FILES, Integer);
 vtkInformationKeyMacro(vtkFileSeriesReader, FILE_SERIES_CURRENT_FILE_NUMBER, Integer);
 vtkInformationKeyMacro(vtkFileSeriesReader, FILE_SERIES_FIRST_FILENAME, String);
+vtkCxxSetObjectMacro(vtkFileSeriesReader, Controller, vtkMultiProcessController);
 //=============================================================================
 // Internal class for holding time ranges.
 class vtkFileSeriesReaderTimeRanges
@@ -378,6 +392,264 @@ public:
 private:
   void operator=(const vtkRecordMTime&);
 };
+
+//-----------------------------------------------------------------------------
+// The time information reported for a file is packed as
+// `[numberOfTimeSteps, hasTimeRange, timeRange[0], timeRange[1], timeSteps...]`
+// so that it can be exchanged between ranks and saved to the metadata cache.
+void PackTimeInformation(vtkInformation* info, std::vector<double>& buffer)
+{
+  const int numTimeSteps = info->Has(vtkStreamingDemandDrivenPipeline::TIME_STEPS())
+    ? info->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS())
+    : 0;
+  const bool hasTimeRange = info->Has(vtkStreamingDemandDrivenPipeline::TIME_RANGE()) != 0;
+  const double* timeRange =
+    hasTimeRange ? info->Get(vtkStreamingDemandDrivenPipeline::TIME_RANGE()) : nullptr;
+  buffer.push_back(numTimeSteps);
+  buffer.push_back(hasTimeRange ? 1.0 : 0.0);
+  buffer.push_back(timeRange ? timeRange[0] : 0.0);
+  buffer.push_back(timeRange ? timeRange[1] : 0.0);
+  if (numTimeSteps > 0)
+  {
+    const double* timeSteps = info->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+    buffer.insert(buffer.end(), timeSteps, timeSteps + numTimeSteps);
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Returns the size of the packed time information starting at `pos` or 0 if
+// `buffer` is too short to hold it.
+size_t GetPackedTimeInformationSize(const std::vector<double>& buffer, size_t pos)
+{
+  if (pos + 4 > buffer.size() || buffer[pos] < 0)
+  {
+    return 0;
+  }
+  const size_t size = 4 + static_cast<size_t>(buffer[pos]);
+  return pos + size <= buffer.size() ? size : 0;
+}
+
+//-----------------------------------------------------------------------------
+// Returns the number of files whose time information `buffer` holds, or -1 if
+// it does not end with complete time information.
+int GetNumberOfPackedTimeInformation(const std::vector<double>& buffer)
+{
+  int count = 0;
+  for (size_t pos = 0; pos < buffer.size(); ++count)
+  {
+    const size_t size = GetPackedTimeInformationSize(buffer, pos);
+    if (size == 0)
+    {
+      return -1;
+    }
+    pos += size;
+  }
+  return count;
+}
+
+//-----------------------------------------------------------------------------
+// Unpacks the time information starting at `pos` into `info` and returns the
+// position of the next file's time information.
+size_t UnpackTimeInformation(const std::vector<double>& buffer, size_t pos, vtkInformation* info)
+{
+  const int numTimeSteps = static_cast<int>(buffer[pos]);
+  if (buffer[pos + 1] != 0.0)
+  {
+    info->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), &buffer[pos + 2], 2);
+  }
+  if (numTimeSteps > 0)
+  {
+    info->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), &buffer[pos + 4], numTimeSteps);
+  }
+  return pos + 4 + numTimeSteps;
+}
+}
+
+//=============================================================================
+// Internal class reading files on a background thread so that they are in the
+// operating system's file cache when the internal reader opens them.
+class vtkFileSeriesReaderReadAhead
+{
+public:
+  ~vtkFileSeriesReaderReadAhead() { this->Stop(); }
+
+  /**
+   * Replaces the files pending read-ahead with `fileNames`. Only the part
+   * `piece` out of `numberOfPieces` equal parts of each file is read.
+   */
+  void Schedule(const std::vector<std::string>& fileNames, int piece, int numberOfPieces);
+
+  /**
+   * Returns true if the part `piece` out of `numberOfPieces` of `fileName` has
+   * been read ahead completely.
+   */
+  bool IsReady(const std::string& fileName, int piece, int numberOfPieces);
+
+  /**
+   * Cancels any pending read-ahead and terminates the thread.
+   */
+  void Stop();
+
+private:
+  // A file to read ahead, with the part of it to read.
+  struct Request
+  {
+    std::string FileName;
+    int Piece;
+    int NumberOfPieces;
+
+    bool operator<(const Request& other) const
+    {
+      return std::tie(this->FileName, this->Piece, this->NumberOfPieces) <
+        std::tie(other.FileName, other.Piece, other.NumberOfPieces);
+    }
+    bool operator==(const Request& other) const
+    {
+      return this->FileName == other.FileName && this->Piece == other.Piece &&
+        this->NumberOfPieces == other.NumberOfPieces;
+    }
+  };
+
+  void Run();
+  bool ReadPiece(const Request& request);
+
+  static constexpr std::size_t CHUNK_SIZE = 1 << 20;
+
+  std::thread Thread;
+  std::mutex Mutex;
+  std::condition_variable Condition;
+  std::deque<Request> Pending;
+  std::set<Request> Ready;
+  Request Current{ std::string(), 0, 1 };
+  std::atomic<bool> CancelCurrent{ false };
+  bool Terminate = false;
+};
+
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReaderReadAhead::Schedule(
+  const std::vector<std::string>& fileNames, int piece, int numberOfPieces)
+{
+  std::unique_lock<std::mutex> lock(this->Mutex);
+  this->Pending.clear();
+
+  // Forget about files, or parts of files, that are no longer wanted, keeping
+  // the cache bounded.
+  std::set<Request> ready;
+  for (const auto& fileName : fileNames)
+  {
+    const Request request{ fileName, piece, numberOfPieces };
+    if (this->Ready.find(request) != this->Ready.end())
+    {
+      ready.insert(request);
+    }
+    else if (!(request == this->Current))
+    {
+      this->Pending.push_back(request);
+    }
+  }
+  this->Ready.swap(ready);
+  if (!this->Current.FileName.empty() &&
+    (this->Current.Piece != piece || this->Current.NumberOfPieces != numberOfPieces ||
+      std::find(fileNames.begin(), fileNames.end(), this->Current.FileName) == fileNames.end()))
+  {
+    this->CancelCurrent = true;
+  }
+
+  if (!this->Thread.joinable())
+  {
+    this->Terminate = false;
+    this->Thread = std::thread(&vtkFileSeriesReaderReadAhead::Run, this);
+  }
+  lock.unlock();
+  this->Condition.notify_one();
+}
+
+//-----------------------------------------------------------------------------
+bool vtkFileSeriesReaderReadAhead::IsReady(
+  const std::string& fileName, int piece, int numberOfPieces)
+{
+  std::lock_guard<std::mutex> lock(this->Mutex);
+  return this->Ready.find(Request{ fileName, piece, numberOfPieces }) != this->Ready.end();
+}
+
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReaderReadAhead::Stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->Terminate = true;
+    this->CancelCurrent = true;
+    this->Pending.clear();
+    this->Ready.clear();
+  }
+  this->Condition.notify_one();
+  if (this->Thread.joinable())
+  {
+    this->Thread.join();
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReaderReadAhead::Run()
+{
+  std::unique_lock<std::mutex> lock(this->Mutex);
+  while (true)
+  {
+    this->Condition.wait(lock, [this]() { return this->Terminate || !this->Pending.empty(); });
+    if (this->Terminate)
+    {
+      return;
+    }
+
+    const Request request = this->Pending.front();
+    this->Pending.pop_front();
+    this->Current = request;
+    this->CancelCurrent = false;
+
+    lock.unlock();
+    const bool done = this->ReadPiece(request);
+    lock.lock();
+
+    this->Current.FileName.clear();
+    if (done && !this->CancelCurrent)
+    {
+      this->Ready.insert(request);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+bool vtkFileSeriesReaderReadAhead::ReadPiece(const Request& request)
+{
+  vtksys::ifstream file(request.FileName.c_str(), std::ios::in | std::ios::binary);
+  if (!file)
+  {
+    return false;
+  }
+
+  const unsigned long length = vtksys::SystemTools::FileLength(request.FileName);
+  const unsigned long pieceLength = length / request.NumberOfPieces;
+  const unsigned long begin = pieceLength * request.Piece;
+  const unsigned long end =
+    request.Piece == request.NumberOfPieces - 1 ? length : begin + pieceLength;
+  if (begin > 0)
+  {
+    file.seekg(static_cast<std::streamoff>(begin));
+  }
+
+  std::vector<char> buffer(std::min(end - begin, static_cast<unsigned long>(CHUNK_SIZE)));
+  unsigned long remaining = end - begin;
+  while (remaining > 0 && !this->CancelCurrent)
+  {
+    const std::streamsize count =
+      static_cast<std::streamsize>(std::min<unsigned long>(remaining, buffer.size()));
+    if (!file.read(buffer.data(), count))
+    {
+      return false;
+    }
+    remaining -= static_cast<unsigned long>(count);
+  }
+  return remaining == 0;
 }
 
 //=============================================================================
@@ -388,6 +660,9 @@ struct vtkFileSeriesReaderInternals
   std::vector<double> TimeValues;
   bool FileNameIsSet;
   vtkFileSeriesReaderTimeRanges* TimeRanges;
+  std::unique_ptr<vtkFileSeriesReaderReadAhead> ReadAhead;
+  int LastReadIndex = -1;
+  int ReadDirection = 1;
 };
 
 //=============================================================================
@@ -404,11 +679,33 @@ vtkFileSeriesReader::vtkFileSeriesReader()
   this->UseJsonMetaFile = false;
 
   this->IgnoreReaderTime = false;
+
+  const char* cacheDir = vtksys::SystemTools::GetEnv("PV_FILE_SERIES_CACHE_DIR");
+  this->UseMetaDataCache = cacheDir != nullptr;
+  this->MetaDataCacheDirectory = nullptr;
+  this->SetMetaDataCacheDirectory(cacheDir && *cacheDir ? cacheDir : nullptr);
+
+  const char* parallelProbe = vtksys::SystemTools::GetEnv("PV_FILE_SERIES_PARALLEL_PROBE");
+  this->ProbeFilesInParallel = parallelProbe && *parallelProbe && strcmp(parallelProbe, "0") != 0;
+
+  this->Controller = nullptr;
+  this->SetController(vtkMultiProcessController::GetGlobalController());
+
+  const char* readAhead = vtksys::SystemTools::GetEnv("PV_FILE_SERIES_READ_AHEAD");
+  const int readAheadSize = readAhead ? std::atoi(readAhead) : 0;
+  this->ReadAhead = readAhead != nullptr;
+  this->ReadAheadBufferSize = readAheadSize > 0 ? readAheadSize : 256;
+  this->NumberOfReadAheadHits = 0;
+  this->NumberOfReadAheadMisses = 0;
 }
 
 //-----------------------------------------------------------------------------
 vtkFileSeriesReader::~vtkFileSeriesReader()
 {
+  // stop the read-ahead thread before anything else is released.
+  this->Internal->ReadAhead.reset();
+  this->SetController(nullptr);
+  this->SetMetaDataCacheDirectory(nullptr);
   delete this->Internal->TimeRanges;
   delete this->Internal;
 }
@@ -650,13 +947,9 @@ int vtkFileSeriesReader::RequestInformation(vtkInformation* request,
     this->Internal->TimeRanges->AddTimeRange(0, outInfo);
 
     // Query all the other files for time info.
-    for (unsigned int i = 1; i < numFiles; i++)
+    if (numFiles > 1)
     {
-      // Expose current file number as information key for potential use in the internal reader
-      outputVector->GetInformationObject(requestFromPort)
-        ->Set(FILE_SERIES_CURRENT_FILE_NUMBER(), static_cast<int>(i));
-      this->RequestInformationForInput(static_cast<int>(i), request, outputVector);
-      this->Internal->TimeRanges->AddTimeRange(static_cast<int>(i), outInfo);
+      this->CollectTimeInformation(request, outputVector, requestFromPort);
     }
   }
 
@@ -732,6 +1025,23 @@ int vtkFileSeriesReader::RequestData(
   vtkInformation* outInfo = outputVector->GetInformationObject(requestFromPort);
   this->Internal->TimeRanges->GetInputTimeInfo(this->_FileIndex, outInfo);
 
+  const int index = static_cast<int>(this->_FileIndex);
+  const bool readAhead = this->ReadAhead && this->GetNumberOfFileNames() > 1 && index >= 0 &&
+    index < static_cast<int>(this->GetNumberOfFileNames());
+  if (readAhead && this->Internal->ReadAhead)
+  {
+    const int numPieces = this->Controller ? this->Controller->GetNumberOfProcesses() : 1;
+    const int piece = this->Controller ? this->Controller->GetLocalProcessId() : 0;
+    if (this->Internal->ReadAhead->IsReady(this->GetFileName(index), piece, numPieces))
+    {
+      ++this->NumberOfReadAheadHits;
+    }
+    else
+    {
+      ++this->NumberOfReadAheadMisses;
+    }
+  }
+
   int retVal = this->Reader->ProcessRequest(request, inputVector, outputVector);
 
   if (this->GetNumberOfFileNames() > 0)
@@ -740,9 +1050,70 @@ int vtkFileSeriesReader::RequestData(
     this->Internal->TimeRanges->GetAggregateTimeInfo(outInfo);
   }
 
+  if (readAhead)
+  {
+    // Read the next files while the data just read is being processed.
+    this->ScheduleReadAhead(index);
+  }
+  else if (this->Internal->ReadAhead)
+  {
+    this->Internal->ReadAhead.reset();
+  }
+
   return retVal;
 }
 
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReader::ScheduleReadAhead(int index)
+{
+  auto& internals = *this->Internal;
+  if (internals.LastReadIndex >= 0 && index != internals.LastReadIndex)
+  {
+    internals.ReadDirection = index > internals.LastReadIndex ? 1 : -1;
+  }
+  internals.LastReadIndex = index;
+
+  const int numPieces = this->Controller ? this->Controller->GetNumberOfProcesses() : 1;
+  const int piece = this->Controller ? this->Controller->GetLocalProcessId() : 0;
+
+  // The next time step in the playing direction comes first, then the
+  // previous one and then the following ones, until the buffer is full.
+  const int direction = internals.ReadDirection;
+  const int candidates[] = { index + direction, index - direction, index + 2 * direction,
+    index + 3 * direction, index + 4 * direction };
+  const double budget = this->ReadAheadBufferSize * 1024.0 * 1024.0;
+  double scheduled = 0.0;
+  std::vector<std::string> fileNames;
+  for (const int candidate : candidates)
+  {
+    if (candidate < 0 || candidate >= static_cast<int>(this->GetNumberOfFileNames()))
+    {
+      continue;
+    }
+    const std::string fileName = this->GetFileName(candidate);
+    const double size = static_cast<double>(vtksys::SystemTools::FileLength(fileName)) / numPieces;
+    if (scheduled + size > budget)
+    {
+      break;
+    }
+    scheduled += size;
+    fileNames.push_back(fileName);
+  }
+
+  if (!internals.ReadAhead)
+  {
+    internals.ReadAhead.reset(new vtkFileSeriesReaderReadAhead());
+  }
+  internals.ReadAhead->Schedule(fileNames, piece, numPieces);
+}
+
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReader::ResetReadAheadStatistics()
+{
+  this->NumberOfReadAheadHits = 0;
+  this->NumberOfReadAheadMisses = 0;
+}
+
 //-----------------------------------------------------------------------------
 int vtkFileSeriesReader::RequestInformationForInput(
   int index, vtkInformation* request, vtkInformationVector* outputVector)
@@ -791,6 +1162,257 @@ int vtkFileSeriesReader::RequestInformationForInput(
   return 1;
 }
 
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReader::CollectTimeInformation(
+  vtkInformation* request, vtkInformationVector* outputVector, int port)
+{
+  vtkInformation* outInfo = outputVector->GetInformationObject(port);
+  const int numFiles = static_cast<int>(this->GetNumberOfFileNames());
+  // Without the parallel probe, each rank works on its own since the ranks may
+  // not all be executing this request.
+  const bool parallel = this->ProbeFilesInParallel && this->Controller != nullptr;
+  const int numProcs = parallel ? this->Controller->GetNumberOfProcesses() : 1;
+  const int rank = parallel ? this->Controller->GetLocalProcessId() : 0;
+
+  // Time information for all files, starting with the first one which has
+  // already been probed by the caller.
+  std::vector<double> timeInfo;
+  ::PackTimeInformation(outInfo, timeInfo);
+
+  bool cached = false;
+  if (this->UseMetaDataCache)
+  {
+    std::vector<double> cachedTimeInfo;
+    if (rank == 0)
+    {
+      cached = this->ReadMetaDataCache(cachedTimeInfo) &&
+        ::GetNumberOfPackedTimeInformation(cachedTimeInfo) == numFiles;
+    }
+    if (numProcs > 1)
+    {
+      // only the validated contents are sent, with the result of the read.
+      vtkIdType size = cached ? static_cast<vtkIdType>(cachedTimeInfo.size()) : 0;
+      int status = cached ? 1 : 0;
+      this->Controller->Broadcast(&status, 1, 0);
+      this->Controller->Broadcast(&size, 1, 0);
+      cached = status != 0;
+      cachedTimeInfo.resize(size);
+      if (size > 0)
+      {
+        this->Controller->Broadcast(cachedTimeInfo.data(), size, 0);
+      }
+    }
+    if (cached)
+    {
+      // use the freshly probed information for the first file.
+      const size_t first = ::GetPackedTimeInformationSize(cachedTimeInfo, 0);
+      timeInfo.insert(timeInfo.end(), cachedTimeInfo.begin() + first, cachedTimeInfo.end());
+    }
+  }
+
+  if (!cached)
+  {
+    // Each rank probes a contiguous subset of the remaining files.
+    const vtkIdType numToProbe = numFiles - 1;
+    const int begin = 1 + static_cast<int>(numToProbe * rank / numProcs);
+    const int end = 1 + static_cast<int>(numToProbe * (rank + 1) / numProcs);
+    std::vector<double> localTimeInfo;
+    for (int i = begin; i < end; ++i)
+    {
+      // Expose current file number as information key for potential use in the internal reader
+      outInfo->Set(FILE_SERIES_CURRENT_FILE_NUMBER(), i);
+      this->RequestInformationForInput(i, request, outputVector);
+      ::PackTimeInformation(outInfo, localTimeInfo);
+    }
+
+    if (numProcs > 1)
+    {
+      // Gather in rank order, which is also the file order.
+      vtkIdType localSize = static_cast<vtkIdType>(localTimeInfo.size());
+      std::vector<vtkIdType> sizes(numProcs, 0);
+      std::vector<vtkIdType> offsets(numProcs, 0);
+      this->Controller->AllGather(&localSize, sizes.data(), 1);
+      for (int cc = 1; cc < numProcs; ++cc)
+      {
+        offsets[cc] = offsets[cc - 1] + sizes[cc - 1];
+      }
+      const size_t first = timeInfo.size();
+      timeInfo.resize(first + offsets[numProcs - 1] + sizes[numProcs - 1]);
+      this->Controller->AllGatherV(localTimeInfo.data(), timeInfo.data() + first, localSize,
+        sizes.data(), offsets.data());
+    }
+    else
+    {
+      timeInfo.insert(timeInfo.end(), localTimeInfo.begin(), localTimeInfo.end());
+    }
+
+    // a single rank writes the cache.
+    const int writer = this->Controller ? this->Controller->GetLocalProcessId() : 0;
+    if (this->UseMetaDataCache && writer == 0)
+    {
+      this->WriteMetaDataCache(timeInfo);
+    }
+  }
+
+  size_t pos = ::GetPackedTimeInformationSize(timeInfo, 0);
+  for (int i = 1; i < numFiles; ++i)
+  {
+    vtkNew<vtkInformation> fileInfo;
+    pos = ::UnpackTimeInformation(timeInfo, pos, fileInfo);
+    this->Internal->TimeRanges->AddTimeRange(i, fileInfo);
+  }
+
+  // Probing the files one after the other leaves the reader on the last file.
+  // Do the same here so that the output information does not depend on the
+  // number of ranks or on whether the cache was used.
+  if (this->_FileIndex != numFiles - 1)
+  {
+    outInfo->Set(FILE_SERIES_CURRENT_FILE_NUMBER(), numFiles - 1);
+    this->RequestInformationForInput(numFiles - 1, request, outputVector);
+  }
+}
+
+//-----------------------------------------------------------------------------
+std::string vtkFileSeriesReader::GetMetaDataCacheFileName()
+{
+  const std::string firstFile = vtksys::SystemTools::CollapseFullPath(this->GetFileName(0));
+  const std::string directory =
+    (this->MetaDataCacheDirectory && *this->MetaDataCacheDirectory)
+    ? std::string(this->MetaDataCacheDirectory)
+    : vtksys::SystemTools::GetFilenamePath(firstFile);
+
+  // The hash keeps caches for series from different directories apart when
+  // they share a cache directory.
+  std::ostringstream name;
+  name << directory << "/." << vtksys::SystemTools::GetFilenameName(firstFile) << "."
+       << std::hex << std::hash<std::string>{}(firstFile) << ".pvseries-cache";
+  return name.str();
+}
+
+//-----------------------------------------------------------------------------
+bool vtkFileSeriesReader::ReadMetaDataCache(std::vector<double>& timeInfo)
+{
+  timeInfo.clear();
+  const std::string cacheFileName = this->GetMetaDataCacheFileName();
+  vtksys::ifstream cacheFile(cacheFileName.c_str());
+  if (!cacheFile)
+  {
+    return false;
+  }
+
+  Json::Value root;
+  Json::CharReaderBuilder builder;
+  builder["collectComments"] = false;
+  if (!Json::parseFromStream(builder, cacheFile, &root, nullptr) || !root.isObject() ||
+    root["file-series-cache-version"].asString() != "1.0" ||
+    root["reader"].asString() != this->Reader->GetClassName())
+  {
+    return false;
+  }
+
+  const Json::Value& files = root["files"];
+  const unsigned int numFiles = this->GetNumberOfFileNames();
+  if (!files.isArray() || files.size() != numFiles)
+  {
+    return false;
+  }
+
+  timeInfo.clear();
+  for (unsigned int cc = 0; cc < numFiles; ++cc)
+  {
+    const Json::Value& file = files[cc];
+    const std::string fname = this->GetFileName(cc);
+    if (!file.isObject() || file["name"].asString() != fname ||
+      file["mtime"].asInt64() !=
+        static_cast<Json::Int64>(vtksys::SystemTools::ModifiedTime(fname)) ||
+      file["size"].asUInt64() != static_cast<Json::UInt64>(vtksys::SystemTools::FileLength(fname)))
+    {
+      vtkLogF(TRACE, "%s: metadata cache '%s' is out of date.", vtkLogIdentifier(this),
+        cacheFileName.c_str());
+      timeInfo.clear();
+      return false;
+    }
+
+    const size_t pos = timeInfo.size();
+    for (const auto& value : file["time"])
+    {
+      timeInfo.push_back(value.asDouble());
+    }
+    const size_t size = ::GetPackedTimeInformationSize(timeInfo, pos);
+    if (size == 0 || size != timeInfo.size() - pos)
+    {
+      timeInfo.clear();
+      return false;
+    }
+  }
+
+  vtkLogF(TRACE, "%s: using metadata cache '%s'.", vtkLogIdentifier(this), cacheFileName.c_str());
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkFileSeriesReader::WriteMetaDataCache(const std::vector<double>& timeInfo)
+{
+  Json::Value root(Json::objectValue);
+  root["file-series-cache-version"] = "1.0";
+  root["reader"] = this->Reader->GetClassName();
+
+  Json::Value& files = root["files"] = Json::Value(Json::arrayValue);
+  size_t pos = 0;
+  for (unsigned int cc = 0, max = this->GetNumberOfFileNames(); cc < max; ++cc)
+  {
+    const size_t size = ::GetPackedTimeInformationSize(timeInfo, pos);
+    if (size == 0)
+    {
+      return false;
+    }
+
+    const std::string fname = this->GetFileName(cc);
+    Json::Value file(Json::objectValue);
+    file["name"] = fname;
+    file["mtime"] = static_cast<Json::Int64>(vtksys::SystemTools::ModifiedTime(fname));
+    file["size"] = static_cast<Json::UInt64>(vtksys::SystemTools::FileLength(fname));
+    Json::Value& time = file["time"] = Json::Value(Json::arrayValue);
+    for (size_t idx = pos; idx < pos + size; ++idx)
+    {
+      time.append(timeInfo[idx]);
+    }
+    files.append(file);
+    pos += size;
+  }
+
+  // Write to a temporary file first so that other processes never see a
+  // partially written cache.
+  const std::string cacheFileName = this->GetMetaDataCacheFileName();
+  const std::string tmpFileName = cacheFileName + ".tmp";
+  {
+    vtksys::ofstream cacheFile(tmpFileName.c_str());
+    if (!cacheFile)
+    {
+      vtkLogF(TRACE, "%s: cannot write metadata cache '%s'.", vtkLogIdentifier(this),
+        cacheFileName.c_str());
+      return false;
+    }
+
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+    std::unique_ptr<Json::StreamWriter> writer(builder.newStreamWriter());
+    writer->write(root, &cacheFile);
+    if (!cacheFile)
+    {
+      cacheFile.close();
+      vtksys::SystemTools::RemoveFile(tmpFileName);
+      return false;
+    }
+  }
+  if (!vtksys::SystemTools::RenameFile(tmpFileName, cacheFileName))
+  {
+    vtksys::SystemTools::RemoveFile(tmpFileName);
+    return false;
+  }
+  return true;
+}
+
 //-----------------------------------------------------------------------------
 int vtkFileSeriesReader::FillOutputPortInformation(int port, vtkInformation* info)
 {
@@ -987,6 +1609,15 @@ void vtkFileSeriesReader::PrintSelf(ostream& os, vtkIndent indent)
      << endl;
   os << indent << "UseMetaFile: " << this->UseMetaFile << endl;
   os << indent << "IgnoreReaderTime: " << this->IgnoreReaderTime << endl;
+  os << indent << "UseMetaDataCache: " << this->UseMetaDataCache << endl;
+  os << indent << "MetaDataCacheDirectory: "
+     << (this->MetaDataCacheDirectory ? this->MetaDataCacheDirectory : "(none)") << endl;
+  os << indent << "ProbeFilesInParallel: " << this->ProbeFilesInParallel << endl;
+  os << indent << "Controller: " << this->Controller << endl;
+  os << indent << "ReadAhead: " << this->ReadAhead << endl;
+  os << indent << "ReadAheadBufferSize: " << this->ReadAheadBufferSize << endl;
+  os << indent << "NumberOfReadAheadHits: " << this->NumberOfReadAheadHits << endl;
+  os << indent << "NumberOfReadAheadMisses: " << this->NumberOfReadAheadMisses << endl;
 }
 
 //-----------------------------------------------------------------------------
@@ -75,6 +75,18 @@
  * with SetMetaFileName in this case. Do not use the AddFileName() method when
  * using SetMetaFileName() as names set with AddFileName() will be ignored.
  *
+ * When the internal reader reports time, time information is needed from every
+ * file in the series. When `ProbeFilesInParallel` is enabled, the files are
+ * probed in parallel, each rank of `Controller` handling a contiguous subset of
+ * the series, and the results are merged on all ranks. When `UseMetaDataCache`
+ * is enabled, the collected time information is also saved to a cache file,
+ * keyed on the modification time and size of each file, so that reopening an
+ * unchanged series does not require probing the files again.
+ *
+ * When `ReadAhead` is enabled, the files adjacent to the one just read are read
+ * on a background thread while the current time step is being processed, so
+ * that they are served from the operating system's file cache when requested.
+ *
 */
 
 #ifndef vtkFileSeriesReader_h
@@ -83,10 +95,12 @@
 #include "vtkMetaReader.h"
 #include "vtkPVVTKExtensionsIOCoreModule.h" //needed for exports
 
+#include <string> // Needed for protected API
 #include <vector> // Needed for protected API
 
 class vtkInformationIntegerKey;
 class vtkInformationStringKey;
+class vtkMultiProcessController;
 class vtkStringArray;
 
 struct vtkFileSeriesReaderInternals;
@@ -153,6 +167,80 @@ public:
   vtkBooleanMacro(IgnoreReaderTime, bool);
   ///@}
 
+  ///@{
+  /**
+   * If true, the time information collected from the files in the series is
+   * saved to a cache file and reused when the series is read again, provided
+   * none of the files changed in size or modification time. The cache file is
+   * written to `MetaDataCacheDirectory`, if set, otherwise next to the first
+   * file of the series. Both default to the value of the
+   * `PV_FILE_SERIES_CACHE_DIR` environment variable, i.e. caching is enabled
+   * when that variable is set and disabled otherwise.
+   */
+  vtkGetMacro(UseMetaDataCache, bool);
+  vtkSetMacro(UseMetaDataCache, bool);
+  vtkBooleanMacro(UseMetaDataCache, bool);
+  vtkGetStringMacro(MetaDataCacheDirectory);
+  vtkSetStringMacro(MetaDataCacheDirectory);
+  ///@}
+
+  ///@{
+  /**
+   * If true, probing the files in the series for time information is split
+   * across the ranks of `Controller`, and the metadata cache is read on the
+   * first rank only. This requires RequestInformation() to be called on all
+   * ranks of `Controller` together, so only enable it when the reader is
+   * updated collectively. Defaults to the value of the
+   * `PV_FILE_SERIES_PARALLEL_PROBE` environment variable, if set, and false
+   * otherwise.
+   */
+  vtkGetMacro(ProbeFilesInParallel, bool);
+  vtkSetMacro(ProbeFilesInParallel, bool);
+  vtkBooleanMacro(ProbeFilesInParallel, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the controller used to distribute probing the files in the series
+   * for time information (see ProbeFilesInParallel). Defaults to the global
+   * controller.
+   */
+  void SetController(vtkMultiProcessController*);
+  vtkGetObjectMacro(Controller, vtkMultiProcessController);
+  ///@}
+
+  ///@{
+  /**
+   * If true, once a file has been read, the files for the next time steps, in
+   * the direction the time steps are being played, and for the previous time
+   * step are read on a background thread. The files are read in full and then
+   * discarded, so that the internal reader finds them in the operating
+   * system's file cache. In parallel, each rank reads an equal part of each
+   * file. `ReadAheadBufferSize`, in MiB, bounds the amount of data each rank
+   * reads ahead. Both default to the value of the `PV_FILE_SERIES_READ_AHEAD`
+   * environment variable, i.e. read-ahead is enabled with that buffer size
+   * when the variable is set and disabled otherwise.
+   */
+  vtkGetMacro(ReadAhead, bool);
+  vtkSetMacro(ReadAhead, bool);
+  vtkBooleanMacro(ReadAhead, bool);
+  vtkGetMacro(ReadAheadBufferSize, int);
+  vtkSetClampMacro(ReadAheadBufferSize, int, 1, VTK_INT_MAX);
+  ///@}
+
+  ///@{
+  /**
+   * Statistics about read-ahead: the number of files whose part assigned to
+   * this rank had been read ahead when requested (hits) and the number of
+   * files for which it had not (misses). In parallel, a hit means that only
+   * this rank's part of the file is known to be in the file cache; the other
+   * parts are read ahead by the other ranks.
+   */
+  vtkGetMacro(NumberOfReadAheadHits, vtkIdType);
+  vtkGetMacro(NumberOfReadAheadMisses, vtkIdType);
+  void ResetReadAheadStatistics();
+  ///@}
+
   // Expose number of files, first filename and current file number as
   // information keys for potential use in the internal reader
   static vtkInformationIntegerKey* FILE_SERIES_NUMBER_OF_FILES();
@@ -235,6 +323,42 @@ protected:
 
   int ChooseInput(vtkInformation*);
 
+  /**
+   * Collects time information for all files in the series but the first one,
+   * which must already have been probed, and adds it to the time ranges. The
+   * information is read from the metadata cache when possible, otherwise the
+   * files are probed, in parallel across the ranks of `Controller` if
+   * `ProbeFilesInParallel` is enabled.
+   */
+  virtual void CollectTimeInformation(
+    vtkInformation* request, vtkInformationVector* outputVector, int port);
+
+  ///@{
+  /**
+   * Read/write the metadata cache. `timeInfo` holds the packed time information
+   * for every file in the series. ReadMetaDataCache returns false, and leaves
+   * `timeInfo` empty, if there is no cache or if it is out of date or invalid.
+   */
+  virtual bool ReadMetaDataCache(std::vector<double>& timeInfo);
+  virtual bool WriteMetaDataCache(const std::vector<double>& timeInfo);
+  std::string GetMetaDataCacheFileName();
+  ///@}
+
+  /**
+   * Schedules the files adjacent to `index` to be read ahead, within
+   * `ReadAheadBufferSize`. Called in RequestData().
+   */
+  virtual void ScheduleReadAhead(int index);
+
+  bool UseMetaDataCache;
+  char* MetaDataCacheDirectory;
+  bool ProbeFilesInParallel;
+  vtkMultiProcessController* Controller;
+  bool ReadAhead;
+  int ReadAheadBufferSize;
+  vtkIdType NumberOfReadAheadHits;
+  vtkIdType NumberOfReadAheadMisses;
+
 private:
   vtkFileSeriesReader(const vtkFileSeriesReader&) = delete;
   void operator=(const vtkFileSeriesReader&) = delete;